@@ -0,0 +1,100 @@
+#-------------------------------------------------
+#
+# msspm-bench: times (or checks) the objective functions
+# and the projection on synthetic Systems, without a database
+#
+#-------------------------------------------------
+
+QT       += core sql concurrent
+QT       -= gui
+
+TARGET = msspm-bench
+TEMPLATE = app
+
+CONFIG += console c++14
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# Build the projection kernel's matrix-vector products with Eigen with: qmake CONFIG+=eigen
+CONFIG(eigen) {
+    DEFINES += MSSPM_EIGEN
+    INCLUDEPATH += /usr/include/eigen3
+}
+
+LIBS += -lboost_system -lboost_filesystem
+
+SOURCES += \
+    main.cpp \
+    nmfBenchmark.cpp \
+    nmfBenchmarkChecks.cpp \
+    nmfSyntheticSystem.cpp \
+    ../MSSPM_Main/nmfEstimationEngine.cpp \
+    ../MSSPM_Main/nmfForecastEngine.cpp \
+    ../MSSPM_Main/nmfSystemLoader.cpp
+
+HEADERS += \
+    nmfBenchmark.h \
+    nmfSyntheticSystem.h \
+    ../MSSPM_Main/nmfEstimationEngine.h \
+    ../MSSPM_Main/nmfForecastEngine.h \
+    ../MSSPM_Main/nmfRandomStream.h \
+    ../MSSPM_Main/nmfSystemLoader.h
+
+INCLUDEPATH += $$PWD/../MSSPM_Main
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/MSSPM/bin
+!isEmpty(target.path): INSTALLS += target
+
+# For the Bees code
+INCLUDEPATH += /home/rklasky
+
+unix|win32: LIBS += -L/usr/local/lib -lnlopt_cxx
+INCLUDEPATH += /usr/local/lib
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-nmfDatabase-Qt_5_12_3_gcc64-Release/release/ -lnmfDatabase
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-nmfDatabase-Qt_5_12_3_gcc64-Release/debug/ -lnmfDatabase
+else:unix: LIBS += -L$$PWD/../../build-nmfDatabase-Qt_5_12_3_gcc64-Release/ -lnmfDatabase
+
+INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfDatabase
+DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfDatabase
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-nmfUtilities-Qt_5_12_3_gcc64-Release/release/ -lnmfUtilities
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-nmfUtilities-Qt_5_12_3_gcc64-Release/debug/ -lnmfUtilities
+else:unix: LIBS += -L$$PWD/../../build-nmfUtilities-Qt_5_12_3_gcc64-Release/ -lnmfUtilities
+
+INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
+DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-BeesAlgorithm-Qt_5_12_3_gcc64-Release/release/ -lBeesAlgorithm
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-BeesAlgorithm-Qt_5_12_3_gcc64-Release/debug/ -lBeesAlgorithm
+else:unix: LIBS += -L$$PWD/../../build-BeesAlgorithm-Qt_5_12_3_gcc64-Release/ -lBeesAlgorithm
+
+INCLUDEPATH += $$PWD/../../nmfSharedUtilities/BeesAlgorithm
+DEPENDPATH += $$PWD/../../nmfSharedUtilities/BeesAlgorithm
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-nmfModels-Qt_5_12_3_gcc64-Release/release/ -lnmfModels
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-nmfModels-Qt_5_12_3_gcc64-Release/debug/ -lnmfModels
+else:unix: LIBS += -L$$PWD/../../build-nmfModels-Qt_5_12_3_gcc64-Release/ -lnmfModels
+
+INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfModels
+DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfModels
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationNLoptAlgorithm-Qt_5_12_3_gcc64-Release/release/ -lMSSPM_ParameterEstimationNLoptAlgorithm
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationNLoptAlgorithm-Qt_5_12_3_gcc64-Release/debug/ -lMSSPM_ParameterEstimationNLoptAlgorithm
+else:unix: LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationNLoptAlgorithm-Qt_5_12_3_gcc64-Release/ -lMSSPM_ParameterEstimationNLoptAlgorithm
+
+INCLUDEPATH += $$PWD/../MSSPM_ParameterEstimationNLoptAlgorithm
+DEPENDPATH += $$PWD/../MSSPM_ParameterEstimationNLoptAlgorithm
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationBeesAlgorithm-Qt_5_12_3_gcc64-Release/release/ -lMSSPM_ParameterEstimationBeesAlgorithm
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationBeesAlgorithm-Qt_5_12_3_gcc64-Release/debug/ -lMSSPM_ParameterEstimationBeesAlgorithm
+else:unix: LIBS += -L$$PWD/../../build-MSSPM_ParameterEstimationBeesAlgorithm-Qt_5_12_3_gcc64-Release/ -lMSSPM_ParameterEstimationBeesAlgorithm
+
+INCLUDEPATH += $$PWD/../MSSPM_ParameterEstimationBeesAlgorithm
+DEPENDPATH += $$PWD/../MSSPM_ParameterEstimationBeesAlgorithm
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
@@ -0,0 +1,153 @@
+#include "nmfBenchmark.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <iostream>
+
+// Splits a comma separated list of names (e.g., model forms) into its trimmed, non-empty names
+static std::vector<std::string>
+settingList(const QString& value)
+{
+    std::vector<std::string> names;
+
+    for (const QString& name : value.split(",")) {
+        if (! name.trimmed().isEmpty()) {
+            names.push_back(name.trimmed().toStdString());
+        }
+    }
+    return names;
+}
+
+// Splits a comma separated list of positive integers, returning false if any is invalid
+static bool
+settingIntList(const QString& value, std::vector<int>& numbers)
+{
+    bool ok;
+    int number;
+
+    numbers.clear();
+    for (const std::string& name : settingList(value)) {
+        number = QString::fromStdString(name).toInt(&ok);
+        if (! ok || (number <= 0)) {
+            return false;
+        }
+        numbers.push_back(number);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    bool ok;
+    nmfBenchmarkSettings Settings;
+
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("msspm-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Times the MSSPM objective functions and projection on synthetic Systems.\n"
+                "Lists are comma separated; an empty form list uses every form.\n"
+                "No database is needed.");
+    parser.addHelpOption();
+    QCommandLineOption benchmarksOption(      "benchmarks",        "Benchmarks to run: nlopt, bees, projection (default: all).","list");
+    QCommandLineOption speciesOption(         "species",           "Numbers of species (default: 5,50,500).","list");
+    QCommandLineOption yearsOption(           "years",             "Numbers of years (default: 10,50,200).","list");
+    QCommandLineOption growthFormsOption(     "growth-forms",      "Growth forms (default: all).","list");
+    QCommandLineOption harvestFormsOption(    "harvest-forms",     "Harvest forms (default: all).","list");
+    QCommandLineOption competitionFormsOption("competition-forms", "Competition forms (default: all).","list");
+    QCommandLineOption predationFormsOption(  "predation-forms",   "Predation forms (default: all).","list");
+    QCommandLineOption densityOption(         "density",           "Fraction of the pairs of species that interact (default: 1).","fraction");
+    QCommandLineOption threadsOption(         "threads",           "Numbers of threads (default: 1,2,4,... up to all cores).","list");
+    QCommandLineOption minTimeOption(         "min-time",          "Minimum seconds each thread spends on a case (default: 0.1).","sec");
+    QCommandLineOption pointsOption(          "points",            "Distinct parameter vectors evaluated in turn (default: 16).","n");
+    QCommandLineOption seedOption(            "seed",              "Seed of the synthetic Systems and parameter vectors (default: 1).","n");
+    QCommandLineOption outputOption(          "output",            "CSV file to write the results to.","file");
+    QCommandLineOption checkOption(           "check",             "Check the objective functions instead of timing them (default sizes: 4 species, 20 years).");
+    parser.addOption(benchmarksOption);
+    parser.addOption(speciesOption);
+    parser.addOption(yearsOption);
+    parser.addOption(growthFormsOption);
+    parser.addOption(harvestFormsOption);
+    parser.addOption(competitionFormsOption);
+    parser.addOption(predationFormsOption);
+    parser.addOption(densityOption);
+    parser.addOption(threadsOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(pointsOption);
+    parser.addOption(seedOption);
+    parser.addOption(outputOption);
+    parser.addOption(checkOption);
+    parser.process(app);
+
+    Settings.Benchmarks       = settingList(parser.value(benchmarksOption));
+    Settings.GrowthForms      = settingList(parser.value(growthFormsOption));
+    Settings.HarvestForms     = settingList(parser.value(harvestFormsOption));
+    Settings.CompetitionForms = settingList(parser.value(competitionFormsOption));
+    Settings.PredationForms   = settingList(parser.value(predationFormsOption));
+    Settings.OutputFile       = parser.value(outputOption).toStdString();
+
+    std::vector<std::string> Benchmarks = nmfBenchmark::benchmarks();
+    for (const std::string& Benchmark : Settings.Benchmarks) {
+        if (std::find(Benchmarks.begin(),Benchmarks.end(),Benchmark) == Benchmarks.end()) {
+            std::cerr << "Error: unknown benchmark: " << Benchmark << std::endl;
+            return 1;
+        }
+    }
+    if (parser.isSet(speciesOption) && ! settingIntList(parser.value(speciesOption),Settings.NumSpecies)) {
+        std::cerr << "Error: invalid --species list" << std::endl;
+        return 1;
+    }
+    if (parser.isSet(yearsOption) && ! settingIntList(parser.value(yearsOption),Settings.NumYears)) {
+        std::cerr << "Error: invalid --years list" << std::endl;
+        return 1;
+    }
+    if (parser.isSet(threadsOption) && ! settingIntList(parser.value(threadsOption),Settings.NumThreads)) {
+        std::cerr << "Error: invalid --threads list" << std::endl;
+        return 1;
+    }
+    if (parser.isSet(densityOption)) {
+        Settings.InteractionDensity = parser.value(densityOption).toDouble(&ok);
+        if (! ok || (Settings.InteractionDensity <= 0) || (Settings.InteractionDensity > 1)) {
+            std::cerr << "Error: invalid --density" << std::endl;
+            return 1;
+        }
+    }
+    if (parser.isSet(minTimeOption)) {
+        Settings.MinSeconds = parser.value(minTimeOption).toDouble(&ok);
+        if (! ok || (Settings.MinSeconds < 0)) {
+            std::cerr << "Error: invalid --min-time" << std::endl;
+            return 1;
+        }
+    }
+    if (parser.isSet(pointsOption)) {
+        Settings.NumPoints = parser.value(pointsOption).toInt(&ok);
+        if (! ok || (Settings.NumPoints <= 0)) {
+            std::cerr << "Error: invalid --points" << std::endl;
+            return 1;
+        }
+    }
+    if (parser.isSet(seedOption)) {
+        Settings.Seed = parser.value(seedOption).toULongLong(&ok);
+        if (! ok) {
+            std::cerr << "Error: invalid --seed" << std::endl;
+            return 1;
+        }
+    }
+
+    // The checks take central differences, so default to small Systems
+    if (parser.isSet(checkOption)) {
+        if (! parser.isSet(speciesOption)) {
+            Settings.NumSpecies = {4};
+        }
+        if (! parser.isSet(yearsOption)) {
+            Settings.NumYears = {20};
+        }
+    }
+
+    nmfBenchmark Benchmark(Settings);
+
+    return (parser.isSet(checkOption)) ? Benchmark.check() : Benchmark.run();
+}
@@ -0,0 +1,446 @@
+#include "nmfBenchmark.h"
+#include "nmfConstantsMSSPM.h"
+#include "BeesAlgorithm.h"
+#include "NLopt_Estimator.h"
+
+#include <QFuture>
+#include <QList>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> NumAllocations(0);
+
+}
+
+// Counts every operator new allocation in the process, including the libraries'. The
+// array forms call these. Memory allocated with malloc directly isn't counted.
+void*
+operator new(std::size_t size)
+{
+    NumAllocations.fetch_add(1,std::memory_order_relaxed);
+    if (void* ptr = std::malloc((size > 0) ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    NumAllocations.fetch_add(1,std::memory_order_relaxed);
+    return std::malloc((size > 0) ? size : 1);
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+/**
+ * @brief One thread's copy of the state evaluated by a benchmark
+ */
+class Evaluator
+{
+public:
+    virtual ~Evaluator() {}
+    virtual bool isValid() = 0;
+    virtual double evaluate(const std::vector<double>& Parameters) = 0;
+};
+
+// NLopt_Estimator::objectiveFunction, as called by the minimizer
+class NLoptEvaluator : public Evaluator
+{
+private:
+    NLoptWorkspace m_Workspace;
+
+public:
+    NLoptEvaluator(const Data_Struct& dataStruct) {
+        NLopt_Estimator::initializeWorkspace(dataStruct,m_Workspace);
+        m_Workspace.ReportProgress = false;
+    }
+    bool isValid() override {
+        return (m_Workspace.Project != nullptr);
+    }
+    double evaluate(const std::vector<double>& Parameters) override {
+        return NLopt_Estimator::objectiveFunction(Parameters.size(),&Parameters[0],nullptr,&m_Workspace);
+    }
+};
+
+// BeesAlgorithm::evaluateObjectiveFunction, as called for each bee
+class BeesEvaluator : public Evaluator
+{
+private:
+    std::unique_ptr<BeesAlgorithm> m_BeesAlgorithm;
+
+public:
+    BeesEvaluator(const Data_Struct& dataStruct) {
+        m_BeesAlgorithm = std::make_unique<BeesAlgorithm>(dataStruct,nmfConstantsMSSPM::VerboseOff);
+    }
+    bool isValid() override {
+        return (m_BeesAlgorithm != nullptr);
+    }
+    double evaluate(const std::vector<double>& Parameters) override {
+        return m_BeesAlgorithm->evaluateObjectiveFunction(Parameters);
+    }
+};
+
+// The projection that nmfMainWindow::updateOutputBiomassTable runs before writing the
+// biomass table, i.e., one clamped projection of a fixed set of estimated parameters
+class ProjectionEvaluator : public Evaluator
+{
+private:
+    nmfProjectionKernel::ProjectionFunction m_Project;
+    nmfProjectionSystem                     m_System;
+    nmfProjectionParameters                 m_Parameters;
+    nmfProjectionScratch                    m_Scratch;
+    nmfProjectionKernel::Matrix             m_Biomass;
+    nmfProjectionKernel::Matrix             m_BiomassGuilds;
+    std::vector<double>                     m_InitialBiomass;
+
+public:
+    ProjectionEvaluator(const Data_Struct& dataStruct) {
+        bool isAggProd = (dataStruct.CompetitionForm == "AGG-PROD");
+        int NumYears   = dataStruct.RunLength+1;
+        int NumSpeciesOrGuilds = (isAggProd) ? dataStruct.NumGuilds : dataStruct.NumSpecies;
+        const nmfProjectionKernel::Matrix& ObservedBiomass = (isAggProd) ?
+                    dataStruct.ObservedBiomassByGuilds : dataStruct.ObservedBiomassBySpecies;
+
+        m_Project = nmfProjectionKernel::select(dataStruct.GrowthForm,dataStruct.HarvestForm,
+                                                dataStruct.CompetitionForm,dataStruct.PredationForm,true);
+        nmfProjectionKernel::initializeSystem(NumYears,NumSpeciesOrGuilds,dataStruct.NumGuilds,isAggProd,
+                                              dataStruct.GuildSpecies,dataStruct.Catch,
+                                              dataStruct.Effort,dataStruct.Exploitation,m_System);
+        NLopt_Estimator::extractParameters(dataStruct,&dataStruct.Parameters[0],
+                                           m_Parameters.GrowthRate,m_Parameters.CarryingCapacity,
+                                           m_Parameters.Catchability,m_Parameters.CompetitionAlpha,
+                                           m_Parameters.CompetitionBetaSpecies,m_Parameters.CompetitionBetaGuilds,
+                                           m_Parameters.Predation,m_Parameters.Handling,m_Parameters.Exponent);
+        nmfProjectionKernel::initializeInteractions(m_Parameters,m_System);
+        nmfUtils::initialize(m_Biomass,      NumYears,NumSpeciesOrGuilds);
+        nmfUtils::initialize(m_BiomassGuilds,NumYears,dataStruct.NumGuilds);
+        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+            m_InitialBiomass.push_back(ObservedBiomass(0,i));
+        }
+    }
+    bool isValid() override {
+        return (m_Project != nullptr);
+    }
+    double evaluate(const std::vector<double>& Parameters) override {
+        for (unsigned i=0; i<m_InitialBiomass.size(); ++i) {
+            m_Biomass(0,i) = m_InitialBiomass[i];
+        }
+        m_Project(m_System,m_Parameters,m_Scratch,m_Biomass,m_BiomassGuilds);
+        return m_Biomass(m_Biomass.size1()-1,0);
+    }
+};
+
+std::unique_ptr<Evaluator>
+createEvaluator(const std::string& Benchmark,
+                const Data_Struct& dataStruct)
+{
+    if (Benchmark == "nlopt") {
+        return std::make_unique<NLoptEvaluator>(dataStruct);
+    } else if (Benchmark == "bees") {
+        return std::make_unique<BeesEvaluator>(dataStruct);
+    } else if (Benchmark == "projection") {
+        return std::make_unique<ProjectionEvaluator>(dataStruct);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief What one thread measured
+ */
+struct ThreadTiming {
+    int64_t NumEvaluations = 0;
+    double  Seconds        = 0;
+};
+
+// Evaluates the points in turn until at least MinSeconds have passed
+void
+timeEvaluations(Evaluator&                               evaluator,
+                const std::vector<std::vector<double> >& Points,
+                const int&                               FirstPoint,
+                const double&                            MinSeconds,
+                ThreadTiming&                            Timing)
+{
+    const int MinNumEvaluations = 3;
+    int point = FirstPoint;
+    volatile double fitness = 0; // keeps the evaluations from being optimized away
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    Timing = ThreadTiming();
+    while ((Timing.NumEvaluations < MinNumEvaluations) || (Timing.Seconds < MinSeconds)) {
+        fitness = evaluator.evaluate(Points[point]);
+        point = (point+1)%Points.size();
+        ++Timing.NumEvaluations;
+        Timing.Seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now()-startTime).count();
+    }
+    (void)fitness;
+}
+
+template<class T>
+std::vector<T>
+orAll(const std::vector<T>& values,
+      const std::vector<T>& all)
+{
+    return (values.empty()) ? all : values;
+}
+
+}
+
+nmfBenchmark::nmfBenchmark(const nmfBenchmarkSettings& Settings)
+{
+    m_Settings = Settings;
+    m_Results.clear();
+}
+
+std::vector<std::string>
+nmfBenchmark::benchmarks()
+{
+    return {"nlopt","bees","projection"};
+}
+
+uint64_t
+nmfBenchmark::getNumAllocations()
+{
+    return NumAllocations.load(std::memory_order_relaxed);
+}
+
+const std::vector<nmfBenchmarkResult>&
+nmfBenchmark::getResults()
+{
+    return m_Results;
+}
+
+std::vector<nmfSyntheticSystemSettings>
+nmfBenchmark::getSystems()
+{
+    nmfSyntheticSystemSettings System;
+    std::vector<nmfSyntheticSystemSettings> Systems;
+
+    System.Seed = m_Settings.Seed;
+    System.InteractionDensity = m_Settings.InteractionDensity;
+    for (const std::string& GrowthForm : orAll(m_Settings.GrowthForms,nmfSyntheticSystem::growthForms())) {
+        System.GrowthForm = GrowthForm;
+        for (const std::string& HarvestForm : orAll(m_Settings.HarvestForms,nmfSyntheticSystem::harvestForms())) {
+            System.HarvestForm = HarvestForm;
+            for (const std::string& CompetitionForm : orAll(m_Settings.CompetitionForms,nmfSyntheticSystem::competitionForms())) {
+                System.CompetitionForm = CompetitionForm;
+                for (const std::string& PredationForm : orAll(m_Settings.PredationForms,nmfSyntheticSystem::predationForms())) {
+                    System.PredationForm = PredationForm;
+                    for (const int& NumSpecies : m_Settings.NumSpecies) {
+                        System.NumSpecies = NumSpecies;
+                        for (const int& NumYears : m_Settings.NumYears) {
+                            System.NumYears = NumYears;
+                            Systems.push_back(System);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return Systems;
+}
+
+int
+nmfBenchmark::run()
+{
+    bool ok = true;
+    Data_Struct dataStruct;
+    nmfProjectionParameters TrueParameters;
+    std::vector<double> LowerBounds;
+    std::vector<double> UpperBounds;
+    std::vector<std::vector<double> > Points;
+
+    if (m_Settings.NumThreads.empty()) {
+        for (int numThreads=1; numThreads<QThread::idealThreadCount(); numThreads *= 2) {
+            m_Settings.NumThreads.push_back(numThreads);
+        }
+        m_Settings.NumThreads.push_back(QThread::idealThreadCount());
+    }
+
+    std::cout << std::left
+              << std::setw(11) << "Benchmark" << std::setw(10) << "Growth"
+              << std::setw(17) << "Harvest"   << std::setw(10) << "Compet."
+              << std::setw(10) << "Predation" << std::right
+              << std::setw(8)  << "Species"   << std::setw(7)  << "Years"
+              << std::setw(8)  << "Params"    << std::setw(8)  << "Threads"
+              << std::setw(14) << "Latency(us)" << std::setw(14) << "Evals/s"
+              << std::setw(12) << "News/eval" << std::setw(9) << "Speedup" << std::endl;
+
+    for (const nmfSyntheticSystemSettings& SystemSettings : getSystems()) {
+        if (! nmfSyntheticSystem::generate(SystemSettings,dataStruct,TrueParameters)) {
+            std::cerr << "Error: no projection for model forms: " <<
+                         SystemSettings.GrowthForm      << ", " << SystemSettings.HarvestForm << ", " <<
+                         SystemSettings.CompetitionForm << ", " << SystemSettings.PredationForm << std::endl;
+            ok = false;
+            continue;
+        }
+
+        // The same points are evaluated by every benchmark of the System
+        nmfSyntheticSystem::getParameterBounds(dataStruct,LowerBounds,UpperBounds);
+        Points.resize(std::max(1,m_Settings.NumPoints));
+        for (unsigned i=0; i<Points.size(); ++i) {
+            nmfSyntheticSystem::randomParameters(LowerBounds,UpperBounds,m_Settings.Seed,i,Points[i]);
+        }
+        for (const std::string& Benchmark : orAll(m_Settings.Benchmarks,benchmarks())) {
+            ok = runCase(Benchmark,dataStruct,Points) && ok;
+        }
+    }
+
+    if (! writeResults()) {
+        ok = false;
+    }
+
+    return (ok) ? 0 : 1;
+}
+
+bool
+nmfBenchmark::runCase(const std::string&                       Benchmark,
+                      const Data_Struct&                       dataStruct,
+                      const std::vector<std::vector<double> >& Points)
+{
+    double singleThreadRate = 0;
+    uint64_t startAllocations;
+    nmfBenchmarkResult Result;
+
+    Result.Benchmark       = Benchmark;
+    Result.GrowthForm      = dataStruct.GrowthForm;
+    Result.HarvestForm     = dataStruct.HarvestForm;
+    Result.CompetitionForm = dataStruct.CompetitionForm;
+    Result.PredationForm   = dataStruct.PredationForm;
+    Result.NumSpecies      = dataStruct.NumSpecies;
+    Result.NumYears        = dataStruct.RunLength;
+    Result.NumParameters   = Points[0].size();
+
+    for (const int& NumThreads : m_Settings.NumThreads) {
+        // MSSPM never evaluates BeesAlgorithm instances concurrently either
+        if ((Benchmark == "bees") && (NumThreads > 1)) {
+            continue;
+        }
+        std::vector<std::unique_ptr<Evaluator> > evaluators;
+        std::vector<ThreadTiming> timings(std::max(1,NumThreads));
+        QList<QFuture<void> > futures;
+        QThreadPool pool;
+
+        // Each thread gets its own state, which is sized by a first (untimed) evaluation
+        for (unsigned thread=0; thread<timings.size(); ++thread) {
+            evaluators.push_back(createEvaluator(Benchmark,dataStruct));
+            if (! evaluators.back() || ! evaluators.back()->isValid()) {
+                std::cerr << "Error: couldn't set up benchmark: " << Benchmark << std::endl;
+                return false;
+            }
+            evaluators.back()->evaluate(Points[0]);
+        }
+
+        pool.setMaxThreadCount(timings.size());
+        startAllocations = getNumAllocations();
+        for (unsigned thread=0; thread<timings.size(); ++thread) {
+            futures.append(QtConcurrent::run(&pool, [&,thread]() {
+                timeEvaluations(*evaluators[thread],Points,thread%Points.size(),
+                                m_Settings.MinSeconds,timings[thread]);
+            }));
+        }
+        for (QFuture<void>& future : futures) {
+            future.waitForFinished();
+        }
+
+        Result.NumThreads           = timings.size();
+        Result.NumEvaluations       = 0;
+        Result.LatencySeconds       = 0;
+        Result.EvaluationsPerSecond = 0;
+        for (const ThreadTiming& timing : timings) {
+            Result.NumEvaluations       += timing.NumEvaluations;
+            Result.LatencySeconds       += timing.Seconds;
+            Result.EvaluationsPerSecond += timing.NumEvaluations/timing.Seconds;
+        }
+        Result.LatencySeconds /= Result.NumEvaluations;
+        Result.NewsPerEvaluation = double(getNumAllocations()-startAllocations)/Result.NumEvaluations;
+        if (Result.NumThreads == 1) {
+            singleThreadRate = Result.EvaluationsPerSecond;
+        }
+        Result.Speedup = (singleThreadRate > 0) ? Result.EvaluationsPerSecond/singleThreadRate : 0;
+
+        m_Results.push_back(Result);
+        printResult(Result);
+    }
+
+    return true;
+}
+
+void
+nmfBenchmark::printResult(const nmfBenchmarkResult& Result)
+{
+    std::cout << std::left
+              << std::setw(11) << Result.Benchmark  << std::setw(10) << Result.GrowthForm
+              << std::setw(17) << Result.HarvestForm << std::setw(10) << Result.CompetitionForm
+              << std::setw(10) << Result.PredationForm << std::right
+              << std::setw(8)  << Result.NumSpecies << std::setw(7) << Result.NumYears
+              << std::setw(8)  << Result.NumParameters << std::setw(8) << Result.NumThreads
+              << std::fixed
+              << std::setw(14) << std::setprecision(3) << Result.LatencySeconds*1.0e6
+              << std::setw(14) << std::setprecision(0) << Result.EvaluationsPerSecond
+              << std::setw(12) << std::setprecision(2) << Result.NewsPerEvaluation
+              << std::setw(9)  << std::setprecision(2) << Result.Speedup
+              << std::defaultfloat << std::endl;
+}
+
+bool
+nmfBenchmark::writeResults()
+{
+    if (m_Settings.OutputFile.empty()) {
+        return true;
+    }
+
+    std::ofstream outputFile(m_Settings.OutputFile);
+    if (! outputFile) {
+        std::cerr << "Error: couldn't write file: " << m_Settings.OutputFile << std::endl;
+        return false;
+    }
+    outputFile << "Benchmark,GrowthForm,HarvestForm,CompetitionForm,PredationForm,"
+               << "NumSpecies,NumYears,NumParameters,NumThreads,NumEvaluations,"
+               << "LatencySeconds,EvaluationsPerSecond,OperatorNewsPerEvaluation,Speedup\n";
+    outputFile << std::setprecision(9);
+    for (const nmfBenchmarkResult& Result : m_Results) {
+        outputFile << Result.Benchmark     << "," << Result.GrowthForm      << ","
+                   << Result.HarvestForm   << "," << Result.CompetitionForm << ","
+                   << Result.PredationForm << "," << Result.NumSpecies      << ","
+                   << Result.NumYears      << "," << Result.NumParameters   << ","
+                   << Result.NumThreads    << "," << Result.NumEvaluations  << ","
+                   << Result.LatencySeconds           << "," << Result.EvaluationsPerSecond << ","
+                   << Result.NewsPerEvaluation        << "," << Result.Speedup << "\n";
+    }
+    std::cout << "Wrote: " << m_Settings.OutputFile << std::endl;
+
+    return true;
+}
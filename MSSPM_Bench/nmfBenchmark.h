@@ -0,0 +1,143 @@
+/**
+ * @file nmfBenchmark.h
+ * @brief Definition of the micro-benchmarks run by msspm-bench
+ *
+ * This file contains the definition of the benchmark runner. It times the NLopt
+ * and Bees objective functions and the biomass projection on synthetic Systems,
+ * reporting the latency and throughput of an evaluation, the number of operator
+ * new allocations made per evaluation and how the throughput scales with threads.
+ * It can also check the estimators' objective functions on the same Systems.
+ *
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfSyntheticSystem.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The benchmark grid and timing settings
+ */
+struct nmfBenchmarkSettings {
+    std::vector<std::string> Benchmarks;       // nlopt, bees and/or projection, empty for all
+    std::vector<int>         NumSpecies = {5,50,500};
+    std::vector<int>         NumYears   = {10,50,200};
+    std::vector<std::string> GrowthForms;      // model forms, empty for all forms
+    std::vector<std::string> HarvestForms;
+    std::vector<std::string> CompetitionForms;
+    std::vector<std::string> PredationForms;
+    double                   InteractionDensity = 1.0; // fraction of the pairs of species that interact
+    std::vector<int>         NumThreads;       // empty for 1, 2, 4, ... up to the ideal thread count
+    double                   MinSeconds = 0.1; // minimum time each thread spends evaluating a case
+    int                      NumPoints  = 16;  // distinct parameter vectors evaluated in turn
+    uint64_t                 Seed       = 1;
+    std::string              OutputFile;       // CSV file of the results, empty for none
+};
+
+/**
+ * @brief The timings of one benchmark case
+ */
+struct nmfBenchmarkResult {
+    std::string Benchmark;
+    std::string GrowthForm;
+    std::string HarvestForm;
+    std::string CompetitionForm;
+    std::string PredationForm;
+    int         NumSpecies     = 0;
+    int         NumYears       = 0;
+    int         NumParameters  = 0;
+    int         NumThreads     = 0;
+    int64_t     NumEvaluations = 0;
+    double      LatencySeconds       = 0; // mean time of an evaluation on one thread
+    double      EvaluationsPerSecond = 0; // over all of the threads
+    double      NewsPerEvaluation    = 0; // operator new allocations per evaluation
+    double      Speedup        = 0;       // throughput relative to one thread (0 if not measured)
+};
+
+/**
+ * @brief Runs the objective function and projection micro-benchmarks
+ *
+ * Each case evaluates its own copy of the objective function's state on each thread,
+ * as the NLopt estimator's concurrent starts do. The Bees objective function isn't
+ * known to be reentrant, so it's only run on one thread. Allocations are counted by the
+ * benchmark's replacement of the global operator new, so memory allocated with
+ * malloc (e.g., by C libraries) isn't counted.
+ */
+class nmfBenchmark
+{
+private:
+    nmfBenchmarkSettings            m_Settings;
+    std::vector<nmfBenchmarkResult> m_Results;
+
+    std::vector<nmfSyntheticSystemSettings> getSystems();
+    bool runCase(const std::string&                       Benchmark,
+                 const Data_Struct&                       dataStruct,
+                 const std::vector<std::vector<double> >& Points);
+    void printResult(const nmfBenchmarkResult& Result);
+    bool writeResults();
+    bool checkFitness(const Data_Struct&                       dataStruct,
+                      const std::vector<std::vector<double> >& Points);
+    bool checkGradient(const Data_Struct&         dataStruct,
+                       const std::vector<double>& Point);
+    bool checkPruning(const Data_Struct& dataStruct);
+
+public:
+    /**
+     * @brief nmfBenchmark : class constructor
+     * @param Settings : the benchmark grid and timing settings
+     */
+    nmfBenchmark(const nmfBenchmarkSettings& Settings);
+   ~nmfBenchmark() {}
+
+    /**
+     * @brief Gets the names of all of the benchmarks
+     */
+    static std::vector<std::string> benchmarks();
+    /**
+     * @brief Gets the number of operator new allocations made by the process so far
+     */
+    static uint64_t getNumAllocations();
+    /**
+     * @brief Gets the results of the cases run so far
+     */
+    const std::vector<nmfBenchmarkResult>& getResults();
+    /**
+     * @brief Runs every case of the benchmark grid, printing each result as it completes
+     * @return Returns the process exit code (0 if every case ran)
+     */
+    int run();
+    /**
+     * @brief Checks the estimators on the Systems of the benchmark grid instead of
+     * timing them: for each objective criterion and scaling, the NLopt objective
+     * function's fitness on the tape must equal the nmfUtilsStatistics fitness at
+     * random points and its gradient must match central differences, and each minimizer
+     * that supports pruning must reach the same optimum with and without it
+     * @return Returns the process exit code (0 if every check passed)
+     */
+    int check();
+};
@@ -0,0 +1,298 @@
+#include "nmfBenchmark.h"
+#include "NLopt_Estimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <nlopt.hpp>
+#include <sstream>
+
+namespace {
+
+// Largest difference between two gradients relative to the largest component of the reference
+double
+relativeError(const std::vector<double>& gradient,
+              const std::vector<double>& reference)
+{
+    double maxDiff = 0;
+    double maxReference = 0;
+
+    for (unsigned k=0; k<gradient.size(); ++k) {
+        maxDiff      = std::max(maxDiff,std::fabs(gradient[k]-reference[k]));
+        maxReference = std::max(maxReference,std::fabs(reference[k]));
+    }
+
+    return (maxReference > 0) ? maxDiff/maxReference : maxDiff;
+}
+
+// Minimizes over the free parameters only, as NLopt_Estimator::runStart does
+double
+freeParametersObjectiveFunction(unsigned      n,
+                                const double* FreeParameters,
+                                double*       gradient,
+                                void*         dataPtr)
+{
+    NLoptWorkspace& ws = *((NLoptWorkspace *)dataPtr);
+
+    for (unsigned k=0; k<n; ++k) {
+        ws.AllParameters[ws.FreeParameters[k]] = FreeParameters[k];
+    }
+    return NLopt_Estimator::objectiveFunction(ws.AllParameters.size(),ws.AllParameters.data(),gradient,dataPtr);
+}
+
+// Runs a minimizer from the middle of the parameter ranges, returning the best fitness found
+double
+minimize(const Data_Struct&         dataStruct,
+         const nlopt::algorithm&    Minimizer,
+         const std::vector<double>& LowerBounds,
+         const std::vector<double>& UpperBounds,
+         const double&              PruneSlackFactor,
+         int&                       NumPruned)
+{
+    const int MaxNumEvaluations = 20000;
+    NLoptWorkspace ws;
+    std::vector<double> freeLowerBounds;
+    std::vector<double> freeUpperBounds;
+    std::vector<double> freeParameters;
+    double fitness = 0;
+
+    NLopt_Estimator::initializeWorkspace(dataStruct,ws);
+    ws.ReportProgress   = false;
+    ws.PruneSlackFactor = PruneSlackFactor;
+    ws.AllParameters.resize(LowerBounds.size());
+    for (unsigned i=0; i<LowerBounds.size(); ++i) {
+        ws.AllParameters[i] = LowerBounds[i] + (UpperBounds[i]-LowerBounds[i])/2.0;
+        if (UpperBounds[i] > LowerBounds[i]) {
+            ws.FreeParameters.push_back(i);
+            freeLowerBounds.push_back(LowerBounds[i]);
+            freeUpperBounds.push_back(UpperBounds[i]);
+            freeParameters.push_back(ws.AllParameters[i]);
+        }
+    }
+
+    nlopt::srand(1); // the same random numbers for both runs of GN_CRS2_LM
+    nlopt::opt optimizer(Minimizer,freeParameters.size());
+    optimizer.set_lower_bounds(freeLowerBounds);
+    optimizer.set_upper_bounds(freeUpperBounds);
+    optimizer.set_min_objective(freeParametersObjectiveFunction,&ws);
+    optimizer.set_ftol_rel(1e-10);
+    optimizer.set_maxeval(MaxNumEvaluations);
+    try {
+        optimizer.optimize(freeParameters,fitness);
+    } catch (const std::exception& e) {
+        // e.g., roundoff limited, the best point so far is still usable
+        fitness = optimizer.last_optimum_value();
+    }
+    NumPruned = ws.FitnessBound.NumPruned;
+
+    return fitness;
+}
+
+void
+printCheck(const std::string& Check,
+           const Data_Struct& dataStruct,
+           const std::string& Detail,
+           const bool&        passed)
+{
+    std::cout << std::left
+              << std::setw(10) << Check
+              << std::setw(10) << dataStruct.GrowthForm      << std::setw(17) << dataStruct.HarvestForm
+              << std::setw(10) << dataStruct.CompetitionForm << std::setw(10) << dataStruct.PredationForm
+              << std::setw(20) << dataStruct.ObjectiveCriterion << std::setw(9) << dataStruct.Scaling
+              << std::setw(40) << Detail << ((passed) ? "ok" : "FAILED") << std::endl;
+}
+
+}
+
+bool
+nmfBenchmark::checkGradient(const Data_Struct&         dataStruct,
+                            const std::vector<double>& Point)
+{
+    const double MaxRelativeError = 1e-4;
+    const double DefaultFitness   = 99999;
+    Data_Struct gradientStruct = dataStruct;
+    NLoptWorkspace ws;
+    std::vector<double> x = Point;
+    std::vector<double> gradient(Point.size());
+    std::vector<double> differences(Point.size());
+    double fitness;
+    double fitnessPlus;
+    double fitnessMinus;
+    double h;
+    double error;
+    std::ostringstream detail;
+
+    // A gradient based minimizer makes the workspace differentiate the objective
+    gradientStruct.Minimizer = "LD_LBFGS";
+    NLopt_Estimator::initializeWorkspace(gradientStruct,ws);
+    ws.ReportProgress = false;
+    if ((ws.Project == nullptr) || (ws.ProjectAD == nullptr)) {
+        printCheck("gradient",dataStruct,"no projection kernel",false);
+        return false;
+    }
+
+    fitness = NLopt_Estimator::objectiveFunction(x.size(),x.data(),gradient.data(),&ws);
+    if (fitness == DefaultFitness) {
+        printCheck("gradient",dataStruct,"skipped (invalid biomass)",true);
+        return true;
+    }
+    for (unsigned k=0; k<x.size(); ++k) {
+        h = 1e-6*std::max(1.0,std::fabs(Point[k]));
+        x[k] = Point[k] + h;
+        fitnessPlus  = NLopt_Estimator::objectiveFunction(x.size(),x.data(),nullptr,&ws);
+        x[k] = Point[k] - h;
+        fitnessMinus = NLopt_Estimator::objectiveFunction(x.size(),x.data(),nullptr,&ws);
+        x[k] = Point[k];
+        differences[k] = (fitnessPlus-fitnessMinus)/(2.0*h);
+    }
+
+    error = relativeError(gradient,differences);
+    detail << "relative error " << std::scientific << std::setprecision(2) << error;
+    printCheck("gradient",dataStruct,detail.str(),(error <= MaxRelativeError));
+
+    return (error <= MaxRelativeError);
+}
+
+bool
+nmfBenchmark::checkFitness(const Data_Struct&                       dataStruct,
+                           const std::vector<std::vector<double> >& Points)
+{
+    const double MaxRelativeDifference = 1e-9;
+    const double DefaultFitness        = 99999;
+    Data_Struct gradientStruct = dataStruct;
+    NLoptWorkspace ws;
+    std::vector<double> x;
+    std::vector<double> gradient;
+    double fitness;
+    double fitnessAD;
+    double difference;
+    double maxDifference = 0;
+    int NumCompared = 0;
+    bool passed;
+    std::ostringstream detail;
+
+    // The value returned with a gradient comes from the criteria on the tape and
+    // the one without from nmfUtilsStatistics
+    gradientStruct.Minimizer = "LD_LBFGS";
+    NLopt_Estimator::initializeWorkspace(gradientStruct,ws);
+    ws.ReportProgress = false;
+    if ((ws.Project == nullptr) || (ws.ProjectAD == nullptr)) {
+        printCheck("fitness",dataStruct,"no projection kernel",false);
+        return false;
+    }
+
+    for (const std::vector<double>& Point : Points) {
+        x = Point;
+        gradient.resize(x.size());
+        fitness   = NLopt_Estimator::objectiveFunction(x.size(),x.data(),nullptr,&ws);
+        fitnessAD = NLopt_Estimator::objectiveFunction(x.size(),x.data(),gradient.data(),&ws);
+        if ((fitness == DefaultFitness) && (fitnessAD == DefaultFitness)) {
+            continue; // invalid biomass
+        }
+        difference    = std::fabs(fitnessAD-fitness)/std::max(1.0,std::fabs(fitness));
+        maxDifference = std::max(maxDifference,difference);
+        ++NumCompared;
+    }
+
+    passed = (maxDifference <= MaxRelativeDifference);
+    detail << "relative difference " << std::scientific << std::setprecision(2)
+           << maxDifference << " (" << NumCompared << " points)";
+    printCheck("fitness",dataStruct,detail.str(),passed);
+
+    return passed;
+}
+
+bool
+nmfBenchmark::checkPruning(const Data_Struct& dataStruct)
+{
+    const double MaxRelativeDifference = 1e-3;
+    const double PruneSlackFactor      = 10.0;
+    Data_Struct pruneStruct = dataStruct;
+    std::vector<double> LowerBounds;
+    std::vector<double> UpperBounds;
+    double fitness;
+    double fitnessPruned;
+    double difference;
+    int NumPruned;
+    bool passed;
+    std::ostringstream detail;
+
+    nmfSyntheticSystem::getParameterBounds(dataStruct,LowerBounds,UpperBounds);
+    const std::map<std::string,nlopt::algorithm> Minimizers = {
+        {"LN_NELDERMEAD",nlopt::LN_NELDERMEAD},
+        {"LN_SBPLX",     nlopt::LN_SBPLX},
+        {"GN_CRS2_LM",   nlopt::GN_CRS2_LM}};
+    for (const auto& Minimizer : Minimizers) {
+        pruneStruct.Minimizer = Minimizer.first;
+        if (! NLopt_Estimator::supportsPruning(Minimizer.first)) {
+            printCheck("pruning",pruneStruct,"not supported",false);
+            return false;
+        }
+        fitness       = minimize(pruneStruct,Minimizer.second,LowerBounds,UpperBounds,0,NumPruned);
+        fitnessPruned = minimize(pruneStruct,Minimizer.second,LowerBounds,UpperBounds,PruneSlackFactor,NumPruned);
+        difference    = std::fabs(fitnessPruned-fitness)/std::max(1e-12,std::fabs(fitness));
+        passed        = (difference <= MaxRelativeDifference);
+
+        detail.str("");
+        detail << Minimizer.first << " " << std::scientific << std::setprecision(2)
+               << difference << " (" << NumPruned << " pruned)";
+        printCheck("pruning",pruneStruct,detail.str(),passed);
+        if (! passed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int
+nmfBenchmark::check()
+{
+    bool ok = true;
+    Data_Struct dataStruct;
+    nmfProjectionParameters TrueParameters;
+    std::vector<double> LowerBounds;
+    std::vector<double> UpperBounds;
+    std::vector<double> Point;
+    std::vector<std::vector<double> > Points;
+    const std::vector<std::string> ObjectiveCriteria = {"Least Squares","Model Efficiency","Maximum Likelihood"};
+    const std::vector<std::string> Scalings          = {"Min Max","Mean"};
+
+    for (const nmfSyntheticSystemSettings& SystemSettings : getSystems()) {
+        if (! nmfSyntheticSystem::generate(SystemSettings,dataStruct,TrueParameters)) {
+            continue;
+        }
+
+        // Halfway between the true parameters and a random point, so the residuals aren't zero
+        nmfSyntheticSystem::getParameterBounds(dataStruct,LowerBounds,UpperBounds);
+        nmfSyntheticSystem::randomParameters(LowerBounds,UpperBounds,m_Settings.Seed,0,Point);
+        for (unsigned k=0; k<Point.size(); ++k) {
+            Point[k] = 0.5*(Point[k]+dataStruct.Parameters[k]);
+        }
+        Points.assign(1,Point);
+        for (int i=1; i<m_Settings.NumPoints; ++i) {
+            Points.emplace_back();
+            nmfSyntheticSystem::randomParameters(LowerBounds,UpperBounds,m_Settings.Seed,i,Points.back());
+        }
+
+        for (const std::string& ObjectiveCriterion : ObjectiveCriteria) {
+            for (const std::string& Scaling : Scalings) {
+                dataStruct.ObjectiveCriterion = ObjectiveCriterion;
+                dataStruct.Scaling            = Scaling;
+                ok = checkFitness(dataStruct,Points) && ok;
+                ok = checkGradient(dataStruct,Point) && ok;
+            }
+        }
+        dataStruct.ObjectiveCriterion = "Least Squares";
+        for (const std::string& Scaling : Scalings) {
+            dataStruct.Scaling = Scaling;
+            ok = checkPruning(dataStruct) && ok;
+        }
+    }
+
+    std::cout << ((ok) ? "All checks passed" : "Some checks FAILED") << std::endl;
+
+    return (ok) ? 0 : 1;
+}
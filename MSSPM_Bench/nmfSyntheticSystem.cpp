@@ -0,0 +1,387 @@
+#include "nmfSyntheticSystem.h"
+#include "nmfEstimationEngine.h"
+#include "nmfRandomStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const double ReferenceBiomass = 100; // typical carrying capacity of a species
+
+typedef boost::numeric::ublas::matrix<double> Matrix;
+
+// Sequential random values for building a System
+class Random
+{
+private:
+    std::mt19937_64                        m_Engine;
+    std::uniform_real_distribution<double> m_Uniform;
+
+public:
+    Random(const uint64_t& Seed) : m_Engine(Seed), m_Uniform(0.0,1.0) {}
+
+    double uniform(const double& min, const double& max) {
+        return min + (max-min)*m_Uniform(m_Engine);
+    }
+};
+
+// Interaction coefficients (row i acting on species i) scaled so that their summed
+// effect stays below a tenth of the species' growth rate. With a density below 1 only
+// that fraction of the off-diagonal pairs interact.
+void randomInteraction(Random&                    random,
+                       const int&                 NumRows,
+                       const int&                 NumColumns,
+                       const std::vector<double>& Scale,
+                       const double&              Density,
+                       Matrix&                    matrix)
+{
+    nmfUtils::initialize(matrix,NumRows,NumColumns);
+    for (int i=0; i<NumRows; ++i) {
+        for (int j=0; j<NumColumns; ++j) {
+            if ((Density < 1) && (i != j) && (random.uniform(0.0,1.0) >= Density)) {
+                continue;
+            }
+            matrix(i,j) = random.uniform(0.0,0.1)*Scale[i];
+        }
+    }
+}
+
+void setRange(const std::vector<double>&             values,
+              const double&                          lowFactor,
+              const double&                          highFactor,
+              boost::numeric::ublas::vector<double>& minValues,
+              boost::numeric::ublas::vector<double>& maxValues)
+{
+    nmfUtils::initialize(minValues,values.size());
+    nmfUtils::initialize(maxValues,values.size());
+    for (unsigned i=0; i<values.size(); ++i) {
+        minValues(i) = lowFactor *values[i];
+        maxValues(i) = highFactor*values[i];
+    }
+}
+
+void setRange(const Matrix&                      values,
+              std::vector<std::vector<double> >& minValues,
+              std::vector<std::vector<double> >& maxValues)
+{
+    minValues.assign(values.size1(),std::vector<double>(values.size2(),0.0));
+    maxValues.assign(values.size1(),std::vector<double>(values.size2(),0.0));
+    for (unsigned i=0; i<values.size1(); ++i) {
+        for (unsigned j=0; j<values.size2(); ++j) {
+            maxValues[i][j] = 2.0*values(i,j);
+        }
+    }
+}
+
+void toVector(const boost::numeric::ublas::vector<double>& values,
+              std::vector<double>&                         vector)
+{
+    vector.assign(values.begin(),values.end());
+}
+
+void toMatrix(const std::vector<std::vector<double> >& values,
+              Matrix&                                  matrix)
+{
+    int NumColumns = (values.empty()) ? 0 : values[0].size();
+
+    nmfUtils::initialize(matrix,values.size(),NumColumns);
+    for (unsigned i=0; i<values.size(); ++i) {
+        for (int j=0; j<NumColumns; ++j) {
+            matrix(i,j) = values[i][j];
+        }
+    }
+}
+
+}
+
+std::vector<std::string>
+nmfSyntheticSystem::growthForms()
+{
+    return {"Null","Linear","Logistic"};
+}
+
+std::vector<std::string>
+nmfSyntheticSystem::harvestForms()
+{
+    return {"Null","Catch","Effort (qE)","Exploitation (F)"};
+}
+
+std::vector<std::string>
+nmfSyntheticSystem::competitionForms()
+{
+    return {"Null","NO_K","MS-PROD","AGG-PROD"};
+}
+
+std::vector<std::string>
+nmfSyntheticSystem::predationForms()
+{
+    return {"Null","Type I","Type II","Type III"};
+}
+
+bool
+nmfSyntheticSystem::generate(const nmfSyntheticSystemSettings& Settings,
+                             Data_Struct&                      dataStruct,
+                             nmfProjectionParameters&          TrueParameters)
+{
+    bool isLogistic = (Settings.GrowthForm      == "Logistic");
+    bool isLinear   = (Settings.GrowthForm      == "Linear");
+    bool isEffort   = (Settings.HarvestForm     == "Effort (qE)");
+    bool isAlpha    = (Settings.CompetitionForm == "NO_K");
+    bool isMSPROD   = (Settings.CompetitionForm == "MS-PROD");
+    bool isAggProd  = (Settings.CompetitionForm == "AGG-PROD");
+    bool isRho      = (Settings.PredationForm   == "Type I")  ||
+                      (Settings.PredationForm   == "Type II") ||
+                      (Settings.PredationForm   == "Type III");
+    bool isHandling = (Settings.PredationForm   == "Type II") ||
+                      (Settings.PredationForm   == "Type III");
+    bool isExponent = (Settings.PredationForm   == "Type III");
+    int NumSpecies  = std::max(1,Settings.NumSpecies);
+    int NumGuilds   = (Settings.NumGuilds > 0) ? std::min(Settings.NumGuilds,NumSpecies) :
+                                                 std::max(1,NumSpecies/5);
+    int RunLength   = std::max(1,Settings.NumYears);
+    int NumYears    = RunLength+1;
+    int NumSpeciesOrGuilds = (isAggProd) ? NumGuilds : NumSpecies;
+    double Density  = std::min(1.0,std::max(0.0,Settings.InteractionDensity));
+    std::vector<double> Size(NumSpeciesOrGuilds,1.0); // number of species in each species (or guild)
+    std::vector<double> InitialBiomass(NumSpeciesOrGuilds);
+    std::vector<double> Scale(NumSpeciesOrGuilds);
+    nmfProjectionParameters& P = TrueParameters;
+    nmfProjectionSystem System;
+    nmfProjectionScratch Scratch;
+    Matrix Biomass;
+    Matrix BiomassGuilds;
+    Random random(Settings.Seed);
+
+    nmfProjectionKernel::ProjectionFunction Project = nmfProjectionKernel::select(
+                Settings.GrowthForm,Settings.HarvestForm,
+                Settings.CompetitionForm,Settings.PredationForm,true);
+    if (Project == nullptr) {
+        return false;
+    }
+
+    dataStruct = Data_Struct();
+    dataStruct.RunLength             = RunLength;
+    dataStruct.NumSpecies            = NumSpecies;
+    dataStruct.NumGuilds             = NumGuilds;
+    dataStruct.GrowthForm            = Settings.GrowthForm;
+    dataStruct.HarvestForm           = Settings.HarvestForm;
+    dataStruct.CompetitionForm       = Settings.CompetitionForm;
+    dataStruct.PredationForm         = Settings.PredationForm;
+    dataStruct.Minimizer             = Settings.Minimizer;
+    dataStruct.ObjectiveCriterion    = Settings.ObjectiveCriterion;
+    dataStruct.Scaling               = Settings.Scaling;
+    dataStruct.Benchmark             = (isAlpha || isRho) ? "LogisticMultiSpecies" : Settings.GrowthForm;
+    dataStruct.BeesNumTotal          = 40;
+    dataStruct.BeesNumElite          = 5;
+    dataStruct.BeesNumOther          = 10;
+    dataStruct.BeesNumEliteSites     = 5;
+    dataStruct.BeesNumBestSites      = 10;
+    dataStruct.BeesNumRepetitions    = 1;
+    dataStruct.BeesMaxGenerations    = 100;
+    dataStruct.BeesNeighborhoodSize  = 4;
+    dataStruct.NLoptUseStopVal       = 0;
+    dataStruct.NLoptUseStopAfterTime = 0;
+    dataStruct.NLoptUseStopAfterIter = 1;
+    dataStruct.NLoptStopVal          = 0;
+    dataStruct.NLoptStopAfterTime    = 1;
+    dataStruct.NLoptStopAfterIter    = 1000;
+    dataStruct.showDiagnosticChart   = false;
+
+    // Species are dealt into the guilds in turn (AGG-PROD runs on the guilds themselves)
+    dataStruct.GuildSpecies.clear();
+    dataStruct.GuildNum.clear();
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        if (isAggProd) {
+            dataStruct.GuildSpecies[i].push_back(i);
+            dataStruct.GuildNum.push_back(i);
+            Size[i] = (NumSpecies/NumGuilds) + ((i < NumSpecies%NumGuilds) ? 1 : 0);
+        } else {
+            dataStruct.GuildSpecies[i%NumGuilds].push_back(i);
+            dataStruct.GuildNum.push_back(i%NumGuilds);
+        }
+    }
+
+    // The true parameters
+    P = nmfProjectionParameters();
+    P.GrowthRate.resize(NumSpeciesOrGuilds);
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        P.GrowthRate[i]   = (isLinear) ? random.uniform(0.01,0.03) : random.uniform(0.2,0.6);
+        InitialBiomass[i] = random.uniform(0.3,0.7)*ReferenceBiomass*Size[i];
+        if (isLogistic) {
+            P.CarryingCapacity.push_back(random.uniform(1.5,2.5)*InitialBiomass[i]);
+        }
+        if (isEffort) {
+            P.Catchability.push_back(random.uniform(1e-4,2e-4));
+        }
+        if (isExponent) {
+            P.Exponent.push_back(random.uniform(0.1,0.5));
+        }
+    }
+    nmfUtils::initialize(P.CompetitionAlpha,      NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(P.CompetitionBetaSpecies,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(P.CompetitionBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
+    nmfUtils::initialize(P.Predation,             NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(P.Handling,              NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    if (isAlpha || isRho) {
+        // Sum of B(i)*coefficient(i,j)*B(j) over j stays below a tenth of r(i)*B(i)
+        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+            Scale[i] = P.GrowthRate[i]/(NumSpeciesOrGuilds*ReferenceBiomass);
+        }
+        if (isAlpha) {
+            randomInteraction(random,NumSpeciesOrGuilds,NumSpeciesOrGuilds,Scale,Density,P.CompetitionAlpha);
+        }
+        if (isExponent) {
+            // Type III predation raises the prey biomass to the exponent+1 power
+            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+                Scale[i] /= std::pow(ReferenceBiomass,P.Exponent[i]);
+            }
+        }
+        if (isRho) {
+            randomInteraction(random,NumSpeciesOrGuilds,NumSpeciesOrGuilds,Scale,Density,P.Predation);
+        }
+    }
+    if (isMSPROD || isAggProd) {
+        // The MS-PROD and AGG-PROD terms are already relative to r(i)*B(i)
+        Scale.assign(NumSpeciesOrGuilds,1.0);
+        if (isMSPROD) {
+            randomInteraction(random,NumSpeciesOrGuilds,NumSpeciesOrGuilds,Scale,Density,P.CompetitionBetaSpecies);
+        }
+        Scale.assign(NumSpeciesOrGuilds,1.0/NumGuilds);
+        randomInteraction(random,NumSpeciesOrGuilds,NumGuilds,Scale,1.0,P.CompetitionBetaGuilds);
+    }
+    if (isHandling) {
+        Scale.assign(NumSpeciesOrGuilds,0.1);
+        randomInteraction(random,NumSpeciesOrGuilds,NumSpeciesOrGuilds,Scale,1.0,P.Handling);
+    }
+
+    // The harvest time series (by species, as they're stored in the database). Catch
+    // declines so that it can't exhaust a species without growth.
+    nmfUtils::initialize(dataStruct.Catch,       NumYears,NumSpecies);
+    nmfUtils::initialize(dataStruct.Effort,      NumYears,NumSpecies);
+    nmfUtils::initialize(dataStruct.Exploitation,NumYears,NumSpecies);
+    for (int i=0; i<NumSpecies; ++i) {
+        double initialBiomass = (i < NumSpeciesOrGuilds) ? InitialBiomass[i] : 0.5*ReferenceBiomass;
+        double effort         = random.uniform(0.8,1.2)*0.02/1.5e-4;
+        double exploitation   = random.uniform(0.01,0.03);
+        for (int time=0; time<NumYears; ++time) {
+            dataStruct.Catch(time,i)        = 0.02*initialBiomass*std::pow(0.98,time);
+            dataStruct.Effort(time,i)       = effort;
+            dataStruct.Exploitation(time,i) = exploitation;
+        }
+    }
+
+    // The observed biomass is the noisy projection of the true parameters
+    nmfProjectionKernel::initializeSystem(NumYears,NumSpeciesOrGuilds,NumGuilds,isAggProd,
+                                          dataStruct.GuildSpecies,dataStruct.Catch,
+                                          dataStruct.Effort,dataStruct.Exploitation,System);
+    nmfUtils::initialize(Biomass,      NumYears,NumSpeciesOrGuilds);
+    nmfUtils::initialize(BiomassGuilds,NumYears,NumGuilds);
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        Biomass(0,i) = InitialBiomass[i];
+    }
+    Project(System,P,Scratch,Biomass,BiomassGuilds);
+    for (int time=1; time<NumYears; ++time) {
+        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+            Biomass(time,i) *= random.uniform(0.9,1.1);
+        }
+    }
+    nmfUtils::initialize(dataStruct.ObservedBiomassBySpecies,NumYears,NumSpecies);
+    nmfUtils::initialize(dataStruct.ObservedBiomassByGuilds, NumYears,NumGuilds);
+    for (int time=0; time<NumYears; ++time) {
+        if (isAggProd) {
+            for (int i=0; i<NumSpecies; ++i) {
+                dataStruct.ObservedBiomassBySpecies(time,i) = Biomass(time,i%NumGuilds)/Size[i%NumGuilds];
+            }
+            for (int i=0; i<NumGuilds; ++i) {
+                dataStruct.ObservedBiomassByGuilds(time,i) = Biomass(time,i);
+            }
+        } else {
+            for (int i=0; i<NumSpecies; ++i) {
+                dataStruct.ObservedBiomassBySpecies(time,i) = Biomass(time,i);
+                dataStruct.ObservedBiomassByGuilds(time,dataStruct.GuildNum[i]) += Biomass(time,i);
+            }
+        }
+    }
+
+    // The parameter ranges are set around the true parameters
+    setRange(P.GrowthRate,0.5,1.5,dataStruct.GrowthRateMin,dataStruct.GrowthRateMax);
+    setRange(P.CarryingCapacity,0.5,1.5,dataStruct.CarryingCapacityMin,dataStruct.CarryingCapacityMax);
+    setRange(P.Catchability,0.5,1.5,dataStruct.CatchabilityMin,dataStruct.CatchabilityMax);
+    nmfUtils::initialize(dataStruct.CarryingCapacityInitial,NumSpeciesOrGuilds);
+    nmfUtils::initialize(dataStruct.ExploitationRateMin,    NumSpeciesOrGuilds);
+    nmfUtils::initialize(dataStruct.ExploitationRateMax,    NumSpeciesOrGuilds);
+    for (unsigned i=0; i<P.CarryingCapacity.size(); ++i) {
+        dataStruct.CarryingCapacityInitial(i) = P.CarryingCapacity[i];
+    }
+    if (isAlpha) {
+        setRange(P.CompetitionAlpha,dataStruct.CompetitionMin,dataStruct.CompetitionMax);
+    }
+    if (isMSPROD) {
+        setRange(P.CompetitionBetaSpecies,dataStruct.CompetitionBetaSpeciesMin,dataStruct.CompetitionBetaSpeciesMax);
+    }
+    if (isMSPROD || isAggProd) {
+        setRange(P.CompetitionBetaGuilds,dataStruct.CompetitionBetaGuildsMin,dataStruct.CompetitionBetaGuildsMax);
+    }
+    if (isRho) {
+        setRange(P.Predation,dataStruct.PredationMin,dataStruct.PredationMax);
+    }
+    if (isHandling) {
+        setRange(P.Handling,dataStruct.HandlingMin,dataStruct.HandlingMax);
+    }
+    for (unsigned i=0; i<P.Exponent.size(); ++i) {
+        dataStruct.ExponentMin.push_back(0.5*P.Exponent[i]);
+        dataStruct.ExponentMax.push_back(1.5*P.Exponent[i]);
+    }
+
+    nmfEstimationEngine::packParameters(dataStruct,P,dataStruct.Parameters);
+    dataStruct.TotalNumberParameters = dataStruct.Parameters.size();
+
+    return true;
+}
+
+void
+nmfSyntheticSystem::getParameterBounds(const Data_Struct&   dataStruct,
+                                       std::vector<double>& LowerBounds,
+                                       std::vector<double>& UpperBounds)
+{
+    nmfProjectionParameters Min;
+    nmfProjectionParameters Max;
+
+    toVector(dataStruct.GrowthRateMin,      Min.GrowthRate);
+    toVector(dataStruct.GrowthRateMax,      Max.GrowthRate);
+    toVector(dataStruct.CarryingCapacityMin,Min.CarryingCapacity);
+    toVector(dataStruct.CarryingCapacityMax,Max.CarryingCapacity);
+    toVector(dataStruct.CatchabilityMin,    Min.Catchability);
+    toVector(dataStruct.CatchabilityMax,    Max.Catchability);
+    Min.Exponent = dataStruct.ExponentMin;
+    Max.Exponent = dataStruct.ExponentMax;
+    toMatrix(dataStruct.CompetitionMin,           Min.CompetitionAlpha);
+    toMatrix(dataStruct.CompetitionMax,           Max.CompetitionAlpha);
+    toMatrix(dataStruct.CompetitionBetaSpeciesMin,Min.CompetitionBetaSpecies);
+    toMatrix(dataStruct.CompetitionBetaSpeciesMax,Max.CompetitionBetaSpecies);
+    toMatrix(dataStruct.CompetitionBetaGuildsMin, Min.CompetitionBetaGuilds);
+    toMatrix(dataStruct.CompetitionBetaGuildsMax, Max.CompetitionBetaGuilds);
+    toMatrix(dataStruct.PredationMin,             Min.Predation);
+    toMatrix(dataStruct.PredationMax,             Max.Predation);
+    toMatrix(dataStruct.HandlingMin,              Min.Handling);
+    toMatrix(dataStruct.HandlingMax,              Max.Handling);
+
+    nmfEstimationEngine::packParameters(dataStruct,Min,LowerBounds);
+    nmfEstimationEngine::packParameters(dataStruct,Max,UpperBounds);
+}
+
+void
+nmfSyntheticSystem::randomParameters(const std::vector<double>& LowerBounds,
+                                     const std::vector<double>& UpperBounds,
+                                     const uint64_t&            Seed,
+                                     const uint32_t&            Index,
+                                     std::vector<double>&       Parameters)
+{
+    Parameters.resize(LowerBounds.size());
+    for (unsigned i=0; i<LowerBounds.size(); ++i) {
+        Parameters[i] = LowerBounds[i] + (UpperBounds[i]-LowerBounds[i])*
+                nmfRandomStream::uniform(Seed,Index,nmfRandomStream::GrowthRate,i,0);
+    }
+}
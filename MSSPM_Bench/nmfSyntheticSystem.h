@@ -0,0 +1,123 @@
+/**
+ * @file nmfSyntheticSystem.h
+ * @brief Definition of the synthetic System generator used by msspm-bench
+ *
+ * This file contains the definition of the synthetic System generator. It builds a
+ * multi-species System with any combination of model forms entirely in memory, so
+ * that the objective functions and the projection kernel can be benchmarked
+ * without a database.
+ *
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfProjectionKernel.h"
+#include "nmfUtils.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The size, model forms and estimation settings of a synthetic System
+ */
+struct nmfSyntheticSystemSettings {
+    int         NumSpecies         = 10;
+    int         NumYears           = 50;   // number of projected years (i.e., the run length)
+    int         NumGuilds          = 0;    // 0 for one guild per 5 species
+    double      InteractionDensity = 1.0;  // fraction of the pairs of species that compete or prey
+    std::string GrowthForm         = "Logistic";
+    std::string HarvestForm        = "Catch";
+    std::string CompetitionForm    = "NO_K";
+    std::string PredationForm      = "Type I";
+    std::string Minimizer          = "GN_ORIG_DIRECT_L";
+    std::string ObjectiveCriterion = "Least Squares";
+    std::string Scaling            = "Min Max";
+    uint64_t    Seed               = 1;
+};
+
+/**
+ * @brief Generates multi-species Systems in memory
+ *
+ * The "true" parameters are drawn so that the interaction terms stay a fraction of
+ * the growth term, which keeps the projected biomass positive. The observed biomass
+ * is the projection of the true parameters with +/-10% noise, and the parameter
+ * ranges are set around the true parameters, as they would be for a real System.
+ * Pairs of species that don't interact have their parameter range fixed at zero.
+ */
+class nmfSyntheticSystem
+{
+public:
+    /**
+     * @brief Gets the names of all of the growth forms
+     */
+    static std::vector<std::string> growthForms();
+    /**
+     * @brief Gets the names of all of the harvest forms
+     */
+    static std::vector<std::string> harvestForms();
+    /**
+     * @brief Gets the names of all of the competition forms
+     */
+    static std::vector<std::string> competitionForms();
+    /**
+     * @brief Gets the names of all of the predation forms
+     */
+    static std::vector<std::string> predationForms();
+    /**
+     * @brief Generates a System
+     * @param Settings : the size, model forms and estimation settings of the System
+     * @param dataStruct : the generated System, as it would be loaded from the database
+     * @param TrueParameters : the parameters the observed biomass was projected from
+     * @return Returns false if the model forms don't have a projection kernel
+     */
+    static bool generate(const nmfSyntheticSystemSettings& Settings,
+                         Data_Struct&                      dataStruct,
+                         nmfProjectionParameters&          TrueParameters);
+    /**
+     * @brief Gets the lower and upper bounds of the estimated parameters in the
+     * estimators' parameter order
+     * @param dataStruct : the System
+     * @param LowerBounds : the lower bound of each parameter
+     * @param UpperBounds : the upper bound of each parameter
+     */
+    static void getParameterBounds(const Data_Struct&   dataStruct,
+                                   std::vector<double>& LowerBounds,
+                                   std::vector<double>& UpperBounds);
+    /**
+     * @brief Draws a parameter vector uniformly from within the bounds. The same seed
+     * and index always draw the same vector.
+     * @param LowerBounds : the lower bound of each parameter
+     * @param UpperBounds : the upper bound of each parameter
+     * @param Seed : the random seed
+     * @param Index : index of the parameter vector
+     * @param Parameters : the drawn parameters
+     */
+    static void randomParameters(const std::vector<double>& LowerBounds,
+                                 const std::vector<double>& UpperBounds,
+                                 const uint64_t&            Seed,
+                                 const uint32_t&            Index,
+                                 std::vector<double>&       Parameters);
+};
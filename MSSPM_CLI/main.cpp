@@ -0,0 +1,155 @@
+#include "nmfCommandLineRunner.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QSettings>
+#include <QSqlDatabase>
+#include <QSqlError>
+
+#include <iostream>
+#include <memory>
+
+// Returns the command line value if given, else the config file value, else the default
+static QString
+settingValue(const QCommandLineParser& parser,
+             const QCommandLineOption& option,
+             QSettings*                config,
+             const QString&            key,
+             const QString&            defaultValue = "")
+{
+    if (parser.isSet(option)) {
+        return parser.value(option);
+    }
+    if (config != nullptr) {
+        return config->value(key,defaultValue).toString();
+    }
+    return defaultValue;
+}
+
+// Splits a comma separated list of names (e.g., model forms) into its trimmed, non-empty names
+static std::vector<std::string>
+settingList(const QString& value)
+{
+    std::vector<std::string> names;
+
+    for (const QString& name : value.split(",")) {
+        if (! name.trimmed().isEmpty()) {
+            names.push_back(name.trimmed().toStdString());
+        }
+    }
+    return names;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("msspm-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Runs an MSSPM estimation, forecast, diagnostic, retrospective analysis or model form sweep\n"
+                "without a display.\n"
+                "Sweep lists are comma separated; an empty list uses the System's setting.\n"
+                "Settings are read from the optional config file and may be overridden on the command line.\n"
+                "The database password is read from the MSSPM_DB_PASSWORD environment variable.");
+    parser.addHelpOption();
+    QCommandLineOption configOption(     "config",      "INI config file with [Database], [Run] and [Sweep] sections.","file");
+    QCommandLineOption hostOption(       "host",        "Database host (default: localhost).","host");
+    QCommandLineOption userOption(       "user",        "Database user.","user");
+    QCommandLineOption databaseOption(   "database",    "Project database name.","name");
+    QCommandLineOption systemOption(     "system",      "System (model) name.","name");
+    QCommandLineOption taskOption(       "task",        "One of: estimate, forecast, diagnostics, retrospective, sweep.","task");
+    QCommandLineOption algorithmOption(  "algorithm",   "\"NLopt Algorithm\" (default) or \"Bees Algorithm\".","name");
+    QCommandLineOption minimizerOption(  "minimizer",   "Override the System's minimizer.","name");
+    QCommandLineOption objectiveOption(  "objective",   "Override the System's objective criterion.","name");
+    QCommandLineOption scalingOption(    "scaling",     "Override the System's scaling.","name");
+    QCommandLineOption startsOption(     "starts",      "Number of starts (NLopt) or repetitions (Bees).","n");
+    QCommandLineOption threadsOption(    "threads",     "Maximum number of estimation threads (default: all cores).","n");
+    QCommandLineOption forecastOption(   "forecast",    "Forecast name (forecast task).","name");
+    QCommandLineOption peelsOption(      "peels",       "Number of retrospective peels (default: 3).","n");
+    QCommandLineOption pointsOption(     "points",      "Diagnostic points on either side of the estimate (default: 10).","n");
+    QCommandLineOption variationOption(  "variation",   "Diagnostic percent variation (default: 10).","pct");
+    QCommandLineOption growthFormsOption(     "growth-forms",      "Growth forms to sweep (sweep task).","list");
+    QCommandLineOption harvestFormsOption(    "harvest-forms",     "Harvest forms to sweep (sweep task).","list");
+    QCommandLineOption competitionFormsOption("competition-forms", "Competition forms to sweep (sweep task).","list");
+    QCommandLineOption predationFormsOption(  "predation-forms",   "Predation forms to sweep (sweep task).","list");
+    QCommandLineOption minimizersOption(      "minimizers",        "Minimizers to sweep (sweep task).","list");
+    QCommandLineOption objectivesOption(      "objectives",        "Objective criteria to sweep (sweep task).","list");
+    QCommandLineOption scalingsOption(        "scalings",          "Scalings to sweep (sweep task).","list");
+    QCommandLineOption rankByOption(          "rank-by",           "Sweep ranking statistic: AIC (default), RMSE or MEF.","stat");
+    QCommandLineOption warmStartOption(  "warm-start",  "Start the estimation from the System's last estimate (not the sweep).");
+    QCommandLineOption resumeOption(     "resume",      "Continue the estimation from its checkpoint in the output directory.");
+    QCommandLineOption forceRerunOption( "force-rerun", "Estimate even if an identical estimation has a cached result.");
+    QCommandLineOption outputOption(     "output",      "Output directory for the CSV files (default: current directory).","dir");
+    parser.addOptions({configOption,hostOption,userOption,databaseOption,systemOption,taskOption,
+                       algorithmOption,minimizerOption,objectiveOption,scalingOption,startsOption,
+                       threadsOption,forecastOption,peelsOption,pointsOption,variationOption,
+                       growthFormsOption,harvestFormsOption,competitionFormsOption,predationFormsOption,
+                       minimizersOption,objectivesOption,scalingsOption,rankByOption,warmStartOption,resumeOption,forceRerunOption,outputOption});
+    parser.process(app);
+
+    std::unique_ptr<QSettings> config;
+    if (parser.isSet(configOption)) {
+        config = std::make_unique<QSettings>(parser.value(configOption),QSettings::IniFormat);
+    }
+
+    nmfCommandLineSettings settings;
+    settings.SystemName         = settingValue(parser,systemOption,   config.get(),"Run/System").toStdString();
+    settings.Task               = settingValue(parser,taskOption,     config.get(),"Run/Task").toStdString();
+    settings.Algorithm          = settingValue(parser,algorithmOption,config.get(),"Run/Algorithm",
+                                               QString::fromStdString(settings.Algorithm)).toStdString();
+    settings.Minimizer          = settingValue(parser,minimizerOption,config.get(),"Run/Minimizer").toStdString();
+    settings.ObjectiveCriterion = settingValue(parser,objectiveOption,config.get(),"Run/ObjectiveCriterion").toStdString();
+    settings.Scaling            = settingValue(parser,scalingOption,  config.get(),"Run/Scaling").toStdString();
+    settings.ForecastName       = settingValue(parser,forecastOption, config.get(),"Run/Forecast").toStdString();
+    settings.OutputDir          = settingValue(parser,outputOption,   config.get(),"Run/Output",".").toStdString();
+    settings.NumStarts          = settingValue(parser,startsOption,   config.get(),"Run/Starts","0").toInt();
+    settings.MaxNumThreads      = settingValue(parser,threadsOption,  config.get(),"Run/Threads","0").toInt();
+    settings.NumPeels           = settingValue(parser,peelsOption,    config.get(),"Run/Peels","3").toInt();
+    settings.NumPoints          = settingValue(parser,pointsOption,   config.get(),"Run/Points","10").toInt();
+    settings.PctVariation       = settingValue(parser,variationOption,config.get(),"Run/Variation","10").toInt();
+    settings.WarmStart          = parser.isSet(warmStartOption) ||
+                                  ((config != nullptr) && config->value("Run/WarmStart",false).toBool());
+    settings.Resume             = parser.isSet(resumeOption) ||
+                                  ((config != nullptr) && config->value("Run/Resume",false).toBool());
+    settings.ForceRerun         = parser.isSet(forceRerunOption) ||
+                                  ((config != nullptr) && config->value("Run/ForceRerun",false).toBool());
+    settings.GrowthForms        = settingList(settingValue(parser,growthFormsOption,     config.get(),"Sweep/GrowthForms"));
+    settings.HarvestForms       = settingList(settingValue(parser,harvestFormsOption,    config.get(),"Sweep/HarvestForms"));
+    settings.CompetitionForms   = settingList(settingValue(parser,competitionFormsOption,config.get(),"Sweep/CompetitionForms"));
+    settings.PredationForms     = settingList(settingValue(parser,predationFormsOption,  config.get(),"Sweep/PredationForms"));
+    settings.Minimizers         = settingList(settingValue(parser,minimizersOption,      config.get(),"Sweep/Minimizers"));
+    settings.ObjectiveCriteria  = settingList(settingValue(parser,objectivesOption,      config.get(),"Sweep/ObjectiveCriteria"));
+    settings.Scalings           = settingList(settingValue(parser,scalingsOption,        config.get(),"Sweep/Scalings"));
+    settings.RankBy             = settingValue(parser,rankByOption,config.get(),"Sweep/RankBy",
+                                               QString::fromStdString(settings.RankBy)).toStdString();
+    if (settings.SystemName.empty() || settings.Task.empty()) {
+        std::cerr << "Error: a system and a task are required (see --help)" << std::endl;
+        return 1;
+    }
+
+    nmfLogger* logger = new nmfLogger();
+    logger->initLogger("MSSPM_CLI");
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QMYSQL");
+    db.setHostName(settingValue(parser,hostOption,config.get(),"Database/Host","localhost"));
+    db.setUserName(settingValue(parser,userOption,config.get(),"Database/User"));
+    db.setPassword(qEnvironmentVariable("MSSPM_DB_PASSWORD"));
+    db.setDatabaseName(settingValue(parser,databaseOption,config.get(),"Database/Name"));
+    if (! db.open()) {
+        std::cerr << "Error: couldn't connect to database: "
+                  << db.lastError().text().toStdString() << std::endl;
+        return 1;
+    }
+    nmfTracedDatabase* databasePtr = new nmfTracedDatabase();
+    databasePtr->nmfSetConnectionByName(db.connectionName());
+    databasePtr->nmfSetDatabase(db.databaseName().toStdString());
+
+    nmfCommandLineRunner runner(databasePtr,logger,settings);
+    int exitCode = runner.run();
+
+    delete databasePtr;
+    delete logger;
+
+    return exitCode;
+}
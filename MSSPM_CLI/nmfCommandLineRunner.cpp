@@ -0,0 +1,543 @@
+#include "nmfCommandLineRunner.h"
+#include "nmfDiagnosticEngine.h"
+#include "nmfForecastEngine.h"
+#include "nmfUtilsStatistics.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+nmfCommandLineRunner::nmfCommandLineRunner(nmfTracedDatabase*            databasePtr,
+                                           nmfLogger*                    logger,
+                                           const nmfCommandLineSettings& settings)
+{
+    m_DatabasePtr = databasePtr;
+    m_Logger      = logger;
+    m_Settings    = settings;
+    m_StartYear   = 0;
+    m_SpeciesOrGuildList.clear();
+    m_Timings.clear();
+}
+
+void
+nmfCommandLineRunner::logError(const std::string& msg)
+{
+    m_Logger->logMsg(nmfConstants::Error,msg);
+    std::cerr << "Error: " << msg << std::endl;
+}
+
+void
+nmfCommandLineRunner::reportTiming(const std::string& label,
+                                   const double&      seconds)
+{
+    std::cout << "Elapsed time (" << label << "): " << seconds << " s" << std::endl;
+    m_Timings << QString::fromStdString(m_Settings.SystemName) + "," +
+                 QString::fromStdString(m_Settings.Task) + "," +
+                 QString::fromStdString(label) + "," + QString::number(seconds);
+}
+
+int
+nmfCommandLineRunner::run()
+{
+    bool ok = false;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    if (! QDir().mkpath(QString::fromStdString(m_Settings.OutputDir))) {
+        logError("Couldn't create output directory: " + m_Settings.OutputDir);
+        return 1;
+    }
+
+    if (m_Settings.Task == "estimate") {
+        ok = runEstimation();
+    } else if (m_Settings.Task == "forecast") {
+        ok = runForecast();
+    } else if (m_Settings.Task == "diagnostics") {
+        ok = runDiagnostics();
+    } else if (m_Settings.Task == "retrospective") {
+        ok = runRetrospective();
+    } else if (m_Settings.Task == "sweep") {
+        ok = runSweep();
+    } else {
+        logError("Unknown task: " + m_Settings.Task +
+                 " (expecting estimate, forecast, diagnostics, retrospective or sweep)");
+        return 1;
+    }
+
+    reportTiming("total",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+    writeLines(m_Settings.SystemName + "_Timing.csv",
+               QStringList() << "SystemName,Task,Step,Seconds" << m_Timings);
+
+    return (ok) ? 0 : 1;
+}
+
+bool
+nmfCommandLineRunner::loadDataStruct(Data_Struct& dataStruct)
+{
+    int NumSpeciesOrGuilds;
+    nmfSystemLoader loader(m_DatabasePtr,m_Logger,m_Settings.SystemName);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    if (! loader.loadParameters(dataStruct,false) ||
+        ! loader.getStartYear(m_StartYear)) {
+        logError("Couldn't load System: " + m_Settings.SystemName + ". " + loader.getErrorMessage());
+        return false;
+    }
+    if (dataStruct.CompetitionForm == "AGG-PROD") {
+        loader.getGuilds(NumSpeciesOrGuilds,m_SpeciesOrGuildList);
+    } else {
+        loader.getSpecies(NumSpeciesOrGuilds,m_SpeciesOrGuildList);
+    }
+
+    // Command line (or config file) overrides of the System's estimation settings
+    if (! m_Settings.Minimizer.empty()) {
+        dataStruct.Minimizer = m_Settings.Minimizer;
+    }
+    if (! m_Settings.ObjectiveCriterion.empty()) {
+        dataStruct.ObjectiveCriterion = m_Settings.ObjectiveCriterion;
+    }
+    if (! m_Settings.Scaling.empty()) {
+        dataStruct.Scaling = m_Settings.Scaling;
+    }
+    if (m_Settings.NumStarts > 0) {
+        dataStruct.BeesNumRepetitions = m_Settings.NumStarts;
+    }
+    dataStruct.showDiagnosticChart = false;
+
+    reportTiming("load",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+
+    return true;
+}
+
+void
+nmfCommandLineRunner::loadInitialParameters(const Data_Struct&   dataStruct,
+                                            std::vector<double>& InitialParameters)
+{
+    nmfSystemLoader loader(m_DatabasePtr,m_Logger,m_Settings.SystemName);
+
+    InitialParameters.clear();
+    if (m_Settings.WarmStart &&
+        ! nmfEstimationEngine::loadInitialParameters(loader,dataStruct,m_Settings.Algorithm,InitialParameters)) {
+        std::cout << "No previous estimate found, running without a warm start" << std::endl;
+    }
+}
+
+bool
+nmfCommandLineRunner::estimate(Data_Struct&         dataStruct,
+                               const int&           RunNum,
+                               nmfEstimationResult& Result)
+{
+    nmfEstimationEngine engine(m_Settings.Algorithm);
+    nmfEstimationCache cache(m_DatabasePtr,m_Logger);
+    nmfEstimationCacheEntry cachedResult;
+    std::vector<double> InitialParameters;
+    std::string cacheHash;
+    bool isCacheHit;
+
+    QString checkpointFile = QString::fromStdString(m_Settings.SystemName + "_" +
+                                                    m_Settings.Algorithm + ".checkpoint");
+
+    // The estimation is checkpointed so that a stopped run can be continued with --resume
+    checkpointFile.replace(" ","_");
+    loadInitialParameters(dataStruct,InitialParameters);
+    engine.setMaxNumThreads(m_Settings.MaxNumThreads);
+    engine.setInitialParameters(InitialParameters);
+    engine.setCheckpoint(QDir(QString::fromStdString(m_Settings.OutputDir)).filePath(checkpointFile).toStdString(),
+                         m_Settings.Resume);
+
+    // An identical estimation's result is reused unless --force-rerun is given
+    cacheHash  = nmfEstimationCache::hash(m_Settings.Algorithm,dataStruct,InitialParameters);
+    isCacheHit = (! m_Settings.ForceRerun) && cache.find(cacheHash,cachedResult);
+    if (isCacheHit) {
+        engine.setCachedResult(cachedResult.Parameters,cachedResult.Fitness,cachedResult.FitnessStdDev);
+    }
+    std::cout << "Estimation cache: " << (isCacheHit ? "hit" : "miss") << std::endl;
+
+    if (! engine.estimate(dataStruct,RunNum,Result)) {
+        logError("Estimation failed: " + engine.getErrorMessage());
+        return false;
+    }
+
+    if (! isCacheHit) {
+        cachedResult.Fitness       = Result.Fitness;
+        cachedResult.FitnessStdDev = Result.FitnessStdDev;
+        cachedResult.Parameters    = Result.EstParameters;
+        cache.store(cacheHash,m_Settings.SystemName,m_Settings.Algorithm,cachedResult);
+    }
+
+    return true;
+}
+
+bool
+nmfCommandLineRunner::runEstimation()
+{
+    Data_Struct dataStruct;
+    nmfEstimationResult Result;
+
+    if (! loadDataStruct(dataStruct) ||
+        ! estimate(dataStruct,1,Result)) {
+        return false;
+    }
+    reportTiming("estimate",Result.ElapsedSeconds);
+    std::cout << "Best fitness: " << Result.Fitness << std::endl;
+
+    return writeParameters(m_Settings.SystemName + "_EstimatedParameters.csv",Result) &&
+           writeBiomass(m_Settings.SystemName + "_EstimatedBiomass.csv",m_StartYear,{Result.EstimatedBiomass});
+}
+
+bool
+nmfCommandLineRunner::runForecast()
+{
+    std::string isAggProdStr;
+    uint64_t Seed;
+    QStringList SpeciesList;
+    nmfForecastSettings Settings;
+    nmfProjectionInputs Inputs;
+    nmfForecastUncertainty Uncertainty;
+    std::vector<boost::numeric::ublas::matrix<double> > Biomass(1);
+    std::vector<boost::numeric::ublas::matrix<double> > MonteCarloBiomass;
+    nmfSystemLoader loader(m_DatabasePtr,m_Logger,m_Settings.SystemName);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    if (m_Settings.ForecastName.empty()) {
+        logError("A forecast name is required for the forecast task");
+        return false;
+    }
+    if (! loader.loadForecastSettings(m_Settings.ForecastName,Settings)) {
+        logError("No Forecast found named: " + m_Settings.ForecastName);
+        return false;
+    }
+    isAggProdStr = (Settings.CompetitionForm == "AGG-PROD") ? "1" : "0";
+    if (! loader.loadProjectionInputs(m_Settings.ForecastName,Settings.RunLength,
+                                      Settings.Algorithm,Settings.Minimizer,
+                                      Settings.ObjectiveCriterion,Settings.Scaling,isAggProdStr,
+                                      Settings.GrowthForm,Settings.HarvestForm,
+                                      Settings.CompetitionForm,Settings.PredationForm,
+                                      "OutputGrowthRate","OutputCarryingCapacity","OutputCatchability",
+                                      SpeciesList,Inputs) ||
+        ! loader.loadUncertaintyData(Inputs.System.NumSpeciesOrGuilds,m_Settings.ForecastName,
+                                     Settings.Algorithm,Settings.Minimizer,
+                                     Settings.ObjectiveCriterion,Settings.Scaling,Uncertainty)) {
+        logError("Couldn't load Forecast: " + m_Settings.ForecastName + ". " + loader.getErrorMessage());
+        return false;
+    }
+    m_SpeciesOrGuildList = SpeciesList;
+    reportTiming("load",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+
+    // A non-deterministic forecast (i.e., no seed) draws a new base seed once per forecast
+    Seed = (Settings.Seed >= 0) ? uint64_t(Settings.Seed) : uint64_t(std::random_device{}());
+
+    startTime = std::chrono::steady_clock::now();
+    nmfForecastEngine engine(Inputs,Uncertainty,Settings.HarvestForm,
+                             Settings.CompetitionForm,Settings.PredationForm);
+    engine.project(Biomass[0]);
+    engine.run(Settings.NumRuns,Seed,MonteCarloBiomass);
+    reportTiming("forecast",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+
+    return writeBiomass(m_Settings.SystemName + "_" + m_Settings.ForecastName + "_ForecastBiomass.csv",
+                        Settings.StartYear,Biomass) &&
+           writeBiomass(m_Settings.SystemName + "_" + m_Settings.ForecastName + "_ForecastBiomassMonteCarlo.csv",
+                        Settings.StartYear,MonteCarloBiomass);
+}
+
+bool
+nmfCommandLineRunner::runDiagnostics()
+{
+    int NumSpeciesOrGuilds;
+    int NumPoints       = m_Settings.NumPoints;
+    int PctVariation    = m_Settings.PctVariation;
+    int NumPointsPerAxis = 2*NumPoints+1;
+    Data_Struct dataStruct;
+    nmfEstimationResult Result;
+    std::vector<double> EstParameters;
+    std::vector<double> Fitness;
+    std::vector<int> Rows;
+    QStringList lines;
+
+    if (! loadDataStruct(dataStruct) ||
+        ! estimate(dataStruct,1,Result)) {
+        return false;
+    }
+    reportTiming("estimate",Result.ElapsedSeconds);
+    if (Result.CarryingCapacity.empty()) {
+        logError("The r and K parameter profiles need a growth form with a carrying capacity");
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    nmfEstimationEngine::packParameters(dataStruct,Result,EstParameters);
+    nmfDiagnosticEngine engine(dataStruct,m_Settings.Algorithm,EstParameters);
+    if (! engine.isValid()) {
+        logError("No diagnostic objective function found for algorithm: " + m_Settings.Algorithm);
+        return false;
+    }
+
+    // A row is one (species, r) pair evaluated at every K point. Each row uses its own
+    // clone of the engine and writes only to its own slots of Fitness.
+    NumSpeciesOrGuilds = engine.getNumSpeciesOrGuilds();
+    Rows.resize(NumSpeciesOrGuilds*NumPointsPerAxis);
+    std::iota(Rows.begin(),Rows.end(),0);
+    Fitness.assign(Rows.size()*NumPointsPerAxis,-1);
+    std::function<void(int&)> calculateRow = [&](int& row) {
+        std::unique_ptr<nmfDiagnosticEngine> rowEngine = engine.clone();
+        int    SpeciesNum = row / NumPointsPerAxis;
+        int    j          = row % NumPointsPerAxis;
+        double rStartVal  = Result.GrowthRate[SpeciesNum]       * (1.0-PctVariation/100.0);
+        double rInc       = (Result.GrowthRate[SpeciesNum]       - rStartVal)/NumPoints;
+        double KStartVal  = Result.CarryingCapacity[SpeciesNum] * (1.0-PctVariation/100.0);
+        double KInc       = (Result.CarryingCapacity[SpeciesNum] - KStartVal)/NumPoints;
+        for (int k=0; k<NumPointsPerAxis; ++k) {
+            Fitness[row*NumPointsPerAxis+k] =
+                    rowEngine->evaluateGrowthRateAndCarryingCapacity(
+                        SpeciesNum,rStartVal+j*rInc,KStartVal+k*KInc);
+        }
+    };
+    // The Bees objective function isn't known to be reentrant, so its rows are evaluated serially
+    if (engine.isReentrant()) {
+        QtConcurrent::blockingMap(Rows,calculateRow);
+    } else {
+        std::for_each(Rows.begin(),Rows.end(),calculateRow);
+    }
+    reportTiming("diagnostics",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+
+    lines << "SpeName,GrowthRatePctDiff,CarryingCapacityPctDiff,Fitness";
+    for (int row=0; row<int(Rows.size()); ++row) {
+        int SpeciesNum = row / NumPointsPerAxis;
+        int j          = row % NumPointsPerAxis;
+        for (int k=0; k<NumPointsPerAxis; ++k) {
+            lines << m_SpeciesOrGuildList[SpeciesNum] + "," +
+                     QString::number(PctVariation*(j-NumPoints)/double(NumPoints)) + "," +
+                     QString::number(PctVariation*(k-NumPoints)/double(NumPoints)) + "," +
+                     QString::number(Fitness[row*NumPointsPerAxis+k],'g',12);
+        }
+    }
+
+    return writeLines(m_Settings.SystemName + "_DiagnosticParameterProfiles.csv",lines);
+}
+
+bool
+nmfCommandLineRunner::runRetrospective()
+{
+    int NumPeels = m_Settings.NumPeels;
+    int NumSpeciesOrGuilds;
+    Data_Struct dataStruct;
+    nmfRetrospectivePeel Peel;
+    std::vector<nmfRetrospectivePeel> Peels;
+    std::vector<nmfEstimationResult> Results;
+    std::vector<double> InitialParameters;
+    nmfRetrospectiveEngine engine(m_Settings.Algorithm);
+    std::chrono::steady_clock::time_point startTime;
+    std::vector<boost::numeric::ublas::matrix<double> > PeelBiomass;
+    std::vector<std::vector<double> > EstBiomass;
+    std::vector<double> MohnsRho;
+    std::vector<double> SpeciesBiomass;
+    QStringList lines;
+
+    if (! loadDataStruct(dataStruct)) {
+        return false;
+    }
+    if ((NumPeels < 1) || (NumPeels >= dataStruct.RunLength)) {
+        logError("The number of peels must be from 1 to " + std::to_string(dataStruct.RunLength-1));
+        return false;
+    }
+
+    // Peel 0 is the full time series, all of the peels are estimated at once
+    for (int peel=0; peel<=NumPeels; ++peel) {
+        Peel.Label     = "peel " + std::to_string(peel);
+        Peel.FirstYear = 0;
+        Peel.RunLength = dataStruct.RunLength-peel;
+        Peels.push_back(Peel);
+    }
+    loadInitialParameters(dataStruct,InitialParameters);
+    startTime = std::chrono::steady_clock::now();
+    engine.setMaxNumThreads(m_Settings.MaxNumThreads);
+    engine.setInitialParameters(InitialParameters);
+    if (! engine.run(dataStruct,Peels,Results)) {
+        logError("Retrospective analysis failed: " + engine.getErrorMessage());
+        return false;
+    }
+    reportTiming("estimate peels",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+
+    for (int peel=0; peel<=NumPeels; ++peel) {
+        const nmfEstimationResult& Result = Results[peel];
+        reportTiming("estimate " + Peels[peel].Label,Result.ElapsedSeconds);
+        PeelBiomass.push_back(Result.EstimatedBiomass);
+
+        // Mohn's Rho expects each peel's biomass in species major order
+        const boost::numeric::ublas::matrix<double>& Biomass = Result.EstimatedBiomass;
+        SpeciesBiomass.clear();
+        for (unsigned species=0; species<Biomass.size2(); ++species) {
+            for (unsigned year=0; year<Biomass.size1(); ++year) {
+                SpeciesBiomass.push_back(Biomass(year,species));
+            }
+        }
+        EstBiomass.push_back(SpeciesBiomass);
+    }
+    NumSpeciesOrGuilds = m_SpeciesOrGuildList.size();
+    nmfUtilsStatistics::calculateMohnsRhoForTimeSeries(NumPeels,NumSpeciesOrGuilds,EstBiomass,MohnsRho);
+
+    lines << "SpeName,MohnsRho";
+    for (unsigned i=0; i<MohnsRho.size() && int(i)<NumSpeciesOrGuilds; ++i) {
+        lines << m_SpeciesOrGuildList[i] + "," + QString::number(MohnsRho[i],'g',12);
+    }
+
+    return writeBiomass(m_Settings.SystemName + "_RetrospectiveBiomass.csv",m_StartYear,PeelBiomass) &&
+           writeLines(m_Settings.SystemName + "_MohnsRho.csv",lines);
+}
+
+bool
+nmfCommandLineRunner::runSweep()
+{
+    // A single minimizer, objective criterion or scaling override applies when its list is empty
+    auto orOverride = [](const std::vector<std::string>& list, const std::string& value) {
+        return (list.empty() && ! value.empty()) ? std::vector<std::string>{value} : list;
+    };
+    bool ok;
+    std::vector<nmfModelSweepCombination> Combinations;
+    std::vector<nmfModelSweepResult> Results;
+    nmfModelSweep sweep(m_DatabasePtr,m_Logger,m_Settings.SystemName,m_Settings.Algorithm);
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    QStringList lines;
+
+    if ((m_Settings.RankBy != "AIC") && (m_Settings.RankBy != "RMSE") && (m_Settings.RankBy != "MEF")) {
+        logError("Unknown rank statistic: " + m_Settings.RankBy + " (expecting AIC, RMSE or MEF)");
+        return false;
+    }
+
+    nmfModelSweep::enumerate(m_Settings.GrowthForms,m_Settings.HarvestForms,
+                             m_Settings.CompetitionForms,m_Settings.PredationForms,
+                             orOverride(m_Settings.Minimizers,       m_Settings.Minimizer),
+                             orOverride(m_Settings.ObjectiveCriteria,m_Settings.ObjectiveCriterion),
+                             orOverride(m_Settings.Scalings,         m_Settings.Scaling),
+                             Combinations);
+    std::cout << "Sweeping " << Combinations.size() << " combination(s)" << std::endl;
+
+    sweep.setMaxNumThreads(m_Settings.MaxNumThreads);
+    ok = sweep.run(Combinations,Results);
+    reportTiming("sweep",std::chrono::duration<double>(
+                     std::chrono::steady_clock::now()-startTime).count());
+    nmfModelSweep::rank(m_Settings.RankBy,Results);
+
+    lines << "Rank,GrowthForm,HarvestForm,CompetitionForm,PredationForm,Minimizer,"
+             "ObjectiveCriterion,Scaling,NumParameters,Fitness,AIC,RMSE,MEF,Seconds,Error";
+    for (unsigned i=0; i<Results.size(); ++i) {
+        const nmfModelSweepResult& Result = Results[i];
+        const nmfModelSweepCombination& Combination = Result.Combination;
+        QStringList fields;
+        fields << ((Result.OK) ? QString::number(i+1) : QString(""))
+               << QString::fromStdString(Combination.GrowthForm)
+               << QString::fromStdString(Combination.HarvestForm)
+               << QString::fromStdString(Combination.CompetitionForm)
+               << QString::fromStdString(Combination.PredationForm)
+               << QString::fromStdString(Combination.Minimizer)
+               << QString::fromStdString(Combination.ObjectiveCriterion)
+               << QString::fromStdString(Combination.Scaling)
+               << QString::number(Result.NumParameters)
+               << QString::number(Result.Fitness,'g',12)
+               << QString::number(Result.AIC,'g',12)
+               << QString::number(Result.RMSE,'g',12)
+               << QString::number(Result.MEF,'g',12)
+               << QString::number(Result.ElapsedSeconds)
+               << QString::fromStdString(Result.ErrorMsg);
+        lines << fields.join(",");
+        if (! Result.OK) {
+            logError("Combination failed: " + Result.ErrorMsg);
+        }
+    }
+
+    return writeLines(m_Settings.SystemName + "_ModelSweep.csv",lines) && ok;
+}
+
+bool
+nmfCommandLineRunner::writeParameters(const std::string&         fileName,
+                                      const nmfEstimationResult& Result)
+{
+    QStringList lines;
+    auto addVector = [&](const QString& name, const std::vector<double>& values) {
+        for (unsigned i=0; i<values.size() && int(i)<m_SpeciesOrGuildList.size(); ++i) {
+            lines << name + "," + m_SpeciesOrGuildList[i] + ",," + QString::number(values[i],'g',12);
+        }
+    };
+    auto addMatrix = [&](const QString& name, const boost::numeric::ublas::matrix<double>& values) {
+        for (unsigned i=0; i<values.size1() && int(i)<m_SpeciesOrGuildList.size(); ++i) {
+            for (unsigned j=0; j<values.size2(); ++j) {
+                lines << name + "," + m_SpeciesOrGuildList[i] + "," + QString::number(j) + "," +
+                         QString::number(values(i,j),'g',12);
+            }
+        }
+    };
+
+    lines << "Parameter,SpeName,Column,Value";
+    lines << "Fitness,,," + QString::number(Result.Fitness,'g',12);
+    addVector("GrowthRate",      Result.GrowthRate);
+    addVector("CarryingCapacity",Result.CarryingCapacity);
+    addVector("Catchability",    Result.Catchability);
+    addVector("Exponent",        Result.Exponent);
+    addMatrix("CompetitionAlpha",      Result.CompetitionAlpha);
+    addMatrix("CompetitionBetaSpecies",Result.CompetitionBetaSpecies);
+    addMatrix("CompetitionBetaGuilds", Result.CompetitionBetaGuilds);
+    addMatrix("Predation",             Result.Predation);
+    addMatrix("Handling",              Result.Handling);
+
+    return writeLines(fileName,lines);
+}
+
+bool
+nmfCommandLineRunner::writeBiomass(const std::string& fileName,
+                                   const int&         StartYear,
+                                   const std::vector<boost::numeric::ublas::matrix<double> >& Biomass)
+{
+    QString line;
+    QStringList lines;
+
+    line = "Run,Year";
+    for (const QString& name : m_SpeciesOrGuildList) {
+        line += "," + name;
+    }
+    lines << line;
+    for (unsigned run=0; run<Biomass.size(); ++run) {
+        for (unsigned year=0; year<Biomass[run].size1(); ++year) {
+            line = QString::number(run) + "," + QString::number(StartYear+int(year));
+            for (unsigned species=0; species<Biomass[run].size2(); ++species) {
+                line += "," + QString::number(Biomass[run](year,species),'g',12);
+            }
+            lines << line;
+        }
+    }
+
+    return writeLines(fileName,lines);
+}
+
+bool
+nmfCommandLineRunner::writeLines(const std::string& fileName,
+                                 const QStringList& lines)
+{
+    QString filePath = QDir(QString::fromStdString(m_Settings.OutputDir)).filePath(
+                QString::fromStdString(fileName));
+    QFile file(filePath);
+
+    if (! file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        logError("Couldn't write file: " + filePath.toStdString());
+        return false;
+    }
+    QTextStream stream(&file);
+    for (const QString& line : lines) {
+        stream << line << "\n";
+    }
+    file.close();
+    std::cout << "Wrote: " << filePath.toStdString() << std::endl;
+
+    return true;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file nmfCommandLineRunner.h
+ * @brief Definition of the runner used by msspm-cli
+ *
+ * This file contains the definition of the command line runner. The runner loads a
+ * System from the database and runs an estimation, a forecast, a parameter profile
+ * diagnostic or a retrospective (Mohn's Rho) analysis on it without any display,
+ * writes the results as CSV files and reports how long each step took.
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfTracedDatabase.h"
+#include "nmfLogger.h"
+#include "nmfEstimationCache.h"
+#include "nmfEstimationEngine.h"
+#include "nmfModelSweep.h"
+#include "nmfRetrospectiveEngine.h"
+#include "nmfSystemLoader.h"
+
+#include <QStringList>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief The settings of one msspm-cli run (from the config file and/or the command line)
+ */
+struct nmfCommandLineSettings {
+    std::string SystemName;
+    std::string Task;                  // estimate, forecast, diagnostics, retrospective or sweep
+    std::string Algorithm = "NLopt Algorithm";
+    std::string Minimizer;             // empty to use the System's minimizer
+    std::string ObjectiveCriterion;    // empty to use the System's objective criterion
+    std::string Scaling;               // empty to use the System's scaling
+    std::string ForecastName;
+    std::string OutputDir = ".";
+    int         NumStarts     = 0;     // 0 to use the System's number of repetitions
+    int         MaxNumThreads = 0;     // 0 for the ideal thread count
+    int         NumPeels      = 3;
+    int         NumPoints     = 10;
+    int         PctVariation  = 10;
+    bool        WarmStart     = false; // start from the System's last estimate (not used by the sweep)
+    bool        Resume        = false; // continue the estimation from its checkpoint
+    bool        ForceRerun    = false; // estimate even if an identical estimation is cached
+    std::vector<std::string> GrowthForms;        // sweep lists, empty to use the System's setting
+    std::vector<std::string> HarvestForms;
+    std::vector<std::string> CompetitionForms;
+    std::vector<std::string> PredationForms;
+    std::vector<std::string> Minimizers;
+    std::vector<std::string> ObjectiveCriteria;
+    std::vector<std::string> Scalings;
+    std::string RankBy = "AIC";        // AIC, RMSE or MEF
+};
+
+/**
+ * @brief Runs one msspm-cli task
+ */
+class nmfCommandLineRunner
+{
+private:
+    nmfTracedDatabase*     m_DatabasePtr;
+    nmfLogger*             m_Logger;
+    nmfCommandLineSettings m_Settings;
+    int                    m_StartYear;
+    QStringList            m_SpeciesOrGuildList;
+    QStringList            m_Timings;
+
+    bool estimate(Data_Struct&         dataStruct,
+                  const int&           RunNum,
+                  nmfEstimationResult& Result);
+    bool loadDataStruct(Data_Struct& dataStruct);
+    void loadInitialParameters(const Data_Struct&   dataStruct,
+                               std::vector<double>& InitialParameters);
+    void logError(const std::string& msg);
+    void reportTiming(const std::string& label,
+                      const double&      seconds);
+    bool runDiagnostics();
+    bool runEstimation();
+    bool runForecast();
+    bool runRetrospective();
+    bool runSweep();
+    bool writeBiomass(const std::string& fileName,
+                      const int&         StartYear,
+                      const std::vector<boost::numeric::ublas::matrix<double> >& Biomass);
+    bool writeLines(const std::string& fileName,
+                    const QStringList& lines);
+    bool writeParameters(const std::string&         fileName,
+                         const nmfEstimationResult& Result);
+
+public:
+    /**
+     * @brief nmfCommandLineRunner : class constructor
+     * @param databasePtr : pointer to the (connected) database
+     * @param logger : pointer to the application logger
+     * @param settings : the settings of the run
+     */
+    nmfCommandLineRunner(nmfTracedDatabase*            databasePtr,
+                         nmfLogger*                    logger,
+                         const nmfCommandLineSettings& settings);
+   ~nmfCommandLineRunner() {}
+
+    /**
+     * @brief Runs the task named in the settings
+     * @return Returns the process exit code (0 on success)
+     */
+    int run();
+};
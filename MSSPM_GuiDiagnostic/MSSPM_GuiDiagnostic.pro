@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += core gui charts sql datavisualization uitools
+QT       += core gui charts sql datavisualization uitools concurrent
 
 TARGET = MSSPM_GuiDiagnostic
 TEMPLATE = lib
@@ -26,12 +26,23 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Build the Chrome trace timers of nmfTrace.h with: qmake CONFIG+=trace
+CONFIG(trace): DEFINES += MSSPM_TRACE
+
+# Build the projection kernel's matrix-vector products with Eigen with: qmake CONFIG+=eigen
+CONFIG(eigen) {
+    DEFINES += MSSPM_EIGEN
+    INCLUDEPATH += /usr/include/eigen3
+}
+
 SOURCES += \
+    nmfDiagnosticEngine.cpp \
     nmfDiagnosticTab01.cpp \
     nmfDiagnosticTab02.cpp
 
 HEADERS +=\
     mainpage.h \
+    nmfDiagnosticEngine.h \
     nmfDiagnosticTab01.h \
     nmfDiagnosticTab02.h
 
@@ -75,3 +86,6 @@ else:unix: LIBS += -L$$PWD/../../build-nmfModels-Qt_5_12_3_gcc64-Release/ -lnmfM
 
 INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfModels
 DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfModels
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
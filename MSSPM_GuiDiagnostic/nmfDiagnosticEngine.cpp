@@ -0,0 +1,104 @@
+#include "nmfDiagnosticEngine.h"
+#include "nmfConstantsMSSPM.h"
+
+nmfDiagnosticEngine::nmfDiagnosticEngine(const Data_Struct&         dataStruct,
+                                         const std::string&         algorithm,
+                                         const std::vector<double>& estParameters)
+{
+    bool isAggProd = (dataStruct.CompetitionForm == "AGG-PROD");
+
+    m_DataStruct         = dataStruct;
+    m_Algorithm          = algorithm;
+    m_EstParameters      = estParameters;
+    m_Parameters         = estParameters;
+    m_NumSpeciesOrGuilds = (isAggProd) ? dataStruct.NumGuilds : dataStruct.NumSpecies;
+
+    // Build the objective function's state once for all of the diagnostic points
+    if (m_Algorithm == "Bees Algorithm") {
+        m_BeesAlgorithm = std::make_unique<BeesAlgorithm>(m_DataStruct,nmfConstantsMSSPM::VerboseOff);
+    } else if (m_Algorithm == "NLopt Algorithm") {
+        NLopt_Estimator::initializeWorkspace(m_DataStruct,m_NLoptWorkspace);
+        m_NLoptWorkspace.ReportProgress = false; // diagnostics don't update the estimation progress chart
+    }
+}
+
+std::unique_ptr<nmfDiagnosticEngine>
+nmfDiagnosticEngine::clone()
+{
+    return std::make_unique<nmfDiagnosticEngine>(m_DataStruct,m_Algorithm,m_EstParameters);
+}
+
+bool
+nmfDiagnosticEngine::isValid()
+{
+    return (m_BeesAlgorithm != nullptr) || (m_NLoptWorkspace.Project != nullptr);
+}
+
+bool
+nmfDiagnosticEngine::isReentrant()
+{
+    return (m_Algorithm == "NLopt Algorithm");
+}
+
+int
+nmfDiagnosticEngine::getNumSpeciesOrGuilds()
+{
+    return m_NumSpeciesOrGuilds;
+}
+
+double
+nmfDiagnosticEngine::evaluateParameters()
+{
+    if (m_BeesAlgorithm) {
+        return m_BeesAlgorithm->evaluateObjectiveFunction(m_Parameters);
+    } else if (m_NLoptWorkspace.Project != nullptr) {
+        // No gradient is requested, so only the fitness is calculated
+        return NLopt_Estimator::objectiveFunction(m_Parameters.size(),&m_Parameters[0],nullptr,&m_NLoptWorkspace);
+    }
+
+    return -1;
+}
+
+double
+nmfDiagnosticEngine::evaluateGrowthRate(const int&    SpeciesOrGuildNum,
+                                        const double& GrowthRate)
+{
+    double fitness;
+
+    m_Parameters[SpeciesOrGuildNum] = GrowthRate;
+    fitness = evaluateParameters();
+    m_Parameters[SpeciesOrGuildNum] = m_EstParameters[SpeciesOrGuildNum];
+
+    return fitness;
+}
+
+double
+nmfDiagnosticEngine::evaluateCarryingCapacity(const int&    SpeciesOrGuildNum,
+                                              const double& CarryingCapacity)
+{
+    double fitness;
+    int index = m_NumSpeciesOrGuilds + SpeciesOrGuildNum; // skip over the Growth Rate parameters
+
+    m_Parameters[index] = CarryingCapacity;
+    fitness = evaluateParameters();
+    m_Parameters[index] = m_EstParameters[index];
+
+    return fitness;
+}
+
+double
+nmfDiagnosticEngine::evaluateGrowthRateAndCarryingCapacity(const int&    SpeciesOrGuildNum,
+                                                           const double& GrowthRate,
+                                                           const double& CarryingCapacity)
+{
+    double fitness;
+    int index = m_NumSpeciesOrGuilds + SpeciesOrGuildNum; // skip over the Growth Rate parameters
+
+    m_Parameters[SpeciesOrGuildNum] = GrowthRate;
+    m_Parameters[index]             = CarryingCapacity;
+    fitness = evaluateParameters();
+    m_Parameters[SpeciesOrGuildNum] = m_EstParameters[SpeciesOrGuildNum];
+    m_Parameters[index]             = m_EstParameters[index];
+
+    return fitness;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file nmfDiagnosticEngine.h
+ * @brief Definition for the nmfDiagnosticEngine class
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ *
+ */
+#ifndef NMFDIAGNOSTICENGINE_H
+#define NMFDIAGNOSTICENGINE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <BeesAlgorithm.h>
+#include "NLopt_Estimator.h"
+
+/**
+ * @brief Evaluates the objective function for Parameter Profile diagnostics
+ *
+ * The data structure and the estimated parameter vector are loaded once, when the
+ * engine is constructed. Every diagnostic point is then evaluated against this cached
+ * state by changing only the parameter(s) being profiled, so no database reads or
+ * estimator construction happen per point.
+ *
+ * An engine isn't thread-safe since it reuses its parameter vector and scratch space.
+ * Use clone() to give each worker thread its own engine. Only NLopt engines may
+ * evaluate on several threads at once (see isReentrant()).
+ */
+class nmfDiagnosticEngine
+{
+private:
+    Data_Struct                    m_DataStruct;
+    std::string                    m_Algorithm;
+    int                            m_NumSpeciesOrGuilds;
+    std::vector<double>            m_EstParameters;
+    std::vector<double>            m_Parameters;
+    std::unique_ptr<BeesAlgorithm> m_BeesAlgorithm;
+    NLoptWorkspace                 m_NLoptWorkspace;
+
+    double evaluateParameters();
+
+public:
+    /**
+     * @brief nmfDiagnosticEngine : class constructor
+     * @param dataStruct : the data structure describing the current model
+     * @param algorithm : name of the estimation algorithm whose objective function is used
+     * @param estParameters : the estimated parameters in the estimator's parameter order
+     */
+    nmfDiagnosticEngine(const Data_Struct&         dataStruct,
+                        const std::string&         algorithm,
+                        const std::vector<double>& estParameters);
+   ~nmfDiagnosticEngine() {}
+
+    /**
+     * @brief Creates an independent copy of this engine from its cached state (no database access)
+     * @return Returns the new engine
+     */
+    std::unique_ptr<nmfDiagnosticEngine> clone();
+    /**
+     * @brief Checks that the engine has an objective function for its algorithm
+     * @return Returns true if the engine can evaluate points
+     */
+    bool isValid();
+    /**
+     * @brief Checks whether clones of the engine may evaluate points at the same time.
+     * NLopt engines share no state since each owns its workspace. The Bees objective
+     * function is in the BeesAlgorithm library, which isn't known to be reentrant, so
+     * Bees engines must evaluate one at a time.
+     * @return Returns true if the engine's clones may be used on several threads at once
+     */
+    bool isReentrant();
+    /**
+     * @brief Gets the number of species (or guilds if running AGG-PROD)
+     * @return Returns the number of species or guilds
+     */
+    int getNumSpeciesOrGuilds();
+    /**
+     * @brief Evaluates the fitness with one species' growth rate changed
+     * @param SpeciesOrGuildNum : index of the species (or guild)
+     * @param GrowthRate : growth rate to use
+     * @return Returns the fitness value (or -1 on error)
+     */
+    double evaluateGrowthRate(const int&    SpeciesOrGuildNum,
+                              const double& GrowthRate);
+    /**
+     * @brief Evaluates the fitness with one species' carrying capacity changed
+     * @param SpeciesOrGuildNum : index of the species (or guild)
+     * @param CarryingCapacity : carrying capacity to use
+     * @return Returns the fitness value (or -1 on error)
+     */
+    double evaluateCarryingCapacity(const int&    SpeciesOrGuildNum,
+                                    const double& CarryingCapacity);
+    /**
+     * @brief Evaluates the fitness with one species' growth rate and carrying capacity changed
+     * @param SpeciesOrGuildNum : index of the species (or guild)
+     * @param GrowthRate : growth rate to use
+     * @param CarryingCapacity : carrying capacity to use
+     * @return Returns the fitness value (or -1 on error)
+     */
+    double evaluateGrowthRateAndCarryingCapacity(const int&    SpeciesOrGuildNum,
+                                                 const double& GrowthRate,
+                                                 const double& CarryingCapacity);
+};
+
+#endif
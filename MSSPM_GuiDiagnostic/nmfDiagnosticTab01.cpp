@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfDiagnostic_Tab1::nmfDiagnostic_Tab1(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     QUiLoader loader;
 
@@ -264,20 +264,12 @@ nmfDiagnostic_Tab1::callback_RunPB()
     double startVal;
     double inc;
     double parameter;
-    double rParameter;
-    double KParameter;
     double diagnosticParameter;
-    double rDiagnosticParam;
-    double KDiagnosticParam;
     double fitness;
-    double rStartVal;
     double rPctVar;
     double rPctInc;
-    double rInc;
-    double KStartVal;
     double KPctVar;
     double KPctInc;
-    double KInc;
     std::string Algorithm;
     std::string Minimizer;
     std::string ObjectiveCriterion;
@@ -327,6 +319,13 @@ nmfDiagnostic_Tab1::callback_RunPB()
 
     m_Diagnostic_Tabs->setCursor(Qt::WaitCursor);
 
+    std::unique_ptr<nmfDiagnosticEngine> engine =
+            createDiagnosticEngine(Algorithm,Minimizer,ObjectiveCriterion,Scaling);
+    if (engine == nullptr) {
+        m_Diagnostic_Tabs->setCursor(Qt::ArrowCursor);
+        return;
+    }
+
     // Hardcode parameter names for diagnostics. Save to the 1-parameter tables to be
     // used in the 2d plots.
     QStringList ParameterNames = {"Growth Rate (r)","Carrying Capacity (K)"};
@@ -352,10 +351,15 @@ nmfDiagnostic_Tab1::callback_RunPB()
             diagnosticParameter = startVal;
             for (int j=0; j<=totalNumPoints; ++j) {
                 try {
-                    fitness = calculateFitness(i,parameterName,diagnosticParameter);
+                    if (parameterName == "Growth Rate (r)") {
+                        fitness = engine->evaluateGrowthRate(i,diagnosticParameter);
+                    } else {
+                        fitness = engine->evaluateCarryingCapacity(i,diagnosticParameter);
+                    }
                 } catch (...) {
                     msg = "Please run Estimation prior to running this Diagnostics.";
                     m_Logger->logMsg(nmfConstants::Warning,msg.toStdString());
+                    m_Diagnostic_Tabs->setCursor(Qt::ArrowCursor);
                     return;
                 }
 
@@ -381,23 +385,23 @@ nmfDiagnostic_Tab1::callback_RunPB()
     // Now save to the 2-parameter table
     // Calculate all parameter increment values and save to table to be
     // used in the 3d plots.
+    std::vector<double> SurfaceFitness;
+    if (! calculateFitnessSurface(*engine,NumSpeciesOrGuilds,numPoints,pctVariation,
+                                  rEstParameter,KEstParameter,SurfaceFitness)) {
+        m_Logger->logMsg(nmfConstants::Normal,"Diagnostic cancelled");
+        m_Diagnostic_Tabs->setCursor(Qt::ArrowCursor);
+        return;
+    }
     DiagnosticTupleVector.clear();
+    int m = 0;
     for (int SpeciesNum=0; SpeciesNum<NumSpeciesOrGuilds; ++SpeciesNum) {
-        rParameter       =  rEstParameter[SpeciesNum];
-        rStartVal        =  rParameter * (1.0-pctVariation/100.0);
-        rInc             = (rParameter - rStartVal)/numPoints;
-        rPctVar          = -pctVariation;
-        rPctInc          = -rPctVar/numPoints;
-        rDiagnosticParam =  rStartVal;
+        rPctVar = -pctVariation;
+        rPctInc = -rPctVar/numPoints;
         for (int j=0; j<=totalNumPoints; ++j) {
-            KParameter       =  KEstParameter[SpeciesNum];
-            KStartVal        =  KParameter * (1.0-pctVariation/100.0);
-            KInc             = (KParameter - KStartVal)/numPoints;
-            KPctVar          = -pctVariation;
-            KPctInc          = -KPctVar/numPoints;
-            KDiagnosticParam =  KStartVal;
+            KPctVar = -pctVariation;
+            KPctInc = -KPctVar/numPoints;
             for (int k=0; k<=totalNumPoints; ++k) {
-                fitness = calculateFitness(SpeciesNum,rDiagnosticParam,KDiagnosticParam);
+                fitness = SurfaceFitness[m++];
                 if (fitness == -1) {
                     m_Diagnostic_Tabs->setCursor(Qt::ArrowCursor);
                     return;
@@ -407,11 +411,9 @@ nmfDiagnostic_Tab1::callback_RunPB()
                                                    KPctVar,
                                                    fitness);
                 DiagnosticTupleVector.push_back(aDiagnosticTuple);
-                KDiagnosticParam += KInc;
-                KPctVar          += KPctInc;
+                KPctVar += KPctInc;
             }
-            rDiagnosticParam += rInc;
-            rPctVar          += rPctInc;
+            rPctVar += rPctInc;
         }
     }
     updateParameterTable(Algorithm,Minimizer,ObjectiveCriterion,Scaling,
@@ -427,100 +429,106 @@ nmfDiagnostic_Tab1::callback_RunPB()
 
 }
 
-double
-nmfDiagnostic_Tab1::calculateFitness(int     SpeciesOrGuildNum,
-                                     QString ParameterName,
-                                     double  ParameterValue)
+bool
+nmfDiagnostic_Tab1::calculateFitnessSurface(nmfDiagnosticEngine&       engine,
+                                            const int&                 NumSpeciesOrGuilds,
+                                            const int&                 NumPoints,
+                                            const int&                 PctVariation,
+                                            const std::vector<double>& rEstParameter,
+                                            const std::vector<double>& KEstParameter,
+                                            std::vector<double>&       Fitness)
 {
-    bool isAggProd;
-    int NumSpecies;
-    int NumGuilds;
-    int NumSpeciesOrGuilds;
-    unsigned unused1 = 0;
-    double unused2[] = {0};
-    double retv = 0;
-    std::string Algorithm;
-    std::string Minimizer;
-    std::string ObjectiveCriterion;
-    std::string Scaling;
-    std::string CompetitionForm;
-    std::string msg;
-    std::vector<double> parameters;
-
-    m_DatabasePtr->getAlgorithmIdentifiers(
-                m_Diagnostic_Tabs,m_Logger,m_ProjectSettingsConfig,
-                Algorithm,Minimizer,ObjectiveCriterion,
-                Scaling,CompetitionForm,nmfConstantsMSSPM::DontShowPopupError);
-
-    emit LoadDataStruct();
-
-    NumSpecies = m_DataStruct.NumSpecies;
-    NumGuilds  = m_DataStruct.NumGuilds;
-    isAggProd  = (m_DataStruct.CompetitionForm == "AGG-PROD");
-    NumSpeciesOrGuilds = (isAggProd) ? NumGuilds : NumSpecies;
-
-    // Load up parameters
-    loadGrowthParameters(     NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,std::to_string(isAggProd),parameters);
-    loadHarvestParameters(    NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,parameters);
-    loadCompetitionParameters(isAggProd,NumSpecies,NumGuilds,NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,parameters);
-    loadPredationParameters(  NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,parameters);
-
-    if (ParameterName.contains("Growth Rate")) {
-        parameters[SpeciesOrGuildNum] = ParameterValue;
-    } else if (ParameterName.contains("Carrying Capacity")) {
-        parameters[NumSpeciesOrGuilds+ SpeciesOrGuildNum] = ParameterValue; // NumSpeciesOrGuilds+ offset since need to skip over Growth Rate parameters
-    } else {
-        msg = "Error: Invalid parameter name: " + ParameterName.toStdString();
-        m_Logger->logMsg(nmfConstants::Error,msg);
-        return -1;
+    int numPointsPerAxis = 2*NumPoints+1;
+    int numRows          = NumSpeciesOrGuilds*numPointsPerAxis;
+    int numThreads       = std::max(1,QThreadPool::globalInstance()->maxThreadCount());
+    int numEngines       = (engine.isReentrant()) ? std::min(numThreads,numRows) : 1;
+    QMutex engineMutex;
+    QSemaphore numFreeEngines(numEngines);
+    std::vector<std::unique_ptr<nmfDiagnosticEngine> > engines;
+    std::vector<nmfDiagnosticEngine*> freeEngines;
+    std::vector<int> rows(numRows);
+    nmfCancellationToken cancelToken;
+
+    // Each row evaluates on an engine of its own. They're cloned up front since
+    // cloning isn't free and this keeps the pool threads busy evaluating. A Bees
+    // surface has a single engine, so its rows are evaluated one at a time.
+    for (int i=0; i<numEngines; ++i) {
+        engines.push_back(engine.clone());
+        freeEngines.push_back(engines.back().get());
     }
-
-    if (Algorithm == "Bees Algorithm") {
-
-        std::unique_ptr<BeesAlgorithm> beesAlg = std::make_unique<BeesAlgorithm>(m_DataStruct,nmfConstantsMSSPM::VerboseOff);
-        retv = beesAlg->evaluateObjectiveFunction(parameters);
-
-    } else if (Algorithm == "NLopt Algorithm") {
-
-        std::unique_ptr<NLopt_Estimator> nlopt_Estimator = std::make_unique<NLopt_Estimator>();
-        retv = nlopt_Estimator->objectiveFunction(unused1,&parameters[0],unused2,&m_DataStruct);
-        if (retv == -1) {
-            m_Logger->logMsg(nmfConstants::Warning,"Please run Estimation prior to running this Diagnostic");
+    std::iota(rows.begin(),rows.end(),0);
+    Fitness.assign(numRows*numPointsPerAxis,-1);
+
+    // A row is one (species, r) pair evaluated at every K point. Each row
+    // writes to its own slots of Fitness so no locking is needed there.
+    std::function<void(int&)> calculateRow = [&](int& row) {
+        nmfDiagnosticEngine* rowEngine;
+        numFreeEngines.acquire();
+        {
+            QMutexLocker locker(&engineMutex);
+            rowEngine = freeEngines.back();
+            freeEngines.pop_back();
         }
-
-    } else {
-
-        retv = -1;
-
-    }
-    return retv;
+        int    SpeciesNum = row / numPointsPerAxis;
+        int    j          = row % numPointsPerAxis;
+        double rStartVal  = rEstParameter[SpeciesNum] * (1.0-PctVariation/100.0);
+        double rInc       = (rEstParameter[SpeciesNum] - rStartVal)/NumPoints;
+        double KStartVal  = KEstParameter[SpeciesNum] * (1.0-PctVariation/100.0);
+        double KInc       = (KEstParameter[SpeciesNum] - KStartVal)/NumPoints;
+        for (int k=0; k<numPointsPerAxis; ++k) {
+            // Rows already running stop at their next point once the user cancels
+            if (cancelToken.isCancelled()) {
+                break;
+            }
+            try {
+                Fitness[row*numPointsPerAxis+k] =
+                        rowEngine->evaluateGrowthRateAndCarryingCapacity(
+                            SpeciesNum,rStartVal+j*rInc,KStartVal+k*KInc);
+            } catch (...) {
+                Fitness[row*numPointsPerAxis+k] = -1;
+            }
+        }
+        {
+            QMutexLocker locker(&engineMutex);
+            freeEngines.push_back(rowEngine);
+        }
+        numFreeEngines.release();
+    };
+
+    QProgressDialog progressDlg("Calculating r and K parameter profiles...",
+                                "Cancel",0,numRows,m_Diagnostic_Tabs);
+    progressDlg.setWindowModality(Qt::WindowModal);
+    progressDlg.setMinimumDuration(500);
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
+    connect(&watcher,     SIGNAL(progressValueChanged(int)),
+            &progressDlg, SLOT(setValue(int)));
+    connect(&progressDlg, &QProgressDialog::canceled, [&]() {
+        cancelToken.cancel();
+        watcher.cancel();
+    });
+    connect(&watcher,     SIGNAL(finished()),
+            &loop,        SLOT(quit()));
+    watcher.setFuture(QtConcurrent::map(rows,calculateRow));
+    loop.exec();
+    watcher.waitForFinished();
+
+    return (! cancelToken.isCancelled());
 }
 
-
-double
-nmfDiagnostic_Tab1::calculateFitness(int     SpeciesOrGuildNum,
-                                     double  rParameter,
-                                     double  KParameter)
+std::unique_ptr<nmfDiagnosticEngine>
+nmfDiagnostic_Tab1::createDiagnosticEngine(const std::string& Algorithm,
+                                           const std::string& Minimizer,
+                                           const std::string& ObjectiveCriterion,
+                                           const std::string& Scaling)
 {
     bool isAggProd;
     int NumSpecies;
     int NumGuilds;
     int NumSpeciesOrGuilds;
-    unsigned unused1 = 0;
-    double unused2[] = {0};
-    double retv = -1;
-    std::string Algorithm;
-    std::string Minimizer;
-    std::string ObjectiveCriterion;
-    std::string Scaling;
-    std::string CompetitionForm;
     std::vector<double> parameters;
 
-    m_DatabasePtr->getAlgorithmIdentifiers(
-                m_Diagnostic_Tabs,m_Logger,m_ProjectSettingsConfig,
-                Algorithm,Minimizer,ObjectiveCriterion,
-                Scaling,CompetitionForm,nmfConstantsMSSPM::DontShowPopupError);
-
+    // Load the data struct and the estimated parameters only once per diagnostic run
     emit LoadDataStruct();
 
     NumSpecies = m_DataStruct.NumSpecies;
@@ -534,24 +542,20 @@ nmfDiagnostic_Tab1::calculateFitness(int     SpeciesOrGuildNum,
     loadCompetitionParameters(isAggProd,NumSpecies,NumGuilds,NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,parameters);
     loadPredationParameters(  NumSpeciesOrGuilds,Algorithm,Minimizer,ObjectiveCriterion,Scaling,parameters);
 
-    // Modify both r and K parameters
-    parameters[SpeciesOrGuildNum]                     = rParameter;
-    parameters[NumSpeciesOrGuilds+ SpeciesOrGuildNum] = KParameter; // NumSpeciesOrGuilds+ offset since need to skip over Growth Rate parameters
-
-    if (Algorithm == "Bees Algorithm") {
-
-        std::unique_ptr<BeesAlgorithm> beesAlg = std::make_unique<BeesAlgorithm>(m_DataStruct,nmfConstantsMSSPM::VerboseOff);
-        retv = beesAlg->evaluateObjectiveFunction(parameters);
-
-    } else if (Algorithm == "NLopt Algorithm") {
-
-        std::unique_ptr<NLopt_Estimator> nlopt_Estimator = std::make_unique<NLopt_Estimator>();
-        retv = nlopt_Estimator->objectiveFunction(unused1,&parameters[0],unused2,&m_DataStruct);
+    // Need at least the growth rate and carrying capacity parameters for the profiles
+    if (int(parameters.size()) < 2*NumSpeciesOrGuilds) {
+        m_Logger->logMsg(nmfConstants::Warning,"Please run Estimation prior to running this Diagnostic");
+        return nullptr;
+    }
 
-    } else {
-        retv = -1;
+    std::unique_ptr<nmfDiagnosticEngine> engine =
+            std::make_unique<nmfDiagnosticEngine>(m_DataStruct,Algorithm,parameters);
+    if (! engine->isValid()) {
+        m_Logger->logMsg(nmfConstants::Error,"Error: No diagnostic objective function found for algorithm: " + Algorithm);
+        return nullptr;
     }
-    return retv;
+
+    return engine;
 }
 
 
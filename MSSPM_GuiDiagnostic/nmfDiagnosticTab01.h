@@ -29,9 +29,19 @@
 #ifndef NMFDIAGNOSTICTAB1_H
 #define NMFDIAGNOSTICTAB1_H
 
+#include <functional>
+#include <numeric>
 #include <tuple>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QMutex>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <BeesAlgorithm.h>
 #include "NLopt_Estimator.h"
+#include "nmfDiagnosticEngine.h"
+#include "nmfCancellationToken.h"
 
 /**
  * @brief Diagnostic Tuple for Percent Variations
@@ -53,27 +63,56 @@ class nmfDiagnostic_Tab1: public QObject
     Q_OBJECT
 
 private:
-    nmfDatabase* m_DatabasePtr;
-    Data_Struct  m_DataStruct;
-    QTabWidget*  m_Diagnostic_Tabs;
-    QWidget*     m_Diagnostic_Tab1_Widget;
-    QComboBox*   m_Diagnostic_Tab1_ParameterCMB;
-    QLabel*      m_Diagnostic_Tab1_ParameterLBL;
-    QSpinBox*    m_Diagnostic_Tab1_PctVarSB;
-    QSpinBox*    m_Diagnostic_Tab1_NumPtsSB;
-    QPushButton* m_Diagnostic_Tab1_RunPB;
-    nmfLogger*   m_Logger;
-    int          m_NumPoints;
-    int          m_PctVariation;
-    std::string  m_ProjectDir;
-    std::string  m_ProjectSettingsConfig;
+    nmfTracedDatabase* m_DatabasePtr;
+    Data_Struct        m_DataStruct;
+    QTabWidget*        m_Diagnostic_Tabs;
+    QWidget*           m_Diagnostic_Tab1_Widget;
+    QComboBox*         m_Diagnostic_Tab1_ParameterCMB;
+    QLabel*            m_Diagnostic_Tab1_ParameterLBL;
+    QSpinBox*          m_Diagnostic_Tab1_PctVarSB;
+    QSpinBox*          m_Diagnostic_Tab1_NumPtsSB;
+    QPushButton*       m_Diagnostic_Tab1_RunPB;
+    nmfLogger*         m_Logger;
+    int                m_NumPoints;
+    int                m_PctVariation;
+    std::string        m_ProjectDir;
+    std::string        m_ProjectSettingsConfig;
 
-    double calculateFitness(int     SpeciesOrGuildNum,
-                            QString ParameterName,
-                            double  ParameterValue);
-    double calculateFitness(int     SpeciesOrGuildNum,
-                            double  rParameter,
-                            double  KParameter);
+    /**
+     * @brief Evaluates the r x K fitness surface for every species (or guild) on the
+     * global thread pool, with each worker thread using its own clone of the engine.
+     * A modal progress dialog is shown that lets the user cancel the calculation.
+     * @param engine : the diagnostic engine to clone for each worker thread
+     * @param NumSpeciesOrGuilds : number of species (or guilds if running AGG-PROD)
+     * @param NumPoints : number of diagnostic points on either side of the estimated value
+     * @param PctVariation : percent variation from the estimated value
+     * @param rEstParameter : estimated growth rate per species or guild
+     * @param KEstParameter : estimated carrying capacity per species or guild
+     * @param Fitness : the fitness values ordered by species, then r point, then K point
+     * @return Returns false if the user cancelled the calculation
+     */
+    bool calculateFitnessSurface(
+            nmfDiagnosticEngine&       engine,
+            const int&                 NumSpeciesOrGuilds,
+            const int&                 NumPoints,
+            const int&                 PctVariation,
+            const std::vector<double>& rEstParameter,
+            const std::vector<double>& KEstParameter,
+            std::vector<double>&       Fitness);
+    /**
+     * @brief Loads the data structure and the estimated parameters once and builds
+     * the engine used to evaluate all of the diagnostic points
+     * @param Algorithm : name of estimation algorithm
+     * @param Minimizer : name of estimation algorithm minimizer function
+     * @param ObjectiveCriterion : name of estimation algorithm objective criterion
+     * @param Scaling : name of estimation algorithm scaling function
+     * @return Returns the diagnostic engine (or nullptr if the parameters couldn't be loaded)
+     */
+    std::unique_ptr<nmfDiagnosticEngine> createDiagnosticEngine(
+            const std::string& Algorithm,
+            const std::string& Minimizer,
+            const std::string& ObjectiveCriterion,
+            const std::string& Scaling);
     bool isAggProd(std::string Algorithm,
                    std::string Minimizer,
                    std::string ObjectiveCriterion,
@@ -158,9 +197,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfDiagnostic_Tab1(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfDiagnostic_Tab1();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfDiagnostic_Tab2::nmfDiagnostic_Tab2(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     QUiLoader loader;
 
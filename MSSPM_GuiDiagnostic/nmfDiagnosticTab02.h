@@ -45,21 +45,21 @@ class nmfDiagnostic_Tab2: public QObject
 
 private:
 
-    Data_Struct  m_BeeStruct;
-    nmfDatabase* m_DatabasePtr;
-    QLabel*      m_Diagnostic_Tab2_MaxYearLBL;
-    QLineEdit*   m_Diagnostic_Tab2_MaxYearLE;
-    QLabel*      m_Diagnostic_Tab2_MinYearLBL;
-    QLineEdit*   m_Diagnostic_Tab2_MinYearLE;
-    QSpinBox*    m_Diagnostic_Tab2_NumPeelsSB;
-    QComboBox*   m_Diagnostic_Tab2_PeelPositionCMB;
-    QPushButton* m_Diagnostic_Tab2_RunPB;
-    QWidget*     m_Diagnostic_Tab2_Widget;
-    QTabWidget*  m_Diagnostic_Tabs;
-    nmfLogger*   m_Logger;
-    std::string  m_ProjectDir;
-    std::string  m_ProjectSettingsConfig;
-    int          m_RunLength;
+    Data_Struct        m_BeeStruct;
+    nmfTracedDatabase* m_DatabasePtr;
+    QLabel*            m_Diagnostic_Tab2_MaxYearLBL;
+    QLineEdit*         m_Diagnostic_Tab2_MaxYearLE;
+    QLabel*            m_Diagnostic_Tab2_MinYearLBL;
+    QLineEdit*         m_Diagnostic_Tab2_MinYearLE;
+    QSpinBox*          m_Diagnostic_Tab2_NumPeelsSB;
+    QComboBox*         m_Diagnostic_Tab2_PeelPositionCMB;
+    QPushButton*       m_Diagnostic_Tab2_RunPB;
+    QWidget*           m_Diagnostic_Tab2_Widget;
+    QTabWidget*        m_Diagnostic_Tabs;
+    nmfLogger*         m_Logger;
+    std::string        m_ProjectDir;
+    std::string        m_ProjectSettingsConfig;
+    int                m_RunLength;
 
     void clearWidgets();
     int  getEndYearLE();
@@ -78,9 +78,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfDiagnostic_Tab2(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfDiagnostic_Tab2();
 
     /**
@@ -26,6 +26,9 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Build the Chrome trace timers of nmfTrace.h with: qmake CONFIG+=trace
+CONFIG(trace): DEFINES += MSSPM_TRACE
+
 SOURCES += \
     nmfEstimationTab01.cpp \
     nmfEstimationTab02.cpp \
@@ -62,3 +65,6 @@ else:unix: LIBS += -L$$PWD/../../build-nmfUtilities-Qt_5_12_3_gcc64-Release/ -ln
 
 INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
 DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
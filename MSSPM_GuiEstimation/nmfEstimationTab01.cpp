@@ -7,9 +7,9 @@
 
 
 nmfEstimation_Tab1::nmfEstimation_Tab1(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     QUiLoader loader;
 
@@ -54,6 +54,11 @@ nmfEstimation_Tab1::nmfEstimation_Tab1(QTabWidget*  tabs,
     Estimation_Tab1_GuildRangeCB        = Estimation_Tabs->findChild<QCheckBox   *>("Estimation_Tab1_GuildRangeCB");
     Estimation_Tab1_ModifySL->setValue(m_StartPosSL); // Set midpoint position to start
 
+    // Throttles the slider preview to about 30 redraws per second
+    m_PreviewTimer = new QTimer(this);
+    m_PreviewTimer->setSingleShot(true);
+    m_PreviewTimer->setInterval(33);
+
     //nmfTableView* Estimation_Tab1_PopulationTV = new nmfTableView();
     QFont noBoldFont;
     noBoldFont.setBold(false);
@@ -87,7 +92,11 @@ nmfEstimation_Tab1::nmfEstimation_Tab1(QTabWidget*  tabs,
             this,                            SLOT(callback_SpeciesRangeSB(int)));
 
 
+    connect(m_PreviewTimer,                 SIGNAL(timeout()),
+            this,                           SIGNAL(PreviewModifiedParameters()));
+
 // Program takes too much time to run the diagnostics to do the following in real-time
+// (while moving, only a preview of the biomass is drawn; see callback_ModifyMovingSL)
 //    connect(Estimation_Tab1_ModifySL,  SIGNAL(valueChanged(int)),
 //            this,                      SLOT(callback_ModifySL(int)));
     connect(Estimation_Tab1_ModifyRunPB, SIGNAL(clicked()),
@@ -166,9 +175,11 @@ nmfEstimation_Tab1::callback_ModifyMovingSL(int sliderValue)
     sliderValue -= m_StartPosSL;
 
     // Modify selected data
+    m_modifiedValuesSelected.clear();
     foreach (const QModelIndex &index, m_selIndexes) {
         origValue  = m_originalValuesSelected[i++];
         tableValue = origValue + origValue*(sliderValue/50.0);
+        m_modifiedValuesSelected.push_back(tableValue);
         item = new QStandardItem(QString::number(tableValue,'f',2));
         item->setTextAlignment(Qt::AlignCenter);
         smodel->setItem(index.row(),index.column(),item);
@@ -178,6 +189,11 @@ nmfEstimation_Tab1::callback_ModifyMovingSL(int sliderValue)
         Estimation_Tab1_SpeciesPopulationTV->selectionModel()->select(index,QItemSelectionModel::Select);
         Estimation_Tab1_SpeciesPopulationTV->selectionModel()->blockSignals(false);
     }
+
+    // Redraw the preview on the next timer tick (unless one is already pending)
+    if (! m_PreviewTimer->isActive()) {
+        m_PreviewTimer->start();
+    }
 }
 
 void
@@ -186,6 +202,9 @@ nmfEstimation_Tab1::callback_ModifyReleasedSL()
     bool ok = true;
     bool runEstimationAndDiagnostic = Estimation_Tab1_ModifyRunCB->isChecked();
 
+    m_PreviewTimer->stop();
+    emit PreviewFinished();
+
     QApplication::setOverrideCursor(Qt::WaitCursor);
 
     emit StoreOutputSpecies();
@@ -248,6 +267,7 @@ nmfEstimation_Tab1::callback_SelectionChangedTV(const QItemSelection& selection,
 
     // Save the values of the selected indexes in case user wants to undo mods from last save
     m_originalValuesSelected.clear();
+    m_modifiedValuesSelected.clear();
     foreach (const QModelIndex &index, m_selIndexes){
         m_originalValuesSelected.push_back(index.data(Qt::DisplayRole).toDouble());
     }
@@ -1272,6 +1292,40 @@ nmfEstimation_Tab1::getOutputSpecies()
     return m_OutputSpecies;
 }
 
+void
+nmfEstimation_Tab1::getSelectedSpeciesValues(const QString& FieldName,
+                                             std::map<QString,double>& Values)
+{
+    int i = 0;
+    int column = -1;
+    QString species;
+    QStandardItemModel* smodel = qobject_cast<QStandardItemModel*>(Estimation_Tab1_SpeciesPopulationTV->model());
+
+    Values.clear();
+    if (smodel == nullptr) {
+        return;
+    }
+    for (int col=0; col<smodel->columnCount(); ++col) {
+        if (smodel->horizontalHeaderItem(col)->text() == FieldName) {
+            column = col;
+            break;
+        }
+    }
+
+    // Use the unrounded modified values if available since the table only shows 2 decimals
+    foreach (const QModelIndex &index, m_selIndexes) {
+        if (index.column() == column) {
+            species = smodel->index(index.row(),0).data().toString();
+            if (i < int(m_modifiedValuesSelected.size())) {
+                Values[species] = m_modifiedValuesSelected[i];
+            } else {
+                Values[species] = index.data().toDouble();
+            }
+        }
+        ++i;
+    }
+}
+
 QModelIndexList
 nmfEstimation_Tab1::getSelectedVisibleCells()
 {
@@ -33,6 +33,8 @@
 
 #include <QComboBox>
 #include <QSpinBox>
+#include <QTimer>
+#include <map>
 #include <set>
 
 /**
@@ -48,13 +50,15 @@ class nmfEstimation_Tab1: public QObject
 
     bool                 m_runFromModifySlider;
     nmfLogger*           m_Logger;
-    nmfDatabase*         m_DatabasePtr;
+    nmfTracedDatabase*   m_DatabasePtr;
     QStandardItemModel*  m_GuildModel;
     QStandardItemModel*  m_SpeciesModel;
     std::string          m_ProjectDir;
     QModelIndexList      m_selIndexes;
     std::vector<QString> m_originalSpeciesValuesAll;
     std::vector<double>  m_originalValuesSelected;
+    std::vector<double>  m_modifiedValuesSelected;
+    QTimer*              m_PreviewTimer;
     int                  m_StartPosSL;
     QString              m_OutputSpecies;
 
@@ -131,6 +135,16 @@ signals:
      * @brief Signal notifying that a new Diagnostics parameter run should be made
      */
     void RunDiagnostics();
+    /**
+     * @brief Signal notifying that the Modify slider has moved and the biomass
+     * chart should be redrawn from the modified (unsaved) parameter values.
+     * Emitted at most about 30 times per second.
+     */
+    void PreviewModifiedParameters();
+    /**
+     * @brief Signal notifying that the Modify slider was released and any preview data can be released
+     */
+    void PreviewFinished();
     /**
      * @brief Signal notifying that a new Estimation should be run
      * @param showDiagnosticsChart : boolean signifying that the user wants to show the Diagnostics chart
@@ -152,9 +166,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab1(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab1();
 
     /**
@@ -171,6 +185,14 @@ public:
      * @return QString denoting the current Output widget species
      */
     QString getOutputSpecies();
+    /**
+     * @brief Gets the current values of the selected cells of a Species table column,
+     * including any unsaved modifications made with the Modify slider
+     * @param FieldName : name of the Species table column (e.g., GrowthRate, SpeciesK)
+     * @param Values : map of species name to current value for each selected cell in the column
+     */
+    void getSelectedSpeciesValues(const QString& FieldName,
+                                  std::map<QString,double>& Values);
     /**
      * @brief Loads all widgets for this GUI from database tables
      * @return Returns true if all data were loaded successfully
@@ -4,10 +4,10 @@
 #include "nmfUtilsQt.h"
 #include "nmfConstants.h"
 
-nmfEstimation_Tab2::nmfEstimation_Tab2(QTabWidget  *tabs,
-                                       nmfLogger   *logger,
-                                       nmfDatabase *databasePtr,
-                                       std::string &projectDir)
+nmfEstimation_Tab2::nmfEstimation_Tab2(QTabWidget        *tabs,
+                                       nmfLogger         *logger,
+                                       nmfTracedDatabase *databasePtr,
+                                       std::string       &projectDir)
 {
     QUiLoader loader;
 
@@ -43,7 +43,7 @@ class nmfEstimation_Tab2: public QObject
     Q_OBJECT
 
     nmfLogger*                        m_Logger;
-    nmfDatabase*                      m_DatabasePtr;
+    nmfTracedDatabase*                m_DatabasePtr;
     std::string                       m_ProjectDir;
     std::string                       m_ProjectSettingsConfig;
     std::string                       m_HarvestType;
@@ -70,9 +70,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab2(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab2();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfEstimation_Tab3::nmfEstimation_Tab3(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     int NumSpecies;
     int NumGuilds;
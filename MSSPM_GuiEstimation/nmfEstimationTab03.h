@@ -44,7 +44,7 @@ class nmfEstimation_Tab3: public QObject
 
 private:
     nmfLogger*                       m_Logger;
-    nmfDatabase*                     m_DatabasePtr;
+    nmfTracedDatabase*               m_DatabasePtr;
     std::string                      m_ProjectDir;
     std::string                      m_ProjectSettingsConfig;
     QString                          m_CompetitionForm;
@@ -91,9 +91,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab3(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab3();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfEstimation_Tab4::nmfEstimation_Tab4(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     QUiLoader loader;
 
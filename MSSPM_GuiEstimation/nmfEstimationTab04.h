@@ -46,7 +46,7 @@ class nmfEstimation_Tab4: public QObject
     Q_OBJECT
 
     nmfLogger*               m_Logger;
-    nmfDatabase*             m_DatabasePtr;
+    nmfTracedDatabase*       m_DatabasePtr;
     std::string              m_PredationForm;
     std::string              m_ProjectDir;
     std::string              m_ProjectSettingsConfig;
@@ -93,9 +93,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab4(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab4();
 
     /**
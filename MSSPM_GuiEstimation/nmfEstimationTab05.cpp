@@ -5,10 +5,10 @@
 #include "nmfUtilsQt.h"
 #include "nmfConstants.h"
 
-nmfEstimation_Tab5::nmfEstimation_Tab5(QTabWidget  *tabs,
-                             nmfLogger   *theLogger,
-                             nmfDatabase *theDatabasePtr,
-                             std::string &theProjectDir)
+nmfEstimation_Tab5::nmfEstimation_Tab5(QTabWidget        *tabs,
+                             nmfLogger         *theLogger,
+                             nmfTracedDatabase *theDatabasePtr,
+                             std::string       &theProjectDir)
 {
     QUiLoader loader;
 
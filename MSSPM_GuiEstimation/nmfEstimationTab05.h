@@ -43,7 +43,7 @@ class nmfEstimation_Tab5: public QObject
 
     Q_OBJECT
 
-    nmfDatabase*        m_DatabasePtr;
+    nmfTracedDatabase*  m_DatabasePtr;
     nmfLogger*          m_Logger;
     std::string         m_ProjectDir;
     std::string         m_ProjectSettingsConfig;
@@ -71,9 +71,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab5(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab5();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfEstimation_Tab6::nmfEstimation_Tab6(QTabWidget*  tabs,
-                                       nmfLogger*   logger,
-                                       nmfDatabase* databasePtr,
-                                       std::string& projectDir)
+                                       nmfLogger*         logger,
+                                       nmfTracedDatabase* databasePtr,
+                                       std::string&       projectDir)
 {
     QUiLoader loader;
     QString   NLoptMsg;
@@ -17,6 +17,7 @@ nmfEstimation_Tab6::nmfEstimation_Tab6(QTabWidget*  tabs,
     m_DatabasePtr  = databasePtr;
     m_FontSize     = 9;
     m_IsMonospaced = false;
+    m_IsWarmStart  = false;
     m_ProjectDir   = projectDir;
     m_ProjectSettingsConfig.clear();
 
@@ -42,12 +43,16 @@ nmfEstimation_Tab6::nmfEstimation_Tab6(QTabWidget*  tabs,
     Estimation_Tab6_MinimizerTypeCMB        = Estimation_Tabs->findChild<QComboBox   *>("Estimation_Tab6_MinimizerTypeCMB");
     Estimation_Tab6_RunTE                   = Estimation_Tabs->findChild<QTextEdit   *>("Estimation_Tab6_RunTE");
     Estimation_Tab6_RunPB                   = Estimation_Tabs->findChild<QPushButton *>("Estimation_Tab6_RunPB");
+    Estimation_Tab6_ResumePB                = Estimation_Tabs->findChild<QPushButton *>("Estimation_Tab6_ResumePB");
     Estimation_Tab6_ReloadPB                = Estimation_Tabs->findChild<QPushButton *>("Estimation_Tab6_ReloadPB");
     Estimation_Tab6_SavePB                  = Estimation_Tabs->findChild<QPushButton *>("Estimation_Tab6_SavePB");
     Estimation_Tab6_PrevPB                  = Estimation_Tabs->findChild<QPushButton *>("Estimation_Tab6_PrevPB");
     Estimation_Tab6_FontSizeCMB             = Estimation_Tabs->findChild<QComboBox   *>("Estimation_Tab6_FontSizeCMB");
     Estimation_Tab6_MonoCB                  = Estimation_Tabs->findChild<QCheckBox   *>("Estimation_Tab6_MonoCB");
     Estimation_Tab6_NumberOfRunsSB          = Estimation_Tabs->findChild<QSpinBox    *>("Estimation_Tab6_NumberOfRunsSB");
+    Estimation_Tab6_WarmStartCB             = Estimation_Tabs->findChild<QCheckBox   *>("Estimation_Tab6_WarmStartCB");
+    Estimation_Tab6_ForceRerunCB            = Estimation_Tabs->findChild<QCheckBox   *>("Estimation_Tab6_ForceRerunCB");
+    Estimation_Tab6_CacheLBL                = Estimation_Tabs->findChild<QLabel      *>("Estimation_Tab6_CacheLBL");
     Estimation_Tab6_Bees_NumBeesSB          = Estimation_Tabs->findChild<QSpinBox    *>("Estimation_Tab6_Bees_NumBeesSB");
     Estimation_Tab6_Bees_NumEliteSitesSB    = Estimation_Tabs->findChild<QSpinBox    *>("Estimation_Tab6_Bees_NumEliteSitesSB");
     Estimation_Tab6_Bees_NumBestSitesSB     = Estimation_Tabs->findChild<QSpinBox    *>("Estimation_Tab6_Bees_NumBestSitesSB");
@@ -80,6 +85,8 @@ nmfEstimation_Tab6::nmfEstimation_Tab6(QTabWidget*  tabs,
             this,                                   SLOT(callback_PrevPB()));
     connect(Estimation_Tab6_RunPB,                  SIGNAL(clicked()),
             this,                                   SLOT(callback_RunPB()));
+    connect(Estimation_Tab6_ResumePB,               SIGNAL(clicked()),
+            this,                                   SLOT(callback_ResumePB()));
     connect(Estimation_Tab6_SavePB,                 SIGNAL(clicked()),
             this,                                   SLOT(callback_SavePB()));
     connect(Estimation_Tab6_ReloadPB,               SIGNAL(clicked()),
@@ -107,6 +114,7 @@ nmfEstimation_Tab6::nmfEstimation_Tab6(QTabWidget*  tabs,
     Estimation_Tab6_MonoCB->blockSignals(true);
     Estimation_Tab6_MonoCB->setChecked(m_IsMonospaced);
     Estimation_Tab6_MonoCB->blockSignals(false);
+    Estimation_Tab6_WarmStartCB->setChecked(m_IsWarmStart);
     QString fontName = (m_IsMonospaced) ? "Courier" : Estimation_Tab6_RunPB->font().family();
     QFont defaultFont(fontName,11,QFont::Medium,false);
     setFont(defaultFont);
@@ -124,6 +132,24 @@ nmfEstimation_Tab6::~nmfEstimation_Tab6()
 {
 }
 
+bool
+nmfEstimation_Tab6::isWarmStart()
+{
+    return Estimation_Tab6_WarmStartCB->isChecked();
+}
+
+bool
+nmfEstimation_Tab6::isForceRerun()
+{
+    return Estimation_Tab6_ForceRerunCB->isChecked();
+}
+
+void
+nmfEstimation_Tab6::setCacheStatus(const QString& Status)
+{
+    Estimation_Tab6_CacheLBL->setText(Status);
+}
+
 bool
 nmfEstimation_Tab6::isStopAfterValue()
 {
@@ -206,6 +232,15 @@ nmfEstimation_Tab6::callback_RunPB()
     QApplication::restoreOverrideCursor();
 }
 
+void
+nmfEstimation_Tab6::callback_ResumePB()
+{
+    m_Logger->logMsg(nmfConstants::Normal,"");
+    m_Logger->logMsg(nmfConstants::Normal,"Resume Estimation");
+
+    emit ResumeEstimation();
+}
+
 void
 nmfEstimation_Tab6::callback_LoadPB()
 {
@@ -677,6 +712,7 @@ nmfEstimation_Tab6::readSettings()
     m_EstimationID         = settings->value("ID","").toString().toStdString();
     m_FontSize           = settings->value("FontSize",9).toString().toInt();
     m_IsMonospaced       = settings->value("Monospace",0).toString().toInt();
+    m_IsWarmStart        = settings->value("WarmStart",0).toString().toInt();
     settings->endGroup();
 
     delete settings;
@@ -694,6 +730,7 @@ nmfEstimation_Tab6::saveSettings()
     settings->setValue("FontSize",   Estimation_Tab6_FontSizeCMB->currentText());
     settings->setValue("FontSize",   Estimation_Tab6_FontSizeCMB->currentText());
     settings->setValue("Monospace",  (int)Estimation_Tab6_MonoCB->isChecked());
+    settings->setValue("WarmStart",  (int)Estimation_Tab6_WarmStartCB->isChecked());
     settings->endGroup();
 
     delete settings;
@@ -46,15 +46,16 @@ class nmfEstimation_Tab6: public QObject
 {
     Q_OBJECT
 
-    nmfDatabase* m_DatabasePtr;
-    int          m_FontSize;
-    int          m_IsMonospaced;
-    nmfLogger*   m_Logger;
-    std::string  m_ProjectDir;
-    std::string  m_ProjectSettingsConfig;
-    std::string  m_EstimationDataFile;
-    std::string  m_EstimationID;
-    std::string  m_EstimationOutputFile;
+    nmfTracedDatabase* m_DatabasePtr;
+    int                m_FontSize;
+    int                m_IsMonospaced;
+    int                m_IsWarmStart;
+    nmfLogger*         m_Logger;
+    std::string        m_ProjectDir;
+    std::string        m_ProjectSettingsConfig;
+    std::string        m_EstimationDataFile;
+    std::string        m_EstimationID;
+    std::string        m_EstimationOutputFile;
 
     QGroupBox*   Estimation_Tab6_Bees_ParametersGB;
     QGroupBox*   Estimation_Tab6_NL_ParametersGB;
@@ -66,6 +67,7 @@ class nmfEstimation_Tab6: public QObject
     QWidget*     Estimation_Tab6_Widget;
     QTextEdit*   Estimation_Tab6_RunTE;
     QPushButton* Estimation_Tab6_RunPB;
+    QPushButton* Estimation_Tab6_ResumePB;
     QPushButton* Estimation_Tab6_SavePB;
     QPushButton* Estimation_Tab6_ReloadPB;
     QPushButton* Estimation_Tab6_PrevPB;
@@ -73,6 +75,9 @@ class nmfEstimation_Tab6: public QObject
     QCheckBox*   Estimation_Tab6_MonoCB;
     QComboBox*   Estimation_Tab6_EstimationAlgorithmCMB;
     QSpinBox*    Estimation_Tab6_NumberOfRunsSB;
+    QCheckBox*   Estimation_Tab6_WarmStartCB;
+    QCheckBox*   Estimation_Tab6_ForceRerunCB;
+    QLabel*      Estimation_Tab6_CacheLBL;
     QSpinBox*    Estimation_Tab6_Bees_NumBeesSB;
     QSpinBox*    Estimation_Tab6_Bees_NumEliteSitesSB;
     QSpinBox*    Estimation_Tab6_Bees_NumBestSitesSB;
@@ -104,9 +109,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfEstimation_Tab6(QTabWidget*  tabs,
-                       nmfLogger*   logger,
-                       nmfDatabase* databasePtr,
-                       std::string& projectDir);
+                       nmfLogger*         logger,
+                       nmfTracedDatabase* databasePtr,
+                       std::string&       projectDir);
     virtual ~nmfEstimation_Tab6();
 
     /**
@@ -133,6 +138,21 @@ public:
      * @return Returns the objective criterion function (as a string)
      */
     std::string getCurrentObjectiveCriterion();
+    /**
+     * @brief Gets whether the estimation should start from the last estimated parameters
+     * @return Returns true if the Warm Start box is checked
+     */
+    bool isWarmStart();
+    /**
+     * @brief Gets whether the estimation should run even if an identical estimation has a cached result
+     * @return Returns true if the Force Re-run box is checked
+     */
+    bool isForceRerun();
+    /**
+     * @brief Shows whether the last run's result was reused from the estimation cache
+     * @param Status : the cache status to show
+     */
+    void setCacheStatus(const QString& Status);
     /**
      * @brief Loads all widgets for this GUI from database tables
      * @return Returns true if all data were loaded successfully
@@ -169,6 +189,10 @@ signals:
      * @brief Signal sent to check all Estimation tables for completeness
      */
     void CheckAllEstimationTablesAndRun();
+    /**
+     * @brief Signal sent to resume the last stopped Estimation from its checkpoint
+     */
+    void ResumeEstimation();
 //    /**
 //     * @brief Signal notifying that a new Estimation should be run
 //     * @param showDiagnosticsChart : boolean signifying that the user wants to show the Diagnostics chart
@@ -196,6 +220,10 @@ public Q_SLOTS:
      * @brief Callback invoked when the user clicks the Run button
      */
     void callback_RunPB();
+    /**
+     * @brief Callback invoked when the user clicks the Resume button
+     */
+    void callback_ResumePB();
     /**
      * @brief Callback invoked when the user clicks the Load button
      */
@@ -5,12 +5,12 @@
 #include "nmfConstants.h"
 
 LoadForecastDlg::LoadForecastDlg(const QString& title,
-                                 QWidget*       parent,
-                                 nmfLogger*     logger,
-                                 nmfDatabase*   databasePtr,
-                                 QLineEdit*     forecastNameLE,
-                                 QSpinBox*      forecastRunLengthSB,
-                                 QSpinBox*      forecastNumRunsSB)
+                                 QWidget*           parent,
+                                 nmfLogger*         logger,
+                                 nmfTracedDatabase* databasePtr,
+                                 QLineEdit*         forecastNameLE,
+                                 QSpinBox*          forecastRunLengthSB,
+                                 QSpinBox*          forecastNumRunsSB)
     : QDialog(parent)
 {
     QLabel *listLabel = new QLabel("Saved Forecasts");
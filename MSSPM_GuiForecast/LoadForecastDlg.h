@@ -42,7 +42,7 @@ class LoadForecastDlg : public QDialog
 
 private:
     QDialogButtonBox*        m_ButtonBox;
-    nmfDatabase*             m_DatabasePtr;
+    nmfTracedDatabase*       m_DatabasePtr;
     QString                  m_ForecastName;
     QLineEdit*               m_ForecastNameLE;
     QSpinBox*                m_ForecastRunLengthSB;
@@ -63,12 +63,12 @@ public:
      * @param numRunsSB : Spin Box for the number of Runs in the current Forecast
      */
     LoadForecastDlg(const QString&     title,
-                          QWidget*     parent,
-                          nmfLogger*   logger,
-                          nmfDatabase* databasePtr,
-                          QLineEdit*   forecastName,
-                          QSpinBox*    runLengthSB,
-                          QSpinBox*    numRunsSB);
+                          QWidget*           parent,
+                          nmfLogger*         logger,
+                          nmfTracedDatabase* databasePtr,
+                          QLineEdit*         forecastName,
+                          QSpinBox*          runLengthSB,
+                          QSpinBox*          numRunsSB);
    ~LoadForecastDlg() {}
 
     /**
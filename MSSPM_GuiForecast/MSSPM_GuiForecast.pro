@@ -26,9 +26,14 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Build the Chrome trace timers of nmfTrace.h with: qmake CONFIG+=trace
+CONFIG(trace): DEFINES += MSSPM_TRACE
+
 SOURCES += \
     LoadForecastDlg.cpp \
     MultiScenarioSaveDlg.cpp \
+    nmfBulkWriter.cpp \
+    nmfColumnQuery.cpp \
     nmfForecastTab01.cpp \
     nmfForecastTab02.cpp \
     nmfForecastTab04.cpp \
@@ -37,6 +42,8 @@ SOURCES += \
 HEADERS += \
     LoadForecastDlg.h \
     MultiScenarioSaveDlg.h \
+    nmfBulkWriter.h \
+    nmfColumnQuery.h \
     mainpage.h \
     nmfForecastTab01.h \
     nmfForecastTab02.h \
@@ -63,3 +70,6 @@ else:unix: LIBS += -L$$PWD/../../build-nmfUtilities-Qt_5_12_3_gcc64-Release/ -ln
 
 INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
 DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfUtilities
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
@@ -9,9 +9,9 @@
 #include <QStringList>
 
 MultiScenarioSaveDlg::MultiScenarioSaveDlg(QTabWidget*  parent,
-                                                 nmfDatabase* databasePtr,
-                                                 nmfLogger*   logger,
-                                                 std::string& ProjectSettingsConfig,
+                                                 nmfTracedDatabase* databasePtr,
+                                                 nmfLogger*         logger,
+                                                 std::string&       ProjectSettingsConfig,
                                                  std::map<QString,QStringList>& SortedForecastLabelsMap,
                                                  std::string& currentScenario,
                                                  std::string  forecastName) : QDialog(parent)
@@ -312,6 +312,7 @@ MultiScenarioSaveDlg::callback_OkPB()
 {
    bool dataWritten  = false;
    bool okToWriteFile = true;
+   bool writeOK = true;
 // bool ForecastAlreadyInMap = false;
    int NumRecords;
    int NumYears;
@@ -319,16 +320,16 @@ MultiScenarioSaveDlg::callback_OkPB()
    std::vector<std::string> fields;
    std::map<std::string, std::vector<std::string> > dataMap;
    std::string cmd;
-   std::string errorMsg;
    std::string queryStr;
    std::string Scenario = getScenarioName();
    std::string Forecast = getForecastLabel();
-   std::string SortOrder = "0";
+   int SortOrder = 0;
    std::vector<std::string> Species;
    std::vector<int> Years;
    boost::numeric::ublas::matrix<double> ForecastBiomass;
    QMessageBox::StandardButton reply;
    QString msg;
+   nmfBulkWriter writer;
 
    // Check that the scenario and forecast aren't blank.
    if (QString::fromStdString(Scenario).trimmed() == "" ||
@@ -371,29 +372,26 @@ MultiScenarioSaveDlg::callback_OkPB()
        cmd  = "DELETE FROM ForecastBiomassMultiScenario";
        cmd += "  WHERE ScenarioName = '" + Scenario +
               "' AND ForecastLabel = '" + Forecast + "'";
-       errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-       if (errorMsg != " ") {
-           m_Logger->logMsg(nmfConstants::Error,"[Error 1] MultiScenarioSaveDlg::callback_OkPB: DELETE error: " + errorMsg);
+       if (! writer.begin() || ! writer.exec(cmd)) {
+           m_Logger->logMsg(nmfConstants::Error,"[Error 1] MultiScenarioSaveDlg::callback_OkPB: DELETE error: " + writer.lastError());
            m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
            return;
        }
 
-       cmd = "INSERT INTO ForecastBiomassMultiScenario (ScenarioName,SortOrder,ForecastLabel,SpeName,Year,Value) VALUES ";
-       for (int i=0; i<NumSpecies; ++i) { // Species
-           for (int j=0; j<NumYears; ++j) { // Time in years
-               cmd += "('"   + Scenario +
-                       "',"  + SortOrder +
-                       ",'"  + Forecast +
-                       "','" + Species[i] +
-                       "',"  + std::to_string(Years[j]) +
-                       ","   + std::to_string(ForecastBiomass(j,i)) + "),";
+       writer.prepare("INSERT","ForecastBiomassMultiScenario",
+                      {"ScenarioName","SortOrder","ForecastLabel","SpeName","Year","Value"});
+       for (int i=0; writeOK && i<NumSpecies; ++i) { // Species
+           for (int j=0; writeOK && j<NumYears; ++j) { // Time in years
+               writeOK = writer.addRow({QString::fromStdString(Scenario),
+                                        SortOrder,
+                                        QString::fromStdString(Forecast),
+                                        QString::fromStdString(Species[i]),
+                                        Years[j],
+                                        ForecastBiomass(j,i)});
            }
        }
-       cmd = cmd.substr(0,cmd.size()-1); // Remove last comma
-       errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-       if (errorMsg != " ") {
-           m_Logger->logMsg(nmfConstants::Error,"[Error 2] MultiScenarioSaveDlg::callback_OkPB: Write table error: " + errorMsg);
-           m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+       if (! writeOK || ! writer.commit()) {
+           m_Logger->logMsg(nmfConstants::Error,"[Error 2] MultiScenarioSaveDlg::callback_OkPB: Write table error: " + writer.lastError());
            return;
        }
        dataWritten = true;
@@ -30,9 +30,10 @@
 
 #pragma once
 
-#include "nmfDatabase.h"
+#include "nmfTracedDatabase.h"
 #include "nmfLogger.h"
 #include "nmfConstantsMSSPM.h"
+#include "nmfBulkWriter.h"
 
 
 /**
@@ -45,9 +46,9 @@ class MultiScenarioSaveDlg : public QDialog
 {
     Q_OBJECT
 
-    nmfDatabase* m_DatabasePtr;
-    std::string  m_ForecastName;
-    nmfLogger*   m_Logger;
+    nmfTracedDatabase* m_DatabasePtr;
+    std::string        m_ForecastName;
+    nmfLogger*         m_Logger;
     std::map<QString,QStringList> m_OrderedForecastLabelsMap;
     std::string  m_ProjectSettingsConfig;
     std::string  m_ScenarioName;
@@ -102,9 +103,9 @@ public:
      * @param forecastName : name of Forecast to add to Scenario
      */
     MultiScenarioSaveDlg(QTabWidget*  parent,
-                         nmfDatabase* databasePtr,
-                         nmfLogger*   logger,
-                         std::string& projectSettingsConfig,
+                         nmfTracedDatabase* databasePtr,
+                         nmfLogger*         logger,
+                         std::string&       projectSettingsConfig,
                          std::map<QString,QStringList>& sortedForecastLabelsMap,
                          std::string& currentScenario,
                          std::string  forecastName);
@@ -0,0 +1,168 @@
+#include "nmfBulkWriter.h"
+
+#include <QSqlError>
+
+nmfBulkWriter::nmfBulkWriter(QSqlDatabase Database,
+                             const int&   RowsPerChunk)
+{
+    m_Database      = Database;
+    m_RowsPerChunk  = (RowsPerChunk > 0) ? RowsPerChunk : 1;
+    m_NumRows       = 0;
+    m_ChunkPrepared = false;
+    m_InTransaction = false;
+    m_LastError.clear();
+}
+
+nmfBulkWriter::~nmfBulkWriter()
+{
+    if (m_InTransaction) {
+        rollback();
+    }
+}
+
+bool
+nmfBulkWriter::begin()
+{
+    m_InTransaction = m_Database.transaction();
+    if (! m_InTransaction) {
+        m_LastError = m_Database.lastError().text().toStdString();
+    }
+    return m_InTransaction;
+}
+
+bool
+nmfBulkWriter::exec(const std::string& cmd)
+{
+    QSqlQuery query(m_Database);
+
+    if (! query.exec(QString::fromStdString(cmd))) {
+        m_LastError = query.lastError().text().toStdString();
+        return false;
+    }
+    return true;
+}
+
+void
+nmfBulkWriter::prepare(const std::string&              Verb,
+                       const std::string&              TableName,
+                       const std::vector<std::string>& Fields)
+{
+    m_Verb          = Verb;
+    m_TableName     = TableName;
+    m_Fields        = Fields;
+    m_NumRows       = 0;
+    m_ChunkPrepared = false;
+    m_Values.clear();
+    m_Values.reserve(m_RowsPerChunk*Fields.size());
+}
+
+std::string
+nmfBulkWriter::buildStatement(const int& NumRows)
+{
+    std::string row = "(";
+    std::string cmd = m_Verb + " INTO " + m_TableName + " (";
+
+    for (unsigned i=0; i<m_Fields.size(); ++i) {
+        cmd += (i == 0) ? m_Fields[i] : "," + m_Fields[i];
+        row += (i == 0) ? "?" : ",?";
+    }
+    row += ")";
+    cmd += ") VALUES " + row;
+    for (int i=1; i<NumRows; ++i) {
+        cmd += "," + row;
+    }
+    return cmd;
+}
+
+bool
+nmfBulkWriter::writeRows(QSqlQuery& Query,
+                         const int& FirstValue,
+                         const int& NumRows)
+{
+    int NumValues = NumRows*m_Fields.size();
+
+    for (int i=0; i<NumValues; ++i) {
+        Query.bindValue(i,m_Values[FirstValue+i]);
+    }
+    if (! Query.exec()) {
+        m_LastError = Query.lastError().text().toStdString();
+        return false;
+    }
+    return true;
+}
+
+bool
+nmfBulkWriter::addRow(const QVariantList& Values)
+{
+    for (const QVariant& value : Values) {
+        m_Values.push_back(value);
+    }
+    if (++m_NumRows < m_RowsPerChunk) {
+        return true;
+    }
+
+    // The full chunk statement is prepared once per table and reused for every full chunk
+    if (! m_ChunkPrepared) {
+        m_ChunkQuery = QSqlQuery(m_Database);
+        if (! m_ChunkQuery.prepare(QString::fromStdString(buildStatement(m_RowsPerChunk)))) {
+            m_LastError = m_ChunkQuery.lastError().text().toStdString();
+            return false;
+        }
+        m_ChunkPrepared = true;
+    }
+    bool ok = writeRows(m_ChunkQuery,0,m_RowsPerChunk);
+    m_NumRows = 0;
+    m_Values.clear();
+
+    return ok;
+}
+
+bool
+nmfBulkWriter::flush()
+{
+    bool ok = true;
+
+    if (m_NumRows > 0) {
+        QSqlQuery query(m_Database);
+        if (! query.prepare(QString::fromStdString(buildStatement(m_NumRows)))) {
+            m_LastError = query.lastError().text().toStdString();
+            ok = false;
+        } else {
+            ok = writeRows(query,0,m_NumRows);
+        }
+    }
+    m_NumRows = 0;
+    m_Values.clear();
+
+    return ok;
+}
+
+bool
+nmfBulkWriter::commit()
+{
+    if (! flush()) {
+        return false;
+    }
+    m_ChunkQuery = QSqlQuery();
+    m_InTransaction = false;
+    if (! m_Database.commit()) {
+        m_LastError = m_Database.lastError().text().toStdString();
+        m_Database.rollback();
+        return false;
+    }
+    return true;
+}
+
+void
+nmfBulkWriter::rollback()
+{
+    m_ChunkQuery = QSqlQuery();
+    m_InTransaction = false;
+    m_Database.rollback();
+}
+
+std::string
+nmfBulkWriter::lastError()
+{
+    return m_LastError;
+}
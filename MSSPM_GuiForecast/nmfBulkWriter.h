@@ -0,0 +1,126 @@
+/**
+ * @file nmfBulkWriter.h
+ * @brief Definition of the prepared statement bulk writer for database tables
+ *
+ * This file contains the definition of the bulk writer. Rows are bound as typed
+ * values to a prepared multi-row statement and written in fixed size chunks inside
+ * a single transaction, so no SQL text is built from the values.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVariant>
+#include <QVariantList>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Writes rows to a database table with prepared statements
+ *
+ * Usage: begin() the transaction, optionally exec() any DELETE statements, then
+ * prepare() each table, addRow() its rows and flush() it. Call commit() once all
+ * of the tables have been written. If the writer is destroyed before commit() is
+ * called, the transaction is rolled back.
+ *
+ * Each row's values are bound in their native types (i.e., doubles are written
+ * at full precision) and the rows are sent in chunks of at most RowsPerChunk rows
+ * per statement, which keeps each statement under the server's packet size limit.
+ */
+class nmfBulkWriter
+{
+private:
+    QSqlDatabase             m_Database;
+    QSqlQuery                m_ChunkQuery;
+    std::string              m_Verb;
+    std::string              m_TableName;
+    std::vector<std::string> m_Fields;
+    std::vector<QVariant>    m_Values;
+    int                      m_RowsPerChunk;
+    int                      m_NumRows;
+    bool                     m_ChunkPrepared;
+    bool                     m_InTransaction;
+    std::string              m_LastError;
+
+    std::string buildStatement(const int& NumRows);
+    bool writeRows(QSqlQuery& Query, const int& FirstValue, const int& NumRows);
+
+public:
+    /**
+     * @brief nmfBulkWriter : class constructor
+     * @param Database : database connection to write to (the default connection if not passed)
+     * @param RowsPerChunk : maximum number of rows sent per statement
+     */
+    nmfBulkWriter(QSqlDatabase Database = QSqlDatabase::database(),
+                  const int&   RowsPerChunk = 500);
+   ~nmfBulkWriter();
+
+    /**
+     * @brief Starts the transaction
+     * @return Returns false if the transaction couldn't be started
+     */
+    bool begin();
+    /**
+     * @brief Executes a statement without any bound values (i.e., a DELETE) inside the transaction
+     * @param cmd : the SQL statement to execute
+     * @return Returns false if the statement failed
+     */
+    bool exec(const std::string& cmd);
+    /**
+     * @brief Prepares the writer for a new table. Any rows still buffered for the previous table are discarded.
+     * @param Verb : either INSERT or REPLACE
+     * @param TableName : name of the table to write to
+     * @param Fields : names of the table fields, in the order in which the row values are passed
+     */
+    void prepare(const std::string&              Verb,
+                 const std::string&              TableName,
+                 const std::vector<std::string>& Fields);
+    /**
+     * @brief Buffers a row, writing the buffered rows whenever a full chunk has been collected
+     * @param Values : the row values, one per field passed to prepare
+     * @return Returns false if writing a full chunk failed
+     */
+    bool addRow(const QVariantList& Values);
+    /**
+     * @brief Writes any rows still buffered for the current table
+     * @return Returns false if the write failed
+     */
+    bool flush();
+    /**
+     * @brief Flushes the current table and commits the transaction
+     * @return Returns false if the flush or the commit failed
+     */
+    bool commit();
+    /**
+     * @brief Rolls back the transaction
+     */
+    void rollback();
+    /**
+     * @brief Gets the last error message
+     * @return Returns the database error message of the last failed operation
+     */
+    std::string lastError();
+};
@@ -0,0 +1,112 @@
+#include "nmfColumnQuery.h"
+
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QVariant>
+
+nmfColumnQuery::nmfColumnQuery(QSqlDatabase Database)
+{
+    m_Database   = Database;
+    m_NumRecords = 0;
+    m_LastError.clear();
+}
+
+bool
+nmfColumnQuery::exec(const std::string&              queryStr,
+                     const std::vector<std::string>& NumericFields,
+                     const std::vector<std::string>& TextFields)
+{
+    int NumNumeric = NumericFields.size();
+    int NumText    = TextFields.size();
+    std::vector<int> NumericIndex(NumNumeric);
+    std::vector<int> TextIndex(NumText);
+    std::vector<std::vector<double>*> NumericColumn(NumNumeric);
+    std::vector<std::vector<std::string>*> TextColumn(NumText);
+    QSqlQuery query(m_Database);
+
+    m_NumRecords = 0;
+    m_NumericColumns.clear();
+    m_TextColumns.clear();
+
+    query.setForwardOnly(true);
+    if (! query.prepare(QString::fromStdString(queryStr)) || ! query.exec()) {
+        m_LastError = query.lastError().text().toStdString();
+        return false;
+    }
+
+    // Look up each column once, rather than once per record
+    QSqlRecord record = query.record();
+    for (int i=0; i<NumNumeric; ++i) {
+        NumericIndex[i]  = record.indexOf(QString::fromStdString(NumericFields[i]));
+        NumericColumn[i] = &m_NumericColumns[NumericFields[i]];
+        if (NumericIndex[i] < 0) {
+            m_LastError = "Field not found: " + NumericFields[i];
+            return false;
+        }
+    }
+    for (int i=0; i<NumText; ++i) {
+        TextIndex[i]  = record.indexOf(QString::fromStdString(TextFields[i]));
+        TextColumn[i] = &m_TextColumns[TextFields[i]];
+        if (TextIndex[i] < 0) {
+            m_LastError = "Field not found: " + TextFields[i];
+            return false;
+        }
+    }
+
+    if (query.size() > 0) {
+        for (int i=0; i<NumNumeric; ++i) {
+            NumericColumn[i]->reserve(query.size());
+        }
+    }
+    while (query.next()) {
+        for (int i=0; i<NumNumeric; ++i) {
+            NumericColumn[i]->push_back(query.value(NumericIndex[i]).toDouble());
+        }
+        for (int i=0; i<NumText; ++i) {
+            TextColumn[i]->push_back(query.value(TextIndex[i]).toString().toStdString());
+        }
+        ++m_NumRecords;
+    }
+
+    return true;
+}
+
+int
+nmfColumnQuery::numRecords()
+{
+    return m_NumRecords;
+}
+
+const std::vector<double>&
+nmfColumnQuery::numeric(const std::string& Field)
+{
+    return m_NumericColumns[Field];
+}
+
+const std::vector<std::string>&
+nmfColumnQuery::text(const std::string& Field)
+{
+    return m_TextColumns[Field];
+}
+
+int
+nmfColumnQuery::fillMatrixByColumn(const std::string&                     Field,
+                                   const int&                             FirstRecord,
+                                   boost::numeric::ublas::matrix<double>& Matrix)
+{
+    int m = FirstRecord;
+    const std::vector<double>& Values = m_NumericColumns[Field];
+
+    for (unsigned col=0; col<Matrix.size2(); ++col) {
+        for (unsigned row=0; row<Matrix.size1(); ++row) {
+            Matrix(row,col) = Values[m++];
+        }
+    }
+    return m;
+}
+
+std::string
+nmfColumnQuery::lastError()
+{
+    return m_LastError;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file nmfColumnQuery.h
+ * @brief Definition of the typed columnar query class
+ *
+ * This file contains the definition of the columnar query. A query's numeric
+ * columns are read as doubles into contiguous vectors (or directly into a
+ * matrix), instead of being returned as a map of string vectors that the
+ * caller then has to parse cell by cell.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs a SELECT query and returns its columns as typed, contiguous vectors
+ *
+ * The query is run as a forward only prepared statement, so the server returns the
+ * numeric values in binary form and no per cell string is ever created for them.
+ * Only the requested text columns (i.e., labels) are converted to strings.
+ */
+class nmfColumnQuery
+{
+private:
+    QSqlDatabase                                    m_Database;
+    int                                             m_NumRecords;
+    std::string                                     m_LastError;
+    std::map<std::string,std::vector<double> >      m_NumericColumns;
+    std::map<std::string,std::vector<std::string> > m_TextColumns;
+
+public:
+    /**
+     * @brief nmfColumnQuery : class constructor
+     * @param Database : database connection to query (the default connection if not passed)
+     */
+    nmfColumnQuery(QSqlDatabase Database = QSqlDatabase::database());
+   ~nmfColumnQuery() {}
+
+    /**
+     * @brief Runs the query and reads the requested columns
+     * @param queryStr : the SELECT statement to run
+     * @param NumericFields : names of the columns to read as doubles
+     * @param TextFields : names of the columns to read as strings
+     * @return Returns false if the query failed or a requested column isn't in the result
+     */
+    bool exec(const std::string&              queryStr,
+              const std::vector<std::string>& NumericFields,
+              const std::vector<std::string>& TextFields = {});
+    /**
+     * @brief Gets the number of records read by the last query
+     * @return Returns the number of records
+     */
+    int numRecords();
+    /**
+     * @brief Gets a numeric column of the last query
+     * @param Field : name of the column (must have been passed as a numeric field)
+     * @return Returns the column values, one per record
+     */
+    const std::vector<double>& numeric(const std::string& Field);
+    /**
+     * @brief Gets a text column of the last query
+     * @param Field : name of the column (must have been passed as a text field)
+     * @return Returns the column values, one per record
+     */
+    const std::vector<std::string>& text(const std::string& Field);
+    /**
+     * @brief Copies consecutive records of a numeric column into a matrix, filling
+     * the matrix one column at a time (i.e., for records ordered by SpeName,Year the
+     * matrix is filled as Year x SpeName)
+     * @param Field : name of the numeric column
+     * @param FirstRecord : the first record to copy
+     * @param Matrix : the matrix to fill, which must already be sized
+     * @return Returns the record following the last one copied
+     */
+    int fillMatrixByColumn(const std::string&                     Field,
+                           const int&                             FirstRecord,
+                           boost::numeric::ublas::matrix<double>& Matrix);
+    /**
+     * @brief Gets the last error message
+     * @return Returns the database error message of the last failed query
+     */
+    std::string lastError();
+};
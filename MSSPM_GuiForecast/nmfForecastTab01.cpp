@@ -6,9 +6,9 @@
 
 
 nmfForecast_Tab1::nmfForecast_Tab1(QTabWidget*  tabs,
-                                   nmfLogger*   logger,
-                                   nmfDatabase* databasePtr,
-                                   std::string& projectDir)
+                                   nmfLogger*         logger,
+                                   nmfTracedDatabase* databasePtr,
+                                   std::string&       projectDir)
 {
     QUiLoader loader;
 
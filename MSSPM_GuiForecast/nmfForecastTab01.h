@@ -44,7 +44,7 @@ class nmfForecast_Tab1: public QObject
     Q_OBJECT
 
 private:
-    nmfDatabase*        m_DatabasePtr;
+    nmfTracedDatabase*  m_DatabasePtr;
     nmfLogger*          m_Logger;
     std::string         m_ProjectDir;
     std::string         m_ProjectSettingsConfig;
@@ -83,9 +83,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfForecast_Tab1(QTabWidget*  tabs,
-                     nmfLogger*   logger,
-                     nmfDatabase* databasePtr,
-                     std::string& projectDir);
+                     nmfLogger*         logger,
+                     nmfTracedDatabase* databasePtr,
+                     std::string&       projectDir);
     virtual ~nmfForecast_Tab1();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfForecast_Tab2::nmfForecast_Tab2(QTabWidget*  tabs,
-                                   nmfLogger*   logger,
-                                   nmfDatabase* databasePtr,
-                                   std::string& projectDir)
+                                   nmfLogger*         logger,
+                                   nmfTracedDatabase* databasePtr,
+                                   std::string&       projectDir)
 {
     QUiLoader loader;
 
@@ -45,7 +45,7 @@ class nmfForecast_Tab2: public QObject
     Q_OBJECT
 
 private:
-    nmfDatabase*        m_DatabasePtr;
+    nmfTracedDatabase*  m_DatabasePtr;
     std::string         m_HarvestType;
     nmfLogger*          m_Logger;
     std::string         m_ProjectSettingsConfig;
@@ -81,9 +81,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfForecast_Tab2(QTabWidget*  tabs,
-                     nmfLogger*   logger,
-                     nmfDatabase* databasePtr,
-                     std::string& projectDir);
+                     nmfLogger*         logger,
+                     nmfTracedDatabase* databasePtr,
+                     std::string&       projectDir);
     virtual ~nmfForecast_Tab2();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfForecast_Tab3::nmfForecast_Tab3(QTabWidget*  tabs,
-                                   nmfLogger*   logger,
-                                   nmfDatabase* databasePtr,
-                                   std::string& projectDir)
+                                   nmfLogger*         logger,
+                                   nmfTracedDatabase* databasePtr,
+                                   std::string&       projectDir)
 {
     QUiLoader loader;
 
@@ -46,7 +46,7 @@ private:
     QString             m_BetaS;
     QString             m_BetaG;
     std::string         m_CompetitionForm;
-    nmfDatabase*        m_DatabasePtr;
+    nmfTracedDatabase*  m_DatabasePtr;
     std::map<std::string,std::vector<std::string> > m_FormMap;
     std::string         m_GrowthForm;
     std::string         m_HarvestForm;
@@ -85,9 +85,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfForecast_Tab3(QTabWidget*  tabs,
-                     nmfLogger*   logger,
-                     nmfDatabase* databasePtr,
-                     std::string& projectDir);
+                     nmfLogger*         logger,
+                     nmfTracedDatabase* databasePtr,
+                     std::string&       projectDir);
     virtual ~nmfForecast_Tab3();
 
     /**
@@ -5,9 +5,9 @@
 #include "nmfConstants.h"
 
 nmfForecast_Tab4::nmfForecast_Tab4(QTabWidget*  tabs,
-                                   nmfLogger*   logger,
-                                   nmfDatabase* databasePtr,
-                                   std::string& projectDir)
+                                   nmfLogger*         logger,
+                                   nmfTracedDatabase* databasePtr,
+                                   std::string&       projectDir)
 {
     QUiLoader loader;
 
@@ -43,7 +43,7 @@ class nmfForecast_Tab4: public QObject
     Q_OBJECT
 
     std::string                   m_CurrentScenario;
-    nmfDatabase*                  m_DatabasePtr;
+    nmfTracedDatabase*            m_DatabasePtr;
     std::string                   m_EstimationOutputFile;
     std::string                   m_EstimationDataFile;
     std::string                   m_EstimationID;
@@ -80,9 +80,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfForecast_Tab4(QTabWidget*  tabs,
-                     nmfLogger*   logger,
-                     nmfDatabase* databasePtr,
-                     std::string& projectDir);
+                     nmfLogger*         logger,
+                     nmfTracedDatabase* databasePtr,
+                     std::string&       projectDir);
     virtual ~nmfForecast_Tab4();
 
     /**
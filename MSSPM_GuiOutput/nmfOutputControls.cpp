@@ -5,10 +5,10 @@
 #include "nmfConstants.h"
 
 MSSPM_GuiOutputControls::MSSPM_GuiOutputControls(
-        QGroupBox*   controlsGroupBox,
-        nmfLogger*   logger,
-        nmfDatabase* databasePtr,
-        std::string& projectDir)
+        QGroupBox*         controlsGroupBox,
+        nmfLogger*         logger,
+        nmfTracedDatabase* databasePtr,
+        std::string&       projectDir)
 {
     m_Logger              = logger;
     m_DatabasePtr         = databasePtr;
@@ -49,7 +49,7 @@ class MSSPM_GuiOutputControls: public QObject
 
     Q_OBJECT
 
-    nmfDatabase*       m_DatabasePtr;
+    nmfTracedDatabase* m_DatabasePtr;
     nmfLogger*         m_Logger;
     std::string        m_ProjectDir;
     std::string        m_ProjectSettingsConfig;
@@ -117,9 +117,9 @@ public:
      * @param projectDir : the project directory
      */
     MSSPM_GuiOutputControls(QGroupBox*   controlsGroupBox,
-                            nmfLogger*   logger,
-                            nmfDatabase* databasePtr,
-                            std::string& projectDir);
+                            nmfLogger*         logger,
+                            nmfTracedDatabase* databasePtr,
+                            std::string&       projectDir);
     virtual ~MSSPM_GuiOutputControls();
 
     /**
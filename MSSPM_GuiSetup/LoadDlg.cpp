@@ -6,9 +6,9 @@
 #include "nmfConstants.h"
 
 LoadDlg::LoadDlg(const QString &title,
-                 QWidget*     parent,
-                 nmfLogger*   theLogger,
-                 nmfDatabase* theDatabasePtr,
+                 QWidget*           parent,
+                 nmfLogger*         theLogger,
+                 nmfTracedDatabase* theDatabasePtr,
                  const QString &currentConfig)
     : QDialog(parent)
 {
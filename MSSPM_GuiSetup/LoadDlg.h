@@ -18,18 +18,18 @@ class LoadDlg : public QDialog
     Q_OBJECT
 
 private:
-    int               m_NumberOfRuns;
-    int               m_RunLength;
-    int               m_TimeStep;
-    nmfLogger*        m_logger;
-    nmfDatabase*      m_databasePtr;
-    QDialogButtonBox* m_buttonBox;
-    QListWidget*      m_SettingsLW;
-    std::string       m_GrowthForm;
-    std::string       m_HarvestForm;
-    std::string       m_CompetitionForm;
-    std::string       m_PredationForm;
-    SystemData        m_data;
+    int                m_NumberOfRuns;
+    int                m_RunLength;
+    int                m_TimeStep;
+    nmfLogger*         m_logger;
+    nmfTracedDatabase* m_databasePtr;
+    QDialogButtonBox*  m_buttonBox;
+    QListWidget*       m_SettingsLW;
+    std::string        m_GrowthForm;
+    std::string        m_HarvestForm;
+    std::string        m_CompetitionForm;
+    std::string        m_PredationForm;
+    SystemData         m_data;
     std::vector<std::string> m_SettingNames;
 
     void reloadSystemsList();
@@ -40,7 +40,7 @@ public:
     LoadDlg(const QString &title,
                   QWidget *parent,
                   nmfLogger* m_logger,
-                  nmfDatabase* m_databasePtr,
+                  nmfTracedDatabase* m_databasePtr,
             const QString &currentConfig);
    ~LoadDlg() {}
 
@@ -6,8 +6,8 @@
 
 
 nmfSetup_Tab2::nmfSetup_Tab2(QTabWidget* tabs,
-                           nmfLogger*    logger,
-                           nmfDatabase*  databasePtr)
+                           nmfLogger*         logger,
+                           nmfTracedDatabase* databasePtr)
 {
     QUiLoader loader;
 
@@ -43,7 +43,7 @@ class nmfSetup_Tab2: public QObject
 {
     Q_OBJECT
 
-    nmfDatabase*          m_DatabasePtr;
+    nmfTracedDatabase*    m_DatabasePtr;
     QString               m_LastProjectDatabase;
     nmfLogger*            m_Logger;
     bool                  m_NewProject;
@@ -114,8 +114,8 @@ public:
      * @param databasePtr : pointer to the application database
      */
     nmfSetup_Tab2(QTabWidget*  tabWidget,
-                  nmfLogger*   logger,
-                  nmfDatabase* databasePtr);
+                  nmfLogger*         logger,
+                  nmfTracedDatabase* databasePtr);
     virtual ~nmfSetup_Tab2();
 
     /**
@@ -8,9 +8,9 @@
 #include <QCheckBox>
 
 nmfSetup_Tab3::nmfSetup_Tab3(QTabWidget*  tabs,
-                             nmfLogger*   logger,
-                             nmfDatabase* databasePtr,
-                             std::string& projectDir)
+                             nmfLogger*         logger,
+                             nmfTracedDatabase* databasePtr,
+                             std::string&       projectDir)
 {
     QUiLoader loader;
 
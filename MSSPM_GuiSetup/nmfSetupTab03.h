@@ -46,7 +46,7 @@ class nmfSetup_Tab3: public QObject
     Q_OBJECT
 
     nmfLogger*          m_logger;
-    nmfDatabase*        m_databasePtr;
+    nmfTracedDatabase*  m_databasePtr;
     std::string         m_ProjectDir;
     std::string         m_ProjectSettingsConfig;
     QStandardItemModel* m_smodelSpecies;
@@ -119,9 +119,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfSetup_Tab3(QTabWidget*  tabs,
-                  nmfLogger*   logger,
-                  nmfDatabase* databasePtr,
-                  std::string& projectDir);
+                  nmfLogger*         logger,
+                  nmfTracedDatabase* databasePtr,
+                  std::string&       projectDir);
     virtual ~nmfSetup_Tab3();
 
     /**
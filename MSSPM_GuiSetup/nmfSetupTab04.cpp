@@ -6,9 +6,9 @@
 
 
 nmfSetup_Tab4::nmfSetup_Tab4(QTabWidget*  tabs,
-                             nmfLogger*   logger,
-                             nmfDatabase* databasePtr,
-                             std::string& projectDir)
+                             nmfLogger*         logger,
+                             nmfTracedDatabase* databasePtr,
+                             std::string&       projectDir)
 {
     QUiLoader loader;
 
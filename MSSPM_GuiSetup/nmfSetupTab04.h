@@ -47,13 +47,13 @@ class nmfSetup_Tab4: public QObject
 {
     Q_OBJECT
 
-    std::string  m_ProjectDir;
-    std::string  m_ProjectSettingsConfig;
-    nmfLogger*   m_logger;
-    nmfDatabase* m_databasePtr;
-    QDialog      m_loadDlg;
-    QPushButton* m_cancelBtn;
-    QPushButton* m_okBtn;
+    std::string        m_ProjectDir;
+    std::string        m_ProjectSettingsConfig;
+    nmfLogger*         m_logger;
+    nmfTracedDatabase* m_databasePtr;
+    QDialog            m_loadDlg;
+    QPushButton*       m_cancelBtn;
+    QPushButton*       m_okBtn;
     std::vector<std::string> m_ModelPresetNames;
     std::map<std::string,std::vector<std::string> > m_ModelPresets;
     LoadDlg*     m_LoadDialog;
@@ -118,9 +118,9 @@ public:
      * @param projectDir : the project directory
      */
     nmfSetup_Tab4(QTabWidget*  tabs,
-                  nmfLogger*   logger,
-                  nmfDatabase* databasePtr,
-                  std::string& projectDir);
+                  nmfLogger*         logger,
+                  nmfTracedDatabase* databasePtr,
+                  std::string&       projectDir);
     virtual ~nmfSetup_Tab4();
 
     /**
@@ -3,7 +3,7 @@
 #include <QTableWidget>
 
 ClearOutputDialog::ClearOutputDialog(QWidget*     parent,
-                                     nmfDatabase* databasePtr) :
+                                     nmfTracedDatabase* databasePtr) :
     QDialog(parent)
 {
     m_databasePtr         = databasePtr;
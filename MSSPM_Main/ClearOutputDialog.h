@@ -30,7 +30,7 @@
 
 #pragma once
 
-#include "nmfDatabase.h"
+#include "nmfTracedDatabase.h"
 
 #include <QTableWidget>
 #include <QComboBox>
@@ -47,7 +47,7 @@ class ClearOutputDialog : public QDialog
 {
     Q_OBJECT
 
-    nmfDatabase* m_databasePtr;
+    nmfTracedDatabase* m_databasePtr;
 
     QVBoxLayout* MainLAYT;
     QHBoxLayout* BtnLAYT;
@@ -71,7 +71,7 @@ public:
      * @param databasePtr : the pointer to the application database
      */
     ClearOutputDialog(QWidget*     parent,
-                      nmfDatabase* databasePtr);
+                      nmfTracedDatabase* databasePtr);
     virtual ~ClearOutputDialog() {}
 
     std::string getAlgorithm();
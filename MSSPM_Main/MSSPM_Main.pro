@@ -30,6 +30,15 @@ QMAKE_CXXFLAGS += -std=c++0x
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Build the Chrome trace timers of nmfTrace.h with: qmake CONFIG+=trace
+CONFIG(trace): DEFINES += MSSPM_TRACE
+
+# Build the projection kernel's matrix-vector products with Eigen with: qmake CONFIG+=eigen
+CONFIG(eigen) {
+    DEFINES += MSSPM_EIGEN
+    INCLUDEPATH += /usr/include/eigen3
+}
+
 CONFIG += c++14
 
 LIBS += -lboost_system -lboost_filesystem
@@ -38,13 +47,24 @@ SOURCES += \
     main.cpp \
     nmfMainWindow.cpp \
     ClearOutputDialog.cpp \
-    PreferencesDialog.cpp
+    PreferencesDialog.cpp \
+    nmfEstimationCache.cpp \
+    nmfEstimationEngine.cpp \
+    nmfForecastEngine.cpp \
+    nmfRetrospectiveEngine.cpp \
+    nmfSystemLoader.cpp
 
 HEADERS  += \
     mainpage.h \
     nmfMainWindow.h \
     ClearOutputDialog.h \
-    PreferencesDialog.h
+    PreferencesDialog.h \
+    nmfEstimationCache.h \
+    nmfEstimationEngine.h \
+    nmfForecastEngine.h \
+    nmfRetrospectiveEngine.h \
+    nmfSystemLoader.h \
+    nmfRandomStream.h
 
 FORMS += \
     nmfMainWindow.ui
@@ -168,3 +188,6 @@ else:unix: LIBS += -L$$PWD/../../build-MSSPM_GuiManagerMode-Qt_5_12_3_gcc64-Rele
 
 INCLUDEPATH += $$PWD/../MSSPM_GuiManagerMode
 DEPENDPATH += $$PWD/../MSSPM_GuiManagerMode
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
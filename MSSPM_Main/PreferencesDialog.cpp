@@ -4,7 +4,7 @@
 #include <QTableWidget>
 
 PreferencesDialog::PreferencesDialog(QWidget *parent,
-                                     nmfDatabase* databasePtr) :
+                                     nmfTracedDatabase* databasePtr) :
     QDialog(parent)
 {
     m_databasePtr = databasePtr;
@@ -30,7 +30,7 @@
 
 #pragma once
 
-#include "nmfDatabase.h"
+#include "nmfTracedDatabase.h"
 
 #include <QComboBox>
 #include <QSpinBox>
@@ -47,7 +47,7 @@ class PreferencesDialog : public QDialog
 {
     Q_OBJECT
 
-    nmfDatabase* m_databasePtr;
+    nmfTracedDatabase* m_databasePtr;
 
     QVBoxLayout* MainLT;
     QHBoxLayout* BtnLT;
@@ -76,7 +76,7 @@ public:
      * @param databasePtr : the pointer to the application database
      */
     PreferencesDialog(QWidget*     parent,
-                      nmfDatabase* databasePtr);
+                      nmfTracedDatabase* databasePtr);
     virtual ~PreferencesDialog() {}
 
     void loadWidgets();
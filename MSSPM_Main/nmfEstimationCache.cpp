@@ -0,0 +1,112 @@
+#include "nmfEstimationCache.h"
+
+#include <iomanip>
+#include <sstream>
+
+nmfEstimationCache::nmfEstimationCache(nmfTracedDatabase* databasePtr,
+                                       nmfLogger*   logger)
+{
+    m_DatabasePtr  = databasePtr;
+    m_Logger       = logger;
+    m_IsTableReady = false;
+}
+
+std::string
+nmfEstimationCache::hash(const std::string&         Algorithm,
+                         const Data_Struct&         dataStruct,
+                         const std::vector<double>& InitialParameters)
+{
+    return nmfEstimationHash::hash(Algorithm,dataStruct,InitialParameters);
+}
+
+bool
+nmfEstimationCache::createTable()
+{
+    std::string cmd;
+    std::string errorMsg;
+
+    if (m_IsTableReady) {
+        return true;
+    }
+
+    cmd  = "CREATE TABLE IF NOT EXISTS EstimationCache";
+    cmd += "(Hash          varchar(40) NOT NULL,";
+    cmd += " SystemName    varchar(50) NOT NULL,";
+    cmd += " Algorithm     varchar(50) NOT NULL,";
+    cmd += " Fitness       double NOT NULL,";
+    cmd += " FitnessStdDev double NOT NULL,";
+    cmd += " Parameters    mediumtext NOT NULL,";
+    cmd += " PRIMARY KEY (Hash))";
+    errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
+    if (errorMsg != " ") {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] nmfEstimationCache::createTable: " + errorMsg);
+        return false;
+    }
+    m_IsTableReady = true;
+
+    return true;
+}
+
+bool
+nmfEstimationCache::find(const std::string&       Hash,
+                         nmfEstimationCacheEntry& Entry)
+{
+    std::string queryStr;
+    std::string value;
+    std::vector<std::string> fields = {"Fitness","FitnessStdDev","Parameters"};
+    std::map<std::string, std::vector<std::string> > dataMap;
+
+    if (! createTable()) {
+        return false;
+    }
+
+    queryStr = "SELECT Fitness,FitnessStdDev,Parameters FROM EstimationCache WHERE Hash = '" + Hash + "'";
+    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    if (dataMap["Fitness"].size() != 1) {
+        return false;
+    }
+
+    Entry = nmfEstimationCacheEntry();
+    Entry.Fitness       = std::stod(dataMap["Fitness"][0]);
+    Entry.FitnessStdDev = std::stod(dataMap["FitnessStdDev"][0]);
+    std::istringstream parameters(dataMap["Parameters"][0]);
+    while (std::getline(parameters,value,',')) {
+        Entry.Parameters.push_back(std::stod(value));
+    }
+
+    return ! Entry.Parameters.empty();
+}
+
+bool
+nmfEstimationCache::store(const std::string&             Hash,
+                          const std::string&             SystemName,
+                          const std::string&             Algorithm,
+                          const nmfEstimationCacheEntry& Entry)
+{
+    std::string cmd;
+    std::string errorMsg;
+    std::ostringstream parameters;
+    std::ostringstream values;
+
+    if (! createTable()) {
+        return false;
+    }
+
+    // Full precision so that a cached result is the same result
+    parameters << std::setprecision(17);
+    for (unsigned i=0; i<Entry.Parameters.size(); ++i) {
+        parameters << ((i == 0) ? "" : ",") << Entry.Parameters[i];
+    }
+    values << std::setprecision(17) << Entry.Fitness << "," << Entry.FitnessStdDev;
+
+    cmd  = "REPLACE INTO EstimationCache (Hash,SystemName,Algorithm,Fitness,FitnessStdDev,Parameters) VALUES ";
+    cmd += "('" + Hash + "','" + SystemName + "','" + Algorithm + "'," + values.str() + ",'" + parameters.str() + "')";
+    errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
+    if (errorMsg != " ") {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] nmfEstimationCache::store: " + errorMsg);
+        m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file nmfEstimationCache.h
+ * @brief Definition of the content addressed cache of estimation results
+ *
+ * Every estimation is keyed by a hash of everything that determines its result (the
+ * model forms, the algorithm and its settings, the parameter ranges and the observed
+ * time series). Completed estimations are saved in the EstimationCache table so that
+ * running an identical estimation again reuses the saved result instead of repeating
+ * the work.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfTracedDatabase.h"
+#include "nmfEstimationHash.h"
+#include "nmfLogger.h"
+#include "nmfUtils.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief A cached estimation result
+ */
+struct nmfEstimationCacheEntry {
+    double              Fitness       = 0;
+    double              FitnessStdDev = 0;
+    std::vector<double> Parameters; // in the estimator's parameter order
+};
+
+/**
+ * @brief Saves and finds estimation results by the hash of their inputs
+ *
+ * The table is created the first time the cache is used, so existing project
+ * databases don't need to be rebuilt.
+ */
+class nmfEstimationCache
+{
+private:
+    nmfTracedDatabase* m_DatabasePtr;
+    nmfLogger*         m_Logger;
+    bool               m_IsTableReady;
+
+    bool createTable();
+
+public:
+    /**
+     * @brief nmfEstimationCache : class constructor
+     * @param databasePtr : pointer to the project database
+     * @param logger : pointer to the application logger
+     */
+    nmfEstimationCache(nmfTracedDatabase* databasePtr,
+                       nmfLogger*   logger);
+   ~nmfEstimationCache() {}
+
+    /**
+     * @brief Hashes the inputs of an estimation. The estimations have no random seed
+     * setting, so two runs with the same hash are interchangeable realizations.
+     * @param Algorithm : name of the estimation algorithm
+     * @param dataStruct : the data structure describing the model to estimate
+     * @param InitialParameters : the warm start parameters (empty for a cold start)
+     * @return Returns the hash as a hex string
+     */
+    static std::string hash(const std::string&         Algorithm,
+                            const Data_Struct&         dataStruct,
+                            const std::vector<double>& InitialParameters);
+    /**
+     * @brief Finds a cached result
+     * @param Hash : the hash of the estimation's inputs
+     * @param Entry : the cached result
+     * @return Returns false if there's no result cached for the hash
+     */
+    bool find(const std::string&       Hash,
+              nmfEstimationCacheEntry& Entry);
+    /**
+     * @brief Saves a result in the cache, replacing any result with the same hash
+     * @param Hash : the hash of the estimation's inputs
+     * @param SystemName : name of the System that was estimated (for reference only)
+     * @param Algorithm : name of the estimation algorithm (for reference only)
+     * @param Entry : the result to save
+     * @return Returns false if the result couldn't be saved
+     */
+    bool store(const std::string&             Hash,
+               const std::string&             SystemName,
+               const std::string&             Algorithm,
+               const nmfEstimationCacheEntry& Entry);
+};
@@ -0,0 +1,341 @@
+#include "nmfEstimationEngine.h"
+
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// nmfEstimationResult and nmfProjectionParameters name their parameters alike
+template<class ParametersType>
+void packParametersT(const Data_Struct&    dataStruct,
+                     const ParametersType& Estimated,
+                     std::vector<double>&  Parameters)
+{
+    bool isLogistic     = (dataStruct.GrowthForm      == "Logistic");
+    bool isCatchability = (dataStruct.HarvestForm     == "Effort (qE)");
+    bool isAlpha        = (dataStruct.CompetitionForm == "NO_K");
+    bool isMSPROD       = (dataStruct.CompetitionForm == "MS-PROD");
+    bool isAGGPROD      = (dataStruct.CompetitionForm == "AGG-PROD");
+    bool isRho          = (dataStruct.PredationForm   == "Type I") ||
+                          (dataStruct.PredationForm   == "Type II") ||
+                          (dataStruct.PredationForm   == "Type III");
+    bool isHandling     = (dataStruct.PredationForm   == "Type II") ||
+                          (dataStruct.PredationForm   == "Type III");
+    bool isExponent     = (dataStruct.PredationForm   == "Type III");
+    auto packMatrix = [&Parameters](const boost::numeric::ublas::matrix<double>& matrix) {
+        for (unsigned i=0; i<matrix.size1(); ++i) {
+            for (unsigned j=0; j<matrix.size2(); ++j) {
+                Parameters.push_back(matrix(i,j));
+            }
+        }
+    };
+
+    Parameters = Estimated.GrowthRate;
+    if (isLogistic) {
+        Parameters.insert(Parameters.end(),Estimated.CarryingCapacity.begin(),Estimated.CarryingCapacity.end());
+    }
+    if (isCatchability) {
+        Parameters.insert(Parameters.end(),Estimated.Catchability.begin(),Estimated.Catchability.end());
+    }
+    if (isAlpha) {
+        packMatrix(Estimated.CompetitionAlpha);
+    }
+    if (isMSPROD) {
+        packMatrix(Estimated.CompetitionBetaSpecies);
+    }
+    if (isMSPROD || isAGGPROD) {
+        packMatrix(Estimated.CompetitionBetaGuilds);
+    }
+    if (isRho) {
+        packMatrix(Estimated.Predation);
+    }
+    if (isHandling) {
+        packMatrix(Estimated.Handling);
+    }
+    if (isExponent) {
+        Parameters.insert(Parameters.end(),Estimated.Exponent.begin(),Estimated.Exponent.end());
+    }
+}
+
+}
+
+nmfEstimationEngine::nmfEstimationEngine(const std::string& algorithm)
+{
+    m_Algorithm     = algorithm;
+    m_MaxNumThreads = 0;
+    m_IsResume      = false;
+    m_CachedFitness       = 0;
+    m_CachedFitnessStdDev = 0;
+    m_ErrorMsg.clear();
+}
+
+std::string
+nmfEstimationEngine::getErrorMessage()
+{
+    return m_ErrorMsg;
+}
+
+void
+nmfEstimationEngine::setCancellationToken(const nmfCancellationToken& CancelToken)
+{
+    m_CancelToken = CancelToken;
+}
+
+void
+nmfEstimationEngine::setMaxNumThreads(const int& MaxNumThreads)
+{
+    m_MaxNumThreads = MaxNumThreads;
+}
+
+void
+nmfEstimationEngine::setInitialParameters(const std::vector<double>& InitialParameters)
+{
+    m_InitialParameters = InitialParameters;
+}
+
+void
+nmfEstimationEngine::setCheckpoint(const std::string& CheckpointFile,
+                                   const bool&        Resume)
+{
+    m_CheckpointFile = CheckpointFile;
+    m_IsResume       = Resume;
+}
+
+void
+nmfEstimationEngine::setCachedResult(const std::vector<double>& Parameters,
+                                     const double&              Fitness,
+                                     const double&              FitnessStdDev)
+{
+    m_CachedParameters    = Parameters;
+    m_CachedFitness       = Fitness;
+    m_CachedFitnessStdDev = FitnessStdDev;
+}
+
+bool
+nmfEstimationEngine::estimate(Data_Struct&         dataStruct,
+                              const int&           RunNum,
+                              nmfEstimationResult& Result)
+{
+    bool ok = false;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    m_ErrorMsg.clear();
+    Result = nmfEstimationResult();
+
+    if (m_Algorithm == "NLopt Algorithm") {
+        ok = estimateNLopt(dataStruct,RunNum,Result);
+    } else if (m_Algorithm == "Bees Algorithm") {
+        ok = estimateBees(dataStruct,RunNum,Result);
+    } else {
+        m_ErrorMsg = "Unknown estimation algorithm: " + m_Algorithm;
+        return false;
+    }
+    Result.ElapsedSeconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now()-startTime).count();
+    if (! ok) {
+        if (m_ErrorMsg.empty()) {
+            m_ErrorMsg = m_CancelToken.isCancelled() ? "Estimation cancelled" :
+                                                       "Estimation didn't complete";
+        }
+        return false;
+    }
+
+    if (! projectBiomass(dataStruct,Result)) {
+        m_ErrorMsg = "No projection for model forms: " +
+                dataStruct.GrowthForm      + ", " + dataStruct.HarvestForm + ", " +
+                dataStruct.CompetitionForm + ", " + dataStruct.PredationForm;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+nmfEstimationEngine::estimateNLopt(Data_Struct&         dataStruct,
+                                   const int&           RunNum,
+                                   nmfEstimationResult& Result)
+{
+    NLopt_Estimator estimator;
+
+    estimator.setMaxNumThreads(m_MaxNumThreads);
+    estimator.setCancellationToken(m_CancelToken);
+    estimator.setInitialParameters(m_InitialParameters);
+    estimator.setCheckpoint(m_CheckpointFile,m_IsResume);
+    estimator.setCachedResult(m_CachedParameters,m_CachedFitness,m_CachedFitnessStdDev);
+    estimator.estimateParameters(dataStruct,RunNum);
+    if (! estimator.getBestFitness(Result.Fitness)) {
+        return false;
+    }
+
+    estimator.getEstGrowthRates(Result.GrowthRate);
+    estimator.getEstCarryingCapacities(Result.CarryingCapacity);
+    estimator.getEstCatchability(Result.Catchability);
+    estimator.getEstExponent(Result.Exponent);
+    estimator.getEstCompetitionAlpha(Result.CompetitionAlpha);
+    estimator.getEstCompetitionBetaSpecies(Result.CompetitionBetaSpecies);
+    estimator.getEstCompetitionBetaGuilds(Result.CompetitionBetaGuilds);
+    estimator.getEstPredation(Result.Predation);
+    estimator.getEstHandling(Result.Handling);
+    estimator.getEstParameters(Result.EstParameters,Result.FitnessStdDev);
+
+    return true;
+}
+
+bool
+nmfEstimationEngine::estimateBees(Data_Struct&         dataStruct,
+                                  const int&           RunNum,
+                                  nmfEstimationResult& Result)
+{
+    Bees_Estimator estimator;
+
+    // The estimator emits its errors from the calling thread once the sub runs have
+    // finished, so a direct connection is enough to keep the message
+    QObject::connect(&estimator, &Bees_Estimator::ErrorFound,
+                     [this](std::string errorMsg) { m_ErrorMsg = errorMsg; });
+
+    estimator.setCancellationToken(m_CancelToken);
+    estimator.setInitialParameters(m_InitialParameters);
+    estimator.setCheckpoint(m_CheckpointFile,m_IsResume);
+    estimator.setCachedResult(m_CachedParameters,m_CachedFitness,m_CachedFitnessStdDev);
+    estimator.estimateParameters(dataStruct,RunNum);
+    if (! estimator.getBestFitness(Result.Fitness)) {
+        return false;
+    }
+
+    estimator.getEstimatedGrowthRates(Result.GrowthRate);
+    estimator.getEstimatedCarryingCapacities(Result.CarryingCapacity);
+    estimator.getEstimatedCatchability(Result.Catchability);
+    estimator.getEstimatedExponent(Result.Exponent);
+    estimator.getEstimatedCompetitionAlpha(Result.CompetitionAlpha);
+    estimator.getEstimatedCompetitionBetaSpecies(Result.CompetitionBetaSpecies);
+    estimator.getEstimatedCompetitionBetaGuilds(Result.CompetitionBetaGuilds);
+    estimator.getEstimatedPredation(Result.Predation);
+    estimator.getEstimatedHandling(Result.Handling);
+    estimator.getEstimatedParameters(Result.EstParameters,Result.FitnessStdDev);
+
+    return true;
+}
+
+void
+nmfEstimationEngine::packParameters(const Data_Struct&         dataStruct,
+                                    const nmfEstimationResult& Result,
+                                    std::vector<double>&       Parameters)
+{
+    packParametersT(dataStruct,Result,Parameters);
+}
+
+void
+nmfEstimationEngine::packParameters(const Data_Struct&             dataStruct,
+                                    const nmfProjectionParameters& ProjectionParameters,
+                                    std::vector<double>&           Parameters)
+{
+    packParametersT(dataStruct,ProjectionParameters,Parameters);
+}
+
+bool
+nmfEstimationEngine::loadInitialParameters(nmfSystemLoader&     loader,
+                                           const Data_Struct&   dataStruct,
+                                           const std::string&   Algorithm,
+                                           std::vector<double>& Parameters)
+{
+    std::string isAggProdStr = (dataStruct.CompetitionForm == "AGG-PROD") ? "1" : "0";
+    QStringList SpeciesList;
+    nmfProjectionParameters ProjectionParameters;
+
+    Parameters.clear();
+    if (! loader.loadEstimatedParameters(Algorithm,dataStruct.Minimizer,
+                                         dataStruct.ObjectiveCriterion,dataStruct.Scaling,
+                                         isAggProdStr,dataStruct.HarvestForm,
+                                         dataStruct.CompetitionForm,dataStruct.PredationForm,
+                                         "OutputGrowthRate","OutputCarryingCapacity",
+                                         "OutputCatchability",
+                                         SpeciesList,ProjectionParameters)) {
+        return false;
+    }
+    packParameters(dataStruct,ProjectionParameters,Parameters);
+
+    return true;
+}
+
+bool
+nmfEstimationEngine::projectBiomass(const Data_Struct&   dataStruct,
+                                    nmfEstimationResult& Result)
+{
+    bool isAggProd         = (dataStruct.CompetitionForm == "AGG-PROD");
+    int NumYears           = dataStruct.RunLength+1;
+    int NumGuilds          = dataStruct.NumGuilds;
+    int NumSpeciesOrGuilds = (isAggProd) ? NumGuilds : dataStruct.NumSpecies;
+    const boost::numeric::ublas::matrix<double>& ObservedBiomass = (isAggProd) ?
+                dataStruct.ObservedBiomassByGuilds : dataStruct.ObservedBiomassBySpecies;
+    nmfProjectionSystem     System;
+    nmfProjectionParameters Parameters;
+    nmfProjectionScratch    Scratch;
+    nmfProjectionKernel::Matrix BiomassGuilds(NumYears,NumGuilds);
+    nmfProjectionKernel::ProjectionFunction Project = nmfProjectionKernel::select(
+                dataStruct.GrowthForm,dataStruct.HarvestForm,
+                dataStruct.CompetitionForm,dataStruct.PredationForm,true);
+
+    if (Project == nullptr) {
+        return false;
+    }
+
+    nmfProjectionKernel::initializeSystem(NumYears,NumSpeciesOrGuilds,NumGuilds,isAggProd,
+                                          dataStruct.GuildSpecies,dataStruct.Catch,
+                                          dataStruct.Effort,dataStruct.Exploitation,
+                                          System);
+    Parameters.GrowthRate             = Result.GrowthRate;
+    Parameters.CarryingCapacity       = Result.CarryingCapacity;
+    Parameters.Catchability           = Result.Catchability;
+    Parameters.Exponent               = Result.Exponent;
+    Parameters.CompetitionAlpha       = Result.CompetitionAlpha;
+    Parameters.CompetitionBetaSpecies = Result.CompetitionBetaSpecies;
+    Parameters.CompetitionBetaGuilds  = Result.CompetitionBetaGuilds;
+    Parameters.Predation              = Result.Predation;
+    Parameters.Handling               = Result.Handling;
+    nmfProjectionKernel::initializeInteractions(Parameters,System);
+
+    nmfUtils::initialize(Result.EstimatedBiomass,NumYears,NumSpeciesOrGuilds);
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        Result.EstimatedBiomass(0,i) = ObservedBiomass(0,i);
+    }
+    BiomassGuilds.clear();
+    Project(System,Parameters,Scratch,Result.EstimatedBiomass,BiomassGuilds);
+
+    return true;
+}
+
+void
+nmfEstimationEngine::peel(const Data_Struct& dataStruct,
+                          const int&         NumYearsPeeled,
+                          Data_Struct&       peeledDataStruct)
+{
+    slice(dataStruct,0,std::max(0,dataStruct.RunLength-NumYearsPeeled),peeledDataStruct);
+}
+
+bool
+nmfEstimationEngine::slice(const Data_Struct& dataStruct,
+                           const int&         FirstYear,
+                           const int&         RunLength,
+                           Data_Struct&       slicedDataStruct)
+{
+    if ((FirstYear < 0) || (RunLength < 0) || (FirstYear+RunLength > dataStruct.RunLength)) {
+        return false;
+    }
+
+    // Only the time series depend on the years, everything else is copied as is
+    slicedDataStruct = dataStruct;
+    slicedDataStruct.RunLength = RunLength;
+    for (boost::numeric::ublas::matrix<double>* timeSeries :
+         {&slicedDataStruct.ObservedBiomassBySpecies, &slicedDataStruct.ObservedBiomassByGuilds,
+          &slicedDataStruct.Catch, &slicedDataStruct.Effort, &slicedDataStruct.Exploitation}) {
+        if (int(timeSeries->size1()) >= FirstYear+RunLength+1) {
+            *timeSeries = boost::numeric::ublas::subrange(*timeSeries,
+                                                          FirstYear,FirstYear+RunLength+1,
+                                                          0,timeSeries->size2());
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file nmfEstimationEngine.h
+ * @brief Definition of the synchronous parameter estimation engine
+ *
+ * This file contains the definition of the estimation engine. The engine runs one of
+ * the estimation algorithms on an already loaded data structure, waits for it to
+ * finish, and returns the estimated parameters and the biomass they project, so that
+ * estimations can be run without the GUI (e.g., from the command line runner).
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "Bees_Estimator.h"
+#include "NLopt_Estimator.h"
+#include "nmfCancellationToken.h"
+#include "nmfProjectionKernel.h"
+#include "nmfSystemLoader.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief The results of one estimation
+ */
+struct nmfEstimationResult {
+    double                                Fitness        = 0;
+    double                                ElapsedSeconds = 0;
+    double                                FitnessStdDev  = 0;
+    std::vector<double>                   EstParameters; // in the estimators' parameter order
+    std::vector<double>                   GrowthRate;
+    std::vector<double>                   CarryingCapacity;
+    std::vector<double>                   Catchability;
+    std::vector<double>                   Exponent;
+    boost::numeric::ublas::matrix<double> CompetitionAlpha;
+    boost::numeric::ublas::matrix<double> CompetitionBetaSpecies;
+    boost::numeric::ublas::matrix<double> CompetitionBetaGuilds;
+    boost::numeric::ublas::matrix<double> Predation;
+    boost::numeric::ublas::matrix<double> Handling;
+    boost::numeric::ublas::matrix<double> EstimatedBiomass; // (RunLength+1) x NumSpeciesOrGuilds
+};
+
+/**
+ * @brief Runs an estimation algorithm to completion on the calling thread
+ *
+ * The NLopt estimator already runs its starts concurrently on its own thread pool
+ * (the Bees sub runs are run one at a time), so the engine only needs to wait for
+ * the estimator and collect the results.
+ */
+class nmfEstimationEngine
+{
+private:
+    std::string          m_Algorithm;
+    int                  m_MaxNumThreads;
+    nmfCancellationToken m_CancelToken;
+    std::string          m_ErrorMsg;
+    std::vector<double>  m_InitialParameters;
+    std::string          m_CheckpointFile;
+    bool                 m_IsResume;
+    std::vector<double>  m_CachedParameters;
+    double               m_CachedFitness;
+    double               m_CachedFitnessStdDev;
+
+    bool estimateBees(Data_Struct&         dataStruct,
+                      const int&           RunNum,
+                      nmfEstimationResult& Result);
+    bool estimateNLopt(Data_Struct&         dataStruct,
+                       const int&           RunNum,
+                       nmfEstimationResult& Result);
+
+public:
+    /**
+     * @brief nmfEstimationEngine : class constructor
+     * @param algorithm : name of the estimation algorithm ("NLopt Algorithm" or "Bees Algorithm")
+     */
+    nmfEstimationEngine(const std::string& algorithm);
+   ~nmfEstimationEngine() {}
+
+    /**
+     * @brief Gets the message describing why the last estimation failed
+     * @return Returns the message (empty if the last estimation completed)
+     */
+    std::string getErrorMessage();
+    /**
+     * @brief Sets the token that cancels the estimation
+     * @param CancelToken : the cancellation token shared with the caller
+     */
+    void setCancellationToken(const nmfCancellationToken& CancelToken);
+    /**
+     * @brief Sets the maximum number of threads the estimator may use (only the
+     * NLopt estimator runs concurrently)
+     * @param MaxNumThreads : the maximum number of threads (0 for the ideal thread count)
+     */
+    void setMaxNumThreads(const int& MaxNumThreads);
+    /**
+     * @brief Warm starts the estimation from previously estimated parameters
+     * @param InitialParameters : the parameters in the estimators' parameter order (empty for a cold start)
+     */
+    void setInitialParameters(const std::vector<double>& InitialParameters);
+    /**
+     * @brief Checkpoints the estimation so that an interrupted run can be resumed
+     * @param CheckpointFile : the checkpoint file (empty to not checkpoint the run)
+     * @param Resume : true to continue from a matching checkpoint
+     */
+    void setCheckpoint(const std::string& CheckpointFile,
+                       const bool&        Resume);
+    /**
+     * @brief Reports the cached result of an identical estimation instead of estimating
+     * @param Parameters : the cached parameters in the estimators' parameter order (empty to estimate)
+     * @param Fitness : the cached best fitness
+     * @param FitnessStdDev : the cached standard deviation of the best fitnesses
+     */
+    void setCachedResult(const std::vector<double>& Parameters,
+                         const double&              Fitness,
+                         const double&              FitnessStdDev);
+    /**
+     * @brief Estimates the parameters and projects the estimated biomass
+     * @param dataStruct : the data structure describing the model to estimate
+     * @param RunNum : the run number (used to label the estimator's progress output)
+     * @param Result : the estimated parameters, fitness, elapsed time and estimated biomass
+     * @return Returns false if the estimation failed or was cancelled
+     */
+    bool estimate(Data_Struct&         dataStruct,
+                  const int&           RunNum,
+                  nmfEstimationResult& Result);
+    /**
+     * @brief Packs estimated parameters into a vector in the estimators' parameter order
+     * (growth, carrying capacity, catchability, alpha, beta species, beta guilds,
+     * predation, handling, exponent), i.e., the inverse of NLopt_Estimator::extractParameters
+     * @param dataStruct : the data structure the parameters were estimated from
+     * @param Result : the estimated parameters
+     * @param Parameters : the packed parameter vector
+     */
+    static void packParameters(const Data_Struct&         dataStruct,
+                               const nmfEstimationResult& Result,
+                               std::vector<double>&       Parameters);
+    /**
+     * @brief Packs projection parameters into a vector in the estimators' parameter order
+     * @param dataStruct : the data structure the parameters were estimated from
+     * @param ProjectionParameters : the estimated parameters
+     * @param Parameters : the packed parameter vector
+     */
+    static void packParameters(const Data_Struct&             dataStruct,
+                               const nmfProjectionParameters& ProjectionParameters,
+                               std::vector<double>&           Parameters);
+    /**
+     * @brief Loads the parameters saved by the last estimation of the data structure's
+     * model as a warm start for the next one
+     * @param loader : the System's loader
+     * @param dataStruct : the data structure describing the model to estimate
+     * @param Algorithm : name of the estimation algorithm
+     * @param Parameters : the packed parameters (empty if none were found)
+     * @return Returns false if no previous estimate with the model's settings was found
+     */
+    static bool loadInitialParameters(nmfSystemLoader&     loader,
+                                      const Data_Struct&   dataStruct,
+                                      const std::string&   Algorithm,
+                                      std::vector<double>& Parameters);
+    /**
+     * @brief Projects the estimated parameters from the first year of observed biomass
+     * @param dataStruct : the data structure the parameters were estimated from
+     * @param Result : the estimated parameters, its EstimatedBiomass is set
+     * @return Returns false if the model forms don't have a projection kernel
+     */
+    static bool projectBiomass(const Data_Struct&   dataStruct,
+                               nmfEstimationResult& Result);
+    /**
+     * @brief Copies a data structure with the last years of its time series removed
+     * (i.e., a retrospective "peel")
+     * @param dataStruct : the data structure to copy
+     * @param NumYearsPeeled : number of years to remove from the end of the time series
+     * @param peeledDataStruct : the copy with RunLength reduced by NumYearsPeeled
+     */
+    static void peel(const Data_Struct& dataStruct,
+                     const int&         NumYearsPeeled,
+                     Data_Struct&       peeledDataStruct);
+    /**
+     * @brief Copies a data structure keeping only a contiguous range of years of its
+     * time series (i.e., a Mohn's Rho range peeled from either end)
+     * @param dataStruct : the data structure to copy
+     * @param FirstYear : first year of the range, relative to the first year of the time series
+     * @param RunLength : number of years in the range's run
+     * @param slicedDataStruct : the copy with the time series starting at FirstYear
+     * @return Returns false if the range isn't within the time series
+     */
+    static bool slice(const Data_Struct& dataStruct,
+                      const int&         FirstYear,
+                      const int&         RunLength,
+                      Data_Struct&       slicedDataStruct);
+};
@@ -0,0 +1,156 @@
+#include "nmfForecastEngine.h"
+
+#include <QtConcurrent>
+#include <numeric>
+
+nmfForecastEngine::nmfForecastEngine(const nmfProjectionInputs&    Inputs,
+                                     const nmfForecastUncertainty& Uncertainty,
+                                     const std::string&            HarvestForm,
+                                     const std::string&            CompetitionForm,
+                                     const std::string&            PredationForm) :
+    m_Inputs(Inputs)
+{
+    m_Uncertainty    = Uncertainty;
+    m_HarvestForm    = HarvestForm;
+    m_isCatchability = (HarvestForm     == "Effort (qE)");
+    m_isAlpha        = (CompetitionForm == "NO_K");
+    m_isBetaSpecies  = (CompetitionForm == "MS-PROD");
+    m_isBetaGuilds   = (CompetitionForm == "AGG-PROD") || (CompetitionForm == "MS-PROD");
+    m_isPredation    = (PredationForm   == "Type I");
+    m_isHandling     = (PredationForm   == "Type II")  || (PredationForm   == "Type III");
+    m_isExponent     = (PredationForm   == "Type III");
+}
+
+void
+nmfForecastEngine::perturbVector(const std::vector<double>&        Uncertainty,
+                                 const uint64_t&                   Seed,
+                                 const int&                        RunNum,
+                                 const nmfRandomStream::Parameter& Parameter,
+                                 std::vector<double>&              Vector)
+{
+    for (unsigned i=0; i<Vector.size(); ++i) {
+        Vector[i] = nmfRandomStream::perturb(Uncertainty[i],Vector[i],Seed,RunNum,Parameter,i,0);
+    }
+}
+
+void
+nmfForecastEngine::perturbMatrix(const std::vector<double>&        Uncertainty,
+                                 const bool&                       byRow,
+                                 const uint64_t&                   Seed,
+                                 const int&                        RunNum,
+                                 const nmfRandomStream::Parameter& Parameter,
+                                 nmfProjectionKernel::Matrix&      Matrix)
+{
+    for (unsigned row=0; row<Matrix.size1(); ++row) {
+        for (unsigned col=0; col<Matrix.size2(); ++col) {
+            Matrix(row,col) = nmfRandomStream::perturb(Uncertainty[(byRow) ? row : col],Matrix(row,col),
+                                                       Seed,RunNum,Parameter,row,col);
+        }
+    }
+}
+
+void
+nmfForecastEngine::perturbRun(const uint64_t& Seed,
+                              const int&      RunNum,
+                              RunInputs&      Run)
+{
+    perturbVector(m_Uncertainty.GrowthRate,      Seed,RunNum,nmfRandomStream::GrowthRate,      Run.Parameters.GrowthRate);
+    perturbVector(m_Uncertainty.CarryingCapacity,Seed,RunNum,nmfRandomStream::CarryingCapacity,Run.Parameters.CarryingCapacity);
+    if (m_isCatchability) {
+        perturbVector(m_Uncertainty.Catchability,Seed,RunNum,nmfRandomStream::Catchability,Run.Parameters.Catchability);
+    }
+    if (m_isExponent) {
+        perturbVector(m_Uncertainty.Exponent,Seed,RunNum,nmfRandomStream::Exponent,Run.Parameters.Exponent);
+    }
+    if (m_isAlpha) {
+        perturbMatrix(m_Uncertainty.Competition,false,Seed,RunNum,nmfRandomStream::CompetitionAlpha,
+                      Run.Parameters.CompetitionAlpha);
+    }
+    if (m_isBetaSpecies) {
+        perturbMatrix(m_Uncertainty.BetaSpecies,false,Seed,RunNum,nmfRandomStream::CompetitionBetaSpecies,
+                      Run.Parameters.CompetitionBetaSpecies);
+    }
+    if (m_isPredation) {
+        perturbMatrix(m_Uncertainty.Predation,false,Seed,RunNum,nmfRandomStream::Predation,
+                      Run.Parameters.Predation);
+    }
+    if (m_isHandling) {
+        perturbMatrix(m_Uncertainty.Handling,false,Seed,RunNum,nmfRandomStream::Handling,
+                      Run.Parameters.Handling);
+    }
+    if (m_isBetaGuilds) {
+        perturbMatrix(m_Uncertainty.BetaGuilds,true,Seed,RunNum,nmfRandomStream::CompetitionBetaGuilds,
+                      Run.Parameters.CompetitionBetaGuilds);
+    }
+
+    // Harvest time series are (year x species), so each species' uncertainty is used down a column
+    for (unsigned i=0; i<Run.Harvest.size2(); ++i) {
+        for (unsigned j=0; j<Run.Harvest.size1(); ++j) {
+            Run.Harvest(j,i) = nmfRandomStream::perturb(m_Uncertainty.Harvest[i],Run.Harvest(j,i),
+                                                        Seed,RunNum,nmfRandomStream::Harvest,i,j);
+        }
+    }
+}
+
+void
+nmfForecastEngine::project(nmfProjectionKernel::Matrix& Biomass)
+{
+    nmfProjectionScratch Scratch;
+    nmfProjectionKernel::Matrix BiomassGuilds(m_Inputs.System.NumYears,m_Inputs.System.NumGuilds);
+
+    Biomass.resize(m_Inputs.System.NumYears,m_Inputs.System.NumSpeciesOrGuilds,false);
+    Biomass.clear();
+    for (int i=0; i<m_Inputs.System.NumSpeciesOrGuilds; ++i) {
+        Biomass(0,i) = m_Inputs.InitialBiomass[i];
+    }
+    BiomassGuilds.clear();
+    m_Inputs.Project(m_Inputs.System,m_Inputs.Parameters,Scratch,Biomass,BiomassGuilds);
+}
+
+bool
+nmfForecastEngine::run(const int&                                NumRuns,
+                       const uint64_t&                           Seed,
+                       std::vector<nmfProjectionKernel::Matrix>& Biomass,
+                       const nmfCancellationToken&               Cancel)
+{
+    std::vector<int> RunNums(NumRuns);
+
+    std::iota(RunNums.begin(),RunNums.end(),0);
+    Biomass.assign(NumRuns,nmfProjectionKernel::Matrix(m_Inputs.System.NumYears,
+                                                       m_Inputs.System.NumSpeciesOrGuilds));
+
+    // Each run perturbs its own copy of the inputs and writes only to its own biomass matrix
+    std::function<void(int&)> projectRun = [&](int& RunNum) {
+        if (Cancel.isCancelled()) {
+            return;
+        }
+        RunInputs Run;
+        nmfProjectionScratch Scratch;
+        nmfProjectionKernel::Matrix BiomassGuilds(m_Inputs.System.NumYears,m_Inputs.System.NumGuilds);
+        nmfProjectionKernel::Matrix& RunBiomass = Biomass[RunNum];
+
+        Run.System     = m_Inputs.System;
+        Run.Parameters = m_Inputs.Parameters;
+        if (m_HarvestForm == "Catch") {
+            Run.Harvest = m_Inputs.Catch;
+            Run.System.Catch = &Run.Harvest;
+        } else if (m_HarvestForm == "Effort (qE)") {
+            Run.Harvest = m_Inputs.Effort;
+            Run.System.Effort = &Run.Harvest;
+        } else if (m_HarvestForm == "Exploitation (F)") {
+            Run.Harvest = m_Inputs.Exploitation;
+            Run.System.Exploitation = &Run.Harvest;
+        }
+        perturbRun(Seed,RunNum,Run);
+
+        RunBiomass.clear();
+        BiomassGuilds.clear();
+        for (int i=0; i<m_Inputs.System.NumSpeciesOrGuilds; ++i) {
+            RunBiomass(0,i) = m_Inputs.InitialBiomass[i];
+        }
+        m_Inputs.Project(Run.System,Run.Parameters,Scratch,RunBiomass,BiomassGuilds);
+    };
+    QtConcurrent::blockingMap(RunNums,projectRun);
+
+    return (! Cancel.isCancelled());
+}
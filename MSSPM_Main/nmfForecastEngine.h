@@ -0,0 +1,134 @@
+/**
+ * @file nmfForecastEngine.h
+ * @brief Definition of the batched Monte Carlo forecast engine
+ *
+ * This file contains the definition of the forecast engine. The engine takes the
+ * forecast inputs, which are loaded once from the database, and perturbs and
+ * projects all of the Monte Carlo runs in parallel.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfCancellationToken.h"
+#include "nmfProjectionKernel.h"
+#include "nmfRandomStream.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per species (or guild) uncertainty factors for a Monte Carlo forecast
+ */
+struct nmfForecastUncertainty {
+    std::vector<double> GrowthRate;
+    std::vector<double> CarryingCapacity;
+    std::vector<double> Predation;
+    std::vector<double> Competition;
+    std::vector<double> BetaSpecies;
+    std::vector<double> BetaGuilds;
+    std::vector<double> Handling;
+    std::vector<double> Exponent;
+    std::vector<double> Catchability;
+    std::vector<double> Harvest;
+};
+
+/**
+ * @brief Batched Monte Carlo forecast engine
+ *
+ * All of the runs share the same (unperturbed) projection inputs. Each run gets its
+ * own copy of the parameters and of the harvest time series, which are perturbed with
+ * random values keyed by (seed, run, parameter, species, index). The runs are then
+ * projected on the global thread pool, and the results don't depend on which thread
+ * ran which run.
+ */
+class nmfForecastEngine
+{
+private:
+    const nmfProjectionInputs& m_Inputs;
+    nmfForecastUncertainty     m_Uncertainty;
+    std::string                m_HarvestForm;
+    bool                       m_isCatchability;
+    bool                       m_isExponent;
+    bool                       m_isAlpha;
+    bool                       m_isBetaSpecies;
+    bool                       m_isBetaGuilds;
+    bool                       m_isPredation;
+    bool                       m_isHandling;
+
+    struct RunInputs {
+        nmfProjectionSystem         System;
+        nmfProjectionParameters     Parameters;
+        nmfProjectionKernel::Matrix Harvest;
+    };
+
+    void perturbMatrix(const std::vector<double>&        Uncertainty,
+                       const bool&                       byRow,
+                       const uint64_t&                   Seed,
+                       const int&                        RunNum,
+                       const nmfRandomStream::Parameter& Parameter,
+                       nmfProjectionKernel::Matrix&      Matrix);
+    void perturbVector(const std::vector<double>&        Uncertainty,
+                       const uint64_t&                   Seed,
+                       const int&                        RunNum,
+                       const nmfRandomStream::Parameter& Parameter,
+                       std::vector<double>&              Vector);
+    void perturbRun(const uint64_t& Seed,
+                    const int&      RunNum,
+                    RunInputs&      Run);
+
+public:
+    /**
+     * @brief nmfForecastEngine : class constructor
+     * @param Inputs : the unperturbed projection inputs (must outlive the engine)
+     * @param Uncertainty : the uncertainty factors for each species (or guild)
+     * @param HarvestForm : name of harvest form
+     * @param CompetitionForm : name of competition form
+     * @param PredationForm : name of predation form
+     */
+    nmfForecastEngine(const nmfProjectionInputs&    Inputs,
+                      const nmfForecastUncertainty& Uncertainty,
+                      const std::string&            HarvestForm,
+                      const std::string&            CompetitionForm,
+                      const std::string&            PredationForm);
+   ~nmfForecastEngine() {}
+
+    /**
+     * @brief Projects the unperturbed inputs
+     * @param Biomass : the projected biomass (NumYears x NumSpeciesOrGuilds)
+     */
+    void project(nmfProjectionKernel::Matrix& Biomass);
+    /**
+     * @brief Perturbs and projects all of the runs in parallel
+     * @param NumRuns : number of Monte Carlo runs
+     * @param Seed : forecast seed, the same seed always gives the same runs
+     * @param Biomass : the projected biomass for each run
+     * @param Cancel : token that stops the runs which haven't started yet once cancelled
+     * @return Returns false if the runs were cancelled before they all completed
+     */
+    bool run(const int&                                NumRuns,
+             const uint64_t&                           Seed,
+             std::vector<nmfProjectionKernel::Matrix>& Biomass,
+             const nmfCancellationToken&               Cancel = nmfCancellationToken());
+};
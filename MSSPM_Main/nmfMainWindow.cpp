@@ -7,11 +7,15 @@
 #include "nmfConstants.h"
 #include "nmfConstantsMSSPM.h"
 
+#include <QEventLoop>
 #include <QLineSeries>
 #include <QProcess>
+#include <QProgressDialog>
 #include <QtConcurrent>
 #include <QWhatsThis>
 
+#include <sstream>
+
 // This is needed since a signal is passing a std::string type
 Q_DECLARE_METATYPE (std::string)
 
@@ -23,9 +27,12 @@ nmfMainWindow::nmfMainWindow(QWidget *parent) :
     m_UI->setupUi(this);
 
     m_Estimator_Bees   = nullptr;
+    m_Estimator_NLopt  = nullptr;
 //  gradient_Estimator = nullptr;
     m_RunOutputMsg.clear();
-    m_NumMohnsRhoRanges = 0;
+    m_PruneSlackFactor = 0;
+    m_isResumeRun = false;
+    m_isCacheHit  = false;
     m_SeedValue = -1;
     m_ScreenshotOn = false;
     m_NumScreenShot = 0;
@@ -33,6 +40,7 @@ nmfMainWindow::nmfMainWindow(QWidget *parent) :
     m_MShotNumRows = 4;
     m_MShotNumCols = 3;
     m_isStartUpOK = true;
+    m_PreviewStartYear = 0;
 
     m_ProjectDir.clear();
     m_ProjectDatabase.clear();
@@ -44,6 +52,7 @@ nmfMainWindow::nmfMainWindow(QWidget *parent) :
 //  m_Session.clear();
     m_RunNumBees        = 1;
     m_RunNumNLopt       = 1;
+    m_ProgressChannel   = nullptr;
 //  RunNumGenetic       = 1;
 //  RunNumGradient      = 1;
     Setup_Tab3_ptr      = nullptr;
@@ -100,7 +109,7 @@ nmfMainWindow::nmfMainWindow(QWidget *parent) :
     // the program can't find the libmysql.dll driver.  Not sure why, but moving
     // the following logic from nmfDatabase.dll to here fixes the issue.
     QSqlDatabase db = QSqlDatabase::addDatabase("QMYSQL");
-    m_DatabasePtr = new nmfDatabase();
+    m_DatabasePtr = new nmfTracedDatabase();
     m_DatabasePtr->nmfSetConnectionByName(db.connectionName());
 
     readSettingsGuiPositionOrientationOnly();
@@ -492,17 +501,7 @@ nmfMainWindow::getModelFormData(std::string& GrowthForm,
 void
 nmfMainWindow::getSpeciesGuildMap(std::map<std::string,std::string>& SpeciesGuildMap)
 {
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-
-    fields   = {"SpeName","GuildName"};
-    queryStr = "SELECT SpeName,GuildName FROM Species ORDER BY SpeName";
-    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-
-    for (unsigned i=0; i<dataMap["SpeName"].size(); ++i) {
-        SpeciesGuildMap[dataMap["SpeName"][i]] = dataMap["GuildName"][i];
-    }
+    getSystemLoader().getSpeciesGuildMap(SpeciesGuildMap);
 }
 
 bool
@@ -513,76 +512,7 @@ nmfMainWindow::getTimeSeriesDataByGuild(
         const int &RunLength,
         boost::numeric::ublas::matrix<double> &TableData)
 {
-    int m=0;
-    int NumRecords;
-    int NumSpecies;
-    int NumGuilds2;
-    int GuildNum;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    std::string errorMsg;
-    std::string ModifiedTableName = "";
-    std::string GuildName;
-    std::string SpeciesName;
-    QStringList SpeciesList;
-    QStringList GuildList;
-    std::map<std::string,std::string> SpeciesToGuildMap;
-    std::map<std::string,int> GuildNameToNumMap;
-
-    nmfUtils::initialize(TableData,RunLength+1,NumGuilds); // +1 because there's a 0 year
-
-    if (! getGuilds(NumGuilds2,GuildList)) {
-        return false;
-    }
-
-    // Get Species names
-    if (! getSpecies(NumSpecies,SpeciesList))
-        return false;
-
-    // Load data
-    if (ForecastName == "") {
-        ModifiedTableName = TableName;;
-        fields   = {"SystemName","SpeName","Year","Value"};
-        queryStr = "SELECT SystemName,SpeName,Year,Value FROM " + ModifiedTableName +
-                   " WHERE SystemName = '" + m_ProjectSettingsConfig + "' ORDER BY SpeName,Year";
-    } else {
-        ModifiedTableName = "Forecast" + TableName;
-        fields   = {"ForecastName","SpeName","Year","Value"};
-        queryStr = "SELECT ForecastName,SpeName,Year,Value FROM " + ModifiedTableName +
-                   " WHERE ForecastName = '" + ForecastName + "' ORDER BY SpeName,Year";
-    }
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["SpeName"].size();
-    if (NumRecords == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getTimeSeriesDataByGuild: No records found in table "+TableName);
-        return false;
-    }
-    if (NumRecords != NumSpecies*(RunLength+1)) {
-        errorMsg  = "[Error 2] getTimeSeriesDataByGuild: Number of records found (" + std::to_string(NumRecords) + ") in ";
-        errorMsg += "table " + ModifiedTableName + " does not equal number of Species*(RunLength+1) (";
-        errorMsg += std::to_string(NumSpecies) + "*" + std::to_string((RunLength+1)) + "=";
-        errorMsg += std::to_string(NumSpecies*(RunLength+1)) + ") records";
-        errorMsg += "\n" + queryStr;
-        m_Logger->logMsg(nmfConstants::Error,errorMsg);
-    }
-
-    m = 0;
-    int num=0;
-    for (QString guildName : GuildList) {
-        GuildNameToNumMap[guildName.toStdString()] = num++;
-    }
-    getSpeciesGuildMap(SpeciesToGuildMap);
-    for (int i=0; i<NumSpecies; ++i) {
-        SpeciesName = dataMap["SpeName"][m];
-        GuildName   = SpeciesToGuildMap[SpeciesName];
-        GuildNum    = GuildNameToNumMap[GuildName];
-        for (int time=0; time<=RunLength; ++time) {
-            TableData(time,GuildNum) += std::stod(dataMap["Value"][m++]);
-        }
-    }
-
-    return true;
+    return getSystemLoader().getTimeSeriesDataByGuild(ForecastName,TableName,NumGuilds,RunLength,TableData);
 }
 
 
@@ -595,63 +525,13 @@ nmfMainWindow::getTimeSeriesData(
         const int&         RunLength,
         boost::numeric::ublas::matrix<double>& TableData)
 {
-    int m=0;
-    int NumRecords;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    std::string errorMsg;
-    std::string ModifiedTableName = "";
-    QString msg;
-    QString SystemName = QString::fromStdString(m_ProjectSettingsConfig);
+    nmfSystemLoader loader = getSystemLoader();
 
-    auto parts = SystemName.split("__");
-    SystemName = parts[0];
-
-    nmfUtils::initialize(TableData,RunLength+1,NumSpecies); // +1 because there's a 0 year
-
-    // Load data
-    if (ForecastName == "") {
-        ModifiedTableName = TableName;;
-        fields   = {"MohnsRhoLabel","SystemName","SpeName","Year","Value"};
-        queryStr = "SELECT MohnsRhoLabel,SystemName,SpeName,Year,Value FROM " + ModifiedTableName +
-                   " WHERE SystemName = '" + SystemName.toStdString() +
-                   "' AND MohnsRhoLabel = '" + MohnsRhoLabel + "' ORDER BY SpeName,Year";
-    } else {
-        ModifiedTableName = "Forecast" + TableName;;
-        fields   = {"ForecastName","SpeName","Year","Value"};
-        queryStr = "SELECT ForecastName,SpeName,Year,Value FROM " + ModifiedTableName +
-                   " WHERE ForecastName = '" + ForecastName +
-                   "' ORDER BY SpeName,Year";
-    }
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["SpeName"].size();
-    if (NumRecords == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getTimeSeriesData: No records found in table "+TableName);
-        m_Logger->logMsg(nmfConstants::Error,queryStr);
-        msg = "\nMissing or unsaved data. Please populate and resave table: " + QString::fromStdString(TableName);
-        QMessageBox::critical(this, "Error", msg, QMessageBox::Ok);
-        return false;
-    }
-    if (NumRecords != NumSpecies*(RunLength+1)) {
-        errorMsg  = "[Error 2] getTimeSeriesData: Number of records found (" + std::to_string(NumRecords) + ") in ";
-        errorMsg += "table " + ModifiedTableName + " does not equal number of Species*(RunLength+1) (";
-        errorMsg += std::to_string(NumSpecies) + "*" + std::to_string((RunLength+1)) + "=";
-        errorMsg += std::to_string(NumSpecies*(RunLength+1)) + ") records";
-        errorMsg += "\n" + queryStr;
-        m_Logger->logMsg(nmfConstants::Error,errorMsg);
-        msg = "\nMissing or unsaved data.\n\nPlease populate and resave table: " + QString::fromStdString(ModifiedTableName) + "\n";
-        QMessageBox::critical(this, "Error", msg, QMessageBox::Ok);
+    if (! loader.getTimeSeriesData(MohnsRhoLabel,ForecastName,TableName,NumSpecies,RunLength,TableData)) {
+        showSystemLoaderError(loader);
         return false;
     }
 
-    // Figure out what to do here with the hardcoded 0 for time=0.....RSK
-    for (int species=0; species<NumSpecies; ++species) {
-        for (int time=0; time<=RunLength; ++time) {
-            TableData(time,species) = std::stod(dataMap["Value"][m++]);
-        }
-    }
-
     return true;
 }
 
@@ -700,39 +580,12 @@ nmfMainWindow::getInitialSpeciesData(int &NumSpecies,
 bool
 nmfMainWindow::getFinalObservedBiomass(QList<double> &FinalBiomass)
 {
-    int NumRecords;
-    int NumSpecies;
-    int RunLength;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    QStringList SpeciesList;
-    boost::numeric::ublas::matrix<double> ObservedBiomass;
-
-    // Get RunLength
-    fields     = {"SystemName","RunLength"};
-    queryStr   = "SELECT SystemName,RunLength from Systems where ";
-    queryStr  += "SystemName = '" +  m_ProjectSettingsConfig + "'";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["SystemName"].size();
-    if (NumRecords == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getFinalObservedBiomass: No records found.");
-        m_Logger->logMsg(nmfConstants::Error,queryStr);
-        return false;
-    }
-    RunLength = std::stoi(dataMap["RunLength"][0]);
-
-    // Get NumSpecies
-    if (! getSpecies(NumSpecies,SpeciesList))
-        return false;
+    nmfSystemLoader loader = getSystemLoader();
 
-    // Get final observed biomass values
-    if (! getTimeSeriesData("","","ObservedBiomass",NumSpecies,RunLength,ObservedBiomass)) {
+    if (! loader.getFinalObservedBiomass(FinalBiomass)) {
+        showSystemLoaderError(loader);
         return false;
     }
-    for (int species=0; species<NumSpecies; ++species) {
-        FinalBiomass.push_back(ObservedBiomass(RunLength,species));
-    }
 
     return true;
 }
@@ -740,25 +593,7 @@ nmfMainWindow::getFinalObservedBiomass(QList<double> &FinalBiomass)
 bool
 nmfMainWindow::getInitialObservedBiomass(QList<double> &InitBiomass)
 {
-
-    int NumSpecies;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-
-    fields     = {"SpeName","InitBiomass"};
-    queryStr   = "SELECT SpeName,InitBiomass from Species ORDER BY SpeName";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumSpecies = dataMap["SpeName"].size();
-    if (NumSpecies == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getInitialObservedBiomass: No species found in table Species");
-        return false;
-    }
-    for (int i=0; i<NumSpecies; ++i) {
-        InitBiomass.append(std::stod(dataMap["InitBiomass"][i]));
-    }
-
-    return true;
+    return getSystemLoader().getInitialObservedBiomass(InitBiomass);
 }
 
 bool
@@ -792,51 +627,13 @@ nmfMainWindow::getSpeciesWithGuilds(int&         NumSpecies,
 bool
 nmfMainWindow::getSpecies(int &NumSpecies, QStringList &SpeciesList)
 {
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-
-    SpeciesList.clear();
-
-    fields   = {"SpeName"};
-    queryStr = "SELECT SpeName from Species ORDER BY SpeName";
-    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumSpecies = dataMap["SpeName"].size();
-    if (NumSpecies == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getSpecies: No species found in table Species");
-        return false;
-    }
-
-    for (int species=0; species<NumSpecies; ++species) {
-        SpeciesList << QString::fromStdString(dataMap["SpeName"][species]);
-    }
-
-    return true;
+    return getSystemLoader().getSpecies(NumSpecies,SpeciesList);
 }
 
 bool
 nmfMainWindow::getGuilds(int &NumGuilds, QStringList &GuildList)
 {
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-
-    GuildList.clear();
-
-    fields   = {"GuildName"};
-    queryStr = "SELECT GuildName from Guilds ORDER BY GuildName";
-    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumGuilds = dataMap["GuildName"].size();
-    if (NumGuilds == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getSpecies: No guilds found in table Guilds");
-        return false;
-    }
-
-    for (int guild=0; guild<NumGuilds; ++guild) {
-        GuildList << QString::fromStdString(dataMap["GuildName"][guild]);
-    }
-
-    return true;
+    return getSystemLoader().getGuilds(NumGuilds,GuildList);
 }
 
 bool
@@ -852,26 +649,27 @@ nmfMainWindow::getForecastBiomassMonteCarlo(const std::string& ForecastName,
 {
     int m=0;
     int NumRecords;
-    std::vector<std::string> fields;
     std::string queryStr;
     std::string errorMsg;
-    std::map<std::string, std::vector<std::string> > dataMapForecastBiomassMonteCarlo;
+    nmfColumnQuery query;
     boost::numeric::ublas::matrix<double> TmpMatrix;
     QString msg;
 
     ForecastBiomassMonteCarlo.clear();
 
     // Load Forecast Biomass data (ie, calculated from estimated parameters r and alpha)
-    fields    = {"ForecastName","RunNum","Algorithm","Minimizer","ObjectiveCriterion","Scaling","SpeName","Year","Value"};
-    queryStr  = "SELECT ForecastName,RunNum,Algorithm,Minimizer,ObjectiveCriterion,Scaling,SpeName,Year,Value FROM ForecastBiomassMonteCarlo";
+    queryStr  = "SELECT RunNum,SpeName,Year,Value FROM ForecastBiomassMonteCarlo";
     queryStr += " WHERE ForecastName = '" + ForecastName +
                 "' AND Algorithm = '" + Algorithm +
                 "' AND Minimizer = '" + Minimizer +
                 "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
                 "' AND Scaling = '" + Scaling + "'";
     queryStr += " ORDER BY RunNum,SpeName,Year";
-    dataMapForecastBiomassMonteCarlo = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMapForecastBiomassMonteCarlo["SpeName"].size();
+    if (! query.exec(queryStr,{"Value"})) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 3] getForecastBiomassMonteCarlo: " + query.lastError());
+        return false;
+    }
+    NumRecords = query.numRecords();
     if (NumRecords == 0) {
         m_ChartView2d->hide();
         errorMsg  = "[Error 1] getForecastBiomassMonteCarlo: No records found in table ForecastBiomass";
@@ -893,13 +691,10 @@ nmfMainWindow::getForecastBiomassMonteCarlo(const std::string& ForecastName,
     }
 
     // Load data into data structure
+    ForecastBiomassMonteCarlo.reserve(NumRuns);
     for (int runNum=0; runNum<NumRuns; ++runNum) {
         nmfUtils::initialize(TmpMatrix,RunLength+1,NumSpecies);
-        for (int species=0; species<NumSpecies; ++species) {
-            for (int time=0; time<=RunLength; ++time) {
-                TmpMatrix(time,species) = std::stod(dataMapForecastBiomassMonteCarlo["Value"][m++]);
-            }
-        }
+        m = query.fillMatrixByColumn("Value",m,TmpMatrix);
         ForecastBiomassMonteCarlo.push_back(TmpMatrix);
     }
 
@@ -922,26 +717,27 @@ nmfMainWindow::getDiagnosticsData(
     int NumRecords;
     int TotalNumPoints = 2*NumPoints+1;
     int fitness;
-    std::vector<std::string> fields;
     std::string queryStr;
     std::string errorMsg;
-    std::map<std::string, std::vector<std::string> > dataMap;
+    nmfColumnQuery query;
     std::string TableName = Diagnostic_Tab1_ptr->getTableName(Output_Controls_ptr->getOutputParameter());
 
     DiagnosticsValue.clear();
     DiagnosticsFitness.clear();
 
     // Load Diagnostics data
-    fields    = {"Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Value","Fitness"};
-    queryStr  = "SELECT Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Value,Fitness FROM " + TableName;
+    queryStr  = "SELECT SpeName,Value,Fitness FROM " + TableName;
     queryStr += "  WHERE Algorithm = '" + Algorithm +
                 "' AND Minimizer = '" + Minimizer +
                 "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
                 "' AND Scaling = '" + Scaling +
                 "' AND isAggProd = " + isAggProd +
                 "  ORDER BY SpeName,Value";
-    dataMap = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["SpeName"].size();
+    if (! query.exec(queryStr,{"Value","Fitness"})) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getDiagnosticsData: " + query.lastError());
+        return false;
+    }
+    NumRecords = query.numRecords();
     if (NumRecords == 0) {
         errorMsg  = "[Warning] getDiagnosticsData: No records found in table: " + TableName;
 //      errorMsg += "\n" + queryStr;
@@ -952,10 +748,12 @@ nmfMainWindow::getDiagnosticsData(
     nmfUtils::initialize(DiagnosticsValue,  TotalNumPoints,NumSpeciesOrGuilds);
     nmfUtils::initialize(DiagnosticsFitness,TotalNumPoints,NumSpeciesOrGuilds);
     int yMax = Output_Controls_ptr->getYMaxSliderVal();
+    const std::vector<double>& Value   = query.numeric("Value");
+    const std::vector<double>& Fitness = query.numeric("Fitness");
     for (int j=0; j<NumSpeciesOrGuilds; ++j) {
         for (int i=0; i<TotalNumPoints; ++i) {
-            DiagnosticsValue(i,j)   = std::stod(dataMap["Value"][m]);
-            fitness = std::stod(dataMap["Fitness"][m]);
+            DiagnosticsValue(i,j)   = Value[m];
+            fitness = Fitness[m];
             fitness = (fitness > yMax) ? yMax : fitness;
             DiagnosticsFitness(i,j) = fitness;
             ++m;
@@ -975,27 +773,27 @@ nmfMainWindow::getForecastBiomass(const std::string &ForecastName,
                                   std::string &Scaling,
                                   std::vector<boost::numeric::ublas::matrix<double> > &ForecastBiomass)
 {
-    int m=0;
     int NumRecords;
-    std::vector<std::string> fields;
     std::string queryStr;
     std::string errorMsg;
     QString msg;
-    std::map<std::string, std::vector<std::string> > dataMapForecastBiomass;
+    nmfColumnQuery query;
 
     ForecastBiomass.clear();
 
     // Load Forecast Biomass data (ie, calculated from estimated parameters r and alpha)
-    fields    = {"ForecastName","Algorithm","Minimizer","ObjectiveCriterion","Scaling","SpeName","Year","Value"};
-    queryStr  = "SELECT ForecastName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,SpeName,Year,Value FROM ForecastBiomass";
+    queryStr  = "SELECT SpeName,Year,Value FROM ForecastBiomass";
     queryStr += " WHERE ForecastName = '" + ForecastName +
                 "' AND Algorithm = '" + Algorithm +
                 "' AND Minimizer = '" + Minimizer +
                 "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
                 "' AND Scaling = '" + Scaling +
                 "' ORDER BY SpeName,Year";
-    dataMapForecastBiomass = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMapForecastBiomass["SpeName"].size();
+    if (! query.exec(queryStr,{"Value"})) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 3] getForecastBiomass: " + query.lastError());
+        return false;
+    }
+    NumRecords = query.numRecords();
     if (NumRecords == 0) {
         m_ChartView2d->hide();
         errorMsg  = "[Warning] getForecastBiomass: No records found in table ForecastBiomass";
@@ -1017,12 +815,7 @@ nmfMainWindow::getForecastBiomass(const std::string &ForecastName,
 
     boost::numeric::ublas::matrix<double> TmpMatrix;
     nmfUtils::initialize(TmpMatrix,RunLength+1,NumSpecies);
-
-    for (int species=0; species<NumSpecies; ++species) {
-        for (int time=0; time<=RunLength; ++time) {
-            TmpMatrix(time,species) = std::stod(dataMapForecastBiomass["Value"][m++]);
-        }
-    }
+    query.fillMatrixByColumn("Value",0,TmpMatrix);
     ForecastBiomass.push_back(TmpMatrix);
 
     return true;
@@ -1058,6 +851,7 @@ nmfMainWindow::getMultiScenarioBiomass(
     std::string errorMsg;
     QString msg;
     std::map<std::string, std::vector<std::string> > dataMap;
+    nmfColumnQuery query;
     boost::numeric::ublas::matrix<double> TmpMatrix;
 
     MultiScenarioBiomass.clear();
@@ -1082,13 +876,15 @@ nmfMainWindow::getMultiScenarioBiomass(
     for (QString ForecastLabel : ForecastLabels) {
 
         // Load Forecast Biomass data (ie, calculated from estimated parameters r and alpha)
-        fields     = {"ScenarioName","ForecastLabel","SpeName","Year","Value"};
-        queryStr   = "SELECT ScenarioName,ForecastLabel,SpeName,Year,Value FROM ForecastBiomassMultiScenario";
+        queryStr   = "SELECT SpeName,Year,Value FROM ForecastBiomassMultiScenario";
         queryStr  += " WHERE ScenarioName = '" + ScenarioName +
                 "' AND ForecastLabel = '" + ForecastLabel.toStdString() +
                 "' ORDER BY SpeName,Year";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMap["SpeName"].size();
+        if (! query.exec(queryStr,{"Value"})) {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 2] getMultiScenarioBiomass: " + query.lastError());
+            return false;
+        }
+        NumRecords = query.numRecords();
         if (NumRecords == 0) {
             errorMsg  = "[Error 1] getMultiScenarioBiomass: No records found in table ForecastBiomassMultiScenario for ScenarioName = '" +
                     ScenarioName + "'";
@@ -1099,11 +895,7 @@ nmfMainWindow::getMultiScenarioBiomass(
         m = 0;
         for (int i=0; i<NumRecords; ++i) {
             nmfUtils::initialize(TmpMatrix,NumYears,NumSpecies);
-            for (int species=0; species<NumSpecies; ++species) {
-                for (int time=0; time<NumYears; ++time) {
-                    TmpMatrix(time,species) = std::stod(dataMap["Value"][m++]);
-                }
-            }
+            m = query.fillMatrixByColumn("Value",m,TmpMatrix);
             MultiScenarioBiomass.push_back(TmpMatrix);
             i += (NumSpecies*NumYears);
         }
@@ -1127,7 +919,6 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
 {
     int m=0;
     int NumRecords;
-    std::vector<std::string> fields;
     std::string queryStr;
     std::string errorMsg;
     std::string Algorithm;
@@ -1136,7 +927,8 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
     std::string Scaling;
     std::string CompetitionForm;
     std::string filterStr;
-    std::map<std::string, std::vector<std::string> > dataMapCalculatedBiomass;
+    std::vector<std::string> textFields = {"Algorithm","Minimizer","ObjectiveCriterion","Scaling"};
+    nmfColumnQuery query;
 
     OutputBiomass.clear();
 
@@ -1146,7 +938,6 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
                 Scaling,CompetitionForm,nmfConstantsMSSPM::DontShowPopupError);
 
     // Load Calculated Biomass data (ie, calculated from estimated parameters r and alpha)
-    fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Year","Value"};
     queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Year,Value FROM OutputBiomass";
     if ((NumLines == 1) && (! isAtLeastOneFilterPressed())) {
         queryStr += " WHERE Algorithm = '" + Algorithm +
@@ -1164,12 +955,11 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
         }
     }
     queryStr += " ORDER BY Algorithm,Minimizer,ObjectiveCriterion,Scaling,SpeName,Year";
-    dataMapCalculatedBiomass = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMapCalculatedBiomass["SpeName"].size();
+    query.exec(queryStr,{"Value"},textFields);
+    NumRecords = query.numRecords();
     if (NumRecords == 0) {
         std::string mlabel = std::to_string(Diagnostic_Tab2_ptr->getStartYearLBL()) + "-" +
                              std::to_string(Diagnostic_Tab2_ptr->getEndYearLBL());
-        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Year","Value"};
         queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Year,Value FROM OutputBiomass";
         if ((NumLines == 1) && (! isAtLeastOneFilterPressed())) {
             queryStr += " WHERE Algorithm = '" + Algorithm +
@@ -1187,8 +977,8 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
             }
         }
         queryStr += " ORDER BY Algorithm,Minimizer,ObjectiveCriterion,Scaling,SpeName,Year";
-        dataMapCalculatedBiomass = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMapCalculatedBiomass["SpeName"].size();
+        query.exec(queryStr,{"Value"},textFields);
+        NumRecords = query.numRecords();
 
         m_Logger->logMsg(nmfConstants::Normal,"q2: "+queryStr);
         m_Logger->logMsg(nmfConstants::Normal,"2NumRecords = "+std::to_string(NumRecords));
@@ -1196,6 +986,9 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
     }
     if (NumRecords == 0) {
         errorMsg  = "[Error 1] getOutputBiomass: No records found in table OutputBiomass";
+        if (! query.lastError().empty()) {
+            errorMsg += ": " + query.lastError();
+        }
         m_Logger->logMsg(nmfConstants::Error,errorMsg);
         m_Logger->logMsg(nmfConstants::Error,queryStr);
         return false;
@@ -1213,21 +1006,12 @@ nmfMainWindow::getOutputBiomass(const int &NumLines,
     boost::numeric::ublas::matrix<double> TmpMatrix;
     nmfUtils::initialize(TmpMatrix,RunLength+1,NumSpecies);
 
-    bool firstRecord;
     for (int chart=0; chart<NumLines; ++chart) {
-        firstRecord = true;
-        for (int species=0; species<NumSpecies; ++species) {
-            for (int time=0; time<=RunLength; ++time) {
-                if (firstRecord) {
-                    Algorithms.push_back(dataMapCalculatedBiomass["Algorithm"][m]);
-                    Minimizers.push_back(dataMapCalculatedBiomass["Minimizer"][m]);
-                    ObjectiveCriteria.push_back(dataMapCalculatedBiomass["ObjectiveCriterion"][m]);
-                    Scalings.push_back(dataMapCalculatedBiomass["Scaling"][m]);
-                    firstRecord = false;
-                }
-                TmpMatrix(time,species) = std::stod(dataMapCalculatedBiomass["Value"][m++]);
-            }
-        }
+        Algorithms.push_back(query.text("Algorithm")[m]);
+        Minimizers.push_back(query.text("Minimizer")[m]);
+        ObjectiveCriteria.push_back(query.text("ObjectiveCriterion")[m]);
+        Scalings.push_back(query.text("Scaling")[m]);
+        m = query.fillMatrixByColumn("Value",m,TmpMatrix);
         OutputBiomass.push_back(TmpMatrix);
     }
 //    m_Logger->logMsg(nmfConstants::Normal,"Read Output Biomass");
@@ -1994,19 +1778,52 @@ nmfMainWindow::callback_ReadProgressChartDataFile()
     callback_ReadProgressChartDataFile(validPointsOnly,false);
 }
 
+bool
+nmfMainWindow::drainProgressChannel()
+{
+    std::vector<nmfProgressSample> Samples;
+
+    if ((m_ProgressChannel == nullptr) ||
+        (m_ProgressChannel->drain(Samples) == 0)) {
+        return false;
+    }
+
+    // The progress widget loads its data from the progress file, so append the new
+    // samples to it here (on the GUI thread) in a single write.
+    std::ostringstream lines;
+    for (const nmfProgressSample& sample : Samples) {
+        lines << "Run " << sample.RunNum << "-" << sample.StartNum << ", "
+              << sample.Evaluation << ", "
+              << sample.Fitness    << ", "
+              << -1 << "\n";
+    }
+    std::ofstream outputFile(nmfConstantsMSSPM::MSSPMProgressChartFile,
+                             std::ios::out|std::ios::app);
+    outputFile << lines.str();
+    outputFile.close();
+
+    return true;
+}
+
 void
 nmfMainWindow::callback_ReadProgressChartDataFile(bool validPointsOnly,
                                                   bool clearChart)
 {
     QString outputMsg;
 
+    // With a progress channel (NLopt), the chart only needs to be reloaded when new
+    // samples have arrived. Without one (Bees), the estimator appends to the file itself.
+    bool hasNewSamples = (m_ProgressChannel == nullptr) || drainProgressChannel();
+
     if (clearChart) {
         m_ProgressWidget->clearChartOnly();
     }
-    m_ProgressWidget->readChartDataFile("MSSPM",
-                                        nmfConstantsMSSPM::MSSPMProgressChartFile,
-                                        nmfConstantsMSSPM::MSSPMProgressChartLabelFile,
-                                        validPointsOnly);
+    if (hasNewSamples || clearChart) {
+        m_ProgressWidget->readChartDataFile("MSSPM",
+                                            nmfConstantsMSSPM::MSSPMProgressChartFile,
+                                            nmfConstantsMSSPM::MSSPMProgressChartLabelFile,
+                                            validPointsOnly);
+    }
     std::string runName = "";
     std::string stopRunFile = nmfConstantsMSSPM::MSSPMStopRunFile;
     std::string state = "";
@@ -2015,6 +1832,7 @@ nmfMainWindow::callback_ReadProgressChartDataFile(bool validPointsOnly,
     {
         m_ProgressWidget->stopTimer();
         // Read chart once more just in case you've missed the last point.
+        drainProgressChannel();
         m_ProgressWidget->readChartDataFile("MSSPM",
                                             nmfConstantsMSSPM::MSSPMProgressChartFile,
                                             nmfConstantsMSSPM::MSSPMProgressChartLabelFile,
@@ -2532,6 +2350,10 @@ nmfMainWindow::initConnections()
 
     connect(Estimation_Tab1_ptr, SIGNAL(RunEstimation(bool)),
             this,                SLOT(callback_RunEstimation(bool)));
+    connect(Estimation_Tab1_ptr, SIGNAL(PreviewModifiedParameters()),
+            this,                SLOT(callback_PreviewModifiedParameters()));
+    connect(Estimation_Tab1_ptr, SIGNAL(PreviewFinished()),
+            this,                SLOT(callback_PreviewFinished()));
     connect(Estimation_Tab1_ptr, SIGNAL(ShowDiagnostics()),
             this,                SLOT(callback_ShowDiagnostics()));
     connect(Estimation_Tab1_ptr, SIGNAL(RunDiagnostics()),
@@ -2556,6 +2378,8 @@ nmfMainWindow::initConnections()
             Estimation_Tab5_ptr, SLOT(callback_LoadPB()));
     connect(Estimation_Tab6_ptr, SIGNAL(CheckAllEstimationTablesAndRun()),
             this,                SLOT(callback_CheckEstimationTablesAndRun()));
+    connect(Estimation_Tab6_ptr, SIGNAL(ResumeEstimation()),
+            this,                SLOT(callback_ResumeEstimation()));
     connect(Estimation_Tab1_ptr, SIGNAL(CheckAllEstimationTablesAndRun()),
             this,                SLOT(callback_CheckEstimationTablesAndRun()));
 
@@ -3182,12 +3006,20 @@ nmfMainWindow::updateOutputTables(
         const boost::numeric::ublas::matrix<double>& EstHandling,
         const std::vector<double>&                   EstExponent)
 {
+    NMF_TRACE_SCOPE("db","nmfMainWindow::updateOutputTables");
     int SpeciesNum;
     double value=0;
+    bool writeOK;
     std::string cmd;
     std::string errorMsg;
     QString msg;
     std::string isAggProd = std::to_string(isCompAggProd);
+    QString MohnsRhoLabel    = QString::fromStdString(m_MohnsRhoLabel);
+    QString AlgorithmStr     = QString::fromStdString(Algorithm);
+    QString MinimizerStr     = QString::fromStdString(Minimizer);
+    QString ObjCriterionStr  = QString::fromStdString(ObjectiveCriterion);
+    QString ScalingStr       = QString::fromStdString(Scaling);
+    nmfBulkWriter writer;
     std::string mohnsRhoLabelsToDelete = " AND MohnsRhoLabel != '' ";
     int NumMohnsRhos = m_MohnsRhoRanges.size();
 
@@ -3195,6 +3027,12 @@ nmfMainWindow::updateOutputTables(
         getMohnsRhoLabelsToDelete(NumMohnsRhos,mohnsRhoLabelsToDelete);
     }
 
+    // All of the output tables are cleared and loaded in a single transaction
+    if (! writer.begin()) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 13] UpdateOutputTables: Transaction error: " + writer.lastError());
+        return;
+    }
+
     //
     // Clear and then load output data tables...
     //
@@ -3216,8 +3054,8 @@ nmfMainWindow::updateOutputTables(
                 "' AND Scaling = '" + Scaling +
                 "' AND isAggProd = " + isAggProd +
                 mohnsRhoLabelsToDelete;
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
+        if (! writer.exec(cmd)) {
+            errorMsg = writer.lastError();
             m_Logger->logMsg(nmfConstants::Error,"[Error 1] UpdateOutputTables: DELETE error: " + errorMsg);
             m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
             msg = "\n[Error 2] updateOutputTables:  Couldn't delete all records from " + tableName + " table.\n";
@@ -3225,10 +3063,10 @@ nmfMainWindow::updateOutputTables(
             return;
         }
 
-        cmd = "REPLACE INTO " + tableName.toStdString() +
-                " (MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Value) VALUES ";
-
-        for (int i=0; i<SpeciesList.size(); ++i) {
+        writer.prepare("REPLACE",tableName.toStdString(),
+                       {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Value"});
+        writeOK = true;
+        for (int i=0; writeOK && i<SpeciesList.size(); ++i) {
             value = 0;
             if (tableName == "OutputGrowthRate") {
                 if (! EstGrowthRates.empty()) {
@@ -3260,20 +3098,12 @@ nmfMainWindow::updateOutputTables(
                     value = EstGrowthRates[SpeciesNum++]/2.0;
                 }
             }
-            cmd += "('"   + m_MohnsRhoLabel +
-                    "','" + Algorithm +
-                    "','" + Minimizer +
-                    "','" + ObjectiveCriterion +
-                    "','" + Scaling +
-                    "',"  + isAggProd + ",'" + SpeciesList[i].toStdString() +
-                    "',"  + std::to_string(value) + "),";
+            writeOK = writer.addRow({MohnsRhoLabel,AlgorithmStr,MinimizerStr,ObjCriterionStr,ScalingStr,
+                                     isCompAggProd,SpeciesList[i],value});
         }
-
-        cmd = cmd.substr(0,cmd.size()-1);
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
-            m_Logger->logMsg(nmfConstants::Error,"[Error 3] UpdateOutputTables: Write table error: " + errorMsg);
-            m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+        if (! writeOK || ! writer.flush()) {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 3] UpdateOutputTables: Write table error: " + writer.lastError());
+            m_Logger->logMsg(nmfConstants::Error,"table: " + tableName.toStdString());
             QMessageBox::warning(this, "Error",
                                  "\n[Error 4] updateOutputTables:  Check that all cells are populated.\n",
                                  QMessageBox::Ok);
@@ -3304,17 +3134,19 @@ nmfMainWindow::updateOutputTables(
                 "' AND Scaling = '" + Scaling +
                 "' AND isAggProd = " + isAggProd +
                 mohnsRhoLabelsToDelete;
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
+        if (! writer.exec(cmd)) {
+            errorMsg = writer.lastError();
             m_Logger->logMsg(nmfConstants::Error,"[Error 5] UpdateOutputTables: DELETE error: " + errorMsg);
             m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
             msg = "\n[Error 6] updateOutputTables: Couldn't delete all records from " + tableName + " table.\n",
                     QMessageBox::warning(this, "Error", msg, QMessageBox::Ok);
             return;
         }
-        cmd = "REPLACE INTO " + tableName.toStdString() + " (MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeciesA,SpeciesB,Value) VALUES ";
-        for (int row=0; row<SpeciesList.size(); ++row) {
-            for (int col=0; col<SpeciesList.size(); ++col) {
+        writer.prepare("REPLACE",tableName.toStdString(),
+                       {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeciesA","SpeciesB","Value"});
+        writeOK = true;
+        for (int row=0; writeOK && row<SpeciesList.size(); ++row) {
+            for (int col=0; writeOK && col<SpeciesList.size(); ++col) {
                 if (tableName == "OutputCompetitionAlpha") {
                     value = EstCompetitionAlpha(row,col);
                 } else if (tableName == "OutputCompetitionBetaSpecies") {
@@ -3326,24 +3158,13 @@ nmfMainWindow::updateOutputTables(
                 }
                 if (std::isnan(std::fabs(value)))
                     value = 0;
-                std::ostringstream val;
-                val << value;
-                cmd += "('"  + m_MohnsRhoLabel +
-                       "','" + Algorithm +
-                       "','" + Minimizer +
-                       "','" + ObjectiveCriterion +
-                       "','" + Scaling +
-                       "',"  + isAggProd +
-                       ",'"  + SpeciesList[row].toStdString() +
-                       "','" + SpeciesList[col].toStdString() +
-                       "',"  + val.str() + "),";
+                writeOK = writer.addRow({MohnsRhoLabel,AlgorithmStr,MinimizerStr,ObjCriterionStr,ScalingStr,
+                                         isCompAggProd,SpeciesList[row],SpeciesList[col],value});
             }
         }
-        cmd = cmd.substr(0,cmd.size()-1);
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
-            m_Logger->logMsg(nmfConstants::Error,"[Error 7] UpdateOutputTables: Write table error: " + errorMsg);
-            m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+        if (! writeOK || ! writer.flush()) {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 7] UpdateOutputTables: Write table error: " + writer.lastError());
+            m_Logger->logMsg(nmfConstants::Error,"table: " + tableName.toStdString());
             QMessageBox::warning(this, "Error",
                                  "\n[Error 8] in updateOutputTables command.  Check that all cells are populated.\n",
                                  QMessageBox::Ok);
@@ -3369,40 +3190,31 @@ nmfMainWindow::updateOutputTables(
                 "' AND Scaling = '" + Scaling +
                 "' AND isAggProd = " + isAggProd +
                 mohnsRhoLabelsToDelete;
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
+        if (! writer.exec(cmd)) {
+            errorMsg = writer.lastError();
             m_Logger->logMsg(nmfConstants::Error,"[Error 9] UpdateOutputTables: DELETE error: " + errorMsg);
             m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
             msg = "\n[Error 10] updateOutputTables: Couldn't delete all records from " + tableName + " table.\n",
                     QMessageBox::warning(this, "Error", msg, QMessageBox::Ok);
             return;
         }
-        cmd = "REPLACE INTO " + tableName.toStdString() + " (MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Guild,Value) VALUES ";
-        for (int row=0; row<SpeciesList.size(); ++row) {
-            for (int col=0; col<GuildList.size(); ++col) {
+        writer.prepare("REPLACE",tableName.toStdString(),
+                       {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Guild","Value"});
+        writeOK = true;
+        for (int row=0; writeOK && row<SpeciesList.size(); ++row) {
+            for (int col=0; writeOK && col<GuildList.size(); ++col) {
                 if (tableName == "OutputCompetitionBetaGuilds") {
                     value = EstCompetitionBetaGuilds(row,col);
                 }
                 if (std::isnan(std::fabs(value)))
                     value = 0;
-                std::ostringstream val;
-                val << value;
-                cmd += "('"  + m_MohnsRhoLabel +
-                       "','" + Algorithm +
-                       "','" + Minimizer +
-                       "','" + ObjectiveCriterion +
-                       "','" + Scaling +
-                       "',"  + isAggProd +
-                       ",'"  + SpeciesList[row].toStdString() +
-                       "','" + GuildList[col].toStdString() +
-                       "',"  + val.str() + "),";
+                writeOK = writer.addRow({MohnsRhoLabel,AlgorithmStr,MinimizerStr,ObjCriterionStr,ScalingStr,
+                                         isCompAggProd,SpeciesList[row],GuildList[col],value});
             }
         }
-        cmd = cmd.substr(0,cmd.size()-1);
-        errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-        if (errorMsg != " ") {
-            m_Logger->logMsg(nmfConstants::Error,"[Error 11] UpdateOutputTables: Write table error: " + errorMsg);
-            m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+        if (! writeOK || ! writer.flush()) {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 11] UpdateOutputTables: Write table error: " + writer.lastError());
+            m_Logger->logMsg(nmfConstants::Error,"table: " + tableName.toStdString());
             QMessageBox::warning(this, "Error",
                                  "\n[Error 12] in updateOutputTables command.  Check that all cells are populated.\n",
                                  QMessageBox::Ok);
@@ -3410,100 +3222,14 @@ nmfMainWindow::updateOutputTables(
         }
     }
 
-}
-
-bool
-nmfMainWindow::loadUncertaintyData(const bool&          isMonteCarlo,
-                                   const int&           NumSpecies,
-                                   const std::string&   ForecastName,
-                                   const std::string&   Algorithm,
-                                   const std::string&   Minimizer,
-                                   const std::string&   ObjectiveCriterion,
-                                   const std::string&   Scaling,
-                                   std::vector<double>& GrowthRateUncertainty,
-                                   std::vector<double>& CarryingCapacityUncertainty,
-                                   std::vector<double>& PredationUncertainty,
-                                   std::vector<double>& CompetitionUncertainty,
-                                   std::vector<double>& BetaSpeciesUncertainty,
-                                   std::vector<double>& BetaGuildsUncertainty,
-                                   std::vector<double>& HandlingUncertainty,
-                                   std::vector<double>& ExponentUncertainty,
-                                   std::vector<double>& CatchabilityUncertainty,
-                                   std::vector<double>& HarvestUncertainty)
-{
-    int NumRecords;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    std::string msg;
-
-    // Clear data structures
-    GrowthRateUncertainty.clear();
-    CarryingCapacityUncertainty.clear();
-    PredationUncertainty.clear();
-    CompetitionUncertainty.clear();
-    BetaSpeciesUncertainty.clear();
-    BetaGuildsUncertainty.clear();
-    HandlingUncertainty.clear();
-    ExponentUncertainty.clear();
-    CatchabilityUncertainty.clear();
-    HarvestUncertainty.clear();
-
-    if (isMonteCarlo) {
-        fields     = {"ForecastName","SpeName","Algorithm","Minimizer","ObjectiveCriterion","Scaling",
-                      "GrowthRate","CarryingCapacity","Predation","Competition",
-                      "BetaSpecies","BetaGuilds","Handling","Exponent","Catchability","Harvest"};
-        queryStr   = "SELECT ForecastName,SpeName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,";
-        queryStr  += "GrowthRate,CarryingCapacity,Predation,Competition,BetaSpecies,";
-        queryStr  += "BetaGuilds,Handling,Exponent,Catchability,Harvest FROM ForecastUncertainty ";
-        queryStr  += " WHERE ForecastName = '" + ForecastName +
-                    "' AND Algorithm = '" + Algorithm +
-                    "' AND Minimizer = '" + Minimizer +
-                    "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
-                    "' AND Scaling = '" + Scaling +
-                    "' ORDER BY SpeName";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMap["SpeName"].size();
-        if (NumRecords != NumSpecies) {
-            msg  = "[Error 1] loadUncertaintyData: Incorrect number of records found in table: ForecastUncertainty. ";
-            msg += "Found " + std::to_string(NumRecords) + " records expecting " + std::to_string(NumSpecies)+".";
-            m_Logger->logMsg(nmfConstants::Error,msg);
-            QMessageBox::warning(this, "Error",
-                                 "\nMissing Forecast data. Please check tabs:\nForecast->Harvest Parameters and Forecast->Uncertainty Parameters\nand re-save.",
-                                 QMessageBox::Ok);
-           return false;
-        }
-        for (int i=0; i<NumSpecies; ++i) {
-            GrowthRateUncertainty.emplace_back(std::stod(dataMap["GrowthRate"][i]));
-            CarryingCapacityUncertainty.emplace_back(std::stod(dataMap["CarryingCapacity"][i]));
-            PredationUncertainty.emplace_back(std::stod(dataMap["Predation"][i]));
-            CompetitionUncertainty.emplace_back(std::stod(dataMap["Competition"][i]));
-            BetaSpeciesUncertainty.emplace_back(std::stod(dataMap["BetaSpecies"][i]));
-            BetaGuildsUncertainty.emplace_back(std::stod(dataMap["BetaGuilds"][i]));
-            HandlingUncertainty.emplace_back(std::stod(dataMap["Handling"][i]));
-            ExponentUncertainty.emplace_back(std::stod(dataMap["Exponent"][i]));
-            CatchabilityUncertainty.emplace_back(std::stod(dataMap["Catchability"][i]));
-            HarvestUncertainty.emplace_back(std::stod(dataMap["Harvest"][i]));
-        }
-
-    } else {
-        for (int i=0; i<NumSpecies; ++i) {
-            GrowthRateUncertainty.emplace_back(0);
-            CarryingCapacityUncertainty.emplace_back(0);
-            PredationUncertainty.emplace_back(0);
-            CompetitionUncertainty.emplace_back(0);
-            BetaSpeciesUncertainty.emplace_back(0);
-            BetaGuildsUncertainty.emplace_back(0);
-            HandlingUncertainty.emplace_back(0);
-            ExponentUncertainty.emplace_back(0);
-            CatchabilityUncertainty.emplace_back(0);
-            HarvestUncertainty.emplace_back(0);
-        }
+    if (! writer.commit()) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 14] UpdateOutputTables: Commit error: " + writer.lastError());
+        QMessageBox::warning(this, "Error",
+                             "\n[Error 15] updateOutputTables: Couldn't save the output tables.\n",
+                             QMessageBox::Ok);
     }
-    return true;
 }
 
-
 bool
 nmfMainWindow::scaleTimeSeries(const std::vector<double>& Uncertainty,
                                boost::numeric::ublas::matrix<double>& HarvestMatrix)
@@ -3614,8 +3340,105 @@ nmfMainWindow::calculateMonteCarloValue(const double& uncertainty,
 
 
 bool
-nmfMainWindow::updateOutputBiomassTable(std::string& ForecastName,
-                                        int&         StartYear,
+nmfMainWindow::loadProjectionInputs(const std::string& ForecastName,
+                                    const int&         RunLength,
+                                    const bool&        isMonteCarlo,
+                                    const std::string& Algorithm,
+                                    const std::string& Minimizer,
+                                    const std::string& ObjectiveCriterion,
+                                    const std::string& Scaling,
+                                    const std::string& isAggProdStr,
+                                    const std::string& GrowthForm,
+                                    const std::string& HarvestForm,
+                                    const std::string& CompetitionForm,
+                                    const std::string& PredationForm,
+                                    const std::string& GrowthRateTable,
+                                    const std::string& CarryingCapacityTable,
+                                    const std::string& CatchabilityTable,
+                                    QStringList&       SpeciesList,
+                                    nmfProjectionInputs& Inputs)
+{
+    bool isAlpha       = (CompetitionForm == "NO_K");
+    bool isBetaSpecies = (CompetitionForm == "MS-PROD");
+    bool isBetaGuilds  = (CompetitionForm == "AGG-PROD") || (CompetitionForm == "MS-PROD");
+    bool isPredation   = (PredationForm   == "Type I");
+    bool isHandling    = (PredationForm   == "Type II")  || (PredationForm   == "Type III");
+    nmfForecastUncertainty Uncertainty;
+    nmfProjectionParameters& Parameters = Inputs.Parameters;
+    nmfSystemLoader loader = getSystemLoader();
+
+    if (! loader.loadProjectionInputs(ForecastName,RunLength,Algorithm,Minimizer,
+                                      ObjectiveCriterion,Scaling,isAggProdStr,
+                                      GrowthForm,HarvestForm,CompetitionForm,PredationForm,
+                                      GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
+                                      SpeciesList,Inputs)) {
+        showSystemLoaderError(loader);
+        return false;
+    }
+    if (! isMonteCarlo) {
+        return true;
+    }
+
+    // Perturb the estimated parameters and the harvest by the uncertainty
+    // factors, in the same order as they were read from the database.
+    if (! loader.loadUncertaintyData(Inputs.System.NumSpeciesOrGuilds,ForecastName,
+                                     Algorithm,Minimizer,ObjectiveCriterion,Scaling,
+                                     Uncertainty)) {
+        showSystemLoaderError(loader);
+        return false;
+    }
+    for (unsigned i=0; i<Parameters.GrowthRate.size(); ++i) {
+        Parameters.GrowthRate[i] = calculateMonteCarloValue(Uncertainty.GrowthRate[i],Parameters.GrowthRate[i]);
+    }
+    for (unsigned i=0; i<Parameters.CarryingCapacity.size(); ++i) {
+        Parameters.CarryingCapacity[i] = calculateMonteCarloValue(Uncertainty.CarryingCapacity[i],Parameters.CarryingCapacity[i]);
+    }
+    for (unsigned i=0; i<Parameters.Catchability.size(); ++i) {
+        Parameters.Catchability[i] = calculateMonteCarloValue(Uncertainty.Catchability[i],Parameters.Catchability[i]);
+    }
+    for (unsigned i=0; i<Parameters.Exponent.size(); ++i) {
+        Parameters.Exponent[i] = calculateMonteCarloValue(Uncertainty.Exponent[i],Parameters.Exponent[i]);
+    }
+    // Interaction uncertainties are per prey/competitor (column), except for the
+    // guild competition terms which are per species (row)
+    auto perturbMatrix = [this](const std::vector<double>& uncertainty,
+                                const bool& byRow,
+                                boost::numeric::ublas::matrix<double>& matrix) {
+        for (unsigned row=0; row<matrix.size1(); ++row) {
+            for (unsigned col=0; col<matrix.size2(); ++col) {
+                matrix(row,col) = calculateMonteCarloValue(uncertainty[byRow ? row : col],matrix(row,col));
+            }
+        }
+    };
+    if (isAlpha) {
+        perturbMatrix(Uncertainty.Competition,false,Parameters.CompetitionAlpha);
+    }
+    if (isBetaSpecies) {
+        perturbMatrix(Uncertainty.BetaSpecies,false,Parameters.CompetitionBetaSpecies);
+    }
+    if (isPredation) {
+        perturbMatrix(Uncertainty.Predation,false,Parameters.Predation);
+    }
+    if (isHandling) {
+        perturbMatrix(Uncertainty.Handling,false,Parameters.Handling);
+    }
+    if (isBetaGuilds) {
+        perturbMatrix(Uncertainty.BetaGuilds,true,Parameters.CompetitionBetaGuilds);
+    }
+    if (HarvestForm == "Catch") {
+        scaleTimeSeries(Uncertainty.Harvest,Inputs.Catch);
+    } else if (HarvestForm == "Effort (qE)") {
+        scaleTimeSeries(Uncertainty.Harvest,Inputs.Effort);
+    } else if (HarvestForm == "Exploitation (F)") {
+        scaleTimeSeries(Uncertainty.Harvest,Inputs.Exploitation);
+    }
+
+    return true;
+}
+
+bool
+nmfMainWindow::updateOutputBiomassTable(std::string& ForecastName,
+                                        int&         StartYear,
                                         int&         RunLength,
                                         bool&        isMonteCarlo,
                                         int&         RunNum,
@@ -3633,468 +3456,74 @@ nmfMainWindow::updateOutputBiomassTable(std::string& ForecastName,
                                         std::string& CatchabilityTable,
                                         std::string& BiomassTable)
 {
-    bool   loadOK;
-    bool   isCatchability = (HarvestForm     == "Effort (qE)");
-    bool   isAggProd      = (CompetitionForm == "AGG-PROD");
-    bool   isAlpha        = (CompetitionForm == "NO_K");
-    bool   isBetaSpecies  = (CompetitionForm == "MS-PROD");
-    bool   isBetaGuilds   = (CompetitionForm == "AGG-PROD") || (CompetitionForm == "MS-PROD");
-    bool   isPredation    = (PredationForm   == "Type I");
-    bool   isHandling     = (PredationForm   == "Type II")  || (PredationForm   == "Type III");
-    bool   isExponent     = (PredationForm   == "Type III");
-    int    m;
-    int    NumSpeciesOrGuilds;
-    int    NumGuilds;
-    int    NumRecords;
-    int    timeMinus1;
-    int    guildNum;
-    double EstimatedBiomassTimeMinus1 = 0;
-    double SystemCarryingCapacity;
-    double GuildCarryingCapacity;
-    double MonteCarloValue; // random value in the range: [val-uncertainty,val+uncertainty]
-    std::string cmd;
-    std::string errorMsg;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
+    int NumSpeciesOrGuilds;
+    int FirstYear;
+    bool writeOK;
+    std::string Verb;
+    std::vector<std::string> Fields;
+    QVariantList Keys;
     QStringList SpeciesList;
-    QStringList GuildList;
-    std::vector<double> EstGrowthRates;
-    std::vector<double> EstCarryingCapacities;
-    std::vector<double> EstExponent;
-    std::vector<double> EstCatchabilityRates;
-    boost::numeric::ublas::matrix<double> EstCompetitionAlpha;
-    boost::numeric::ublas::matrix<double> EstCompetitionBetaSpecies;
-    boost::numeric::ublas::matrix<double> EstCompetitionBetaGuilds;
-    boost::numeric::ublas::matrix<double> EstPredation;
-    boost::numeric::ublas::matrix<double> EstHandling;
-    boost::numeric::ublas::matrix<double> Catch;
-    boost::numeric::ublas::matrix<double> Effort;
-    boost::numeric::ublas::matrix<double> Exploitation;
+    nmfBulkWriter writer;
+    nmfProjectionInputs  Inputs;
+    nmfProjectionScratch ProjectionScratch;
     boost::numeric::ublas::matrix<double> EstimatedBiomassBySpecies;
     boost::numeric::ublas::matrix<double> EstimatedBiomassByGuilds;
-    QList<QList<double> > BiomassData; // A Vector of row vectors
-    QList<double> BiomassRow;
-    QList<double> InitialBiomass;
-    std::vector<double> exploitationRate;
-    std::vector<double> catchabilityRate;
-    double growthTerm;
-    double harvestTerm;
-    double competitionTerm;
-    double predationTerm;
-    std::vector<double> GrowthRateUncertainty;
-    std::vector<double> CarryingCapacityUncertainty;
-    std::vector<double> PredationUncertainty;
-    std::vector<double> CompetitionUncertainty;
-    std::vector<double> BetaSpeciesUncertainty;
-    std::vector<double> BetaGuildsUncertainty;
-    std::vector<double> HandlingUncertainty;
-    std::vector<double> ExponentUncertainty;
-    std::vector<double> CatchabilityUncertainty;
-    std::vector<double> HarvestUncertainty;
-    std::vector<std::string> TableNames;
-    nmfGrowthForm*      growthForm      = new nmfGrowthForm(GrowthForm);
-    nmfHarvestForm*     harvestForm     = new nmfHarvestForm(HarvestForm);
-    nmfCompetitionForm* competitionForm = new nmfCompetitionForm(CompetitionForm);
-    nmfPredationForm*   predationForm   = new nmfPredationForm(PredationForm);
 
-    BiomassData.clear();
-    EstGrowthRates.clear();
-    EstCarryingCapacities.clear();
-    EstExponent.clear();
-    EstCatchabilityRates.clear();
-    SpeciesList.clear();
-    GuildList.clear();
-    exploitationRate.clear();
-    catchabilityRate.clear();
-
-    // Find Guilds and Species
-    if (! getGuilds(NumGuilds,GuildList)) {
+    if (! loadProjectionInputs(ForecastName,RunLength,isMonteCarlo,
+                               Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
+                               GrowthForm,HarvestForm,CompetitionForm,PredationForm,
+                               GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
+                               SpeciesList,Inputs)) {
         return false;
     }
-    if (isAggProd) {
-        SpeciesList        = GuildList;
-        NumSpeciesOrGuilds = NumGuilds;
-    } else {
-        if (! getSpecies(NumSpeciesOrGuilds,SpeciesList)) {
-            return false;
-        }
-    }
-
-    // Load uncertainty factors if this is a monte carlo simulation
-    loadOK = loadUncertaintyData(isMonteCarlo,NumSpeciesOrGuilds,ForecastName,
-                                 Algorithm,Minimizer,ObjectiveCriterion,Scaling,
-                                 GrowthRateUncertainty,
-                                 CarryingCapacityUncertainty,
-                                 PredationUncertainty,
-                                 CompetitionUncertainty,
-                                 BetaSpeciesUncertainty,
-                                 BetaGuildsUncertainty,
-                                 HandlingUncertainty,
-                                 ExponentUncertainty,
-                                 CatchabilityUncertainty,
-                                 HarvestUncertainty);
-    if (! loadOK) {
-        return false;
-    }
-
-    // Load appropriate r and K (for given Algorithm, Minimizer, and Objective Criterion)
-    TableNames.clear();
-    TableNames.push_back(GrowthRateTable);
-    TableNames.push_back(CarryingCapacityTable);
-    if (isCatchability)
-        TableNames.push_back(CatchabilityTable);
-    if (isExponent)
-        TableNames.push_back("OutputExponent");
-    for (unsigned j=0; j<TableNames.size(); ++j) {
-        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Value"};
-        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Value FROM " + TableNames[j];
-        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
-                    "' AND Algorithm = '" + Algorithm +
-                    "' AND Minimizer = '" + Minimizer +
-                    "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
-                    "' AND Scaling = '" + Scaling +
-                    "' AND isAggProd = " + isAggProdStr +
-                    " ORDER BY SpeName";
-        dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMap["SpeName"].size();
-        if (NumRecords != NumSpeciesOrGuilds) {
-            errorMsg  = "Run failed. Incorrect number of records found in " + TableNames[j] + ". ";
-            errorMsg += "Found " + std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds) + ".";
-            m_Logger->logMsg(nmfConstants::Error, "[Error 4] " + errorMsg);
-            m_Logger->logMsg(nmfConstants::Error, queryStr);
-            errorMsg  = "\n" + errorMsg + "\n";
-            QMessageBox::information(this, tr("Run Failed"), tr(errorMsg.c_str()),QMessageBox::Ok);
-            return false;
-        }
-        if (TableNames[j] == GrowthRateTable) {
-            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-                MonteCarloValue = calculateMonteCarloValue(GrowthRateUncertainty[i],
-                                                           std::stod(dataMap["Value"][i]));
-                EstGrowthRates.push_back(MonteCarloValue);
-            }
-        } else if (TableNames[j] == CarryingCapacityTable) {
-            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-                MonteCarloValue = calculateMonteCarloValue(CarryingCapacityUncertainty[i],
-                                                           std::stod(dataMap["Value"][i]));
-                EstCarryingCapacities.push_back(MonteCarloValue);
-            }
-        } else if (TableNames[j] == CatchabilityTable) {
-            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-                MonteCarloValue = calculateMonteCarloValue(CatchabilityUncertainty[i],
-                                                           std::stod(dataMap["Value"][i]));
-                EstCatchabilityRates.push_back(MonteCarloValue);
-            }
-        } else if (TableNames[j] == "OutputExponent") {
-            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-                MonteCarloValue = calculateMonteCarloValue(ExponentUncertainty[i],
-                                                           std::stod(dataMap["Value"][i]));
-                EstExponent.push_back(MonteCarloValue);
-            }
-        }
-    }
-
-    // Load data from OutputCompetitionAlpha, OutputCompetitionBetaSpecies,
-    // OutputPredation, and OutputHandling
-    TableNames.clear();
-    if (isAlpha)
-        TableNames.push_back("OutputCompetitionAlpha");
-    if (isBetaSpecies)
-        TableNames.push_back("OutputCompetitionBetaSpecies");
-    if (isPredation)
-        TableNames.push_back("OutputPredation");
-    if (isHandling)
-        TableNames.push_back("OutputHandling");
-    nmfUtils::initialize(EstCompetitionAlpha,      NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-    nmfUtils::initialize(EstCompetitionBetaSpecies,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-    nmfUtils::initialize(EstPredation,             NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-    nmfUtils::initialize(EstHandling,              NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-    for (unsigned i=0; i<TableNames.size(); ++i) {
-        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeciesA","SpeciesB","Value"};
-        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeciesA,SpeciesB,Value FROM " + TableNames[i];
-        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
-                "' AND Algorithm = '" + Algorithm +
-                "' AND Minimizer = '" + Minimizer +
-                "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
-                "' AND Scaling = '" + Scaling +
-                "' AND isAggProd = " + isAggProdStr +
-                "  ORDER BY SpeciesA,SpeciesB";
-        dataMap = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMap["SpeciesA"].size();
-        if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
-            m_Logger->logMsg(nmfConstants::Error,
-                           "[Error 5] UpdateOutputBiomassTable: Incorrect number of records found in " + TableNames[i] + ". Found " +
-                           std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".");
-            m_Logger->logMsg(nmfConstants::Error, queryStr);
-            return false;
-        }
-        // In row major order
-        m = 0;
-        for (int row=0; row<NumSpeciesOrGuilds; ++row) {
-            for (int col=0; col<NumSpeciesOrGuilds; ++col) {
-                if (TableNames[i] == "OutputCompetitionAlpha") {
-                    EstCompetitionAlpha(row,col) = calculateMonteCarloValue(CompetitionUncertainty[col],
-                                                                            std::stod(dataMap["Value"][m]));
-                } else if (TableNames[i] == "OutputCompetitionBetaSpecies") {
-                    EstCompetitionBetaSpecies(row,col) = calculateMonteCarloValue(BetaSpeciesUncertainty[col],
-                                                                                  std::stod(dataMap["Value"][m]));
-                } else if (TableNames[i] == "OutputPredation") {
-                    EstPredation(row,col) = calculateMonteCarloValue(PredationUncertainty[col],
-                                                                     std::stod(dataMap["Value"][m]));
-                } else if (TableNames[i] == "OutputHandling") {
-                    EstHandling(row,col) = calculateMonteCarloValue(HandlingUncertainty[col],
-                                                                    std::stod(dataMap["Value"][m]));
-                }
-                ++m;
-            }
-        }
-    }
-
-    TableNames.clear();
-    if (isBetaGuilds)
-        TableNames.push_back("OutputCompetitionBetaGuilds");
-    nmfUtils::initialize(EstCompetitionBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
-    for (unsigned i=0; i<TableNames.size(); ++i) {
-        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Guild","Value"};
-        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Guild,Value FROM " + TableNames[i];
-        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
-                    "' AND Algorithm = '" + Algorithm +
-                    "' AND Minimizer = '" + Minimizer +
-                    "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
-                    "' AND Scaling = '" + Scaling +
-                    "' AND isAggProd = " + isAggProdStr +
-                    " ORDER BY SpeName,Guild";
-        dataMap = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumRecords = dataMap["SpeName"].size();
-        if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
-            m_Logger->logMsg(nmfConstants::Error,
-                           "[Error 6] UpdateOutputBiomassTable: Incorrect number of records found in " + TableNames[i] + ". Found " +
-                           std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds*NumGuilds) + ".");
-            m_Logger->logMsg(nmfConstants::Error, queryStr);
-            return false;
-        }
-        // In row major order
-        m = 0;
-        for (int row=0; row<NumSpeciesOrGuilds; ++row) {
-            for (int col=0; col<NumGuilds; ++col) {
-                if (TableNames[i] == "OutputCompetitionBetaGuilds") {
-                    EstCompetitionBetaGuilds(row,col) = calculateMonteCarloValue(BetaGuildsUncertainty[row],
-                                                                                 std::stod(dataMap["Value"][m]));
-                }
-                ++m;
-            }
-        }
-    }
-
-    if (HarvestForm == "Catch") {
-        if (isAggProd) {
-            if (! getTimeSeriesDataByGuild(ForecastName,"Catch", NumSpeciesOrGuilds,RunLength,Catch)) {
-                QMessageBox::warning(this, "Error",
-                                     "\nError: No data found in ForecastCatch table for current Forecast.\nCheck Forecast->Harvest Parameters tab.",
-                                     QMessageBox::Ok);
-                return false;
-            }
-        } else {
-            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Catch", NumSpeciesOrGuilds,RunLength,Catch)) {
-                QMessageBox::warning(this, "Error",
-                                     "\nError: No data found in ForecastCatch table for current Forecast.\nCheck Forecast->Harvest Parameters tab.",
-                                     QMessageBox::Ok);
-                return false;
-            }
-        }
-        if (isMonteCarlo) {
-            scaleTimeSeries(HarvestUncertainty,Catch);
-        }
-    } else if (HarvestForm == "Effort (qE)") {
-        if (isAggProd) {
-            if (! getTimeSeriesDataByGuild(ForecastName,"Effort",NumSpeciesOrGuilds,RunLength,Effort))
-                return false;
-        } else {
-            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Effort",NumSpeciesOrGuilds,RunLength,Effort))
-                return false;
-        }
-        if (isMonteCarlo) {
-            scaleTimeSeries(HarvestUncertainty,Effort);
-        }
-    } else if (HarvestForm == "Exploitation (F)") {
-        if (isAggProd) {
-            if (! getTimeSeriesDataByGuild(ForecastName,"Exploitation",NumSpeciesOrGuilds,RunLength,Exploitation))
-                return false;
-        } else {
-            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Exploitation",NumSpeciesOrGuilds,RunLength,Exploitation))
-                return false;
-        }
-        if (isMonteCarlo) {
-            scaleTimeSeries(HarvestUncertainty,Exploitation);
-        }
-    }
-
-    // If not running a forecast initial biomass is the first observed biomass.
-    // else if running a forecast initial biomass is the last observed biomass.
-    if (ForecastName == "") {
-        if (! getInitialObservedBiomass(InitialBiomass))
-            return false;
-    } else {
-        if (! getFinalObservedBiomass(InitialBiomass)) {
-            std::cout << "Error: getFinalObservedBiomass" << std::endl;
-            return false;
-        }
-    }
+    NumSpeciesOrGuilds = Inputs.System.NumSpeciesOrGuilds;
 
+    // Project the biomass (the kernel also fills in the guild biomass from the species biomass)
     nmfUtils::initialize(EstimatedBiomassBySpecies,RunLength+1,NumSpeciesOrGuilds);
     for (int SpeciesNum=0; SpeciesNum<NumSpeciesOrGuilds; ++SpeciesNum) {
-        EstimatedBiomassBySpecies(0,SpeciesNum) = InitialBiomass[SpeciesNum];
+        EstimatedBiomassBySpecies(0,SpeciesNum) = Inputs.InitialBiomass[SpeciesNum];
     }
-    nmfUtils::initialize(EstimatedBiomassByGuilds,RunLength+1,NumGuilds);
-
-    // Get guild map
-    std::map<int,std::vector<int> > GuildSpecies;
-    std::vector<int>                GuildNum;
-    boost::numeric::ublas::matrix<double> ObservedBiomassByGuilds;
-    getGuildData(NumGuilds,RunLength,GuildList,GuildSpecies,GuildNum,ObservedBiomassByGuilds);
-    EstimatedBiomassByGuilds = ObservedBiomassByGuilds;
+    nmfUtils::initialize(EstimatedBiomassByGuilds,RunLength+1,Inputs.System.NumGuilds);
+    Inputs.Project(Inputs.System,Inputs.Parameters,ProjectionScratch,
+                   EstimatedBiomassBySpecies,EstimatedBiomassByGuilds);
 
-    SystemCarryingCapacity = 0;
-
-    if (isAggProd) {
-        for (int i=0; i<NumGuilds; ++i) {
-            SystemCarryingCapacity += EstCarryingCapacities[i];
-        }
-    } else {
-        for (int i=0; i<NumGuilds; ++i) {
-            for (unsigned j=0; j<GuildSpecies[i].size(); ++j) {
-                SystemCarryingCapacity += EstCarryingCapacities[GuildSpecies[i][j]];
-            }
-        }
-    }
-
-    for (int time = 1; time <= RunLength; time++) {
-        timeMinus1 = time-1;
-        BiomassRow.clear();
-        for (int species=0; species<NumSpeciesOrGuilds; ++species)
-        {
-            // Find the guild carrying capacity for guild: guildNum
-            GuildCarryingCapacity = 0;
-            if (isAggProd) {
-                GuildCarryingCapacity = EstCarryingCapacities[species];
-            } else {
-                guildNum = GuildNum[species];
-                for (unsigned j=0; j<GuildSpecies[guildNum].size(); ++j) {
-                    GuildCarryingCapacity += EstCarryingCapacities[GuildSpecies[guildNum][j]];
-                }
-            }
-
-            EstimatedBiomassTimeMinus1  = EstimatedBiomassBySpecies(timeMinus1,species);
-            growthTerm      = growthForm->evaluate(species,EstimatedBiomassTimeMinus1,
-                                                   EstGrowthRates,EstCarryingCapacities);
-            harvestTerm     = harvestForm->evaluate(timeMinus1,species,Catch,Effort,
-                                                    Exploitation,
-                                                    EstimatedBiomassTimeMinus1,
-                                                    EstCatchabilityRates);
-            competitionTerm = competitionForm->evaluate(timeMinus1,
-                                                        species,
-                                                        EstimatedBiomassTimeMinus1,
-                                                        SystemCarryingCapacity,
-                                                        EstGrowthRates,
-                                                        GuildCarryingCapacity,
-                                                        EstCompetitionAlpha,
-                                                        EstCompetitionBetaSpecies,
-                                                        EstCompetitionBetaGuilds,
-                                                        EstimatedBiomassBySpecies,
-                                                        EstimatedBiomassByGuilds);
-            predationTerm   = predationForm->evaluate(timeMinus1,species,
-                                                      EstPredation,EstHandling,EstExponent,
-                                                      EstimatedBiomassBySpecies,EstimatedBiomassTimeMinus1);
-            EstimatedBiomassTimeMinus1 += growthTerm - harvestTerm - competitionTerm - predationTerm;
-
-            if ( std::isnan(std::fabs(EstimatedBiomassTimeMinus1)) ||
-                (EstimatedBiomassTimeMinus1 < 0) )
-            {
-                EstimatedBiomassTimeMinus1 = 0;
-            }
-            EstimatedBiomassBySpecies(time,species) = EstimatedBiomassTimeMinus1;
-
-            // update estBiomassGuilds for next time step
-            if (isAggProd) {
-                for (int i=0; i<NumGuilds; ++i) {
-                    EstimatedBiomassByGuilds(time,i) = EstimatedBiomassBySpecies(time,i);
-                }
-            } else {
-                for (int i=0; i<NumGuilds; ++i) {
-                    for (unsigned j=0; j<GuildSpecies[i].size(); ++j) {
-                        EstimatedBiomassByGuilds(time,i) += EstimatedBiomassBySpecies(time,GuildSpecies[i][j]);
-                    }
-                }
-            }
-
-        }
-    }
-
-
-    m = 0;
+    // The estimation output replaces the rows from the start year on, a forecast inserts all of its years
     if (ForecastName == "") {
-        cmd = "REPLACE INTO " + BiomassTable + " (MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Year,Value) VALUES ";
-        for (int species=0; species<NumSpeciesOrGuilds; ++ species) { // Species
-            for (int time=StartYear; time<=RunLength; ++time) { // Time in years
-                if (std::isnan(EstimatedBiomassBySpecies(time,species))) {
-                    EstimatedBiomassBySpecies(time,species) = -1;
-                }
-                cmd += "('"   + m_MohnsRhoLabel +
-                        "','" + Algorithm +
-                        "','" + Minimizer +
-                        "','" + ObjectiveCriterion +
-                        "','" + Scaling +
-                        "',"  + isAggProdStr +
-                        ",'"  + SpeciesList[species].toStdString() +
-                        "',"  + std::to_string(time) +
-                        ","   + std::to_string(EstimatedBiomassBySpecies(time,species)) + "),";
-            }
-        }
+        Verb      = "REPLACE";
+        FirstYear = StartYear;
+        Fields    = {"MohnsRhoLabel"};
+        Keys      = {QString::fromStdString(m_MohnsRhoLabel)};
     } else {
+        Verb      = "INSERT";
+        FirstYear = 0;
+        Fields    = {"ForecastName"};
+        Keys      = {QString::fromStdString(ForecastName)};
         if (isMonteCarlo) {
-            cmd = "INSERT INTO " + BiomassTable + " (ForecastName,RunNum,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Year,Value) VALUES ";
-            for (int species=0; species<NumSpeciesOrGuilds; ++ species) { // Species
-                for (int time=0; time<=RunLength; ++time) { // Time in years
-                    if (std::isnan(EstimatedBiomassBySpecies(time,species))) {
-                        EstimatedBiomassBySpecies(time,species) = -1;
-                    }
-                    cmd += "('"   + ForecastName + "'," + std::to_string(RunNum) +
-                            ",'"  + Algorithm +
-                            "','" + Minimizer +
-                            "','" + ObjectiveCriterion +
-                            "','" + Scaling +
-                            "',"  + isAggProdStr +
-                            ",'"  + SpeciesList[species].toStdString() +
-                            "',"  + std::to_string(time) +
-                            ","   + std::to_string(EstimatedBiomassBySpecies(time,species)) + "),";
-                }
-            }
-        } else {
-            cmd = "INSERT INTO " + BiomassTable + " (ForecastName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Year,Value) VALUES ";
-            for (int species=0; species<NumSpeciesOrGuilds; ++ species) { // Species
-                for (int time=0; time<=RunLength; ++time) { // Time in years
-                    if (std::isnan(EstimatedBiomassBySpecies(time,species))) {
-                        EstimatedBiomassBySpecies(time,species) = -1;
-                    }
-                    cmd += "('"   + ForecastName +
-                            "','" + Algorithm +
-                            "','" + Minimizer +
-                            "','" + ObjectiveCriterion +
-                            "','" + Scaling +
-                            "',"  + isAggProdStr +
-                            ",'"  + SpeciesList[species].toStdString() +
-                            "',"  + std::to_string(time) +
-                            ","   + std::to_string(EstimatedBiomassBySpecies(time,species)) + "),";
-                }
+            Fields.push_back("RunNum");
+            Keys.append(RunNum);
+        }
+    }
+    Fields.insert(Fields.end(),{"Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Year","Value"});
+    Keys << QString::fromStdString(Algorithm)
+         << QString::fromStdString(Minimizer)
+         << QString::fromStdString(ObjectiveCriterion)
+         << QString::fromStdString(Scaling)
+         << QString::fromStdString(isAggProdStr).toInt();
+
+    writeOK = writer.begin();
+    writer.prepare(Verb,BiomassTable,Fields);
+    for (int species=0; writeOK && species<NumSpeciesOrGuilds; ++ species) { // Species
+        for (int time=FirstYear; writeOK && time<=RunLength; ++time) { // Time in years
+            if (std::isnan(EstimatedBiomassBySpecies(time,species))) {
+                EstimatedBiomassBySpecies(time,species) = -1;
             }
+            writeOK = writer.addRow(Keys + QVariantList({SpeciesList[species],time,
+                                                         EstimatedBiomassBySpecies(time,species)}));
         }
     }
-
-    cmd = cmd.substr(0,cmd.size()-1);
-    errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-    if (errorMsg != " ") {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 8] UpdateOutputBiomassTable: Write table error: " + errorMsg);
-        m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
+    if (! writeOK || ! writer.commit()) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 8] UpdateOutputBiomassTable: Write table error: " + writer.lastError());
+        m_Logger->logMsg(nmfConstants::Error,"table: " + BiomassTable);
         return false;
     }
 
@@ -4121,6 +3550,153 @@ nmfMainWindow::callback_RestoreOutputSpecies()
     Output_Controls_ptr->setOutputSpecies(Estimation_Tab1_ptr->getOutputSpecies());
 }
 
+bool
+nmfMainWindow::loadPreviewInputs()
+{
+    int RunLength;
+    int InitialYear;
+    std::string Algorithm;
+    std::string Minimizer;
+    std::string ObjectiveCriterion;
+    std::string Scaling;
+    std::string GrowthForm;
+    std::string HarvestForm;
+    std::string CompetitionForm;
+    std::string PredationForm;
+    std::string isAggProdStr;
+    std::unique_ptr<nmfProjectionInputs> inputs = std::make_unique<nmfProjectionInputs>();
+
+    m_DatabasePtr->getAlgorithmIdentifiers(
+                this,m_Logger,m_ProjectSettingsConfig,
+                Algorithm,Minimizer,ObjectiveCriterion,
+                Scaling,CompetitionForm,nmfConstantsMSSPM::DontShowPopupError);
+    if (! getModelFormData(GrowthForm,HarvestForm,CompetitionForm,PredationForm,RunLength,InitialYear)) {
+        return false;
+    }
+    if (CompetitionForm == "AGG-PROD") {
+        // The Modify slider edits per Species values and AGG-PROD projects per Guild
+        return false;
+    }
+    isAggProdStr = "0";
+
+    if (! loadProjectionInputs("",RunLength,false,
+                               Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
+                               GrowthForm,HarvestForm,CompetitionForm,PredationForm,
+                               "OutputGrowthRate","OutputCarryingCapacity","OutputCatchability",
+                               m_PreviewSpeciesList,*inputs)) {
+        return false;
+    }
+    if (! getTimeSeriesData(m_MohnsRhoLabel,"","ObservedBiomass",
+                            inputs->System.NumSpeciesOrGuilds,RunLength,m_PreviewObservedBiomass)) {
+        return false;
+    }
+
+    m_PreviewEstGrowthRates        = inputs->Parameters.GrowthRate;
+    m_PreviewEstCarryingCapacities = inputs->Parameters.CarryingCapacity;
+    m_PreviewStartYear             = InitialYear;
+    m_PreviewAlgorithmIdentifiers  = {Algorithm,Minimizer,ObjectiveCriterion,Scaling};
+    nmfUtils::initialize(m_PreviewBiomassSpecies,RunLength+1,inputs->System.NumSpeciesOrGuilds);
+    nmfUtils::initialize(m_PreviewBiomassGuilds, RunLength+1,inputs->System.NumGuilds);
+    for (int i=0; i<inputs->System.NumSpeciesOrGuilds; ++i) {
+        m_PreviewBiomassSpecies(0,i) = inputs->InitialBiomass[i];
+    }
+    m_PreviewInputs = std::move(inputs);
+
+    return true;
+}
+
+void
+nmfMainWindow::callback_PreviewModifiedParameters()
+{
+    int SpeciesNum;
+    int NumSpecies;
+    int RunLength;
+    int NumLines = 1;
+    double ScaleVal;
+    double YMinSliderVal = Output_Controls_ptr->getYMinSliderVal();
+    QString ScaleStr     = Output_Controls_ptr->getOutputScale();
+    QString OutputSpecies = Output_Controls_ptr->getOutputSpecies();
+    QList<double> BMSYValues;
+    std::map<QString,double> ModifiedGrowthRates;
+    std::map<QString,double> ModifiedCarryingCapacities;
+    std::vector<std::string> Algorithms;
+    std::vector<std::string> Minimizers;
+    std::vector<std::string> ObjectiveCriteria;
+    std::vector<std::string> Scalings;
+    std::vector<boost::numeric::ublas::matrix<double> > OutputBiomass;
+
+    if (Output_Controls_ptr->getOutputChartType() != "Biomass vs Time") {
+        return;
+    }
+    // The database is read only once per slider drag
+    if ((m_PreviewInputs == nullptr) && (! loadPreviewInputs())) {
+        return;
+    }
+    nmfProjectionInputs& Inputs = *m_PreviewInputs;
+    NumSpecies = Inputs.System.NumSpeciesOrGuilds;
+    RunLength  = Inputs.System.NumYears-1;
+
+    // Start from the estimated parameters and apply the (unsaved) modified values
+    Estimation_Tab1_ptr->getSelectedSpeciesValues("GrowthRate",ModifiedGrowthRates);
+    Estimation_Tab1_ptr->getSelectedSpeciesValues("SpeciesK",  ModifiedCarryingCapacities);
+    Inputs.Parameters.GrowthRate       = m_PreviewEstGrowthRates;
+    Inputs.Parameters.CarryingCapacity = m_PreviewEstCarryingCapacities;
+    for (const std::pair<const QString,double>& modified : ModifiedGrowthRates) {
+        SpeciesNum = m_PreviewSpeciesList.indexOf(modified.first);
+        if (SpeciesNum >= 0) {
+            Inputs.Parameters.GrowthRate[SpeciesNum] = modified.second;
+        }
+    }
+    for (const std::pair<const QString,double>& modified : ModifiedCarryingCapacities) {
+        SpeciesNum = m_PreviewSpeciesList.indexOf(modified.first);
+        if (SpeciesNum >= 0) {
+            Inputs.Parameters.CarryingCapacity[SpeciesNum] = modified.second;
+        }
+    }
+
+    // Species are coupled through the competition and predation terms, so the
+    // whole system is re-projected. This reuses the preview matrices and scratch.
+    Inputs.Project(Inputs.System,Inputs.Parameters,m_PreviewScratch,
+                   m_PreviewBiomassSpecies,m_PreviewBiomassGuilds);
+
+    for (int i=0; i<NumSpecies; ++i) {
+        BMSYValues.append(Inputs.Parameters.CarryingCapacity[i]/2.0);
+    }
+    Algorithms.push_back(m_PreviewAlgorithmIdentifiers[0]);
+    Minimizers.push_back(m_PreviewAlgorithmIdentifiers[1]);
+    ObjectiveCriteria.push_back(m_PreviewAlgorithmIdentifiers[2]);
+    Scalings.push_back(m_PreviewAlgorithmIdentifiers[3]);
+    OutputBiomass.push_back(m_PreviewBiomassSpecies);
+    SpeciesNum = Output_Controls_ptr->getSpeciesNumFromName(OutputSpecies);
+    if ((SpeciesNum < 0) || (SpeciesNum >= NumSpecies)) {
+        return;
+    }
+    ScaleVal   = convertUnitsStringToValue(ScaleStr);
+
+    showChartBiomassVsTime(NumSpecies,OutputSpecies,
+                           SpeciesNum,RunLength,m_PreviewStartYear,
+                           NumLines,
+                           Algorithms,
+                           Minimizers,
+                           ObjectiveCriteria,
+                           Scalings,
+                           OutputBiomass,
+                           m_PreviewObservedBiomass,
+                           BMSYValues,
+                           ScaleStr,ScaleVal,
+                           YMinSliderVal);
+    Output_Controls_ptr->clearOutputBMSY();
+    if (Output_Controls_ptr->isCheckedOutputBMSY()) {
+        Output_Controls_ptr->setTextOutputBMSY(QString::number(BMSYValues[SpeciesNum]/ScaleVal));
+    }
+}
+
+void
+nmfMainWindow::callback_PreviewFinished()
+{
+    m_PreviewInputs.reset();
+}
+
 void
 nmfMainWindow::callback_EnableFilterButtons(bool state)
 {
@@ -4193,6 +3769,7 @@ bool
 nmfMainWindow::callback_ShowChart(QString OutputType,
                                   QString OutputSpecies)
 {
+    NMF_TRACE_SCOPE("chart","nmfMainWindow::callback_ShowChart");
     bool isAlpha;
     bool isMsProd;
     bool isRho;
@@ -7348,6 +6925,11 @@ nmfMainWindow::readSettings()
     m_ForecastFontSize = settings->value("FontSize",9).toInt();
     settings->endGroup();
 
+    // Early termination of dominated Least Squares projections (0 means off)
+    settings->beginGroup("Estimation");
+    m_PruneSlackFactor = settings->value("PruneSlackFactor",0.0).toDouble();
+    settings->endGroup();
+
     settings->beginGroup("Preferences");
     m_MShotNumRows = settings->value("MShotNumRows",3).toInt();
     m_MShotNumCols = settings->value("MShotNumCols",4).toInt();
@@ -7567,6 +7149,9 @@ nmfMainWindow::callback_RunEstimation(bool showDiagnosticsChart)
         return;
     }
 
+    m_CancelToken = nmfCancellationToken();
+    beginTraceSession();
+
     // Get current algorithm and run its estimation routine
     std::string Algorithm = Estimation_Tab6_ptr->getCurrentAlgorithm();
 
@@ -7587,6 +7172,120 @@ nmfMainWindow::callback_RunEstimation(bool showDiagnosticsChart)
     setCurrentOutputTab("Chart");
 }
 
+void
+nmfMainWindow::callback_ResumeEstimation()
+{
+    // The estimators read the flag while the run is being set up
+    m_isResumeRun = true;
+    callback_CheckEstimationTablesAndRun();
+    m_isResumeRun = false;
+}
+
+std::string
+nmfMainWindow::getCheckpointFile(const std::string& Algorithm)
+{
+    QString fileName = QString::fromStdString(m_ProjectSettingsConfig + "_" + Algorithm + ".checkpoint");
+
+    fileName.replace(" ","_");
+
+    return QDir(QDir(QString::fromStdString(m_ProjectDir)).filePath("outputData")).filePath(fileName).toStdString();
+}
+
+bool
+nmfMainWindow::findCachedResult(const std::string&         Algorithm,
+                                const Data_Struct&         dataStruct,
+                                const std::vector<double>& InitialParameters,
+                                nmfEstimationCacheEntry&   Entry)
+{
+    nmfEstimationCache cache(m_DatabasePtr,m_Logger);
+
+    m_CacheAlgorithm = Algorithm;
+    m_CacheHash      = nmfEstimationCache::hash(Algorithm,dataStruct,InitialParameters);
+    m_isCacheHit     = (! Estimation_Tab6_ptr->isForceRerun()) && cache.find(m_CacheHash,Entry);
+
+    Estimation_Tab6_ptr->setCacheStatus(m_isCacheHit ? "Cache: hit" : "Cache: miss");
+    if (m_isCacheHit) {
+        m_Logger->logMsg(nmfConstants::Normal,"Reusing the cached result of an identical estimation");
+    }
+
+    return m_isCacheHit;
+}
+
+void
+nmfMainWindow::storeCachedResult()
+{
+    bool ok = false;
+    nmfEstimationCacheEntry entry;
+
+    // A reused result is already in the cache
+    if (m_isCacheHit || m_CacheHash.empty()) {
+        return;
+    }
+
+    if ((m_CacheAlgorithm == "NLopt Algorithm") && (m_Estimator_NLopt != nullptr)) {
+        ok = m_Estimator_NLopt->getBestFitness(entry.Fitness) &&
+             m_Estimator_NLopt->getEstParameters(entry.Parameters,entry.FitnessStdDev);
+    } else if ((m_CacheAlgorithm == "Bees Algorithm") && (m_Estimator_Bees != nullptr)) {
+        ok = m_Estimator_Bees->getBestFitness(entry.Fitness) &&
+             m_Estimator_Bees->getEstimatedParameters(entry.Parameters,entry.FitnessStdDev);
+    }
+    if (ok) {
+        nmfEstimationCache cache(m_DatabasePtr,m_Logger);
+        cache.store(m_CacheHash,m_ProjectSettingsConfig,m_CacheAlgorithm,entry);
+    }
+    m_CacheHash.clear();
+}
+
+void
+nmfMainWindow::beginTraceSession()
+{
+    if (nmfTrace::isCompiledIn()) {
+        nmfTrace::instance().begin();
+    }
+}
+
+QString
+nmfMainWindow::endTraceSession(const std::string& SessionName)
+{
+    QString msg;
+    QString path = QDir(QString::fromStdString(m_ProjectDir)).filePath("outputData");
+    QString fileName = QString::fromStdString(m_ProjectSettingsConfig + "_" + SessionName + ".trace.json");
+    std::vector<std::pair<std::string,nmfTraceTotal> > Totals;
+
+    if (! nmfTrace::instance().isActive()) {
+        return msg;
+    }
+    nmfTrace::instance().end();
+
+    fileName.replace(" ","_");
+    QDir().mkpath(path);
+    fileName = QDir(path).filePath(fileName);
+    if (nmfTrace::instance().write(fileName.toStdString())) {
+        m_Logger->logMsg(nmfConstants::Normal,"Wrote trace file: " + fileName.toStdString());
+    } else {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] nmfMainWindow::endTraceSession: Couldn't write trace file: " +
+                         fileName.toStdString());
+    }
+
+    // Longest stages first (a stage's time includes that of the stages it calls)
+    for (const auto& item : nmfTrace::instance().totals()) {
+        Totals.push_back(item);
+    }
+    std::sort(Totals.begin(),Totals.end(),
+              [](const std::pair<std::string,nmfTraceTotal>& a,
+                 const std::pair<std::string,nmfTraceTotal>& b) {
+        return a.second.Seconds > b.second.Seconds;
+    });
+    msg = "<br><br><strong>Stage Timings</strong><br>";
+    for (const std::pair<std::string,nmfTraceTotal>& Total : Totals) {
+        msg += "<br>" + QString::fromStdString(Total.first) + ":&nbsp;&nbsp;" +
+                QString::number(Total.second.Seconds,'f',3) + " sec (" +
+                QString::number(qlonglong(Total.second.Count)) + " calls)";
+    }
+
+    return msg;
+}
+
 void
 nmfMainWindow::callback_ForecastLoaded(std::string ForecastName)
 {
@@ -7604,16 +7303,30 @@ void
 nmfMainWindow::callback_RunForecast(std::string ForecastName,
                                     bool GenerateBiomass)
 {
+    // A forecast run as part of an estimation is traced in the estimation's session
+    bool isTraceSession = ! nmfTrace::instance().isActive();
+
+    if (isTraceSession) {
+        beginTraceSession();
+    }
+    runForecast(ForecastName,GenerateBiomass);
+    if (isTraceSession) {
+        endTraceSession("Forecast");
+    }
+}
+
+void
+nmfMainWindow::runForecast(std::string ForecastName,
+                           bool        GenerateBiomass)
+{
+    NMF_TRACE_SCOPE("forecast","nmfMainWindow::callback_RunForecast");
     bool updateOK = true;
-    bool isMonteCarlo;
     bool isAggProd;
     // int NumSpecies;
     int RunLength = 0;
     int StartYear = nmfConstantsMSSPM::Start_Year;
-    int NullStartYear = 0;
     int EndYear = StartYear;
     int NumRuns = 0;
-    int RunNum = 0;
     std::vector<std::string> fields;
     std::map<std::string, std::vector<std::string> > dataMap;
     std::string queryStr;
@@ -7686,34 +7399,21 @@ nmfMainWindow::callback_RunForecast(std::string ForecastName,
 
     if (GenerateBiomass)
     {
-        // Calculate Monte Carlo simulations
-        isMonteCarlo = true;
+        // Calculate Monte Carlo simulations along with the Forecast Biomass without any errors
+        // (so it appears superimposed over the simulations). The inputs are loaded once for all runs.
         clearOutputBiomassTable(ForecastName,Algorithm,Minimizer,
                                 ObjectiveCriterion,Scaling,
                                 isAggProdStr,BiomassMonteCarloTable);
-        for (RunNum=0; RunNum<NumRuns; ++RunNum) {
-            updateOK = updateOutputBiomassTable(ForecastName,NullStartYear,RunLength,isMonteCarlo,RunNum,
-                                                Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
-                                                GrowthForm,HarvestForm,CompetitionForm,PredationForm,
-                                                GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
-                                                BiomassMonteCarloTable);
-            if (! updateOK) {
-                m_Logger->logMsg(nmfConstants::Error,"[Error 1] callback_RunForecast: Problem with Monte Carlo simulation");
-                m_UI->ForecastDataInputTabWidget->setCursor(Qt::ArrowCursor);
-                return;
-            }
-        }
-        // Calculate Forecast Biomass without any errors and ensure it appears superimposed over
-        // Monte Carlo simulations
-        isMonteCarlo = false;
-        RunNum = 0;
         clearOutputBiomassTable(ForecastName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,
                                 isAggProdStr,BiomassTable);
-        updateOK = updateOutputBiomassTable(ForecastName,NullStartYear,RunLength,isMonteCarlo,RunNum,
-                                            Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
-                                            GrowthForm,HarvestForm,CompetitionForm,PredationForm,
-                                            GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
-                                            BiomassTable);
+        updateOK = runForecastBatch(ForecastName,RunLength,NumRuns,
+                                    Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
+                                    GrowthForm,HarvestForm,CompetitionForm,PredationForm,
+                                    GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
+                                    BiomassTable,BiomassMonteCarloTable);
+        if (! updateOK) {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 1] callback_RunForecast: Problem with Monte Carlo simulation");
+        }
     }
     if (! updateOK) {
         m_UI->ForecastDataInputTabWidget->setCursor(Qt::ArrowCursor);
@@ -7742,7 +7442,139 @@ nmfMainWindow::callback_RunForecast(std::string ForecastName,
     // Assure Output tab is set to Chart
     setCurrentOutputTab("Chart");
 
-} // end callback_RunForecast
+} // end runForecast
+
+bool
+nmfMainWindow::runForecastBatch(const std::string& ForecastName,
+                                const int&         RunLength,
+                                const int&         NumRuns,
+                                const std::string& Algorithm,
+                                const std::string& Minimizer,
+                                const std::string& ObjectiveCriterion,
+                                const std::string& Scaling,
+                                const std::string& isAggProdStr,
+                                const std::string& GrowthForm,
+                                const std::string& HarvestForm,
+                                const std::string& CompetitionForm,
+                                const std::string& PredationForm,
+                                const std::string& GrowthRateTable,
+                                const std::string& CarryingCapacityTable,
+                                const std::string& CatchabilityTable,
+                                const std::string& BiomassTable,
+                                const std::string& BiomassMonteCarloTable)
+{
+    QStringList SpeciesList;
+    nmfProjectionInputs Inputs;
+    nmfForecastUncertainty Uncertainty;
+    std::vector<boost::numeric::ublas::matrix<double> > Biomass(1);
+    std::vector<boost::numeric::ublas::matrix<double> > MonteCarloBiomass;
+
+    if (! loadProjectionInputs(ForecastName,RunLength,false,
+                               Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
+                               GrowthForm,HarvestForm,CompetitionForm,PredationForm,
+                               GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
+                               SpeciesList,Inputs)) {
+        return false;
+    }
+    nmfSystemLoader loader = getSystemLoader();
+    if (! loader.loadUncertaintyData(Inputs.System.NumSpeciesOrGuilds,ForecastName,
+                                     Algorithm,Minimizer,ObjectiveCriterion,Scaling,
+                                     Uncertainty)) {
+        showSystemLoaderError(loader);
+        return false;
+    }
+
+    // A non-deterministic forecast (i.e., no seed) draws a new base seed once per forecast
+    uint64_t StreamSeed = (m_SeedValue >= 0) ? uint64_t(m_SeedValue) : uint64_t(std::random_device{}());
+
+    // Run the batch off of the GUI thread so that the user can cancel it from the progress dialog
+    nmfForecastEngine engine(Inputs,Uncertainty,HarvestForm,CompetitionForm,PredationForm);
+    nmfCancellationToken cancelToken;
+    QProgressDialog progressDlg("Running Monte Carlo forecast...","Cancel",0,0,this);
+    progressDlg.setWindowModality(Qt::WindowModal);
+    progressDlg.setMinimumDuration(500);
+    QFutureWatcher<bool> watcher;
+    QEventLoop loop;
+    connect(&progressDlg, &QProgressDialog::canceled, [&]() {
+        cancelToken.cancel();
+    });
+    connect(&watcher,     SIGNAL(finished()),
+            &loop,        SLOT(quit()));
+    watcher.setFuture(QtConcurrent::run([&]() {
+        return engine.run(NumRuns,StreamSeed,MonteCarloBiomass,cancelToken);
+    }));
+    loop.exec();
+    watcher.waitForFinished();
+    progressDlg.reset();
+    if (! watcher.result()) {
+        m_Logger->logMsg(nmfConstants::Normal,"runForecastBatch: Monte Carlo forecast cancelled by user");
+        return false;
+    }
+    engine.project(Biomass[0]);
+
+    if (! writeForecastBiomass(ForecastName,true,Algorithm,Minimizer,ObjectiveCriterion,Scaling,
+                               isAggProdStr,SpeciesList,BiomassMonteCarloTable,MonteCarloBiomass)) {
+        return false;
+    }
+    return writeForecastBiomass(ForecastName,false,Algorithm,Minimizer,ObjectiveCriterion,Scaling,
+                                isAggProdStr,SpeciesList,BiomassTable,Biomass);
+}
+
+bool
+nmfMainWindow::writeForecastBiomass(const std::string& ForecastName,
+                                    const bool&        isMonteCarlo,
+                                    const std::string& Algorithm,
+                                    const std::string& Minimizer,
+                                    const std::string& ObjectiveCriterion,
+                                    const std::string& Scaling,
+                                    const std::string& isAggProdStr,
+                                    const QStringList& SpeciesList,
+                                    const std::string& BiomassTable,
+                                    std::vector<boost::numeric::ublas::matrix<double> >& Biomass)
+{
+    int NumRuns = Biomass.size();
+    bool writeOK;
+    std::vector<std::string> Fields = {"ForecastName"};
+    QVariantList Keys;
+    nmfBulkWriter writer;
+
+    if (isMonteCarlo) {
+        Fields.push_back("RunNum");
+    }
+    Fields.insert(Fields.end(),{"Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Year","Value"});
+
+    // All of the runs are written in chunks inside a single transaction
+    writeOK = writer.begin();
+    writer.prepare("INSERT",BiomassTable,Fields);
+    for (int RunNum=0; writeOK && RunNum<NumRuns; ++RunNum) {
+        boost::numeric::ublas::matrix<double>& RunBiomass = Biomass[RunNum];
+        Keys = {QString::fromStdString(ForecastName)};
+        if (isMonteCarlo) {
+            Keys.append(RunNum);
+        }
+        Keys << QString::fromStdString(Algorithm)
+             << QString::fromStdString(Minimizer)
+             << QString::fromStdString(ObjectiveCriterion)
+             << QString::fromStdString(Scaling)
+             << QString::fromStdString(isAggProdStr).toInt();
+        for (unsigned species=0; writeOK && species<RunBiomass.size2(); ++species) {
+            for (unsigned time=0; writeOK && time<RunBiomass.size1(); ++time) {
+                if (std::isnan(RunBiomass(time,species))) {
+                    RunBiomass(time,species) = -1;
+                }
+                writeOK = writer.addRow(Keys + QVariantList({SpeciesList[species],int(time),
+                                                             RunBiomass(time,species)}));
+            }
+        }
+    }
+    if (! writeOK || ! writer.commit()) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] writeForecastBiomass: Write table error: " + writer.lastError());
+        m_Logger->logMsg(nmfConstants::Error,"table: " + BiomassTable);
+        return false;
+    }
+
+    return true;
+}
 
 
 void
@@ -7761,16 +7593,30 @@ nmfMainWindow::callback_LoadDataStruct()
 void
 nmfMainWindow::runBeesAlgorithm(bool showDiagnosticChart)
 {
+    std::vector<double> InitialParameters;
+    nmfEstimationCacheEntry cachedResult;
     bool loadOK = loadParameters(m_DataStruct,nmfConstantsMSSPM::VerboseOn);
     if (! loadOK) {
         std::cout << "Run cancelled. LoadParameters returned: " << loadOK << std::endl;
         return;
     }
     m_DataStruct.showDiagnosticChart = showDiagnosticChart;
+    loadWarmStartParameters("Bees Algorithm",m_DataStruct,InitialParameters);
 
     m_Estimator_Bees = new Bees_Estimator();
+    m_Estimator_Bees->setCancellationToken(m_CancelToken);
+    m_Estimator_Bees->setInitialParameters(InitialParameters);
+    m_Estimator_Bees->setCheckpoint(getCheckpointFile("Bees Algorithm"),m_isResumeRun);
+    if (findCachedResult("Bees Algorithm",m_DataStruct,InitialParameters,cachedResult)) {
+        m_Estimator_Bees->setCachedResult(cachedResult.Parameters,cachedResult.Fitness,
+                                          cachedResult.FitnessStdDev);
+    }
+    m_ProgressChannel = nullptr; // the Bees algorithm writes the progress file itself
 
     // Set up connections
+    connect(m_ProgressWidget, SIGNAL(StopTheRun()),
+            this,             SLOT(callback_StopTheRun()),
+            Qt::UniqueConnection);
     disconnect(m_Estimator_Bees, 0, 0, 0);
     connect(m_Estimator_Bees, SIGNAL(RunCompleted(std::string,bool)),
             this,             SLOT(callback_RunCompleted(std::string,bool)));
@@ -7818,20 +7664,32 @@ nmfMainWindow::runBeesAlgorithm(bool showDiagnosticChart)
 void
 nmfMainWindow::runNLoptAlgorithm(bool showDiagnosticChart)
 {
+    std::vector<double> InitialParameters;
+    nmfEstimationCacheEntry cachedResult;
     bool loadOK = loadParameters(m_DataStruct,nmfConstantsMSSPM::VerboseOn);
     if (! loadOK) {
         std::cout << "Run cancelled. LoadParameters returned: " << loadOK << std::endl;
         return;
     }
     m_DataStruct.showDiagnosticChart = showDiagnosticChart;
+    loadWarmStartParameters("NLopt Algorithm",m_DataStruct,InitialParameters);
 
     // Create the NLopt object
     m_Estimator_NLopt = new NLopt_Estimator();
+    m_Estimator_NLopt->setCancellationToken(m_CancelToken);
+    m_Estimator_NLopt->setPruneSlackFactor(m_PruneSlackFactor);
+    m_Estimator_NLopt->setInitialParameters(InitialParameters);
+    m_Estimator_NLopt->setCheckpoint(getCheckpointFile("NLopt Algorithm"),m_isResumeRun);
+    if (findCachedResult("NLopt Algorithm",m_DataStruct,InitialParameters,cachedResult)) {
+        m_Estimator_NLopt->setCachedResult(cachedResult.Parameters,cachedResult.Fitness,
+                                           cachedResult.FitnessStdDev);
+    }
+    m_ProgressChannel = m_Estimator_NLopt->getProgressChannel();
 
     // Set up connections
     disconnect(m_ProgressWidget, 0, 0, 0);
     connect(m_ProgressWidget,  SIGNAL(StopTheRun()),
-            m_Estimator_NLopt, SLOT(callback_StopTheOptimizer()));
+            this,              SLOT(callback_StopTheRun()));
     connect(m_ProgressWidget,  SIGNAL(RedrawValidPointsOnly(bool,bool)),
             this,              SLOT(callback_ReadProgressChartDataFile(bool,bool)));
     disconnect(m_Estimator_NLopt, 0, 0, 0);
@@ -8029,7 +7887,12 @@ void
 nmfMainWindow::callback_RunCompleted(std::string output, bool showDiagnosticChart)
 {
 std::cout << "=====>>>>> run completed" << std::endl;
+    // A run that completed just as the user stopped it is discarded
+    if (m_CancelToken.isCancelled()) {
+        return;
+    }
     m_Logger->logMsg(nmfConstants::Normal,"Run Completed");
+    storeCachedResult();
 
     // Set Chart Type to "Biomass vs Time"
     Output_Controls_ptr->setOutputType("Biomass vs Time");
@@ -8041,6 +7904,9 @@ std::cout << "=====>>>>> run completed" << std::endl;
     msg += "<br>Competition Form:&nbsp;&nbsp;" + QString::fromStdString(m_DataStruct.CompetitionForm);
     msg += "<br>Predation Form:&nbsp;&nbsp;&nbsp;&nbsp;" + QString::fromStdString(m_DataStruct.PredationForm);
     msg += "<br>Scaling Algorithm:&nbsp;" + QString::fromStdString(m_DataStruct.Scaling);
+    if (m_isCacheHit) {
+        msg += "<br><br>(result reused from the estimation cache)";
+    }
     msg += "<br><br>" + QString::fromStdString(output);
     Estimation_Tab6_ptr->setOutputTE("");
     Estimation_Tab6_ptr->appendOutputTE(msg);
@@ -8048,10 +7914,13 @@ std::cout << "=====>>>>> run completed" << std::endl;
     m_RunOutputMsg = msg;
 
     menu_saveAndShowCurrentRun(showDiagnosticChart);
-    if (isMohnsRho()) {
-        runNextMohnsRhoEstimation();
-    } else {
-        callback_UpdateSummaryStatistics();
+    callback_UpdateSummaryStatistics();
+
+    // The stage timings cover the estimation, output tables and charts
+    QString timings = endTraceSession("Estimation");
+    if (! timings.isEmpty()) {
+        Estimation_Tab6_ptr->appendOutputTE(timings);
+        m_RunOutputMsg += timings;
     }
 
     m_ProgressWidget->showLegend();
@@ -8082,6 +7951,12 @@ nmfMainWindow::callback_ShowRunMessage(QString fontName)
     Estimation_Tab6_ptr->refreshMsg(font,m_RunOutputMsg);
 }
 
+void
+nmfMainWindow::callback_StopTheRun()
+{
+    m_CancelToken.cancel();
+}
+
 void
 nmfMainWindow::callback_StoreOutputSpecies()
 {
@@ -8113,14 +7988,27 @@ nmfMainWindow::callback_RunDiagnosticEstimation(
 {
     int RunLength;
     int InitialYear;
+    int NumPeels = MohnsRhoRanges.size();
     std::string GrowthForm;
     std::string HarvestForm;
     std::string CompetitionForm;
     std::string PredationForm;
     std::string HarvestTable = "Catch";
     std::string ObservedBiomassTable = "ObservedBiomass";
+    std::string Algorithm = Estimation_Tab6_ptr->getCurrentAlgorithm();
+    Data_Struct dataStruct;
+    nmfRetrospectivePeel Peel;
+    std::vector<nmfRetrospectivePeel> Peels;
+    std::vector<nmfEstimationResult> Results;
+    std::vector<double> InitialParameters;
 
-    // First run the Mohns Rho
+    if (isEstimationRunning()) {
+        QMessageBox::information(this,
+                                 tr("MSSPM Run In Progress"),
+                                 tr("\nStop current Run before beginning another.\n"),
+                                 QMessageBox::Ok);
+        return;
+    }
     if (! getModelFormData(GrowthForm,HarvestForm,CompetitionForm,PredationForm,RunLength,InitialYear))
         return;
     if (HarvestForm == "Effort (qE)") {
@@ -8129,19 +8017,79 @@ nmfMainWindow::callback_RunDiagnosticEstimation(
         HarvestTable = "Exploitation";
     }
 
-    m_MohnsRhoRanges    = MohnsRhoRanges;
-    m_NumMohnsRhoRanges = m_MohnsRhoRanges.size();
-    m_MohnsRhoLabel     = getMohnsRhoLabel(m_NumMohnsRhoRanges);
-
-    deleteAllMohnsRho(HarvestTable);
-    deleteAllMohnsRho(ObservedBiomassTable);
-    deleteAllOutputMohnsRho();
+    m_CancelToken    = nmfCancellationToken();
+    m_MohnsRhoRanges = MohnsRhoRanges;
+    m_MohnsRhoLabel.clear();
+
+    // Remove the previous analysis (including any time series written by earlier versions)
+    deleteAllMohnsRho(HarvestTable);
+    deleteAllMohnsRho(ObservedBiomassTable);
+    deleteAllOutputMohnsRho();
+
+    // Each range is a slice of the full range's time series, so the System is read once
+    if (! loadParameters(dataStruct,nmfConstantsMSSPM::VerboseOff)) {
+        return;
+    }
+    dataStruct.showDiagnosticChart = false;
+    for (int i=0; i<NumPeels; ++i) {
+        Peel.Label     = getMohnsRhoLabel(i);
+        Peel.FirstYear = m_MohnsRhoRanges[i].first - InitialYear;
+        Peel.RunLength = m_MohnsRhoRanges[i].second - m_MohnsRhoRanges[i].first;
+        Peels.push_back(Peel);
+    }
+    m_Logger->logMsg(nmfConstants::Normal,"Start MohnsRhoAnalysis: " + std::to_string(NumPeels) + " ranges");
+
+    // A warm start seeds every range from the full range's estimate
+    loadWarmStartParameters(Algorithm,dataStruct,InitialParameters);
+
+    // Estimate all of the ranges off of the GUI thread so that the user can cancel them
+    nmfRetrospectiveEngine engine(Algorithm);
+    engine.setCancellationToken(m_CancelToken);
+    engine.setInitialParameters(InitialParameters);
+    QProgressDialog progressDlg("Running Mohn's Rho analysis...","Cancel",0,0,this);
+    progressDlg.setWindowModality(Qt::WindowModal);
+    progressDlg.setMinimumDuration(500);
+    QFutureWatcher<bool> watcher;
+    QEventLoop loop;
+    connect(&progressDlg, &QProgressDialog::canceled, [&]() {
+        m_CancelToken.cancel();
+    });
+    connect(&watcher,     SIGNAL(finished()),
+            &loop,        SLOT(quit()));
+    watcher.setFuture(QtConcurrent::run([&]() {
+        return engine.run(dataStruct,Peels,Results);
+    }));
+    loop.exec();
+    watcher.waitForFinished();
+    progressDlg.reset();
+    if (! watcher.result()) {
+        if (m_CancelToken.isCancelled()) {
+            m_Logger->logMsg(nmfConstants::Normal,"Mohn's Rho analysis stopped by user");
+        } else {
+            m_Logger->logMsg(nmfConstants::Error,"[Error 1] callback_RunDiagnosticEstimation: " + engine.getErrorMessage());
+            QMessageBox::warning(this, "Error",
+                                 "\n" + QString::fromStdString(engine.getErrorMessage()) + "\n",
+                                 QMessageBox::Ok);
+        }
+        return;
+    }
+
+    // Only the final results of each range are saved
+    for (int i=0; i<NumPeels; ++i) {
+        m_MohnsRhoLabel = Peels[i].Label;
+        saveMohnsRhoResult(Algorithm,dataStruct,Results[i]);
+    }
+    m_MohnsRhoLabel.clear();
+    m_Logger->logMsg(nmfConstants::Normal,"End MohnsRhoAnalysis");
 
-    runNextMohnsRhoEstimation();
+    // Display Mohn's Rho plot and update all statistics, assuring that the
+    // Summary Statistics are from the full range and not a Mohn's Rho range
+    Output_Controls_ptr->displayMohnsRho();
+    callback_UpdateSummaryStatistics();
+    updateDiagnosticSummaryStatistics();
 
     // Assure Output tab is set to Chart
     setCurrentOutputTab("Chart");
-
 }
 
 void
@@ -8151,135 +8099,61 @@ nmfMainWindow::setCurrentOutputTab(QString outputTab)
 }
 
 void
-nmfMainWindow::runNextMohnsRhoEstimation()
+nmfMainWindow::saveMohnsRhoResult(const std::string&         Algorithm,
+                                  const Data_Struct&         dataStruct,
+                                  const nmfEstimationResult& Result)
 {
-    bool ok;
-    int OriginalRunLength;
-    int OriginalStartYear;
-    int MohnsRhoRunLength;
-    int MohnsRhoStartYear;
-    int RunLength;
-    int InitialYear;
-    int firstYear;
-    int lastYear;
-    int StartYear;
-    QString MohnsRhoLabel;
-    QString OriginalSystemName = QString::fromStdString(m_ProjectSettingsConfig).split("__")[0];
-    QString MohnsRhoSystemName;
-    std::string HarvestTable = "Catch";
-    std::string ObservedBiomassTable = "ObservedBiomass";
-    std::string GrowthForm;
-    std::string HarvestForm;
-    std::string CompetitionForm;
-    std::string PredationForm;
-    std::string queryStr;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    QString SystemName;
-    QStringList parts;
+    int NumGuilds;
+    int NumSpecies;
+    bool writeOK;
+    bool isCompetitionAGGPROD = (dataStruct.CompetitionForm == "AGG-PROD");
+    std::string Minimizer          = dataStruct.Minimizer;
+    std::string ObjectiveCriterion = dataStruct.ObjectiveCriterion;
+    std::string Scaling            = dataStruct.Scaling;
+    std::string AlgorithmStr       = Algorithm;
+    QStringList GuildList;
+    QStringList SpeciesList;
+    QVariantList Keys;
+    nmfBulkWriter writer;
+    const boost::numeric::ublas::matrix<double>& Biomass = Result.EstimatedBiomass;
 
-    if (! getModelFormData(GrowthForm,HarvestForm,CompetitionForm,PredationForm,RunLength,InitialYear))
+    if (! getGuilds(NumGuilds,GuildList)) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] saveMohnsRhoResult: No records found in table Guilds, Name = "+m_ProjectSettingsConfig);
         return;
-    if (HarvestForm == "Effort (qE)") {
-        HarvestTable = "Effort";
-    } else if (HarvestForm == "Exploitation (F)") {
-        HarvestTable = "Exploitation";
     }
-
-    this->setCursor(Qt::WaitCursor);
-
-    if (--m_NumMohnsRhoRanges >= 0) {
-        firstYear = m_MohnsRhoRanges[m_NumMohnsRhoRanges].first;
-        lastYear  = m_MohnsRhoRanges[m_NumMohnsRhoRanges].second;
-        m_Logger->logMsg(nmfConstants::Normal,"Running Mohn's Rho: " + std::to_string(m_NumMohnsRhoRanges));
-        // 1. Save a System for each Mohn's Rhos range with appropriate
-        //    StartYear and RunLength
-        MohnsRhoLabel      = QString::fromStdString(getMohnsRhoLabel(m_NumMohnsRhoRanges));
-        MohnsRhoStartYear  = firstYear;
-        MohnsRhoRunLength  = lastYear - firstYear;
-        MohnsRhoSystemName = OriginalSystemName+"__"+MohnsRhoLabel;
-
-        m_Logger->logMsg(nmfConstants::Normal,"Start MohnsRhoAnalysis: " + MohnsRhoLabel.toStdString());
-
-        Setup_Tab4_ptr->setStartYear(MohnsRhoStartYear);
-        Setup_Tab4_ptr->setRunLength(MohnsRhoRunLength);
-        Setup_Tab4_ptr->setSystemName(MohnsRhoSystemName);
-
-        // RSK - Bug here.  The method saveSystem clears the StartYearLE
-        // widget. Resetting StartYear to patch.
-        StartYear = Diagnostic_Tab2_ptr->getStartYearLE();
-        Setup_Tab4_ptr->saveSystem(false);
-        Diagnostic_Tab2_ptr->setStartYearLE(StartYear);
-
-        Estimation_Tab6_ptr->saveSystem(false);
-
-        // 2. Modify Catch, Effort, or Exploitation tables and load
-        ok = modifyTable(HarvestTable,OriginalSystemName,MohnsRhoLabel,
-                         MohnsRhoStartYear,MohnsRhoRunLength,InitialYear);
-        if (! ok) {
-            m_Logger->logMsg(nmfConstants::Warning,"runNextMohnsRhoEstimation: modifyTable returned false for HarvestTable");
-        }
-        Estimation_Tab2_ptr->loadWidgets(MohnsRhoLabel);
-
-        // 3. Modify Observed Biomass table and load
-        ok = modifyTable(ObservedBiomassTable,OriginalSystemName,MohnsRhoLabel,
-                         MohnsRhoStartYear,MohnsRhoRunLength,InitialYear);
-        if (! ok) {
-            m_Logger->logMsg(nmfConstants::Warning,"runNextMohnsRhoEstimation: modifyTable returned false for ObservedBiomassTable");
-        }
-        Estimation_Tab5_ptr->loadWidgets(MohnsRhoLabel);
-
-        // 4. Run the Mohn's Rho system
-        m_MohnsRhoLabel = MohnsRhoLabel.toStdString();
-
-        callback_RunEstimation(nmfConstantsMSSPM::DontShowDiagnosticsChart);
+    if (isCompetitionAGGPROD) {
+        SpeciesList = GuildList;
+    } else if (! getSpecies(NumSpecies,SpeciesList)) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 2] saveMohnsRhoResult: No records found in table Species, Name = "+m_ProjectSettingsConfig);
+        return;
     }
 
-    this->setCursor(Qt::ArrowCursor);
-    m_Logger->logMsg(nmfConstants::Normal,"End MohnsRhoAnalysis: " + MohnsRhoLabel.toStdString());
-
-    // This means that the MohnsRho analysis has completed and there are no more ranges to process.
-    if (MohnsRhoLabel.isEmpty()) {
-        // 6. Display Mohn's Rho plot
-        Output_Controls_ptr->displayMohnsRho();
+    updateOutputTables(AlgorithmStr,Minimizer,ObjectiveCriterion,Scaling,
+                       isCompetitionAGGPROD,SpeciesList,GuildList,
+                       Result.GrowthRate,Result.CarryingCapacity,Result.Catchability,
+                       Result.CompetitionAlpha,Result.CompetitionBetaSpecies,
+                       Result.CompetitionBetaGuilds,Result.Predation,Result.Handling,
+                       Result.Exponent);
 
-        // 7. Reload original System
-        fields     = {"RunLength","StartYear"};
-        queryStr   = "SELECT RunLength,StartYear ";
-        queryStr  += "FROM Systems WHERE SystemName = '" + OriginalSystemName.toStdString() + "'";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        OriginalRunLength = std::stoi(dataMap["RunLength"][0]);
-        OriginalStartYear = std::stoi(dataMap["StartYear"][0]);
-        Setup_Tab4_ptr->setStartYear(OriginalStartYear);
-        Setup_Tab4_ptr->setRunLength(OriginalRunLength);
-        Setup_Tab4_ptr->setSystemName(OriginalSystemName);
-        Setup_Tab4_ptr->saveSystem(false);
-        Estimation_Tab6_ptr->saveSystem(false);
-
-        // Get all system names and delete the temporary Mohns Rho systems
-        fields   = {"SystemName"};
-        queryStr = "SELECT SystemName FROM Systems";
-        dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        for (unsigned i=0; i<dataMap["SystemName"].size(); ++i) {
-            SystemName = QString::fromStdString(dataMap["SystemName"][i]);
-            parts = SystemName.split("__");
-            if ((parts.size() == 2) && (parts[0] == OriginalSystemName)) {
-                Setup_Tab4_ptr->deleteSystem(SystemName);
-            }
+    // The range's years are relative to its own first year, as in the full range's output
+    Keys << QString::fromStdString(m_MohnsRhoLabel)
+         << QString::fromStdString(Algorithm)
+         << QString::fromStdString(Minimizer)
+         << QString::fromStdString(ObjectiveCriterion)
+         << QString::fromStdString(Scaling)
+         << int(isCompetitionAGGPROD);
+    writeOK = writer.begin();
+    writer.prepare("REPLACE","OutputBiomass",
+                   {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Year","Value"});
+    for (int species=0; writeOK && species<int(Biomass.size2()) && species<SpeciesList.size(); ++species) {
+        for (int time=0; writeOK && time<int(Biomass.size1()); ++time) {
+            writeOK = writer.addRow(Keys + QVariantList({SpeciesList[species],time,
+                                                         std::isnan(Biomass(time,species)) ? -1 : Biomass(time,species)}));
         }
-        saveSettings();
-        Diagnostic_Tab2_ptr->loadWidgets();
-        Diagnostic_Tab2_ptr->callback_Diagnostic_Tab2_PeelPositionCMB("");
-
-        m_MohnsRhoLabel.clear();
-
-        // Update all statistics, assure that the Summary Statistics
-        // are from the full range and not a Mohn's Rho range
-        callback_UpdateSummaryStatistics();
-        updateDiagnosticSummaryStatistics();
     }
-
-    Setup_Tab4_ptr->reloadSystemName();
+    if (! writeOK || ! writer.commit()) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 3] saveMohnsRhoResult: Write table error: " + writer.lastError());
+    }
 }
 
 
@@ -8431,94 +8305,6 @@ nmfMainWindow::deleteAllMohnsRho(const std::string& TableName)
     return true;
 }
 
-bool
-nmfMainWindow::modifyTable(
-        const std::string& TableName,
-        const QString& OriginalSystemName,
-        const QString& MohnsRhoLabel,
-        const int& MohnsRhoStartYear,
-        const int& MohnsRhoRunLength,
-        const int& InitialYear)
-{
-    int m;
-    int iInc;
-    int RunLength;
-    int NumSpecies;
-    int NumRecords;
-    int newMohnsRhoEndYear;
-    int newMohnsRhoStartYear;
-    std::string cmd;
-    std::string errorMsg;
-    std::string queryStr;
-    boost::numeric::ublas::matrix<double> OriginalData;
-    boost::numeric::ublas::matrix<double> MohnsRhoData;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    QStringList SpeciesList;
-
-    if (! getSpecies(NumSpecies,SpeciesList))
-            return false;
-
-    newMohnsRhoStartYear = MohnsRhoStartYear - InitialYear;
-
-    // Read Original data and store in matrix
-    fields     = {"MohnsRhoLabel","SystemName","SpeName","Year","Value"};
-    queryStr   = "SELECT MohnsRhoLabel,SystemName,SpeName,Year,Value";
-    queryStr  += " FROM " + TableName + " WHERE SystemName = '" + OriginalSystemName.toStdString();
-    queryStr  += "' AND MohnsRhoLabel = ''";
-    queryStr  += " ORDER BY SpeName,Year ";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["SystemName"].size();
-    if (NumRecords == 0) {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 2] ModifyTable: No records found");
-        m_Logger->logMsg(nmfConstants::Error,"queryStr: " + queryStr);
-        return false;
-    }
-
-    RunLength = (NumRecords/NumSpecies)-1;
-
-    nmfUtils::initialize(OriginalData,RunLength+1,NumSpecies);
-    m = 0;
-    for (int j=0; j<NumSpecies; ++j) {
-        for (int i=0; i<=RunLength; ++i) {
-            OriginalData(i,j) = std::stod(dataMap["Value"][m++]);
-        }
-    }
-
-    // Put the Mohns Rho data into its own matrix
-    newMohnsRhoEndYear = newMohnsRhoStartYear + MohnsRhoRunLength;
-    nmfUtils::initialize(MohnsRhoData,MohnsRhoRunLength+1,NumSpecies);
-
-    for (int j=0; j<NumSpecies; ++j) {
-        iInc = 0;
-        for (int i=newMohnsRhoStartYear; i<=newMohnsRhoEndYear; ++i) {
-            MohnsRhoData(iInc++,j) = OriginalData(i,j);
-        }
-    }
-
-    // Write out new data
-    cmd  = "REPLACE INTO " + TableName + " (MohnsRhoLabel,SystemName,SpeName,Year,Value) VALUES ";
-    for (int j=0; j<NumSpecies; ++j) {
-        for (int i=0; i<=MohnsRhoRunLength; ++i) {
-            cmd += "('"   + MohnsRhoLabel.toStdString() +
-                    "','" + OriginalSystemName.toStdString() +
-                    "','" + SpeciesList[j].toStdString() +
-                    "',"  + std::to_string(i) +
-                    ","   + std::to_string(MohnsRhoData(i,j)) + "),";
-        }
-    }
-
-    cmd = cmd.substr(0,cmd.size()-1);
-    errorMsg = m_DatabasePtr->nmfUpdateDatabase(cmd);
-    if (errorMsg != " ") {
-        m_Logger->logMsg(nmfConstants::Error,"[Error 3] ModifyTable: Write table error: " + errorMsg);
-        m_Logger->logMsg(nmfConstants::Error,"cmd: " + cmd);
-        return false;
-    }
-
-    return true;
-}
-
 void
 nmfMainWindow::callback_SetChartType(std::string type, std::string method)
 {
@@ -8740,616 +8526,60 @@ nmfMainWindow::getGuildData(const int&                             NumGuilds,
                             std::vector<int>&                      GuildNum,
                             boost::numeric::ublas::matrix<double>& ObservedBiomassByGuilds)
 {
-    int NumSpecies;
-    int guildNum;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    std::string guildName;
-    std::map<std::string,double> InitialGuildBiomass;
-    std::map<std::string,int> GuildMap;
-
-    GuildSpecies.clear();
-    GuildNum.clear();
-    InitialGuildBiomass.clear();
-    ObservedBiomassByGuilds.clear();
-
-    fields    = {"GuildName","GuildK"};
-    queryStr  = "SELECT GuildName,GuildK from Guilds ORDER by GuildName";
-    dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    for (int i=0; i<NumGuilds; ++i) {
-        guildName = dataMap["GuildName"][i];
-        GuildMap[guildName] = i;
-    }
-
-    // Load Growth Rate Min and Max
-    fields     = {"SpeName","GuildName","InitBiomass"};
-    queryStr   = "SELECT SpeName,GuildName,InitBiomass from Species ORDER BY SpeName";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumSpecies = dataMap["SpeName"].size();
-
-    for (int species=0; species<NumSpecies; ++species) {
-        guildName = dataMap["GuildName"][species];
-        guildNum  = GuildMap[guildName];
-        InitialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
-        GuildSpecies[guildNum].push_back(species);
-        GuildNum.push_back(guildNum);
-    }
-
-    nmfUtils::initialize(ObservedBiomassByGuilds,RunLength+1,NumGuilds);
-    for (int i=0; i<NumGuilds; ++i) {
-       ObservedBiomassByGuilds(0,i) = InitialGuildBiomass[GuildList[i].toStdString()];
-    }
-
-    return true;
+    return getSystemLoader().getGuildData(NumGuilds,RunLength,GuildList,
+                                          GuildSpecies,GuildNum,ObservedBiomassByGuilds);
 }
 
 bool
 nmfMainWindow::loadParameters(Data_Struct &dataStruct, const bool& verbose)
 {
-    bool loadOK;
-    int RunLength;
-    int NumSpecies;
-    int NumGuilds;
-    int GuildNum;
-    int NumCompetitionParameters = 0;
-    int NumPredationParameters   = 0;
-    int NumHandlingParameters    = 0;
-    int NumExponentParameters    = 0;
-    int NumBetaSpeciesParameters = 0;
-    int NumBetaGuildsParameters  = 0;
-    int NumSpeciesOrGuilds;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
-    std::string queryStr;
-    QString msg;
-    std::string growthForm;
-    std::string harvestForm;
-    std::string competitionForm;
-    std::string predationForm;
-    std::map<std::string,double> initialGuildBiomass;
-    std::vector<std::string> Guild;
-    std::map<std::string,int> GuildMap;
-    std::map<std::string,std::string> GuildSpeciesMap;
-    std::string guildName;
-
-    initialGuildBiomass.clear();
-    dataStruct.GuildSpecies.clear();
-    dataStruct.GuildNum.clear();
-    dataStruct.ObservedBiomassBySpecies.clear();
-    dataStruct.ObservedBiomassByGuilds.clear();
-    dataStruct.Catch.clear();
-    dataStruct.Effort.clear();
-    dataStruct.Exploitation.clear();
-    dataStruct.GrowthRateMax.clear();
-    dataStruct.GrowthRateMin.clear();
-    dataStruct.CarryingCapacityInitial.clear();
-    dataStruct.CarryingCapacityMax.clear();
-    dataStruct.CarryingCapacityMin.clear();
-    dataStruct.ExploitationRateMax.clear();
-    dataStruct.ExploitationRateMin.clear();
-    dataStruct.CatchabilityMax.clear();
-    dataStruct.CatchabilityMin.clear();
-    dataStruct.CompetitionMin.clear();
-    dataStruct.CompetitionMax.clear();
-    dataStruct.CompetitionBetaSpeciesMin.clear();
-    dataStruct.CompetitionBetaSpeciesMax.clear();
-    dataStruct.CompetitionBetaGuildsMin.clear();
-    dataStruct.CompetitionBetaGuildsMax.clear();
-    dataStruct.PredationMin.clear();
-    dataStruct.PredationMax.clear();
-    dataStruct.HandlingMin.clear();
-    dataStruct.HandlingMax.clear();
-    dataStruct.ExponentMin.clear();
-    dataStruct.ExponentMax.clear();
-//  dataStruct.OutputBiomass.clear();
-    dataStruct.Minimizer.clear();
-    dataStruct.ObjectiveCriterion.clear();
-    dataStruct.Scaling.clear();
-
-    if (verbose) {
-        std::cout << "Reading from: " << m_ProjectSettingsConfig << std::endl;
-    }
-    // Find RunLength
-    fields     = {"GrowthForm","HarvestForm","WithinGuildCompetitionForm","PredationForm","RunLength","Minimizer","ObjectiveCriterion",
-                  "BeesNumTotal","BeesNumElite","BeesNumOther","BeesNumEliteSites",
-                  "BeesNumBestSites","BeesNumRepetitions","BeesMaxGenerations","BeesNeighborhoodSize",
-                  "Scaling","GAGenerations","GAConvergence",
-                  "NLoptUseStopVal","NLoptUseStopAfterTime","NLoptUseStopAfterIter",
-                  "NLoptStopVal","NLoptStopAfterTime","NLoptStopAfterIter"};
-    queryStr   = "SELECT GrowthForm,HarvestForm,WithinGuildCompetitionForm,PredationForm,RunLength,Minimizer,ObjectiveCriterion,";
-    queryStr  += "BeesNumTotal,BeesNumElite,BeesNumOther,BeesNumEliteSites,BeesNumBestSites,BeesNumRepetitions,";
-    queryStr  += "BeesMaxGenerations,BeesNeighborhoodSize,Scaling,GAGenerations,GAConvergence,";
-    queryStr  += "NLoptUseStopVal,NLoptUseStopAfterTime,NLoptUseStopAfterIter,";
-    queryStr  += "NLoptStopVal,NLoptStopAfterTime,NLoptStopAfterIter ";
-    queryStr  += "FROM Systems WHERE SystemName='" + m_ProjectSettingsConfig + "'";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-
-    RunLength                        = std::stoi(dataMap["RunLength"][0]);
-    dataStruct.RunLength             = RunLength;
-    dataStruct.GrowthForm            = dataMap["GrowthForm"][0];
-    dataStruct.HarvestForm           = dataMap["HarvestForm"][0];
-    dataStruct.CompetitionForm       = dataMap["WithinGuildCompetitionForm"][0];
-    dataStruct.PredationForm         = dataMap["PredationForm"][0];
-    dataStruct.BeesNumTotal          = std::stoi(dataMap["BeesNumTotal"][0]);
-    dataStruct.BeesNumElite          = std::stoi(dataMap["BeesNumElite"][0]);
-    dataStruct.BeesNumOther          = std::stoi(dataMap["BeesNumOther"][0]);
-    dataStruct.BeesNumEliteSites     = std::stoi(dataMap["BeesNumEliteSites"][0]);
-    dataStruct.BeesNumBestSites      = std::stoi(dataMap["BeesNumBestSites"][0]);
-    dataStruct.BeesNumRepetitions    = std::stoi(dataMap["BeesNumRepetitions"][0]);
-    dataStruct.BeesMaxGenerations    = std::stoi(dataMap["BeesMaxGenerations"][0]);
-    dataStruct.BeesNeighborhoodSize  = std::stof(dataMap["BeesNeighborhoodSize"][0]);
-    dataStruct.Scaling               = dataMap["Scaling"][0];
-    dataStruct.GAGenerations         = std::stoi(dataMap["GAGenerations"][0]);
-    dataStruct.GAConvergence         = std::stoi(dataMap["GAConvergence"][0]);
-    dataStruct.Minimizer             = dataMap["Minimizer"][0];
-    dataStruct.ObjectiveCriterion    = dataMap["ObjectiveCriterion"][0];
-    dataStruct.NLoptUseStopVal       = std::stoi(dataMap["NLoptUseStopVal"][0]);
-    dataStruct.NLoptUseStopAfterTime = std::stoi(dataMap["NLoptUseStopAfterTime"][0]);
-    dataStruct.NLoptUseStopAfterIter = std::stoi(dataMap["NLoptUseStopAfterIter"][0]);
-    dataStruct.NLoptStopVal          = std::stod(dataMap["NLoptStopVal"][0]);
-    dataStruct.NLoptStopAfterTime    = std::stoi(dataMap["NLoptStopAfterTime"][0]);
-    dataStruct.NLoptStopAfterIter    = std::stoi(dataMap["NLoptStopAfterIter"][0]);
-
-    growthForm      = dataStruct.GrowthForm;
-    harvestForm     = dataStruct.HarvestForm;
-    competitionForm = dataStruct.CompetitionForm;
-    predationForm   = dataStruct.PredationForm;
-
-    if (growthForm == "Null") {
-        msg = "\nPlease enter a non-null growth form.\n";
-        QMessageBox::warning(this, "Error", msg, QMessageBox::Ok);
-        return false;
-    }
-
-    bool isAlpha    = (competitionForm == "NO_K");
-    bool isRho      = (predationForm   != "Null");
-    bool isHandling = (predationForm   == "Type II") || (predationForm == "Type III");
-    bool isExponent = (predationForm   == "Type III");
-    bool isMSPROD   = (competitionForm == "MS-PROD");
-    bool isAGGPROD  = (competitionForm == "AGG-PROD");
-
-    if (isAlpha) {
-        dataStruct.CompetitionMin.clear();
-        dataStruct.CompetitionMax.clear();
-    }
-    if (isRho) {
-        dataStruct.PredationMin.clear();
-        dataStruct.PredationMax.clear();
-    }
-    if (isHandling) {
-        dataStruct.HandlingMin.clear();
-        dataStruct.HandlingMax.clear();
-    }
-    if (isExponent) {
-        dataStruct.ExponentMin.clear();
-        dataStruct.ExponentMax.clear();
-    }
-    if (isMSPROD) {
-        dataStruct.CompetitionBetaSpeciesMin.clear();
-        dataStruct.CompetitionBetaSpeciesMax.clear();
-        dataStruct.CompetitionBetaGuildsMin.clear();
-        dataStruct.CompetitionBetaGuildsMax.clear();
-    } else if (isAGGPROD) {
-        dataStruct.CompetitionBetaGuildsMin.clear();
-        dataStruct.CompetitionBetaGuildsMax.clear();
-    }
-
-    // Get Guild information
-    fields    = {"GuildName","GuildK"};
-    queryStr  = "SELECT GuildName,GuildK from Guilds ORDER by GuildName";
-    dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumGuilds = dataMap["GuildName"].size();
-    dataStruct.NumGuilds = NumGuilds;
-    for (int i=0; i<NumGuilds; ++i) {
-        guildName = dataMap["GuildName"][i];
-        Guild.push_back(guildName);
-        GuildMap[guildName] = i;
-    }
-
-    if (isAGGPROD) {
-        fields     = {"GuildName","GrowthRateMin","GrowthRateMax","GuildK","GuildKMin",
-                      "GuildKMax","CatchabilityMin","CatchabilityMax"};
-        queryStr   = "SELECT GuildName,GrowthRateMin,GrowthRateMax,GuildK,GuildKMin,";
-        queryStr  += "GuildKMax,CatchabilityMin,CatchabilityMax from Guilds ORDER BY GuildName";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumGuilds  = dataMap["GuildName"].size();
-        nmfUtils::initialize(dataStruct.GrowthRateMin,      NumGuilds);
-        nmfUtils::initialize(dataStruct.GrowthRateMax,      NumGuilds);
-        nmfUtils::initialize(dataStruct.CarryingCapacityInitial,NumGuilds);
-        nmfUtils::initialize(dataStruct.CarryingCapacityMin,NumGuilds);
-        nmfUtils::initialize(dataStruct.CarryingCapacityMax,NumGuilds);
-        nmfUtils::initialize(dataStruct.CatchabilityMin,    NumGuilds);
-        nmfUtils::initialize(dataStruct.CatchabilityMax,    NumGuilds);
-        for (int guild=0; guild<NumGuilds; ++guild) {
-            dataStruct.GrowthRateMin(guild)       = std::stod(dataMap["GrowthRateMin"][guild]);
-            dataStruct.GrowthRateMax(guild)       = std::stod(dataMap["GrowthRateMax"][guild]);
-            dataStruct.CarryingCapacityInitial(guild) = std::stod(dataMap["GuildK"][guild]);
-            dataStruct.CarryingCapacityMin(guild) = std::stod(dataMap["GuildKMin"][guild]);
-            dataStruct.CarryingCapacityMax(guild) = std::stod(dataMap["GuildKMax"][guild]);
-            dataStruct.CatchabilityMin(guild)     = std::stod(dataMap["CatchabilityMin"][guild]);
-            dataStruct.CatchabilityMax(guild)     = std::stod(dataMap["CatchabilityMax"][guild]);
-            guildName = dataMap["GuildName"][guild];
-            GuildNum  = GuildMap[guildName];
-            dataStruct.GuildSpecies[GuildNum].push_back(guild);
-            dataStruct.GuildNum.push_back(GuildNum);
-        }
-
-        fields     = {"SpeName","GuildName","InitBiomass","GrowthRateMin","GrowthRateMax",
-                      "SpeciesK","SpeciesKMin","SpeciesKMax","CatchabilityMin","CatchabilityMax"};
-        queryStr   = "SELECT SpeName,GuildName,InitBiomass,GrowthRateMin,GrowthRateMax,";
-        queryStr  += "SpeciesK,SpeciesKMin,SpeciesKMax,CatchabilityMin,CatchabilityMax from Species ORDER BY SpeName";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumSpecies = dataMap["SpeName"].size();
-        for (int species=0; species<NumSpecies; ++species) {
-            guildName = dataMap["GuildName"][species];
-            GuildSpeciesMap[dataMap["SpeName"][species]] = guildName;
-            initialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
-        }
-        dataStruct.NumSpecies = NumSpecies;
-
-    } else {
-        fields     = {"SpeName","GuildName","InitBiomass","GrowthRateMin","GrowthRateMax",
-                      "SpeciesK","SpeciesKMin","SpeciesKMax","CatchabilityMin","CatchabilityMax"};
-        queryStr   = "SELECT SpeName,GuildName,InitBiomass,GrowthRateMin,GrowthRateMax,";
-        queryStr  += "SpeciesK,SpeciesKMin,SpeciesKMax,CatchabilityMin,CatchabilityMax from Species ORDER BY SpeName";
-        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-        NumSpecies = dataMap["SpeName"].size();
-        dataStruct.NumSpecies = NumSpecies;
-        nmfUtils::initialize(dataStruct.GrowthRateMin,      NumSpecies);
-        nmfUtils::initialize(dataStruct.GrowthRateMax,      NumSpecies);
-        nmfUtils::initialize(dataStruct.CarryingCapacityInitial,NumSpecies);
-        nmfUtils::initialize(dataStruct.CarryingCapacityMin,NumSpecies);
-        nmfUtils::initialize(dataStruct.CarryingCapacityMax,NumSpecies);
-        nmfUtils::initialize(dataStruct.CatchabilityMin,    NumSpecies);
-        nmfUtils::initialize(dataStruct.CatchabilityMax,    NumSpecies);
-        for (int species=0; species<NumSpecies; ++species) {
-            dataStruct.GrowthRateMin(species)       = std::stod(dataMap["GrowthRateMin"][species]);
-            dataStruct.GrowthRateMax(species)       = std::stod(dataMap["GrowthRateMax"][species]);
-            dataStruct.CarryingCapacityInitial(species) = std::stod(dataMap["SpeciesK"][species]);
-            dataStruct.CarryingCapacityMin(species) = std::stod(dataMap["SpeciesKMin"][species]);
-            dataStruct.CarryingCapacityMax(species) = std::stod(dataMap["SpeciesKMax"][species]);
-            dataStruct.CatchabilityMin(species)     = std::stod(dataMap["CatchabilityMin"][species]);
-            dataStruct.CatchabilityMax(species)     = std::stod(dataMap["CatchabilityMax"][species]);
-            guildName = dataMap["GuildName"][species];
-            GuildNum  = GuildMap[guildName];
-            initialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
-            dataStruct.GuildSpecies[GuildNum].push_back(species);
-            dataStruct.GuildNum.push_back(GuildNum);
-        }
-    }
+    NMF_TRACE_SCOPE("db","nmfMainWindow::loadParameters");
+    nmfSystemLoader loader = getSystemLoader();
 
-    if (verbose) {
-        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Growth Rate Min/Max");
-        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Carrying Capacity Min/Max");
-    }
-
-    NumSpeciesOrGuilds = (isAGGPROD) ? NumGuilds : NumSpecies;
-
-    // Load Interaction coefficients
-    if (isAlpha) {
-        loadOK = loadInteraction(NumSpeciesOrGuilds, "Competition",
-                                 "CompetitionAlphaMin","CompetitionAlphaMax",
-                                 dataStruct.CompetitionMin, dataStruct.CompetitionMax,
-                                 NumCompetitionParameters);
-        if (! loadOK) return false;
-    }
-    if (isRho) {
-        loadOK = loadInteraction(NumSpeciesOrGuilds, "Predation",
-                                 "PredationLossRatesMin", "PredationLossRatesMax",
-                                 dataStruct.PredationMin, dataStruct.PredationMax,
-                                 NumPredationParameters);
-        if (! loadOK) return false;
-    }
-    if (isHandling) {
-        loadOK = loadInteraction(NumSpeciesOrGuilds, "Handling",
-                                 "HandlingTimeMin", "HandlingTimeMax",
-                                 dataStruct.HandlingMin, dataStruct.HandlingMax,
-                                 NumHandlingParameters);
-        if (! loadOK) return false;
-    }
-    if (isExponent) {
-        loadOK = loadInteraction(NumSpeciesOrGuilds, "Exponent",
-                                 "PredationExponentMin", "PredationExponentMax",
-                                 dataStruct.ExponentMin, dataStruct.ExponentMax,
-                                 NumExponentParameters);
-        if (! loadOK) return false;
-    }
-
-    if (isMSPROD) {
-        loadOK = loadInteraction(NumSpecies, "MSPROD-Species",
-                                 "CompetitionBetaSpeciesMin",
-                                 "CompetitionBetaSpeciesMax",
-                                 dataStruct.CompetitionBetaSpeciesMin,
-                                 dataStruct.CompetitionBetaSpeciesMax,
-                                 NumBetaSpeciesParameters);
-        if (! loadOK) return false;
-        loadOK = loadInteractionGuilds(NumSpecies, NumGuilds, "Competition-MSPROD",
-                                       GuildSpeciesMap,
-                                      "CompetitionBetaGuildsMin","CompetitionBetaGuildsMax",
-                                       dataStruct.CompetitionBetaGuildsMin,
-                                       dataStruct.CompetitionBetaGuildsMax,
-                                       NumBetaGuildsParameters);
-        if (! loadOK) return false;
-    } else if (isAGGPROD) {
-        loadOK = loadInteractionGuilds(NumSpecies, NumGuilds, "Competition-AGGPROD",
-                                       GuildSpeciesMap,
-                                      "CompetitionBetaGuildsMin", "CompetitionBetaGuildsMax",
-                                       dataStruct.CompetitionBetaGuildsMin,
-                                       dataStruct.CompetitionBetaGuildsMax,
-                                       NumBetaSpeciesParameters);
-        if (! loadOK) return false;
-    }
-
-    // Calculate total number of parameters
-    dataStruct.TotalNumberParameters = 0;
-    if (growthForm == "Linear") {
-        dataStruct.TotalNumberParameters = NumSpecies;
-    } else if (growthForm == "Logistic") {
-        dataStruct.TotalNumberParameters = 2*NumSpecies;
-    }
-    if (harvestForm == "Effort (qE)") {
-        dataStruct.TotalNumberParameters += NumSpecies;
-    }
-    if (predationForm != "Null") {
-        dataStruct.TotalNumberParameters += NumPredationParameters;
-    }
-    if ((predationForm == "Type II") || (predationForm == "Type III")) {
-        dataStruct.TotalNumberParameters += NumHandlingParameters;
-    }
-    if (predationForm == "Type III") {
-        dataStruct.TotalNumberParameters += NumExponentParameters;
-    }
-    if (competitionForm == "NO_K") {
-        dataStruct.TotalNumberParameters += NumCompetitionParameters;
-    } else if (competitionForm == "MS-PROD") {
-        dataStruct.TotalNumberParameters += NumBetaSpeciesParameters;
-        dataStruct.TotalNumberParameters += NumBetaGuildsParameters;
-    } else if (competitionForm == "AGG-PROD") {
-        dataStruct.TotalNumberParameters += NumBetaGuildsParameters;
-    }
-
-    // Set Benchmark type and number of parameters (RSK - improve this later)
-    dataStruct.Benchmark = growthForm;
-    if (isAlpha || isRho) {
-        dataStruct.Benchmark = "LogisticMultiSpecies";
-    }
-
-    if (harvestForm == "Catch") {
-        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Catch",NumSpecies,RunLength,dataStruct.Catch))
-            return false;
-        if (verbose) {
-            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Catch");
-        }
-    } else if (harvestForm == "Effort (qE)") {
-        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Effort",NumSpecies,RunLength,dataStruct.Effort))
-            return false;
-        if (verbose) {
-            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Effort");
-        }
-    } else if (harvestForm == "Exploitation (F)") {
-        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Exploitation",NumSpecies,RunLength,dataStruct.Exploitation))
-            return false;
-        if (verbose) {
-            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Exploitation");
-        }
-    }
-    if (! getTimeSeriesData(m_MohnsRhoLabel,"","ObservedBiomass",NumSpecies,RunLength,dataStruct.ObservedBiomassBySpecies)) {
+    if (! loader.loadParameters(dataStruct,verbose)) {
+        showSystemLoaderError(loader);
         return false;
     }
 
-    // Load time series by guild observed biomass just load the first year's
-    nmfUtils::initialize(dataStruct.ObservedBiomassByGuilds,RunLength+1,NumGuilds);
-    for (int i=0; i<NumGuilds; ++i) {
-       dataStruct.ObservedBiomassByGuilds(0,i) = initialGuildBiomass[Guild[i]];
-    }
-    if (verbose) {
-        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Biomass");
-    }
-
     return true;
 }
 
-bool
-nmfMainWindow::loadInteraction(int &NumSpeciesOrGuilds,
-                               std::string InteractionType,
-                               std::string MinTable,
-                               std::string MaxTable,
-                               std::vector<double> &MinData,
-                               std::vector<double> &MaxData,
-                               int &NumInteractionParameters)
+void
+nmfMainWindow::loadWarmStartParameters(const std::string&   Algorithm,
+                                       const Data_Struct&   dataStruct,
+                                       std::vector<double>& InitialParameters)
 {
-    int m;
-    int NumRecords;
-    double valMin;
-    double valMax;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
-    std::string queryStr;
-    QString msg;
-    std::vector<double> MinRow;
-    std::vector<double> MaxRow;
-
-    NumInteractionParameters = 0;
-
-    fields      = {"SystemName","SpeName","Value"};
-    queryStr    = "SELECT SystemName,SpeName,Value FROM " + MinTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMin["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds) {
-        msg = "[Error 1] LoadInteraction1d: Incorrect number of records found in table: " + QString::fromStdString(MinTable) + ". Found " +
-                QString::number(NumRecords) + " expecting " + QString::number(NumSpeciesOrGuilds) + ".";
-        m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
-        QMessageBox::warning(this, "Error", "\n"+msg+"\n\nCheck min/max values in " + QString::fromStdString(InteractionType) + " Parameters tab.", QMessageBox::Ok);
-        return false;
-    }
-    queryStr    = "SELECT SystemName,SpeName,Value FROM " + MaxTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMax["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds) {
-        m_Logger->logMsg(nmfConstants::Error,
-                       "[Error 2] LoadInteraction1d: Incorrect number of records found in table: " + MaxTable + ". Found " +
-                       std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds) + ".");
-        return false;
+    nmfSystemLoader loader = getSystemLoader();
+
+    InitialParameters.clear();
+    if (! Estimation_Tab6_ptr->isWarmStart()) {
+        return;
     }
-    m = 0;
-    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
-        valMin = std::stod(dataMapMin["Value"][m]);
-        valMax = std::stod(dataMapMax["Value"][m]);
-        ++NumInteractionParameters;
-        MinData.push_back(valMin);
-        MaxData.push_back(valMax);
-        ++m;
+    if (nmfEstimationEngine::loadInitialParameters(loader,dataStruct,Algorithm,InitialParameters)) {
+        m_Logger->logMsg(nmfConstants::Normal,"Warm starting from the previous estimate");
+    } else {
+        m_Logger->logMsg(nmfConstants::Warning,"No previous estimate found for the current model. Running without a warm start.");
     }
-    return true;
 }
 
-bool
-nmfMainWindow::loadInteraction(int &NumSpeciesOrGuilds,
-                               std::string InteractionType,
-                               std::string MinTable,
-                               std::string MaxTable,
-                               std::vector<std::vector<double> > &MinData,
-                               std::vector<std::vector<double> > &MaxData,
-                               int &NumInteractionParameters)
+nmfSystemLoader
+nmfMainWindow::getSystemLoader()
 {
-    int m;
-    int NumRecords;
-    double valMin;
-    double valMax;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
-    std::string queryStr;
-    QString msg;
-    std::vector<double> MinRow;
-    std::vector<double> MaxRow;
+    nmfSystemLoader loader(m_DatabasePtr,m_Logger,m_ProjectSettingsConfig);
 
-    NumInteractionParameters = 0;
+    loader.setMohnsRhoLabel(m_MohnsRhoLabel);
 
-    fields      = {"SystemName","SpeciesA","SpeciesB","Value"};
-    queryStr    = "SELECT SystemName,SpeciesA,SpeciesB,Value FROM " + MinTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMin["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
-        if (NumRecords == 0) {
-            msg = "\nMissing data. Please populate table: " + QString::fromStdString(MinTable);
-            QMessageBox::critical(this, "Error", msg, QMessageBox::Ok);
-        } else {
-            msg = "[Error 1] LoadInteraction2d: Incorrect number of records found in table: " +
-                    QString::fromStdString(MinTable) + ". Found " +
-                    QString::number(NumRecords) + " expecting " +
-                    QString::number(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".";
-            m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
-            m_Logger->logMsg(nmfConstants::Error, queryStr);
-            QMessageBox::warning(this, "Error", "\n"+msg+"\n\nCheck min/max values in " +
-                                 QString::fromStdString(InteractionType) + " Parameters tab.",
-                                 QMessageBox::Ok);
-        }
-        return false;
-    }
-    queryStr    = "SELECT SystemName,SpeciesA,SpeciesB,Value FROM " + MaxTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMax["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
-        m_Logger->logMsg(nmfConstants::Error,
-                       "[Error 2] LoadInteraction2d: Incorrect number of records found in table: " +
-                       MaxTable + ". Found " + std::to_string(NumRecords) + " expecting " +
-                       std::to_string(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".");
-        return false;
-    }
-    m = 0;
-    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
-        MinRow.clear();
-        MaxRow.clear();
-        for (int col=0; col<NumSpeciesOrGuilds; ++col) {
-            valMin = std::stod(dataMapMin["Value"][m]);
-            valMax = std::stod(dataMapMax["Value"][m]);
-            MinRow.push_back(valMin);
-            MaxRow.push_back(valMax);
-            ++NumInteractionParameters;
-            ++m;
-        }
-        MinData.push_back(MinRow);
-        MaxData.push_back(MaxRow);
-    }
-    return true;
+    return loader;
 }
 
-
-bool
-nmfMainWindow::loadInteractionGuilds(int &NumSpecies,
-                                     int &NumGuilds,
-                                     std::string InteractionType,
-                                     std::map<std::string,std::string> &GuildSpeciesMap,
-                                     std::string MinTable,
-                                     std::string MaxTable,
-                                     std::vector<std::vector<double> > &MinData,
-                                     std::vector<std::vector<double> > &MaxData,
-                                     int &NumInteractionParameters)
+void
+nmfMainWindow::showSystemLoaderError(nmfSystemLoader& loader)
 {
-    int m;
-    int NumRecords;
-    double valMin;
-    double valMax;
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
-    std::string queryStr;
-    QString msg;
-    std::vector<double> MinRow;
-    std::vector<double> MaxRow;
-    int NumSpeciesOrGuilds = (InteractionType == "Competition-AGGPROD") ? NumGuilds : NumSpecies;
-
-    NumInteractionParameters = 0;
-
-    fields      = {"SystemName","SpeName","Guild","Value"};
-    queryStr    = "SELECT SystemName,SpeName,Guild,Value FROM " + MinTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMin["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
-        msg = "[Error 1] LoadInteractionGuilds: Incorrect number of records found in table: " +
-                QString::fromStdString(MinTable) + ". Found " +
-                QString::number(NumRecords) + " expecting " +
-                QString::number(NumSpeciesOrGuilds*NumGuilds) + ".";
-        m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
-        QMessageBox::warning(this, "Error", "\n"+msg+"\n\nCheck min/max values in " +
-                             QString::fromStdString(InteractionType) + " Parameters tab.",
-                             QMessageBox::Ok);
-        return false;
-    }
-
-    queryStr    = "SELECT SystemName,SpeName,Guild,Value FROM " + MaxTable;
-    queryStr   += " WHERE SystemName = '" + m_ProjectSettingsConfig + "'";
-    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords  = dataMapMax["Value"].size();
-    if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
-        m_Logger->logMsg(nmfConstants::Error,
-                       "[Error 2] LoadInteractionGuilds: Incorrect number of records found in table: " +
-                       MaxTable + ". Found " + std::to_string(NumRecords) + " expecting " +
-                       std::to_string(NumSpeciesOrGuilds*NumGuilds) + ".");
-        return false;
-    }
+    std::string msg = loader.getErrorMessage();
 
-    m = 0;
-    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
-        MinRow.clear();
-        MaxRow.clear();
-        for (int col=0; col<NumGuilds; ++col) {
-            valMin = std::stod(dataMapMin["Value"][m]);
-            valMax = std::stod(dataMapMax["Value"][m]);
-            MinRow.push_back(valMin);
-            MaxRow.push_back(valMax);
-            ++NumInteractionParameters;
-            ++m;
-        }
-        MinData.push_back(MinRow);
-        MaxData.push_back(MaxRow);
+    if (! msg.empty()) {
+        QMessageBox::warning(this, "Error", "\n" + QString::fromStdString(msg) + "\n", QMessageBox::Ok);
     }
-    return true;
 }
 
 /*
@@ -9984,8 +9214,7 @@ nmfMainWindow::getSurfaceData(
     std::string isAggProdStr;
     std::string currentSpecies = Output_Controls_ptr->getOutputSpecies().toStdString();
 
-    std::vector<std::string> fields;
-    std::map<std::string, std::vector<std::string> > dataMap;
+    nmfColumnQuery query;
     QStringList TableNames = {"DiagnosticGRandCC"};
 
     m_DatabasePtr->getAlgorithmIdentifiers(
@@ -9994,10 +9223,7 @@ nmfMainWindow::getSurfaceData(
                 Scaling,CompetitionForm,nmfConstantsMSSPM::DontShowPopupError);
     isAggProdStr = (CompetitionForm == "AGG-PROD") ? "1" : "0";
 
-    fields     = {"Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd",
-                  "SpeName","rPctVariation","KPctVariation","Fitness"};
-    queryStr   = "SELECT Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,";
-    queryStr  += "SpeName,rPctVariation,KPctVariation,Fitness FROM " + TableNames[0].toStdString();
+    queryStr   = "SELECT SpeName,rPctVariation,KPctVariation,Fitness FROM " + TableNames[0].toStdString();
     queryStr  += "  WHERE SpeName = '" + currentSpecies +
                 "' AND Algorithm = '" + Algorithm +
                 "' AND Minimizer = '" + Minimizer +
@@ -10005,8 +9231,8 @@ nmfMainWindow::getSurfaceData(
                 "' AND Scaling = '" + Scaling +
                 "' AND isAggProd = " + isAggProdStr +
                 "  ORDER BY SpeName";
-    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
-    NumRecords = dataMap["Algorithm"].size();
+    query.exec(queryStr,{"rPctVariation","KPctVariation","Fitness"});
+    NumRecords = query.numRecords();
     if (NumRecords != nrows*ncols) {
         msg  = "[Error 1] nmfMainWindow::getSurfaceData: Incorrect number of records read. Found "+std::to_string(NumRecords);
         msg += " expecting " + std::to_string(nrows*ncols);
@@ -10018,11 +9244,14 @@ nmfMainWindow::getSurfaceData(
     rowValues.resize(nrows,ncols);
     columnValues.resize(nrows,ncols);
     heightValues.resize(nrows,ncols);
+    const std::vector<double>& rPctVariation = query.numeric("rPctVariation");
+    const std::vector<double>& KPctVariation = query.numeric("KPctVariation");
+    const std::vector<double>& Fitness       = query.numeric("Fitness");
     for (int row = 0; row < nrows; ++row) {
         for (int col = 0; col < ncols; ++col) {
-            x = std::stod(dataMap["rPctVariation"][m]);
-            y = std::stod(dataMap["Fitness"][m]);
-            z = std::stod(dataMap["KPctVariation"][m]);
+            x = rPctVariation[m];
+            y = Fitness[m];
+            z = KPctVariation[m];
             if (yMax > 0) {
                 y = (y > yMax) ? yMax : y;
             }
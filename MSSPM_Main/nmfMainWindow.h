@@ -32,7 +32,7 @@
 
 //#include <nlopt.hpp>
 
-#include "nmfDatabase.h"
+#include "nmfTracedDatabase.h"
 #include "nmfLogWidget.h"
 #include "nmfUtilsStatistics.h"
 #include "nmfStructsQt.h"
@@ -59,6 +59,11 @@
 //#include "GA_Estimator.h"
 #include "Bees_Estimator.h"
 #include "NLopt_Estimator.h"
+#include "nmfForecastEngine.h"
+#include "nmfRetrospectiveEngine.h"
+#include "nmfSystemLoader.h"
+#include "nmfEstimationCache.h"
+#include "nmfTrace.h"
 
 #include "nmfGrowthForm.h"
 #include "nmfCompetitionForm.h"
@@ -84,6 +89,8 @@
 #include "nmfForecastTab02.h"
 #include "nmfForecastTab03.h"
 #include "nmfForecastTab04.h"
+#include "nmfBulkWriter.h"
+#include "nmfColumnQuery.h"
 
 #include "nmfOutputControls.h"
 #include "nmfViewerWidget.h"
@@ -159,10 +166,13 @@ class nmfMainWindow : public QMainWindow
 private:
     Ui::nmfMainWindow* m_UI;
 
+    std::string                           m_CacheAlgorithm;
+    std::string                           m_CacheHash;
+    nmfCancellationToken                  m_CancelToken;
     QChart*                               m_ChartWidget;
     QChartView*                           m_ChartView2d;
     QWidget*                              m_ChartView3d;
-    nmfDatabase*                          m_DatabasePtr;
+    nmfTracedDatabase*                    m_DatabasePtr;
     Data_Struct                           m_DataStruct;
     int                                   m_DiagnosticsFontSize;
     int                                   m_DiagnosticsNumPoints;
@@ -175,6 +185,8 @@ private:
     int                                   m_isPressedNLoptButton;
     int                                   m_isPressedGeneticButton;
     int                                   m_isPressedGradientButton;
+    bool                                  m_isResumeRun;
+    bool                                  m_isCacheHit;
     bool                                  m_LoadLastProject;
     nmfLogger*                            m_Logger;
     nmfLogWidget*                         m_LogWidget;
@@ -182,8 +194,8 @@ private:
     nmfOutputChart3DBarModifier*          m_Modifier;
     std::string                           m_MohnsRhoLabel;
     int                                   m_NumLines;
-    int                                   m_NumMohnsRhoRanges;
     std::string                           m_Password;
+    nmfProgressChannel*                   m_ProgressChannel;
     QChart*                               m_ProgressChartBees;
     QTimer*                               m_ProgressChartTimer;
     QBarSeries*                           m_ProgressSeries;
@@ -194,6 +206,7 @@ private:
     std::string                           m_ProjectDatabase;
     std::string                           m_ProjectName;
     std::string                           m_ProjectSettingsConfig;
+    double                                m_PruneSlackFactor;
     int                                   m_RunNumBees;
     int                                   m_RunNumNLopt;
     QString                               m_RunOutputMsg;
@@ -212,6 +225,16 @@ private:
     nmfViewerWidget*                      m_ViewerWidget;
 //    QString                               m_outputFile;
     bool                                  m_isStartUpOK;
+    std::unique_ptr<nmfProjectionInputs>  m_PreviewInputs;
+    nmfProjectionScratch                  m_PreviewScratch;
+    std::vector<double>                   m_PreviewEstGrowthRates;
+    std::vector<double>                   m_PreviewEstCarryingCapacities;
+    boost::numeric::ublas::matrix<double> m_PreviewBiomassSpecies;
+    boost::numeric::ublas::matrix<double> m_PreviewBiomassGuilds;
+    boost::numeric::ublas::matrix<double> m_PreviewObservedBiomass;
+    QStringList                           m_PreviewSpeciesList;
+    int                                   m_PreviewStartYear;
+    std::vector<std::string>              m_PreviewAlgorithmIdentifiers;
 
     QBarSeries*              ProgressBarSeries;
     QBarSet*                 ProgressBarSet;
@@ -343,18 +366,26 @@ private:
     std::pair<bool,QString> dataAdequateForCurrentModel(QStringList estParamNames);
     bool deleteAllMohnsRho(const std::string& TableName);
     bool deleteAllOutputMohnsRho();
+    bool drainProgressChannel();
     /**
      * @brief Forces user to input and save project data.  Until they do so, application
      * functionality is disabled (i.e., grayed out).
      */
     void enableApplicationFeatures(std::string navigatorGroup,
                                    bool enable);
+    void beginTraceSession();
+    QString endTraceSession(const std::string& SessionName);
+    bool findCachedResult(const std::string&         Algorithm,
+                          const Data_Struct&         dataStruct,
+                          const std::vector<double>& InitialParameters,
+                          nmfEstimationCacheEntry&   Entry);
     QTableView* findTableInFocus();
     void getAlgorithmIdentifiers(std::string& algorithm,
                                  std::string& minimizer,
                                  std::string& objectiveCriterion,
                                  std::string& scaling,
                                  std::string& competitionForm);
+    std::string getCheckpointFile(const std::string& Algorithm);
     QString getCurrentStyle();
 
     bool getSystemDataForChart(
@@ -459,6 +490,7 @@ private:
                               QStringList& SpeciesList,
                               QStringList& GuildList);
     int  getStartYearOffset();
+    nmfSystemLoader getSystemLoader();
     bool getMSYData(const int&     NumLines,
                     const int&     NumGroups,
                     const std::string& Group,
@@ -497,31 +529,29 @@ private:
                    std::string &state);
     void loadGuis();
     void loadDatabase();
-    bool loadInteraction(int &NumSpecies,
-                         std::string InteractionType,
-                         std::string MinTable,
-                         std::string MaxTable,
-                         std::vector<double> &MinData,
-                         std::vector<double> &MaxData,
-                         int &NumInteractionParameters);
-    bool loadInteraction(int &NumSpecies,
-                         std::string InteractionType,
-                         std::string MinTable,
-                         std::string MaxTable,
-                         std::vector<std::vector<double> > &MinData,
-                         std::vector<std::vector<double> > &MaxData,
-                         int &NumInteractionParameters);
-    bool loadInteractionGuilds(int &NumSpecies,
-                               int &NumGuilds,
-                               std::string InteractionType,
-                               std::map<std::string,std::string> &GuildSpeciesMap,
-                               std::string MinTable,
-                               std::string MaxTable,
-                               std::vector<std::vector<double> > &MinData,
-                               std::vector<std::vector<double> > &MaxData,
-                               int &NumInteractionParameters);
     bool loadParameters(Data_Struct &m_DataStruct,
                         const bool& verbose);
+    bool loadPreviewInputs();
+    void loadWarmStartParameters(const std::string&   Algorithm,
+                                 const Data_Struct&   dataStruct,
+                                 std::vector<double>& InitialParameters);
+    bool loadProjectionInputs(const std::string&   ForecastName,
+                              const int&           RunLength,
+                              const bool&          isMonteCarlo,
+                              const std::string&   Algorithm,
+                              const std::string&   Minimizer,
+                              const std::string&   ObjectiveCriterion,
+                              const std::string&   Scaling,
+                              const std::string&   isAggProdStr,
+                              const std::string&   GrowthForm,
+                              const std::string&   HarvestForm,
+                              const std::string&   CompetitionForm,
+                              const std::string&   PredationForm,
+                              const std::string&   GrowthRateTable,
+                              const std::string&   CarryingCapacityTable,
+                              const std::string&   CatchabilityTable,
+                              QStringList&         SpeciesList,
+                              nmfProjectionInputs& Inputs);
     void loadVisibleTables(const bool& isAlpha,
                            const bool& isMsProd,
                            const bool& isAggProd,
@@ -529,36 +559,34 @@ private:
                            const bool& isHandling,
                            QList<QTableView*>& TableViews,
                            QList<QString>& TableNames);
-    bool loadUncertaintyData(const bool&          isMonteCarlo,
-                             const int&           NumSpecies,
-                             const std::string&   ForecastName,
-                             const std::string&   Algorithm,
-                             const std::string&   Minimizer,
-                             const std::string&   ObjectiveCriterion,
-                             const std::string&   Scaling,
-                             std::vector<double>& GrowthRateUncertainty,
-                             std::vector<double>& CarryingCapacityUncertainty,
-                             std::vector<double>& PredationUncertainty,
-                             std::vector<double>& CompetitionUncertainty,
-                             std::vector<double>& BetaSpeciesUncertainty,
-                             std::vector<double>& BetaGuildsUncertainty,
-                             std::vector<double>& HandlingUncertainty,
-                             std::vector<double>& ExponentUncertainty,
-                             std::vector<double>& CatchabilityUncertainty,
-                             std::vector<double>& HarvestUncertainty);
-    bool modifyTable(const std::string& TableName,
-                     const QString&     OriginalSystemName,
-                     const QString&     MohnsRhoLabel,
-                     const int&         MohnsRhoStartYear,
-                     const int&         MohnsRhoRunLength,
-                     const int&         InitialYear);
     void queryUserPreviousDatabase();
     void readSettings(QString name);
     void readSettings();
     void readSettingsGuiPositionOrientationOnly();
     void runBeesAlgorithm(bool showDiagnosticsChart);
-    void runNextMohnsRhoEstimation();
+    void runForecast(std::string ForecastName,
+                     bool        GenerateBiomass);
+    bool runForecastBatch(const std::string& ForecastName,
+                          const int&         RunLength,
+                          const int&         NumRuns,
+                          const std::string& Algorithm,
+                          const std::string& Minimizer,
+                          const std::string& ObjectiveCriterion,
+                          const std::string& Scaling,
+                          const std::string& isAggProdStr,
+                          const std::string& GrowthForm,
+                          const std::string& HarvestForm,
+                          const std::string& CompetitionForm,
+                          const std::string& PredationForm,
+                          const std::string& GrowthRateTable,
+                          const std::string& CarryingCapacityTable,
+                          const std::string& CatchabilityTable,
+                          const std::string& BiomassTable,
+                          const std::string& BiomassMonteCarloTable);
     void runNLoptAlgorithm(bool showDiagnosticChart);
+    void saveMohnsRhoResult(const std::string&         Algorithm,
+                            const Data_Struct&         dataStruct,
+                            const nmfEstimationResult& Result);
     bool saveScreenshot(QString &outputfile, QPixmap &pm);
     void saveSettings();
     bool scaleTimeSeries(const std::vector<double>&             Uncertainty,
@@ -661,6 +689,8 @@ private:
                            double&     ScaleVal,
                            double&     YMinSliderVal,
                            double      BrightnessFactor);
+    void showSystemLoaderError(nmfSystemLoader& loader);
+    void storeCachedResult();
     void showMohnsRhoBiomassVsTime(const std::string &label,
                                    const int         &InitialYear,
                                    const int         &StartYear,
@@ -728,6 +758,16 @@ private:
     void updateModelEquationSummary();
 
     void updateScreenShotViewer(QString filename);
+    bool writeForecastBiomass(const std::string& ForecastName,
+                              const bool&        isMonteCarlo,
+                              const std::string& Algorithm,
+                              const std::string& Minimizer,
+                              const std::string& ObjectiveCriterion,
+                              const std::string& Scaling,
+                              const std::string& isAggProdStr,
+                              const QStringList& SpeciesList,
+                              const std::string& BiomassTable,
+                              std::vector<boost::numeric::ublas::matrix<double> >& Biomass);
 
     void getSurfaceData(
             boost::numeric::ublas::matrix<double>& rowValues,
@@ -872,6 +912,17 @@ public slots:
     void callback_OutputTypeCMB(
             QString Type,
             std::map<QString,QStringList> SortedForecastLabelsMap);
+    /**
+     * @brief Callback invoked while the user drags the Population Parameters Modify slider.
+     * Re-projects the biomass from the last estimated parameters with the modified
+     * r and K values and redraws the Biomass vs Time chart. Nothing is saved.
+     */
+    void callback_PreviewModifiedParameters();
+    /**
+     * @brief Callback invoked when the user releases the Modify slider. Frees the
+     * preview data since the estimated parameters are about to change.
+     */
+    void callback_PreviewFinished();
     /**
      * @brief Callback invoked when a user has saved new project settings
      */
@@ -907,6 +958,11 @@ public slots:
      * Output widget to what it was just prior to modifying the Population Parameters
      */
     void callback_RestoreOutputSpecies();
+    /**
+     * @brief Callback invoked when the user resumes the last stopped Estimation. The
+     * starts (or sub runs) saved in the run's checkpoint aren't rerun.
+     */
+    void callback_ResumeEstimation();
     /**
      * @brief Callback invoked when Estimation run has completed
      * @param outputMsg : output message for Estimation run completion
@@ -1034,6 +1090,11 @@ public slots:
      * @param type : type of chart grouping desired: species, guild, system
      */
     void callback_ShowChartBy(QString type);
+    /**
+     * @brief Callback invoked when the user stops the current Estimation run. This also
+     * stops any remaining Mohn's Rho peels and restores the original System.
+     */
+    void callback_StopTheRun();
     /**
      * @brief Callback invoked when user is modifying the Population Parameters and needs to
      * store the current value of the Output widget's species
@@ -0,0 +1,229 @@
+#include "nmfModelSweep.h"
+#include "nmfUtilsStatistics.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <numeric>
+
+nmfModelSweep::nmfModelSweep(nmfTracedDatabase* databasePtr,
+                             nmfLogger*         logger,
+                             const std::string& systemName,
+                             const std::string& algorithm)
+{
+    m_DatabasePtr   = databasePtr;
+    m_Logger        = logger;
+    m_SystemName    = systemName;
+    m_Algorithm     = algorithm;
+    m_MaxNumThreads = 0;
+}
+
+void
+nmfModelSweep::setCancellationToken(const nmfCancellationToken& CancelToken)
+{
+    m_CancelToken = CancelToken;
+}
+
+void
+nmfModelSweep::setMaxNumThreads(const int& MaxNumThreads)
+{
+    m_MaxNumThreads = MaxNumThreads;
+}
+
+void
+nmfModelSweep::enumerate(const std::vector<std::string>&        GrowthForms,
+                         const std::vector<std::string>&        HarvestForms,
+                         const std::vector<std::string>&        CompetitionForms,
+                         const std::vector<std::string>&        PredationForms,
+                         const std::vector<std::string>&        Minimizers,
+                         const std::vector<std::string>&        ObjectiveCriteria,
+                         const std::vector<std::string>&        Scalings,
+                         std::vector<nmfModelSweepCombination>& Combinations)
+{
+    // An empty list sweeps over just the System's setting (an empty name)
+    auto orCurrent = [](const std::vector<std::string>& list) {
+        return (list.empty()) ? std::vector<std::string>{""} : list;
+    };
+    nmfModelSweepCombination Combination;
+
+    Combinations.clear();
+    for (const std::string& growthForm : orCurrent(GrowthForms)) {
+     for (const std::string& harvestForm : orCurrent(HarvestForms)) {
+      for (const std::string& competitionForm : orCurrent(CompetitionForms)) {
+       for (const std::string& predationForm : orCurrent(PredationForms)) {
+        for (const std::string& minimizer : orCurrent(Minimizers)) {
+         for (const std::string& objectiveCriterion : orCurrent(ObjectiveCriteria)) {
+          for (const std::string& scaling : orCurrent(Scalings)) {
+              Combination.GrowthForm         = growthForm;
+              Combination.HarvestForm        = harvestForm;
+              Combination.CompetitionForm    = competitionForm;
+              Combination.PredationForm      = predationForm;
+              Combination.Minimizer          = minimizer;
+              Combination.ObjectiveCriterion = objectiveCriterion;
+              Combination.Scaling            = scaling;
+              Combinations.push_back(Combination);
+          }
+         }
+        }
+       }
+      }
+     }
+    }
+}
+
+void
+nmfModelSweep::rank(const std::string&                RankBy,
+                    std::vector<nmfModelSweepResult>& Results)
+{
+    std::stable_sort(Results.begin(),Results.end(),
+                     [&RankBy](const nmfModelSweepResult& a, const nmfModelSweepResult& b) {
+        if (a.OK != b.OK) {
+            return a.OK;
+        }
+        if (RankBy == "MEF") {
+            return a.MEF > b.MEF;
+        } else if (RankBy == "RMSE") {
+            return a.RMSE < b.RMSE;
+        }
+        return a.AIC < b.AIC;
+    });
+}
+
+void
+nmfModelSweep::calculateStatistics(const Data_Struct&         dataStruct,
+                                   const nmfEstimationResult& Estimate,
+                                   nmfModelSweepResult&       Result)
+{
+    bool isAggProd = (dataStruct.CompetitionForm == "AGG-PROD");
+    int RunLength  = dataStruct.RunLength;
+    int NumSpeciesOrGuilds = Estimate.EstimatedBiomass.size2();
+    double meanVal;
+    std::vector<double> observed;
+    std::vector<double> estimated;
+    std::vector<double> meanObserved;
+    std::vector<double> SSresiduals;
+    std::vector<double> aic;
+    std::vector<double> rmse;
+    std::vector<double> mef;
+    std::vector<double> Parameters;
+    const boost::numeric::ublas::matrix<double>& ObservedBiomass = (isAggProd) ?
+                dataStruct.ObservedBiomassByGuilds : dataStruct.ObservedBiomassBySpecies;
+
+    // Species major order, as in calculateSummaryStatistics
+    for (int species=0; species<NumSpeciesOrGuilds; ++species) {
+        meanVal = 0;
+        for (int time=0; time<=RunLength; ++time) {
+            observed.push_back(ObservedBiomass(time,species));
+            estimated.push_back(Estimate.EstimatedBiomass(time,species));
+            meanVal += ObservedBiomass(time,species);
+        }
+        meanObserved.push_back(meanVal/(RunLength+1));
+    }
+
+    // The number of parameters depends on the model forms, so it's counted for
+    // each combination rather than read from the System
+    nmfEstimationEngine::packParameters(dataStruct,Estimate,Parameters);
+    Result.NumParameters = Parameters.size();
+
+    nmfUtilsStatistics::calculateSSResiduals(NumSpeciesOrGuilds,RunLength,observed,estimated,SSresiduals);
+    nmfUtilsStatistics::calculateAIC(NumSpeciesOrGuilds,Result.NumParameters,RunLength,SSresiduals,aic);
+    if (! nmfUtilsStatistics::calculateRMSE(NumSpeciesOrGuilds,RunLength,observed,estimated,rmse) ||
+        ! nmfUtilsStatistics::calculateMEF(NumSpeciesOrGuilds,RunLength,meanObserved,observed,estimated,mef)) {
+        Result.OK       = false;
+        Result.ErrorMsg = "Couldn't calculate the summary statistics";
+        return;
+    }
+
+    // Model values are averaged over the species as in the Summary Statistics table
+    Result.AIC  = std::accumulate(aic.begin(), aic.end(), 0.0)/NumSpeciesOrGuilds;
+    Result.RMSE = std::accumulate(rmse.begin(),rmse.end(),0.0)/NumSpeciesOrGuilds;
+    Result.MEF  = std::accumulate(mef.begin(), mef.end(), 0.0)/NumSpeciesOrGuilds;
+}
+
+bool
+nmfModelSweep::run(const std::vector<nmfModelSweepCombination>& Combinations,
+                   std::vector<nmfModelSweepResult>&            Results)
+{
+    int NumCombinations = Combinations.size();
+    int NumThreads      = (m_MaxNumThreads > 0) ? m_MaxNumThreads : QThread::idealThreadCount();
+    int NumConcurrent   = std::max(1,std::min(NumCombinations,NumThreads));
+    std::vector<Data_Struct> DataStructs(NumCombinations);
+    std::vector<bool> Loaded(NumCombinations,false);
+    QList<QFuture<void> > futures;
+
+    Results.assign(NumCombinations,nmfModelSweepResult());
+
+    // Load every combination's data structure up front on this thread
+    for (int i=0; i<NumCombinations; ++i) {
+        const nmfModelSweepCombination& Combination = Combinations[i];
+        nmfSystemLoader loader(m_DatabasePtr,m_Logger,m_SystemName);
+        Data_Struct& dataStruct = DataStructs[i];
+
+        Results[i].Combination = Combination;
+        loader.setModelForms(Combination.GrowthForm,Combination.HarvestForm,
+                             Combination.CompetitionForm,Combination.PredationForm);
+        if (! loader.loadParameters(dataStruct,false)) {
+            Results[i].ErrorMsg = "Couldn't load the System. " + loader.getErrorMessage();
+            m_Logger->logMsg(nmfConstants::Error,"[Error 1] nmfModelSweep::run: " + Results[i].ErrorMsg);
+            continue;
+        }
+        if (! Combination.Minimizer.empty()) {
+            dataStruct.Minimizer = Combination.Minimizer;
+        }
+        if (! Combination.ObjectiveCriterion.empty()) {
+            dataStruct.ObjectiveCriterion = Combination.ObjectiveCriterion;
+        }
+        if (! Combination.Scaling.empty()) {
+            dataStruct.Scaling = Combination.Scaling;
+        }
+        dataStruct.showDiagnosticChart = false;
+
+        // Report the settings that were actually used
+        Results[i].Combination.GrowthForm         = dataStruct.GrowthForm;
+        Results[i].Combination.HarvestForm        = dataStruct.HarvestForm;
+        Results[i].Combination.CompetitionForm    = dataStruct.CompetitionForm;
+        Results[i].Combination.PredationForm      = dataStruct.PredationForm;
+        Results[i].Combination.Minimizer          = dataStruct.Minimizer;
+        Results[i].Combination.ObjectiveCriterion = dataStruct.ObjectiveCriterion;
+        Results[i].Combination.Scaling            = dataStruct.Scaling;
+        Loaded[i] = true;
+    }
+
+    // Each combination is independent. The cores are split between the combinations
+    // running at once, and each estimator runs its starts on its share of them.
+    // BeesAlgorithm isn't known to be reentrant, so Bees combinations run one at a time.
+    if (m_Algorithm == "Bees Algorithm") {
+        NumConcurrent = 1;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(NumConcurrent);
+    for (int i=0; i<NumCombinations; ++i) {
+        if (! Loaded[i]) {
+            continue;
+        }
+        futures.append(QtConcurrent::run(&pool, [this,i,NumThreads,NumConcurrent,&DataStructs,&Results]() {
+            nmfEstimationResult Estimate;
+            nmfEstimationEngine engine(m_Algorithm);
+            if (m_CancelToken.isCancelled()) {
+                Results[i].ErrorMsg = "Sweep cancelled";
+                return;
+            }
+            engine.setCancellationToken(m_CancelToken);
+            engine.setMaxNumThreads(std::max(1,NumThreads/NumConcurrent));
+            Results[i].OK = engine.estimate(DataStructs[i],i+1,Estimate);
+            Results[i].ElapsedSeconds = Estimate.ElapsedSeconds;
+            if (! Results[i].OK) {
+                Results[i].ErrorMsg = engine.getErrorMessage();
+                return;
+            }
+            Results[i].Fitness = Estimate.Fitness;
+            calculateStatistics(DataStructs[i],Estimate,Results[i]);
+        }));
+    }
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+
+    return ! m_CancelToken.isCancelled();
+}
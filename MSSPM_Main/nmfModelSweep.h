@@ -0,0 +1,151 @@
+/**
+ * @file nmfModelSweep.h
+ * @brief Definition of the model form sweep
+ *
+ * This file contains the definition of the model form sweep. The sweep estimates a
+ * System with each of a set of model form, minimizer, objective criterion and scaling
+ * combinations concurrently (one at a time for the Bees Algorithm), and ranks the
+ * combinations by their summary statistics.
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfEstimationEngine.h"
+#include "nmfSystemLoader.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief One combination of settings to estimate in a sweep
+ */
+struct nmfModelSweepCombination {
+    std::string GrowthForm;
+    std::string HarvestForm;
+    std::string CompetitionForm;
+    std::string PredationForm;
+    std::string Minimizer;
+    std::string ObjectiveCriterion;
+    std::string Scaling;
+};
+
+/**
+ * @brief The estimation results of one sweep combination. The statistics are the
+ * model values shown in the Summary Statistics table (i.e., averaged over the species).
+ */
+struct nmfModelSweepResult {
+    nmfModelSweepCombination Combination;
+    bool                     OK             = false;
+    std::string              ErrorMsg;
+    int                      NumParameters  = 0;
+    double                   Fitness        = 0;
+    double                   AIC            = 0;
+    double                   RMSE           = 0;
+    double                   MEF            = 0;
+    double                   ElapsedSeconds = 0;
+};
+
+/**
+ * @brief Estimates a set of model combinations concurrently and ranks them
+ *
+ * The data structures are loaded from the database on the calling thread, since the
+ * database connection can't be shared between threads. Only the estimations run on
+ * the worker pool, and the cores are split between the combinations running at once.
+ * BeesAlgorithm isn't known to be reentrant, so Bees combinations run one at a time.
+ */
+class nmfModelSweep
+{
+private:
+    nmfTracedDatabase*   m_DatabasePtr;
+    nmfLogger*           m_Logger;
+    std::string          m_SystemName;
+    std::string          m_Algorithm;
+    int                  m_MaxNumThreads;
+    nmfCancellationToken m_CancelToken;
+
+    void calculateStatistics(const Data_Struct&         dataStruct,
+                             const nmfEstimationResult& Estimate,
+                             nmfModelSweepResult&       Result);
+
+public:
+    /**
+     * @brief nmfModelSweep : class constructor
+     * @param databasePtr : pointer to the (connected) database
+     * @param logger : pointer to the application logger
+     * @param systemName : name of the System to sweep
+     * @param algorithm : name of the estimation algorithm
+     */
+    nmfModelSweep(nmfTracedDatabase* databasePtr,
+                  nmfLogger*         logger,
+                  const std::string& systemName,
+                  const std::string& algorithm);
+   ~nmfModelSweep() {}
+
+    /**
+     * @brief Builds every combination of the passed settings. An empty list means
+     * the System's current setting.
+     * @param GrowthForms : growth forms to sweep
+     * @param HarvestForms : harvest forms to sweep
+     * @param CompetitionForms : competition forms to sweep
+     * @param PredationForms : predation forms to sweep
+     * @param Minimizers : minimizers to sweep
+     * @param ObjectiveCriteria : objective criteria to sweep
+     * @param Scalings : scaling algorithms to sweep
+     * @param Combinations : the combinations
+     */
+    static void enumerate(const std::vector<std::string>&        GrowthForms,
+                          const std::vector<std::string>&        HarvestForms,
+                          const std::vector<std::string>&        CompetitionForms,
+                          const std::vector<std::string>&        PredationForms,
+                          const std::vector<std::string>&        Minimizers,
+                          const std::vector<std::string>&        ObjectiveCriteria,
+                          const std::vector<std::string>&        Scalings,
+                          std::vector<nmfModelSweepCombination>& Combinations);
+    /**
+     * @brief Sorts the results best first. Failed combinations are sorted last.
+     * @param RankBy : "AIC" (lowest first), "RMSE" (lowest first) or "MEF" (highest first)
+     * @param Results : the results to sort
+     */
+    static void rank(const std::string&                RankBy,
+                     std::vector<nmfModelSweepResult>& Results);
+    /**
+     * @brief Estimates all of the combinations concurrently (Bees combinations one at a time)
+     * @param Combinations : the combinations to estimate
+     * @param Results : the results in the same order as the combinations
+     * @return Returns false if the sweep was cancelled
+     */
+    bool run(const std::vector<nmfModelSweepCombination>& Combinations,
+             std::vector<nmfModelSweepResult>&            Results);
+    /**
+     * @brief Sets the token that cancels the sweep
+     * @param CancelToken : the cancellation token shared with the caller
+     */
+    void setCancellationToken(const nmfCancellationToken& CancelToken);
+    /**
+     * @brief Sets the maximum number of threads used by the whole sweep
+     * @param MaxNumThreads : the maximum number of threads (0 for the ideal thread count)
+     */
+    void setMaxNumThreads(const int& MaxNumThreads);
+};
@@ -0,0 +1,109 @@
+/**
+ * @file nmfRandomStream.h
+ * @brief Definition of the counter-based random number streams used by the forecasts
+ *
+ * Each random value is a pure function of its key: (seed, run, parameter, species, index).
+ * Values can therefore be drawn in any order and on any thread and a given seed always
+ * reproduces the same forecast.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Counter-based random number generator
+ *
+ * There's no generator state to share or advance. The key is hashed with the
+ * SplitMix64 finalizer, one key component at a time.
+ */
+namespace nmfRandomStream {
+
+/**
+ * @brief The parameters (and harvest) that may be perturbed in a Monte Carlo forecast
+ */
+enum Parameter {
+    GrowthRate = 0,
+    CarryingCapacity,
+    Catchability,
+    Exponent,
+    CompetitionAlpha,
+    CompetitionBetaSpecies,
+    Predation,
+    Handling,
+    CompetitionBetaGuilds,
+    Harvest
+};
+
+inline uint64_t
+mix(uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ULL;
+    z  = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z  = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Returns the uniform random value in [0,1) for the passed key
+ * @param seed : forecast seed
+ * @param run : Monte Carlo run number
+ * @param parameter : parameter being perturbed
+ * @param species : species (or guild) index (or matrix row)
+ * @param index : secondary index (matrix column or year), 0 for per species parameters
+ * @return Returns the random value
+ */
+inline double
+uniform(const uint64_t& seed,
+        const uint32_t& run,
+        const Parameter& parameter,
+        const uint32_t& species,
+        const uint32_t& index)
+{
+    uint64_t h = mix(seed);
+    h = mix(h ^ run);
+    h = mix(h ^ ((uint64_t(parameter) << 32) | species));
+    h = mix(h ^ index);
+    return (h >> 11) * (1.0/9007199254740992.0); // top 53 bits / 2^53
+}
+
+/**
+ * @brief Returns the value perturbed uniformly in the range: [value*(1-uncertainty),value*(1+uncertainty)]
+ */
+inline double
+perturb(const double&    uncertainty,
+        const double&    value,
+        const uint64_t&  seed,
+        const uint32_t&  run,
+        const Parameter& parameter,
+        const uint32_t&  species,
+        const uint32_t&  index)
+{
+    if (uncertainty == 0) {
+        return value;
+    }
+    return value*(1.0 + uncertainty*(2.0*uniform(seed,run,parameter,species,index) - 1.0));
+}
+
+} // end namespace nmfRandomStream
@@ -0,0 +1,97 @@
+#include "nmfRetrospectiveEngine.h"
+
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+nmfRetrospectiveEngine::nmfRetrospectiveEngine(const std::string& algorithm)
+{
+    m_Algorithm     = algorithm;
+    m_MaxNumThreads = 0;
+    m_ErrorMsg.clear();
+}
+
+std::string
+nmfRetrospectiveEngine::getErrorMessage()
+{
+    return m_ErrorMsg;
+}
+
+void
+nmfRetrospectiveEngine::setCancellationToken(const nmfCancellationToken& CancelToken)
+{
+    m_CancelToken = CancelToken;
+}
+
+void
+nmfRetrospectiveEngine::setMaxNumThreads(const int& MaxNumThreads)
+{
+    m_MaxNumThreads = MaxNumThreads;
+}
+
+void
+nmfRetrospectiveEngine::setInitialParameters(const std::vector<double>& InitialParameters)
+{
+    m_InitialParameters = InitialParameters;
+}
+
+bool
+nmfRetrospectiveEngine::run(const Data_Struct&                       dataStruct,
+                            const std::vector<nmfRetrospectivePeel>& Peels,
+                            std::vector<nmfEstimationResult>&        Results)
+{
+    int NumPeels      = Peels.size();
+    int NumThreads    = (m_MaxNumThreads > 0) ? m_MaxNumThreads : QThread::idealThreadCount();
+    int NumConcurrent = std::max(1,std::min(NumPeels,NumThreads));
+    std::vector<Data_Struct> PeelDataStructs(NumPeels);
+    std::vector<std::string> ErrorMsgs(NumPeels);
+    QList<QFuture<void> > futures;
+
+    m_ErrorMsg.clear();
+    Results.assign(NumPeels,nmfEstimationResult());
+
+    for (int i=0; i<NumPeels; ++i) {
+        if (! nmfEstimationEngine::slice(dataStruct,Peels[i].FirstYear,Peels[i].RunLength,PeelDataStructs[i])) {
+            m_ErrorMsg = "Mohn's Rho range " + Peels[i].Label + " isn't within the System's years";
+            return false;
+        }
+    }
+
+    // The ranges are independent, so they're estimated at once with the cores split
+    // between them (each estimator runs its own starts on its share). BeesAlgorithm
+    // isn't known to be reentrant, so Bees ranges are estimated one at a time.
+    if (m_Algorithm == "Bees Algorithm") {
+        NumConcurrent = 1;
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(NumConcurrent);
+    for (int i=0; i<NumPeels; ++i) {
+        futures.append(QtConcurrent::run(&pool, [this,i,NumThreads,NumConcurrent,
+                                                 &PeelDataStructs,&ErrorMsgs,&Results]() {
+            nmfEstimationEngine engine(m_Algorithm);
+            if (m_CancelToken.isCancelled()) {
+                ErrorMsgs[i] = "Estimation cancelled";
+                return;
+            }
+            engine.setCancellationToken(m_CancelToken);
+            engine.setMaxNumThreads(std::max(1,NumThreads/NumConcurrent));
+            engine.setInitialParameters(m_InitialParameters);
+            if (! engine.estimate(PeelDataStructs[i],i+1,Results[i])) {
+                ErrorMsgs[i] = engine.getErrorMessage();
+            }
+        }));
+    }
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
+
+    for (int i=0; i<NumPeels; ++i) {
+        if (! ErrorMsgs[i].empty()) {
+            m_ErrorMsg = "Mohn's Rho range " + Peels[i].Label + ": " + ErrorMsgs[i];
+            return false;
+        }
+    }
+
+    return ! m_CancelToken.isCancelled();
+}
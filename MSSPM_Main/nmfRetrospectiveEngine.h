@@ -0,0 +1,102 @@
+/**
+ * @file nmfRetrospectiveEngine.h
+ * @brief Definition of the in-memory retrospective (Mohn's Rho) engine
+ *
+ * This file contains the definition of the retrospective engine. Each Mohn's Rho
+ * range is a slice of the System's time series held in memory, and the ranges are
+ * estimated concurrently (one at a time for the Bees Algorithm).
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfEstimationEngine.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief One Mohn's Rho range of a retrospective analysis
+ */
+struct nmfRetrospectivePeel {
+    std::string Label;         // the Mohn's Rho label (e.g., "1990-2010")
+    int         FirstYear = 0; // relative to the first year of the System's time series
+    int         RunLength = 0;
+};
+
+/**
+ * @brief Estimates all of the Mohn's Rho ranges of a retrospective analysis at once
+ *
+ * The ranges are sliced from the time series of the full range's data structure, so
+ * nothing is read from or written to the database. The caller persists the results.
+ */
+class nmfRetrospectiveEngine
+{
+private:
+    std::string          m_Algorithm;
+    int                  m_MaxNumThreads;
+    nmfCancellationToken m_CancelToken;
+    std::string          m_ErrorMsg;
+    std::vector<double>  m_InitialParameters;
+
+public:
+    /**
+     * @brief nmfRetrospectiveEngine : class constructor
+     * @param algorithm : name of the estimation algorithm
+     */
+    nmfRetrospectiveEngine(const std::string& algorithm);
+   ~nmfRetrospectiveEngine() {}
+
+    /**
+     * @brief Gets the message describing why the last analysis failed
+     * @return Returns the message (empty if the last analysis completed)
+     */
+    std::string getErrorMessage();
+    /**
+     * @brief Sets the token that cancels the analysis
+     * @param CancelToken : the cancellation token shared with the caller
+     */
+    void setCancellationToken(const nmfCancellationToken& CancelToken);
+    /**
+     * @brief Sets the maximum number of threads used by the whole analysis
+     * @param MaxNumThreads : the maximum number of threads (0 for the ideal thread count)
+     */
+    void setMaxNumThreads(const int& MaxNumThreads);
+    /**
+     * @brief Warm starts every range from previously estimated parameters (typically
+     * the full range's estimate, since the ranges share its parameters)
+     * @param InitialParameters : the parameters in the estimators' parameter order (empty for a cold start)
+     */
+    void setInitialParameters(const std::vector<double>& InitialParameters);
+    /**
+     * @brief Estimates each of the ranges concurrently (Bees ranges one at a time)
+     * @param dataStruct : the data structure of the System's full range
+     * @param Peels : the Mohn's Rho ranges to estimate
+     * @param Results : the estimation results in the same order as the ranges
+     * @return Returns false if any range failed or the analysis was cancelled
+     */
+    bool run(const Data_Struct&                       dataStruct,
+             const std::vector<nmfRetrospectivePeel>& Peels,
+             std::vector<nmfEstimationResult>&        Results);
+};
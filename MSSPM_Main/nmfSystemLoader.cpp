@@ -0,0 +1,1408 @@
+/**
+ * @file nmfSystemLoader.cpp
+ * @brief Implementation of the loader that reads a System's model inputs from the database
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#include "nmfSystemLoader.h"
+
+#include <iostream>
+
+nmfSystemLoader::nmfSystemLoader(nmfTracedDatabase* databasePtr,
+                                 nmfLogger*         logger,
+                                 const std::string& systemName)
+{
+    m_DatabasePtr   = databasePtr;
+    m_Logger        = logger;
+    m_SystemName    = systemName;
+    m_MohnsRhoLabel = "";
+    m_ErrorMsg      = "";
+    m_GrowthForm.clear();
+    m_HarvestForm.clear();
+    m_CompetitionForm.clear();
+    m_PredationForm.clear();
+}
+
+std::string
+nmfSystemLoader::getErrorMessage()
+{
+    return m_ErrorMsg;
+}
+
+void
+nmfSystemLoader::setErrorMessage(const std::string& msg)
+{
+    m_ErrorMsg = msg;
+}
+
+void
+nmfSystemLoader::setMohnsRhoLabel(const std::string& mohnsRhoLabel)
+{
+    m_MohnsRhoLabel = mohnsRhoLabel;
+}
+
+void
+nmfSystemLoader::setModelForms(const std::string& growthForm,
+                               const std::string& harvestForm,
+                               const std::string& competitionForm,
+                               const std::string& predationForm)
+{
+    m_GrowthForm      = growthForm;
+    m_HarvestForm     = harvestForm;
+    m_CompetitionForm = competitionForm;
+    m_PredationForm   = predationForm;
+}
+
+bool
+nmfSystemLoader::getGuilds(int &NumGuilds, QStringList &GuildList)
+{
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    GuildList.clear();
+
+    fields   = {"GuildName"};
+    queryStr = "SELECT GuildName from Guilds ORDER BY GuildName";
+    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumGuilds = dataMap["GuildName"].size();
+    if (NumGuilds == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getSpecies: No guilds found in table Guilds");
+        return false;
+    }
+
+    for (int guild=0; guild<NumGuilds; ++guild) {
+        GuildList << QString::fromStdString(dataMap["GuildName"][guild]);
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getSpecies(int &NumSpecies, QStringList &SpeciesList)
+{
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    SpeciesList.clear();
+
+    fields   = {"SpeName"};
+    queryStr = "SELECT SpeName from Species ORDER BY SpeName";
+    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumSpecies = dataMap["SpeName"].size();
+    if (NumSpecies == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getSpecies: No species found in table Species");
+        return false;
+    }
+
+    for (int species=0; species<NumSpecies; ++species) {
+        SpeciesList << QString::fromStdString(dataMap["SpeName"][species]);
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getStartYear(int &StartYear)
+{
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    fields   = {"StartYear"};
+    queryStr = "SELECT StartYear FROM Systems WHERE SystemName = '" + m_SystemName + "'";
+    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    if (dataMap["StartYear"].size() == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getStartYear: No System found named: " + m_SystemName);
+        return false;
+    }
+    StartYear = std::stoi(dataMap["StartYear"][0]);
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getInitialObservedBiomass(QList<double> &InitBiomass)
+{
+
+    int NumSpecies;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    fields     = {"SpeName","InitBiomass"};
+    queryStr   = "SELECT SpeName,InitBiomass from Species ORDER BY SpeName";
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumSpecies = dataMap["SpeName"].size();
+    if (NumSpecies == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getInitialObservedBiomass: No species found in table Species");
+        return false;
+    }
+    for (int i=0; i<NumSpecies; ++i) {
+        InitBiomass.append(std::stod(dataMap["InitBiomass"][i]));
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getFinalObservedBiomass(QList<double> &FinalBiomass)
+{
+    int NumRecords;
+    int NumSpecies;
+    int RunLength;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    QStringList SpeciesList;
+    boost::numeric::ublas::matrix<double> ObservedBiomass;
+
+    // Get RunLength
+    fields     = {"SystemName","RunLength"};
+    queryStr   = "SELECT SystemName,RunLength from Systems where ";
+    queryStr  += "SystemName = '" +  m_SystemName + "'";
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords = dataMap["SystemName"].size();
+    if (NumRecords == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getFinalObservedBiomass: No records found.");
+        m_Logger->logMsg(nmfConstants::Error,queryStr);
+        return false;
+    }
+    RunLength = std::stoi(dataMap["RunLength"][0]);
+
+    // Get NumSpecies
+    if (! getSpecies(NumSpecies,SpeciesList))
+        return false;
+
+    // Get final observed biomass values
+    if (! getTimeSeriesData("","","ObservedBiomass",NumSpecies,RunLength,ObservedBiomass)) {
+        return false;
+    }
+    for (int species=0; species<NumSpecies; ++species) {
+        FinalBiomass.push_back(ObservedBiomass(RunLength,species));
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getGuildData(const int&                             NumGuilds,
+                              const int&                             RunLength,
+                              const QStringList&                     GuildList,
+                              std::map<int,std::vector<int> >&       GuildSpecies,
+                              std::vector<int>&                      GuildNum,
+                              boost::numeric::ublas::matrix<double>& ObservedBiomassByGuilds)
+{
+    int NumSpecies;
+    int guildNum;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    std::string guildName;
+    std::map<std::string,double> InitialGuildBiomass;
+    std::map<std::string,int> GuildMap;
+
+    GuildSpecies.clear();
+    GuildNum.clear();
+    InitialGuildBiomass.clear();
+    ObservedBiomassByGuilds.clear();
+
+    fields    = {"GuildName","GuildK"};
+    queryStr  = "SELECT GuildName,GuildK from Guilds ORDER by GuildName";
+    dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    for (int i=0; i<NumGuilds; ++i) {
+        guildName = dataMap["GuildName"][i];
+        GuildMap[guildName] = i;
+    }
+
+    // Load Growth Rate Min and Max
+    fields     = {"SpeName","GuildName","InitBiomass"};
+    queryStr   = "SELECT SpeName,GuildName,InitBiomass from Species ORDER BY SpeName";
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumSpecies = dataMap["SpeName"].size();
+
+    for (int species=0; species<NumSpecies; ++species) {
+        guildName = dataMap["GuildName"][species];
+        guildNum  = GuildMap[guildName];
+        InitialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
+        GuildSpecies[guildNum].push_back(species);
+        GuildNum.push_back(guildNum);
+    }
+
+    nmfUtils::initialize(ObservedBiomassByGuilds,RunLength+1,NumGuilds);
+    for (int i=0; i<NumGuilds; ++i) {
+       ObservedBiomassByGuilds(0,i) = InitialGuildBiomass[GuildList[i].toStdString()];
+    }
+
+    return true;
+}
+
+void
+nmfSystemLoader::getSpeciesGuildMap(std::map<std::string,std::string>& SpeciesGuildMap)
+{
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    fields   = {"SpeName","GuildName"};
+    queryStr = "SELECT SpeName,GuildName FROM Species ORDER BY SpeName";
+    dataMap  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+
+    for (unsigned i=0; i<dataMap["SpeName"].size(); ++i) {
+        SpeciesGuildMap[dataMap["SpeName"][i]] = dataMap["GuildName"][i];
+    }
+}
+
+bool
+nmfSystemLoader::getTimeSeriesData(
+        const std::string  MohnsRhoLabel,
+        const std::string  ForecastName,
+        const std::string& TableName,
+        const int&         NumSpecies,
+        const int&         RunLength,
+        boost::numeric::ublas::matrix<double>& TableData)
+{
+    int m=0;
+    int NumRecords;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    std::string errorMsg;
+    std::string ModifiedTableName = "";
+    QString SystemName = QString::fromStdString(m_SystemName);
+
+    auto parts = SystemName.split("__");
+    SystemName = parts[0];
+
+    nmfUtils::initialize(TableData,RunLength+1,NumSpecies); // +1 because there's a 0 year
+
+    // Load data
+    if (ForecastName == "") {
+        ModifiedTableName = TableName;;
+        fields   = {"MohnsRhoLabel","SystemName","SpeName","Year","Value"};
+        queryStr = "SELECT MohnsRhoLabel,SystemName,SpeName,Year,Value FROM " + ModifiedTableName +
+                   " WHERE SystemName = '" + SystemName.toStdString() +
+                   "' AND MohnsRhoLabel = '" + MohnsRhoLabel + "' ORDER BY SpeName,Year";
+    } else {
+        ModifiedTableName = "Forecast" + TableName;;
+        fields   = {"ForecastName","SpeName","Year","Value"};
+        queryStr = "SELECT ForecastName,SpeName,Year,Value FROM " + ModifiedTableName +
+                   " WHERE ForecastName = '" + ForecastName +
+                   "' ORDER BY SpeName,Year";
+    }
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords = dataMap["SpeName"].size();
+    if (NumRecords == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getTimeSeriesData: No records found in table "+TableName);
+        m_Logger->logMsg(nmfConstants::Error,queryStr);
+        setErrorMessage("Missing or unsaved data. Please populate and resave table: " + TableName);
+        return false;
+    }
+    if (NumRecords != NumSpecies*(RunLength+1)) {
+        errorMsg  = "[Error 2] getTimeSeriesData: Number of records found (" + std::to_string(NumRecords) + ") in ";
+        errorMsg += "table " + ModifiedTableName + " does not equal number of Species*(RunLength+1) (";
+        errorMsg += std::to_string(NumSpecies) + "*" + std::to_string((RunLength+1)) + "=";
+        errorMsg += std::to_string(NumSpecies*(RunLength+1)) + ") records";
+        errorMsg += "\n" + queryStr;
+        m_Logger->logMsg(nmfConstants::Error,errorMsg);
+        setErrorMessage("Missing or unsaved data.\n\nPlease populate and resave table: " + ModifiedTableName);
+        return false;
+    }
+
+    // Figure out what to do here with the hardcoded 0 for time=0.....RSK
+    for (int species=0; species<NumSpecies; ++species) {
+        for (int time=0; time<=RunLength; ++time) {
+            TableData(time,species) = std::stod(dataMap["Value"][m++]);
+        }
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::getTimeSeriesDataByGuild(
+        std::string ForecastName,
+        const std::string &TableName,
+        const int &NumGuilds,
+        const int &RunLength,
+        boost::numeric::ublas::matrix<double> &TableData)
+{
+    int m=0;
+    int NumRecords;
+    int NumSpecies;
+    int NumGuilds2;
+    int GuildNum;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    std::string errorMsg;
+    std::string ModifiedTableName = "";
+    std::string GuildName;
+    std::string SpeciesName;
+    QStringList SpeciesList;
+    QStringList GuildList;
+    std::map<std::string,std::string> SpeciesToGuildMap;
+    std::map<std::string,int> GuildNameToNumMap;
+
+    nmfUtils::initialize(TableData,RunLength+1,NumGuilds); // +1 because there's a 0 year
+
+    if (! getGuilds(NumGuilds2,GuildList)) {
+        return false;
+    }
+
+    // Get Species names
+    if (! getSpecies(NumSpecies,SpeciesList))
+        return false;
+
+    // Load data
+    if (ForecastName == "") {
+        ModifiedTableName = TableName;;
+        fields   = {"SystemName","SpeName","Year","Value"};
+        queryStr = "SELECT SystemName,SpeName,Year,Value FROM " + ModifiedTableName +
+                   " WHERE SystemName = '" + m_SystemName + "' ORDER BY SpeName,Year";
+    } else {
+        ModifiedTableName = "Forecast" + TableName;
+        fields   = {"ForecastName","SpeName","Year","Value"};
+        queryStr = "SELECT ForecastName,SpeName,Year,Value FROM " + ModifiedTableName +
+                   " WHERE ForecastName = '" + ForecastName + "' ORDER BY SpeName,Year";
+    }
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords = dataMap["SpeName"].size();
+    if (NumRecords == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] getTimeSeriesDataByGuild: No records found in table "+TableName);
+        return false;
+    }
+    if (NumRecords != NumSpecies*(RunLength+1)) {
+        errorMsg  = "[Error 2] getTimeSeriesDataByGuild: Number of records found (" + std::to_string(NumRecords) + ") in ";
+        errorMsg += "table " + ModifiedTableName + " does not equal number of Species*(RunLength+1) (";
+        errorMsg += std::to_string(NumSpecies) + "*" + std::to_string((RunLength+1)) + "=";
+        errorMsg += std::to_string(NumSpecies*(RunLength+1)) + ") records";
+        errorMsg += "\n" + queryStr;
+        m_Logger->logMsg(nmfConstants::Error,errorMsg);
+    }
+
+    m = 0;
+    int num=0;
+    for (QString guildName : GuildList) {
+        GuildNameToNumMap[guildName.toStdString()] = num++;
+    }
+    getSpeciesGuildMap(SpeciesToGuildMap);
+    for (int i=0; i<NumSpecies; ++i) {
+        SpeciesName = dataMap["SpeName"][m];
+        GuildName   = SpeciesToGuildMap[SpeciesName];
+        GuildNum    = GuildNameToNumMap[GuildName];
+        for (int time=0; time<=RunLength; ++time) {
+            TableData(time,GuildNum) += std::stod(dataMap["Value"][m++]);
+        }
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::loadParameters(Data_Struct &dataStruct, const bool& verbose)
+{
+    bool loadOK;
+    int RunLength;
+    int NumSpecies;
+    int NumGuilds;
+    int GuildNum;
+    int NumCompetitionParameters = 0;
+    int NumPredationParameters   = 0;
+    int NumHandlingParameters    = 0;
+    int NumExponentParameters    = 0;
+    int NumBetaSpeciesParameters = 0;
+    int NumBetaGuildsParameters  = 0;
+    int NumSpeciesOrGuilds;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    std::string growthForm;
+    std::string harvestForm;
+    std::string competitionForm;
+    std::string predationForm;
+    std::map<std::string,double> initialGuildBiomass;
+    std::vector<std::string> Guild;
+    std::map<std::string,int> GuildMap;
+    std::map<std::string,std::string> GuildSpeciesMap;
+    std::string guildName;
+
+    initialGuildBiomass.clear();
+    dataStruct.GuildSpecies.clear();
+    dataStruct.GuildNum.clear();
+    dataStruct.ObservedBiomassBySpecies.clear();
+    dataStruct.ObservedBiomassByGuilds.clear();
+    dataStruct.Catch.clear();
+    dataStruct.Effort.clear();
+    dataStruct.Exploitation.clear();
+    dataStruct.GrowthRateMax.clear();
+    dataStruct.GrowthRateMin.clear();
+    dataStruct.CarryingCapacityInitial.clear();
+    dataStruct.CarryingCapacityMax.clear();
+    dataStruct.CarryingCapacityMin.clear();
+    dataStruct.ExploitationRateMax.clear();
+    dataStruct.ExploitationRateMin.clear();
+    dataStruct.CatchabilityMax.clear();
+    dataStruct.CatchabilityMin.clear();
+    dataStruct.CompetitionMin.clear();
+    dataStruct.CompetitionMax.clear();
+    dataStruct.CompetitionBetaSpeciesMin.clear();
+    dataStruct.CompetitionBetaSpeciesMax.clear();
+    dataStruct.CompetitionBetaGuildsMin.clear();
+    dataStruct.CompetitionBetaGuildsMax.clear();
+    dataStruct.PredationMin.clear();
+    dataStruct.PredationMax.clear();
+    dataStruct.HandlingMin.clear();
+    dataStruct.HandlingMax.clear();
+    dataStruct.ExponentMin.clear();
+    dataStruct.ExponentMax.clear();
+//  dataStruct.OutputBiomass.clear();
+    dataStruct.Minimizer.clear();
+    dataStruct.ObjectiveCriterion.clear();
+    dataStruct.Scaling.clear();
+
+    if (verbose) {
+        std::cout << "Reading from: " << m_SystemName << std::endl;
+    }
+    // Find RunLength
+    fields     = {"GrowthForm","HarvestForm","WithinGuildCompetitionForm","PredationForm","RunLength","Minimizer","ObjectiveCriterion",
+                  "BeesNumTotal","BeesNumElite","BeesNumOther","BeesNumEliteSites",
+                  "BeesNumBestSites","BeesNumRepetitions","BeesMaxGenerations","BeesNeighborhoodSize",
+                  "Scaling","GAGenerations","GAConvergence",
+                  "NLoptUseStopVal","NLoptUseStopAfterTime","NLoptUseStopAfterIter",
+                  "NLoptStopVal","NLoptStopAfterTime","NLoptStopAfterIter"};
+    queryStr   = "SELECT GrowthForm,HarvestForm,WithinGuildCompetitionForm,PredationForm,RunLength,Minimizer,ObjectiveCriterion,";
+    queryStr  += "BeesNumTotal,BeesNumElite,BeesNumOther,BeesNumEliteSites,BeesNumBestSites,BeesNumRepetitions,";
+    queryStr  += "BeesMaxGenerations,BeesNeighborhoodSize,Scaling,GAGenerations,GAConvergence,";
+    queryStr  += "NLoptUseStopVal,NLoptUseStopAfterTime,NLoptUseStopAfterIter,";
+    queryStr  += "NLoptStopVal,NLoptStopAfterTime,NLoptStopAfterIter ";
+    queryStr  += "FROM Systems WHERE SystemName='" + m_SystemName + "'";
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    if (dataMap["RunLength"].size() == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] loadParameters: No System found named: " + m_SystemName);
+        setErrorMessage("No System found named: " + m_SystemName);
+        return false;
+    }
+
+    RunLength                        = std::stoi(dataMap["RunLength"][0]);
+    dataStruct.RunLength             = RunLength;
+    dataStruct.GrowthForm            = dataMap["GrowthForm"][0];
+    dataStruct.HarvestForm           = dataMap["HarvestForm"][0];
+    dataStruct.CompetitionForm       = dataMap["WithinGuildCompetitionForm"][0];
+    dataStruct.PredationForm         = dataMap["PredationForm"][0];
+    dataStruct.BeesNumTotal          = std::stoi(dataMap["BeesNumTotal"][0]);
+    dataStruct.BeesNumElite          = std::stoi(dataMap["BeesNumElite"][0]);
+    dataStruct.BeesNumOther          = std::stoi(dataMap["BeesNumOther"][0]);
+    dataStruct.BeesNumEliteSites     = std::stoi(dataMap["BeesNumEliteSites"][0]);
+    dataStruct.BeesNumBestSites      = std::stoi(dataMap["BeesNumBestSites"][0]);
+    dataStruct.BeesNumRepetitions    = std::stoi(dataMap["BeesNumRepetitions"][0]);
+    dataStruct.BeesMaxGenerations    = std::stoi(dataMap["BeesMaxGenerations"][0]);
+    dataStruct.BeesNeighborhoodSize  = std::stof(dataMap["BeesNeighborhoodSize"][0]);
+    dataStruct.Scaling               = dataMap["Scaling"][0];
+    dataStruct.GAGenerations         = std::stoi(dataMap["GAGenerations"][0]);
+    dataStruct.GAConvergence         = std::stoi(dataMap["GAConvergence"][0]);
+    dataStruct.Minimizer             = dataMap["Minimizer"][0];
+    dataStruct.ObjectiveCriterion    = dataMap["ObjectiveCriterion"][0];
+    dataStruct.NLoptUseStopVal       = std::stoi(dataMap["NLoptUseStopVal"][0]);
+    dataStruct.NLoptUseStopAfterTime = std::stoi(dataMap["NLoptUseStopAfterTime"][0]);
+    dataStruct.NLoptUseStopAfterIter = std::stoi(dataMap["NLoptUseStopAfterIter"][0]);
+    dataStruct.NLoptStopVal          = std::stod(dataMap["NLoptStopVal"][0]);
+    dataStruct.NLoptStopAfterTime    = std::stoi(dataMap["NLoptStopAfterTime"][0]);
+    dataStruct.NLoptStopAfterIter    = std::stoi(dataMap["NLoptStopAfterIter"][0]);
+
+    // Model forms other than the System's (e.g., when sweeping over model forms)
+    if (! m_GrowthForm.empty()) {
+        dataStruct.GrowthForm = m_GrowthForm;
+    }
+    if (! m_HarvestForm.empty()) {
+        dataStruct.HarvestForm = m_HarvestForm;
+    }
+    if (! m_CompetitionForm.empty()) {
+        dataStruct.CompetitionForm = m_CompetitionForm;
+    }
+    if (! m_PredationForm.empty()) {
+        dataStruct.PredationForm = m_PredationForm;
+    }
+
+    growthForm      = dataStruct.GrowthForm;
+    harvestForm     = dataStruct.HarvestForm;
+    competitionForm = dataStruct.CompetitionForm;
+    predationForm   = dataStruct.PredationForm;
+
+    if (growthForm == "Null") {
+        setErrorMessage("Please enter a non-null growth form.");
+        return false;
+    }
+
+    bool isAlpha    = (competitionForm == "NO_K");
+    bool isRho      = (predationForm   != "Null");
+    bool isHandling = (predationForm   == "Type II") || (predationForm == "Type III");
+    bool isExponent = (predationForm   == "Type III");
+    bool isMSPROD   = (competitionForm == "MS-PROD");
+    bool isAGGPROD  = (competitionForm == "AGG-PROD");
+
+    if (isAlpha) {
+        dataStruct.CompetitionMin.clear();
+        dataStruct.CompetitionMax.clear();
+    }
+    if (isRho) {
+        dataStruct.PredationMin.clear();
+        dataStruct.PredationMax.clear();
+    }
+    if (isHandling) {
+        dataStruct.HandlingMin.clear();
+        dataStruct.HandlingMax.clear();
+    }
+    if (isExponent) {
+        dataStruct.ExponentMin.clear();
+        dataStruct.ExponentMax.clear();
+    }
+    if (isMSPROD) {
+        dataStruct.CompetitionBetaSpeciesMin.clear();
+        dataStruct.CompetitionBetaSpeciesMax.clear();
+        dataStruct.CompetitionBetaGuildsMin.clear();
+        dataStruct.CompetitionBetaGuildsMax.clear();
+    } else if (isAGGPROD) {
+        dataStruct.CompetitionBetaGuildsMin.clear();
+        dataStruct.CompetitionBetaGuildsMax.clear();
+    }
+
+    // Get Guild information
+    fields    = {"GuildName","GuildK"};
+    queryStr  = "SELECT GuildName,GuildK from Guilds ORDER by GuildName";
+    dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumGuilds = dataMap["GuildName"].size();
+    dataStruct.NumGuilds = NumGuilds;
+    for (int i=0; i<NumGuilds; ++i) {
+        guildName = dataMap["GuildName"][i];
+        Guild.push_back(guildName);
+        GuildMap[guildName] = i;
+    }
+
+    if (isAGGPROD) {
+        fields     = {"GuildName","GrowthRateMin","GrowthRateMax","GuildK","GuildKMin",
+                      "GuildKMax","CatchabilityMin","CatchabilityMax"};
+        queryStr   = "SELECT GuildName,GrowthRateMin,GrowthRateMax,GuildK,GuildKMin,";
+        queryStr  += "GuildKMax,CatchabilityMin,CatchabilityMax from Guilds ORDER BY GuildName";
+        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumGuilds  = dataMap["GuildName"].size();
+        nmfUtils::initialize(dataStruct.GrowthRateMin,      NumGuilds);
+        nmfUtils::initialize(dataStruct.GrowthRateMax,      NumGuilds);
+        nmfUtils::initialize(dataStruct.CarryingCapacityInitial,NumGuilds);
+        nmfUtils::initialize(dataStruct.CarryingCapacityMin,NumGuilds);
+        nmfUtils::initialize(dataStruct.CarryingCapacityMax,NumGuilds);
+        nmfUtils::initialize(dataStruct.CatchabilityMin,    NumGuilds);
+        nmfUtils::initialize(dataStruct.CatchabilityMax,    NumGuilds);
+        for (int guild=0; guild<NumGuilds; ++guild) {
+            dataStruct.GrowthRateMin(guild)       = std::stod(dataMap["GrowthRateMin"][guild]);
+            dataStruct.GrowthRateMax(guild)       = std::stod(dataMap["GrowthRateMax"][guild]);
+            dataStruct.CarryingCapacityInitial(guild) = std::stod(dataMap["GuildK"][guild]);
+            dataStruct.CarryingCapacityMin(guild) = std::stod(dataMap["GuildKMin"][guild]);
+            dataStruct.CarryingCapacityMax(guild) = std::stod(dataMap["GuildKMax"][guild]);
+            dataStruct.CatchabilityMin(guild)     = std::stod(dataMap["CatchabilityMin"][guild]);
+            dataStruct.CatchabilityMax(guild)     = std::stod(dataMap["CatchabilityMax"][guild]);
+            guildName = dataMap["GuildName"][guild];
+            GuildNum  = GuildMap[guildName];
+            dataStruct.GuildSpecies[GuildNum].push_back(guild);
+            dataStruct.GuildNum.push_back(GuildNum);
+        }
+
+        fields     = {"SpeName","GuildName","InitBiomass","GrowthRateMin","GrowthRateMax",
+                      "SpeciesK","SpeciesKMin","SpeciesKMax","CatchabilityMin","CatchabilityMax"};
+        queryStr   = "SELECT SpeName,GuildName,InitBiomass,GrowthRateMin,GrowthRateMax,";
+        queryStr  += "SpeciesK,SpeciesKMin,SpeciesKMax,CatchabilityMin,CatchabilityMax from Species ORDER BY SpeName";
+        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumSpecies = dataMap["SpeName"].size();
+        for (int species=0; species<NumSpecies; ++species) {
+            guildName = dataMap["GuildName"][species];
+            GuildSpeciesMap[dataMap["SpeName"][species]] = guildName;
+            initialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
+        }
+        dataStruct.NumSpecies = NumSpecies;
+
+    } else {
+        fields     = {"SpeName","GuildName","InitBiomass","GrowthRateMin","GrowthRateMax",
+                      "SpeciesK","SpeciesKMin","SpeciesKMax","CatchabilityMin","CatchabilityMax"};
+        queryStr   = "SELECT SpeName,GuildName,InitBiomass,GrowthRateMin,GrowthRateMax,";
+        queryStr  += "SpeciesK,SpeciesKMin,SpeciesKMax,CatchabilityMin,CatchabilityMax from Species ORDER BY SpeName";
+        dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumSpecies = dataMap["SpeName"].size();
+        dataStruct.NumSpecies = NumSpecies;
+        nmfUtils::initialize(dataStruct.GrowthRateMin,      NumSpecies);
+        nmfUtils::initialize(dataStruct.GrowthRateMax,      NumSpecies);
+        nmfUtils::initialize(dataStruct.CarryingCapacityInitial,NumSpecies);
+        nmfUtils::initialize(dataStruct.CarryingCapacityMin,NumSpecies);
+        nmfUtils::initialize(dataStruct.CarryingCapacityMax,NumSpecies);
+        nmfUtils::initialize(dataStruct.CatchabilityMin,    NumSpecies);
+        nmfUtils::initialize(dataStruct.CatchabilityMax,    NumSpecies);
+        for (int species=0; species<NumSpecies; ++species) {
+            dataStruct.GrowthRateMin(species)       = std::stod(dataMap["GrowthRateMin"][species]);
+            dataStruct.GrowthRateMax(species)       = std::stod(dataMap["GrowthRateMax"][species]);
+            dataStruct.CarryingCapacityInitial(species) = std::stod(dataMap["SpeciesK"][species]);
+            dataStruct.CarryingCapacityMin(species) = std::stod(dataMap["SpeciesKMin"][species]);
+            dataStruct.CarryingCapacityMax(species) = std::stod(dataMap["SpeciesKMax"][species]);
+            dataStruct.CatchabilityMin(species)     = std::stod(dataMap["CatchabilityMin"][species]);
+            dataStruct.CatchabilityMax(species)     = std::stod(dataMap["CatchabilityMax"][species]);
+            guildName = dataMap["GuildName"][species];
+            GuildNum  = GuildMap[guildName];
+            initialGuildBiomass[guildName] += std::stod(dataMap["InitBiomass"][species]);
+            dataStruct.GuildSpecies[GuildNum].push_back(species);
+            dataStruct.GuildNum.push_back(GuildNum);
+        }
+    }
+
+    if (verbose) {
+        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Growth Rate Min/Max");
+        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Carrying Capacity Min/Max");
+    }
+
+    NumSpeciesOrGuilds = (isAGGPROD) ? NumGuilds : NumSpecies;
+
+    // Load Interaction coefficients
+    if (isAlpha) {
+        loadOK = loadInteraction(NumSpeciesOrGuilds, "Competition",
+                                 "CompetitionAlphaMin","CompetitionAlphaMax",
+                                 dataStruct.CompetitionMin, dataStruct.CompetitionMax,
+                                 NumCompetitionParameters);
+        if (! loadOK) return false;
+    }
+    if (isRho) {
+        loadOK = loadInteraction(NumSpeciesOrGuilds, "Predation",
+                                 "PredationLossRatesMin", "PredationLossRatesMax",
+                                 dataStruct.PredationMin, dataStruct.PredationMax,
+                                 NumPredationParameters);
+        if (! loadOK) return false;
+    }
+    if (isHandling) {
+        loadOK = loadInteraction(NumSpeciesOrGuilds, "Handling",
+                                 "HandlingTimeMin", "HandlingTimeMax",
+                                 dataStruct.HandlingMin, dataStruct.HandlingMax,
+                                 NumHandlingParameters);
+        if (! loadOK) return false;
+    }
+    if (isExponent) {
+        loadOK = loadInteraction(NumSpeciesOrGuilds, "Exponent",
+                                 "PredationExponentMin", "PredationExponentMax",
+                                 dataStruct.ExponentMin, dataStruct.ExponentMax,
+                                 NumExponentParameters);
+        if (! loadOK) return false;
+    }
+
+    if (isMSPROD) {
+        loadOK = loadInteraction(NumSpecies, "MSPROD-Species",
+                                 "CompetitionBetaSpeciesMin",
+                                 "CompetitionBetaSpeciesMax",
+                                 dataStruct.CompetitionBetaSpeciesMin,
+                                 dataStruct.CompetitionBetaSpeciesMax,
+                                 NumBetaSpeciesParameters);
+        if (! loadOK) return false;
+        loadOK = loadInteractionGuilds(NumSpecies, NumGuilds, "Competition-MSPROD",
+                                       GuildSpeciesMap,
+                                      "CompetitionBetaGuildsMin","CompetitionBetaGuildsMax",
+                                       dataStruct.CompetitionBetaGuildsMin,
+                                       dataStruct.CompetitionBetaGuildsMax,
+                                       NumBetaGuildsParameters);
+        if (! loadOK) return false;
+    } else if (isAGGPROD) {
+        loadOK = loadInteractionGuilds(NumSpecies, NumGuilds, "Competition-AGGPROD",
+                                       GuildSpeciesMap,
+                                      "CompetitionBetaGuildsMin", "CompetitionBetaGuildsMax",
+                                       dataStruct.CompetitionBetaGuildsMin,
+                                       dataStruct.CompetitionBetaGuildsMax,
+                                       NumBetaSpeciesParameters);
+        if (! loadOK) return false;
+    }
+
+    // Calculate total number of parameters
+    dataStruct.TotalNumberParameters = 0;
+    if (growthForm == "Linear") {
+        dataStruct.TotalNumberParameters = NumSpecies;
+    } else if (growthForm == "Logistic") {
+        dataStruct.TotalNumberParameters = 2*NumSpecies;
+    }
+    if (harvestForm == "Effort (qE)") {
+        dataStruct.TotalNumberParameters += NumSpecies;
+    }
+    if (predationForm != "Null") {
+        dataStruct.TotalNumberParameters += NumPredationParameters;
+    }
+    if ((predationForm == "Type II") || (predationForm == "Type III")) {
+        dataStruct.TotalNumberParameters += NumHandlingParameters;
+    }
+    if (predationForm == "Type III") {
+        dataStruct.TotalNumberParameters += NumExponentParameters;
+    }
+    if (competitionForm == "NO_K") {
+        dataStruct.TotalNumberParameters += NumCompetitionParameters;
+    } else if (competitionForm == "MS-PROD") {
+        dataStruct.TotalNumberParameters += NumBetaSpeciesParameters;
+        dataStruct.TotalNumberParameters += NumBetaGuildsParameters;
+    } else if (competitionForm == "AGG-PROD") {
+        dataStruct.TotalNumberParameters += NumBetaGuildsParameters;
+    }
+
+    // Set Benchmark type and number of parameters (RSK - improve this later)
+    dataStruct.Benchmark = growthForm;
+    if (isAlpha || isRho) {
+        dataStruct.Benchmark = "LogisticMultiSpecies";
+    }
+
+    if (harvestForm == "Catch") {
+        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Catch",NumSpecies,RunLength,dataStruct.Catch))
+            return false;
+        if (verbose) {
+            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Catch");
+        }
+    } else if (harvestForm == "Effort (qE)") {
+        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Effort",NumSpecies,RunLength,dataStruct.Effort))
+            return false;
+        if (verbose) {
+            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Effort");
+        }
+    } else if (harvestForm == "Exploitation (F)") {
+        if (! getTimeSeriesData(m_MohnsRhoLabel,"","Exploitation",NumSpecies,RunLength,dataStruct.Exploitation))
+            return false;
+        if (verbose) {
+            m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Exploitation");
+        }
+    }
+    if (! getTimeSeriesData(m_MohnsRhoLabel,"","ObservedBiomass",NumSpecies,RunLength,dataStruct.ObservedBiomassBySpecies)) {
+        return false;
+    }
+
+    // Load time series by guild observed biomass just load the first year's
+    nmfUtils::initialize(dataStruct.ObservedBiomassByGuilds,RunLength+1,NumGuilds);
+    for (int i=0; i<NumGuilds; ++i) {
+       dataStruct.ObservedBiomassByGuilds(0,i) = initialGuildBiomass[Guild[i]];
+    }
+    if (verbose) {
+        m_Logger->logMsg(nmfConstants::Normal,"LoadParameters Read: Biomass");
+    }
+
+    return true;
+}
+
+bool
+nmfSystemLoader::loadInteraction(int &NumSpeciesOrGuilds,
+                                 std::string InteractionType,
+                                 std::string MinTable,
+                                 std::string MaxTable,
+                                 std::vector<double> &MinData,
+                                 std::vector<double> &MaxData,
+                                 int &NumInteractionParameters)
+{
+    int m;
+    int NumRecords;
+    double valMin;
+    double valMax;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
+    std::string queryStr;
+    QString msg;
+    std::vector<double> MinRow;
+    std::vector<double> MaxRow;
+
+    NumInteractionParameters = 0;
+
+    fields      = {"SystemName","SpeName","Value"};
+    queryStr    = "SELECT SystemName,SpeName,Value FROM " + MinTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMin["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds) {
+        msg = "[Error 1] LoadInteraction1d: Incorrect number of records found in table: " + QString::fromStdString(MinTable) + ". Found " +
+                QString::number(NumRecords) + " expecting " + QString::number(NumSpeciesOrGuilds) + ".";
+        m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
+        setErrorMessage(msg.toStdString() + "\n\nCheck min/max values in " + InteractionType + " Parameters tab.");
+        return false;
+    }
+    queryStr    = "SELECT SystemName,SpeName,Value FROM " + MaxTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMax["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds) {
+        m_Logger->logMsg(nmfConstants::Error,
+                       "[Error 2] LoadInteraction1d: Incorrect number of records found in table: " + MaxTable + ". Found " +
+                       std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds) + ".");
+        return false;
+    }
+    m = 0;
+    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
+        valMin = std::stod(dataMapMin["Value"][m]);
+        valMax = std::stod(dataMapMax["Value"][m]);
+        ++NumInteractionParameters;
+        MinData.push_back(valMin);
+        MaxData.push_back(valMax);
+        ++m;
+    }
+    return true;
+}
+
+bool
+nmfSystemLoader::loadInteraction(int &NumSpeciesOrGuilds,
+                                 std::string InteractionType,
+                                 std::string MinTable,
+                                 std::string MaxTable,
+                                 std::vector<std::vector<double> > &MinData,
+                                 std::vector<std::vector<double> > &MaxData,
+                                 int &NumInteractionParameters)
+{
+    int m;
+    int NumRecords;
+    double valMin;
+    double valMax;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
+    std::string queryStr;
+    QString msg;
+    std::vector<double> MinRow;
+    std::vector<double> MaxRow;
+
+    NumInteractionParameters = 0;
+
+    fields      = {"SystemName","SpeciesA","SpeciesB","Value"};
+    queryStr    = "SELECT SystemName,SpeciesA,SpeciesB,Value FROM " + MinTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMin["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
+        if (NumRecords == 0) {
+            setErrorMessage("Missing data. Please populate table: " + MinTable);
+        } else {
+            msg = "[Error 1] LoadInteraction2d: Incorrect number of records found in table: " +
+                    QString::fromStdString(MinTable) + ". Found " +
+                    QString::number(NumRecords) + " expecting " +
+                    QString::number(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".";
+            m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
+            m_Logger->logMsg(nmfConstants::Error, queryStr);
+            setErrorMessage(msg.toStdString() + "\n\nCheck min/max values in " +
+                            InteractionType + " Parameters tab.");
+        }
+        return false;
+    }
+    queryStr    = "SELECT SystemName,SpeciesA,SpeciesB,Value FROM " + MaxTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMax["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
+        m_Logger->logMsg(nmfConstants::Error,
+                       "[Error 2] LoadInteraction2d: Incorrect number of records found in table: " +
+                       MaxTable + ". Found " + std::to_string(NumRecords) + " expecting " +
+                       std::to_string(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".");
+        return false;
+    }
+    m = 0;
+    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
+        MinRow.clear();
+        MaxRow.clear();
+        for (int col=0; col<NumSpeciesOrGuilds; ++col) {
+            valMin = std::stod(dataMapMin["Value"][m]);
+            valMax = std::stod(dataMapMax["Value"][m]);
+            MinRow.push_back(valMin);
+            MaxRow.push_back(valMax);
+            ++NumInteractionParameters;
+            ++m;
+        }
+        MinData.push_back(MinRow);
+        MaxData.push_back(MaxRow);
+    }
+    return true;
+}
+
+bool
+nmfSystemLoader::loadInteractionGuilds(int &NumSpecies,
+                                       int &NumGuilds,
+                                       std::string InteractionType,
+                                       std::map<std::string,std::string> &GuildSpeciesMap,
+                                       std::string MinTable,
+                                       std::string MaxTable,
+                                       std::vector<std::vector<double> > &MinData,
+                                       std::vector<std::vector<double> > &MaxData,
+                                       int &NumInteractionParameters)
+{
+    int m;
+    int NumRecords;
+    double valMin;
+    double valMax;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMapMin,dataMapMax;
+    std::string queryStr;
+    QString msg;
+    std::vector<double> MinRow;
+    std::vector<double> MaxRow;
+    int NumSpeciesOrGuilds = (InteractionType == "Competition-AGGPROD") ? NumGuilds : NumSpecies;
+
+    NumInteractionParameters = 0;
+
+    fields      = {"SystemName","SpeName","Guild","Value"};
+    queryStr    = "SELECT SystemName,SpeName,Guild,Value FROM " + MinTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMin  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMin["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
+        msg = "[Error 1] LoadInteractionGuilds: Incorrect number of records found in table: " +
+                QString::fromStdString(MinTable) + ". Found " +
+                QString::number(NumRecords) + " expecting " +
+                QString::number(NumSpeciesOrGuilds*NumGuilds) + ".";
+        m_Logger->logMsg(nmfConstants::Error, msg.toStdString());
+        setErrorMessage(msg.toStdString() + "\n\nCheck min/max values in " +
+                        InteractionType + " Parameters tab.");
+        return false;
+    }
+
+    queryStr    = "SELECT SystemName,SpeName,Guild,Value FROM " + MaxTable;
+    queryStr   += " WHERE SystemName = '" + m_SystemName + "'";
+    dataMapMax  = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords  = dataMapMax["Value"].size();
+    if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
+        m_Logger->logMsg(nmfConstants::Error,
+                       "[Error 2] LoadInteractionGuilds: Incorrect number of records found in table: " +
+                       MaxTable + ". Found " + std::to_string(NumRecords) + " expecting " +
+                       std::to_string(NumSpeciesOrGuilds*NumGuilds) + ".");
+        return false;
+    }
+
+    m = 0;
+    for (int row=0; row<NumSpeciesOrGuilds; ++row) {
+        MinRow.clear();
+        MaxRow.clear();
+        for (int col=0; col<NumGuilds; ++col) {
+            valMin = std::stod(dataMapMin["Value"][m]);
+            valMax = std::stod(dataMapMax["Value"][m]);
+            MinRow.push_back(valMin);
+            MaxRow.push_back(valMax);
+            ++NumInteractionParameters;
+            ++m;
+        }
+        MinData.push_back(MinRow);
+        MaxData.push_back(MaxRow);
+    }
+    return true;
+}
+
+bool
+nmfSystemLoader::loadForecastSettings(const std::string&   ForecastName,
+                                      nmfForecastSettings& Settings)
+{
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+
+    fields    = {"ForecastName","Algorithm","Minimizer","ObjectiveCriterion","Scaling",
+                 "GrowthForm","HarvestForm","WithinGuildCompetitionForm","PredationForm",
+                 "RunLength","StartYear","EndYear","NumRuns","IsDeterministic","Seed"};
+    queryStr  = "SELECT ForecastName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,";
+    queryStr += "GrowthForm,HarvestForm,WithinGuildCompetitionForm,PredationForm,";
+    queryStr += "RunLength,StartYear,EndYear,NumRuns,IsDeterministic,Seed FROM Forecasts where ";
+    queryStr += "ForecastName = '" + ForecastName + "'";
+    dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    if (dataMap["ForecastName"].size() == 0) {
+        m_Logger->logMsg(nmfConstants::Error,"[Error 1] loadForecastSettings: No Forecast found named: " + ForecastName);
+        setErrorMessage("No Forecast found named: " + ForecastName);
+        return false;
+    }
+    Settings.Algorithm          = dataMap["Algorithm"][0];
+    Settings.Minimizer          = dataMap["Minimizer"][0];
+    Settings.ObjectiveCriterion = dataMap["ObjectiveCriterion"][0];
+    Settings.Scaling            = dataMap["Scaling"][0];
+    Settings.GrowthForm         = dataMap["GrowthForm"][0];
+    Settings.HarvestForm        = dataMap["HarvestForm"][0];
+    Settings.CompetitionForm    = dataMap["WithinGuildCompetitionForm"][0];
+    Settings.PredationForm      = dataMap["PredationForm"][0];
+    Settings.RunLength          = std::stoi(dataMap["RunLength"][0]);
+    Settings.StartYear          = std::stoi(dataMap["StartYear"][0]);
+    Settings.EndYear            = std::stoi(dataMap["EndYear"][0]);
+    Settings.NumRuns            = std::stoi(dataMap["NumRuns"][0]);
+    Settings.Seed               = (std::stoi(dataMap["IsDeterministic"][0]) == 1) ?
+                                   std::stoi(dataMap["Seed"][0]) : -1;
+
+    return true;
+}
+
+bool
+nmfSystemLoader::loadEstimatedParameters(const std::string&       Algorithm,
+                                         const std::string&       Minimizer,
+                                         const std::string&       ObjectiveCriterion,
+                                         const std::string&       Scaling,
+                                         const std::string&       isAggProdStr,
+                                         const std::string&       HarvestForm,
+                                         const std::string&       CompetitionForm,
+                                         const std::string&       PredationForm,
+                                         const std::string&       GrowthRateTable,
+                                         const std::string&       CarryingCapacityTable,
+                                         const std::string&       CatchabilityTable,
+                                         QStringList&             SpeciesList,
+                                         nmfProjectionParameters& Parameters)
+{
+    bool   isCatchability = (HarvestForm     == "Effort (qE)");
+    bool   isAggProd      = (CompetitionForm == "AGG-PROD");
+    bool   isAlpha        = (CompetitionForm == "NO_K");
+    bool   isBetaSpecies  = (CompetitionForm == "MS-PROD");
+    bool   isBetaGuilds   = (CompetitionForm == "AGG-PROD") || (CompetitionForm == "MS-PROD");
+    bool   isPredation    = (PredationForm   == "Type I")   || (PredationForm   == "Type II") ||
+                            (PredationForm   == "Type III");
+    bool   isHandling     = (PredationForm   == "Type II")  || (PredationForm   == "Type III");
+    bool   isExponent     = (PredationForm   == "Type III");
+    int    m;
+    int    NumSpeciesOrGuilds;
+    int    NumGuilds;
+    int    NumRecords;
+    std::string errorMsg;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    QStringList GuildList;
+    std::vector<double> EstGrowthRates;
+    std::vector<double> EstCarryingCapacities;
+    std::vector<double> EstExponent;
+    std::vector<double> EstCatchabilityRates;
+    boost::numeric::ublas::matrix<double> EstCompetitionAlpha;
+    boost::numeric::ublas::matrix<double> EstCompetitionBetaSpecies;
+    boost::numeric::ublas::matrix<double> EstCompetitionBetaGuilds;
+    boost::numeric::ublas::matrix<double> EstPredation;
+    boost::numeric::ublas::matrix<double> EstHandling;
+    std::vector<std::string> TableNames;
+
+    EstGrowthRates.clear();
+    EstCarryingCapacities.clear();
+    EstExponent.clear();
+    EstCatchabilityRates.clear();
+    SpeciesList.clear();
+    GuildList.clear();
+
+    // Find Guilds and Species
+    if (! getGuilds(NumGuilds,GuildList)) {
+        return false;
+    }
+    if (isAggProd) {
+        SpeciesList        = GuildList;
+        NumSpeciesOrGuilds = NumGuilds;
+    } else {
+        if (! getSpecies(NumSpeciesOrGuilds,SpeciesList)) {
+            return false;
+        }
+    }
+
+    // Load appropriate r and K (for given Algorithm, Minimizer, and Objective Criterion)
+    TableNames.clear();
+    TableNames.push_back(GrowthRateTable);
+    TableNames.push_back(CarryingCapacityTable);
+    if (isCatchability)
+        TableNames.push_back(CatchabilityTable);
+    if (isExponent)
+        TableNames.push_back("OutputExponent");
+    for (unsigned j=0; j<TableNames.size(); ++j) {
+        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Value"};
+        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Value FROM " + TableNames[j];
+        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
+                    "' AND Algorithm = '" + Algorithm +
+                    "' AND Minimizer = '" + Minimizer +
+                    "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
+                    "' AND Scaling = '" + Scaling +
+                    "' AND isAggProd = " + isAggProdStr +
+                    " ORDER BY SpeName";
+        dataMap   = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumRecords = dataMap["SpeName"].size();
+        if (NumRecords != NumSpeciesOrGuilds) {
+            errorMsg  = "Run failed. Incorrect number of records found in " + TableNames[j] + ". ";
+            errorMsg += "Found " + std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds) + ".";
+            m_Logger->logMsg(nmfConstants::Error, "[Error 4] " + errorMsg);
+            m_Logger->logMsg(nmfConstants::Error, queryStr);
+            setErrorMessage(errorMsg);
+            return false;
+        }
+        if (TableNames[j] == GrowthRateTable) {
+            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+                EstGrowthRates.push_back(std::stod(dataMap["Value"][i]));
+            }
+        } else if (TableNames[j] == CarryingCapacityTable) {
+            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+                EstCarryingCapacities.push_back(std::stod(dataMap["Value"][i]));
+            }
+        } else if (TableNames[j] == CatchabilityTable) {
+            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+                EstCatchabilityRates.push_back(std::stod(dataMap["Value"][i]));
+            }
+        } else if (TableNames[j] == "OutputExponent") {
+            for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+                EstExponent.push_back(std::stod(dataMap["Value"][i]));
+            }
+        }
+    }
+
+    // Load data from OutputCompetitionAlpha, OutputCompetitionBetaSpecies,
+    // OutputPredation, and OutputHandling
+    TableNames.clear();
+    if (isAlpha)
+        TableNames.push_back("OutputCompetitionAlpha");
+    if (isBetaSpecies)
+        TableNames.push_back("OutputCompetitionBetaSpecies");
+    if (isPredation)
+        TableNames.push_back("OutputPredation");
+    if (isHandling)
+        TableNames.push_back("OutputHandling");
+    nmfUtils::initialize(EstCompetitionAlpha,      NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(EstCompetitionBetaSpecies,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(EstPredation,             NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    nmfUtils::initialize(EstHandling,              NumSpeciesOrGuilds,NumSpeciesOrGuilds);
+    for (unsigned i=0; i<TableNames.size(); ++i) {
+        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeciesA","SpeciesB","Value"};
+        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeciesA,SpeciesB,Value FROM " + TableNames[i];
+        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
+                "' AND Algorithm = '" + Algorithm +
+                "' AND Minimizer = '" + Minimizer +
+                "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
+                "' AND Scaling = '" + Scaling +
+                "' AND isAggProd = " + isAggProdStr +
+                "  ORDER BY SpeciesA,SpeciesB";
+        dataMap = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumRecords = dataMap["SpeciesA"].size();
+        if (NumRecords != NumSpeciesOrGuilds*NumSpeciesOrGuilds) {
+            m_Logger->logMsg(nmfConstants::Error,
+                           "[Error 5] LoadEstimatedParameters: Incorrect number of records found in " + TableNames[i] + ". Found " +
+                           std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds*NumSpeciesOrGuilds) + ".");
+            m_Logger->logMsg(nmfConstants::Error, queryStr);
+            return false;
+        }
+        // In row major order
+        m = 0;
+        for (int row=0; row<NumSpeciesOrGuilds; ++row) {
+            for (int col=0; col<NumSpeciesOrGuilds; ++col) {
+                if (TableNames[i] == "OutputCompetitionAlpha") {
+                    EstCompetitionAlpha(row,col) = std::stod(dataMap["Value"][m]);
+                } else if (TableNames[i] == "OutputCompetitionBetaSpecies") {
+                    EstCompetitionBetaSpecies(row,col) = std::stod(dataMap["Value"][m]);
+                } else if (TableNames[i] == "OutputPredation") {
+                    EstPredation(row,col) = std::stod(dataMap["Value"][m]);
+                } else if (TableNames[i] == "OutputHandling") {
+                    EstHandling(row,col) = std::stod(dataMap["Value"][m]);
+                }
+                ++m;
+            }
+        }
+    }
+
+    TableNames.clear();
+    if (isBetaGuilds)
+        TableNames.push_back("OutputCompetitionBetaGuilds");
+    nmfUtils::initialize(EstCompetitionBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
+    for (unsigned i=0; i<TableNames.size(); ++i) {
+        fields    = {"MohnsRhoLabel","Algorithm","Minimizer","ObjectiveCriterion","Scaling","isAggProd","SpeName","Guild","Value"};
+        queryStr  = "SELECT MohnsRhoLabel,Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProd,SpeName,Guild,Value FROM " + TableNames[i];
+        queryStr += " WHERE MohnsRhoLabel = '" + m_MohnsRhoLabel +
+                    "' AND Algorithm = '" + Algorithm +
+                    "' AND Minimizer = '" + Minimizer +
+                    "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
+                    "' AND Scaling = '" + Scaling +
+                    "' AND isAggProd = " + isAggProdStr +
+                    " ORDER BY SpeName,Guild";
+        dataMap = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+        NumRecords = dataMap["SpeName"].size();
+        if (NumRecords != NumSpeciesOrGuilds*NumGuilds) {
+            m_Logger->logMsg(nmfConstants::Error,
+                           "[Error 6] LoadEstimatedParameters: Incorrect number of records found in " + TableNames[i] + ". Found " +
+                           std::to_string(NumRecords) + " expecting " + std::to_string(NumSpeciesOrGuilds*NumGuilds) + ".");
+            m_Logger->logMsg(nmfConstants::Error, queryStr);
+            return false;
+        }
+        // In row major order
+        m = 0;
+        for (int row=0; row<NumSpeciesOrGuilds; ++row) {
+            for (int col=0; col<NumGuilds; ++col) {
+                if (TableNames[i] == "OutputCompetitionBetaGuilds") {
+                    EstCompetitionBetaGuilds(row,col) = std::stod(dataMap["Value"][m]);
+                }
+                ++m;
+            }
+        }
+    }
+
+    Parameters.GrowthRate             = EstGrowthRates;
+    Parameters.CarryingCapacity       = EstCarryingCapacities;
+    Parameters.Catchability           = EstCatchabilityRates;
+    Parameters.Exponent               = EstExponent;
+    Parameters.CompetitionAlpha       = EstCompetitionAlpha;
+    Parameters.CompetitionBetaSpecies = EstCompetitionBetaSpecies;
+    Parameters.CompetitionBetaGuilds  = EstCompetitionBetaGuilds;
+    Parameters.Predation              = EstPredation;
+    Parameters.Handling               = EstHandling;
+
+    return true;
+}
+
+bool
+nmfSystemLoader::loadProjectionInputs(const std::string& ForecastName,
+                                      const int&         RunLength,
+                                      const std::string& Algorithm,
+                                      const std::string& Minimizer,
+                                      const std::string& ObjectiveCriterion,
+                                      const std::string& Scaling,
+                                      const std::string& isAggProdStr,
+                                      const std::string& GrowthForm,
+                                      const std::string& HarvestForm,
+                                      const std::string& CompetitionForm,
+                                      const std::string& PredationForm,
+                                      const std::string& GrowthRateTable,
+                                      const std::string& CarryingCapacityTable,
+                                      const std::string& CatchabilityTable,
+                                      QStringList&       SpeciesList,
+                                      nmfProjectionInputs& Inputs)
+{
+    bool   isAggProd = (CompetitionForm == "AGG-PROD");
+    int    NumSpeciesOrGuilds;
+    int    NumGuilds;
+    QStringList GuildList;
+    QList<double> InitialBiomass;
+
+    Inputs.Project = nmfProjectionKernel::select(GrowthForm,HarvestForm,CompetitionForm,PredationForm,true);
+    if (Inputs.Project == nullptr) {
+        m_Logger->logMsg(nmfConstants::Error,
+                         "[Error 7] LoadProjectionInputs: Unknown model form combination: " +
+                         GrowthForm + ", " + HarvestForm + ", " + CompetitionForm + ", " + PredationForm);
+        return false;
+    }
+
+    if (! loadEstimatedParameters(Algorithm,Minimizer,ObjectiveCriterion,Scaling,isAggProdStr,
+                                  HarvestForm,CompetitionForm,PredationForm,
+                                  GrowthRateTable,CarryingCapacityTable,CatchabilityTable,
+                                  SpeciesList,Inputs.Parameters)) {
+        return false;
+    }
+    NumSpeciesOrGuilds = SpeciesList.size();
+    if (! getGuilds(NumGuilds,GuildList)) {
+        return false;
+    }
+
+    if (HarvestForm == "Catch") {
+        if (isAggProd) {
+            if (! getTimeSeriesDataByGuild(ForecastName,"Catch", NumSpeciesOrGuilds,RunLength,Inputs.Catch)) {
+                setErrorMessage("No data found in ForecastCatch table for current Forecast.\nCheck Forecast->Harvest Parameters tab.");
+                return false;
+            }
+        } else {
+            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Catch", NumSpeciesOrGuilds,RunLength,Inputs.Catch)) {
+                setErrorMessage("No data found in ForecastCatch table for current Forecast.\nCheck Forecast->Harvest Parameters tab.");
+                return false;
+            }
+        }
+    } else if (HarvestForm == "Effort (qE)") {
+        if (isAggProd) {
+            if (! getTimeSeriesDataByGuild(ForecastName,"Effort",NumSpeciesOrGuilds,RunLength,Inputs.Effort))
+                return false;
+        } else {
+            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Effort",NumSpeciesOrGuilds,RunLength,Inputs.Effort))
+                return false;
+        }
+    } else if (HarvestForm == "Exploitation (F)") {
+        if (isAggProd) {
+            if (! getTimeSeriesDataByGuild(ForecastName,"Exploitation",NumSpeciesOrGuilds,RunLength,Inputs.Exploitation))
+                return false;
+        } else {
+            if (! getTimeSeriesData(m_MohnsRhoLabel,ForecastName,"Exploitation",NumSpeciesOrGuilds,RunLength,Inputs.Exploitation))
+                return false;
+        }
+    }
+
+    // If not running a forecast initial biomass is the first observed biomass.
+    // else if running a forecast initial biomass is the last observed biomass.
+    if (ForecastName == "") {
+        if (! getInitialObservedBiomass(InitialBiomass))
+            return false;
+    } else {
+        if (! getFinalObservedBiomass(InitialBiomass)) {
+            std::cout << "Error: getFinalObservedBiomass" << std::endl;
+            return false;
+        }
+    }
+
+    Inputs.InitialBiomass.assign(InitialBiomass.begin(),InitialBiomass.end());
+
+    // Get guild map
+    std::map<int,std::vector<int> > GuildSpecies;
+    std::vector<int>                GuildNum;
+    boost::numeric::ublas::matrix<double> ObservedBiomassByGuilds;
+    getGuildData(NumGuilds,RunLength,GuildList,GuildSpecies,GuildNum,ObservedBiomassByGuilds);
+
+    nmfProjectionKernel::initializeSystem(RunLength+1,NumSpeciesOrGuilds,NumGuilds,isAggProd,
+                                          GuildSpecies,Inputs.Catch,Inputs.Effort,Inputs.Exploitation,
+                                          Inputs.System);
+    // Only the non-zero interactions are projected (the forecast perturbations keep zeros at zero)
+    nmfProjectionKernel::initializeInteractions(Inputs.Parameters,Inputs.System);
+
+    return true;
+}
+
+bool
+nmfSystemLoader::loadUncertaintyData(const int&              NumSpeciesOrGuilds,
+                                     const std::string&      ForecastName,
+                                     const std::string&      Algorithm,
+                                     const std::string&      Minimizer,
+                                     const std::string&      ObjectiveCriterion,
+                                     const std::string&      Scaling,
+                                     nmfForecastUncertainty& Uncertainty)
+{
+    int NumRecords;
+    std::vector<std::string> fields;
+    std::map<std::string, std::vector<std::string> > dataMap;
+    std::string queryStr;
+    std::string msg;
+
+    Uncertainty = nmfForecastUncertainty();
+
+    fields     = {"ForecastName","SpeName","Algorithm","Minimizer","ObjectiveCriterion","Scaling",
+                  "GrowthRate","CarryingCapacity","Predation","Competition",
+                  "BetaSpecies","BetaGuilds","Handling","Exponent","Catchability","Harvest"};
+    queryStr   = "SELECT ForecastName,SpeName,Algorithm,Minimizer,ObjectiveCriterion,Scaling,";
+    queryStr  += "GrowthRate,CarryingCapacity,Predation,Competition,BetaSpecies,";
+    queryStr  += "BetaGuilds,Handling,Exponent,Catchability,Harvest FROM ForecastUncertainty ";
+    queryStr  += " WHERE ForecastName = '" + ForecastName +
+                "' AND Algorithm = '" + Algorithm +
+                "' AND Minimizer = '" + Minimizer +
+                "' AND ObjectiveCriterion = '" + ObjectiveCriterion +
+                "' AND Scaling = '" + Scaling +
+                "' ORDER BY SpeName";
+    dataMap    = m_DatabasePtr->nmfQueryDatabase(queryStr, fields);
+    NumRecords = dataMap["SpeName"].size();
+    if (NumRecords != NumSpeciesOrGuilds) {
+        msg  = "[Error 1] loadUncertaintyData: Incorrect number of records found in table: ForecastUncertainty. ";
+        msg += "Found " + std::to_string(NumRecords) + " records expecting " + std::to_string(NumSpeciesOrGuilds)+".";
+        m_Logger->logMsg(nmfConstants::Error,msg);
+        setErrorMessage("Missing Forecast data. Please check tabs:\nForecast->Harvest Parameters and Forecast->Uncertainty Parameters\nand re-save.");
+        return false;
+    }
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        Uncertainty.GrowthRate.emplace_back(std::stod(dataMap["GrowthRate"][i]));
+        Uncertainty.CarryingCapacity.emplace_back(std::stod(dataMap["CarryingCapacity"][i]));
+        Uncertainty.Predation.emplace_back(std::stod(dataMap["Predation"][i]));
+        Uncertainty.Competition.emplace_back(std::stod(dataMap["Competition"][i]));
+        Uncertainty.BetaSpecies.emplace_back(std::stod(dataMap["BetaSpecies"][i]));
+        Uncertainty.BetaGuilds.emplace_back(std::stod(dataMap["BetaGuilds"][i]));
+        Uncertainty.Handling.emplace_back(std::stod(dataMap["Handling"][i]));
+        Uncertainty.Exponent.emplace_back(std::stod(dataMap["Exponent"][i]));
+        Uncertainty.Catchability.emplace_back(std::stod(dataMap["Catchability"][i]));
+        Uncertainty.Harvest.emplace_back(std::stod(dataMap["Harvest"][i]));
+    }
+
+    return true;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file nmfSystemLoader.h
+ * @brief Definition of the loader that reads a System's model inputs from the database
+ *
+ * This file contains the definition of the System loader. The loader reads everything
+ * an estimation or a forecast needs (model forms, parameter ranges, interaction ranges,
+ * time series and previously estimated parameters) without any GUI, so that it can be
+ * shared by the main window and the command line runner.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfTracedDatabase.h"
+#include "nmfLogger.h"
+#include "nmfUtils.h"
+#include "nmfForecastEngine.h"
+
+#include <QList>
+#include <QStringList>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The settings of a saved Forecast (a row of the Forecasts table)
+ */
+struct nmfForecastSettings {
+    std::string Algorithm;
+    std::string Minimizer;
+    std::string ObjectiveCriterion;
+    std::string Scaling;
+    std::string GrowthForm;
+    std::string HarvestForm;
+    std::string CompetitionForm;
+    std::string PredationForm;
+    int         RunLength = 0;
+    int         StartYear = 0;
+    int         EndYear   = 0;
+    int         NumRuns   = 0;
+    int         Seed      = -1; // -1 if the forecast isn't deterministic
+};
+
+/**
+ * @brief Loads the model inputs of a System from the database
+ *
+ * None of the methods show any dialogs. Problems are logged and, where the user
+ * needs to fix something, a message describing what to fix is kept and can be
+ * read with getErrorMessage() (the GUI shows it, the command line runner prints it).
+ */
+class nmfSystemLoader
+{
+private:
+    nmfTracedDatabase* m_DatabasePtr;
+    nmfLogger*         m_Logger;
+    std::string        m_SystemName;
+    std::string        m_MohnsRhoLabel;
+    std::string        m_ErrorMsg;
+    std::string        m_GrowthForm;
+    std::string        m_HarvestForm;
+    std::string        m_CompetitionForm;
+    std::string        m_PredationForm;
+
+    bool loadInteraction(int&                 NumSpeciesOrGuilds,
+                         std::string          InteractionType,
+                         std::string          MinTable,
+                         std::string          MaxTable,
+                         std::vector<double>& MinData,
+                         std::vector<double>& MaxData,
+                         int&                 NumInteractionParameters);
+    bool loadInteraction(int&                               NumSpeciesOrGuilds,
+                         std::string                        InteractionType,
+                         std::string                        MinTable,
+                         std::string                        MaxTable,
+                         std::vector<std::vector<double> >& MinData,
+                         std::vector<std::vector<double> >& MaxData,
+                         int&                               NumInteractionParameters);
+    bool loadInteractionGuilds(int&                                NumSpecies,
+                               int&                                NumGuilds,
+                               std::string                         InteractionType,
+                               std::map<std::string,std::string>&  GuildSpeciesMap,
+                               std::string                         MinTable,
+                               std::string                         MaxTable,
+                               std::vector<std::vector<double> >&  MinData,
+                               std::vector<std::vector<double> >&  MaxData,
+                               int&                                NumInteractionParameters);
+    void setErrorMessage(const std::string& msg);
+
+public:
+    /**
+     * @brief nmfSystemLoader : class constructor
+     * @param databasePtr : pointer to the (connected) database
+     * @param logger : pointer to the application logger
+     * @param systemName : name of the System (i.e., the project settings configuration)
+     */
+    nmfSystemLoader(nmfTracedDatabase* databasePtr,
+                    nmfLogger*         logger,
+                    const std::string& systemName);
+   ~nmfSystemLoader() {}
+
+    /**
+     * @brief Gets the message describing what the user needs to fix after a failed load
+     * @return Returns the message (empty if there's nothing for the user to fix)
+     */
+    std::string getErrorMessage();
+    /**
+     * @brief Sets the Mohn's Rho label used to select the estimated parameters and the
+     * observed biomass and harvest time series of a Mohn's Rho peel
+     * @param mohnsRhoLabel : the Mohn's Rho label (empty for the full range)
+     */
+    void setMohnsRhoLabel(const std::string& mohnsRhoLabel);
+    /**
+     * @brief Sets model forms that loadParameters uses instead of the System's forms
+     * @param growthForm : name of growth form (empty for the System's growth form)
+     * @param harvestForm : name of harvest form (empty for the System's harvest form)
+     * @param competitionForm : name of competition form (empty for the System's competition form)
+     * @param predationForm : name of predation form (empty for the System's predation form)
+     */
+    void setModelForms(const std::string& growthForm,
+                       const std::string& harvestForm,
+                       const std::string& competitionForm,
+                       const std::string& predationForm);
+    /**
+     * @brief Gets the names of the Guilds
+     * @param NumGuilds : number of guilds found
+     * @param GuildList : names of the guilds found
+     * @return Returns false if no guilds were found
+     */
+    bool getGuilds(int& NumGuilds, QStringList& GuildList);
+    /**
+     * @brief Gets the names of the Species
+     * @param NumSpecies : number of species found
+     * @param SpeciesList : names of the species found
+     * @return Returns false if no species were found
+     */
+    bool getSpecies(int& NumSpecies, QStringList& SpeciesList);
+    /**
+     * @brief Gets the first year of the System's time series
+     * @param StartYear : the first year
+     * @return Returns false if the System wasn't found
+     */
+    bool getStartYear(int& StartYear);
+    /**
+     * @brief Gets the initial biomass of each species
+     * @param InitBiomass : the initial biomass values
+     * @return Returns false if no species were found
+     */
+    bool getInitialObservedBiomass(QList<double>& InitBiomass);
+    /**
+     * @brief Gets the last year's observed biomass of each species
+     * @param FinalBiomass : the final observed biomass values
+     * @return Returns false if the System or its observed biomass wasn't found
+     */
+    bool getFinalObservedBiomass(QList<double>& FinalBiomass);
+    /**
+     * @brief Gets the guild membership of the species and the initial guild biomass
+     * @param NumGuilds : number of guilds
+     * @param RunLength : number of years in the run
+     * @param GuildList : names of the guilds
+     * @param GuildSpecies : the species indices for each guild index
+     * @param GuildNum : the guild index for each species
+     * @param ObservedBiomassByGuilds : observed biomass by guild (only the first year is set)
+     * @return Returns true
+     */
+    bool getGuildData(const int&                             NumGuilds,
+                      const int&                             RunLength,
+                      const QStringList&                     GuildList,
+                      std::map<int,std::vector<int> >&       GuildSpecies,
+                      std::vector<int>&                      GuildNum,
+                      boost::numeric::ublas::matrix<double>& ObservedBiomassByGuilds);
+    /**
+     * @brief Gets the map of species name to guild name
+     * @param SpeciesGuildMap : the map to fill in
+     */
+    void getSpeciesGuildMap(std::map<std::string,std::string>& SpeciesGuildMap);
+    /**
+     * @brief Reads a species time series table
+     * @param MohnsRhoLabel : the Mohn's Rho label of the time series (empty for the full range)
+     * @param ForecastName : name of the forecast (empty if not reading a Forecast table)
+     * @param TableName : name of the time series table (without the Forecast prefix)
+     * @param NumSpecies : number of species
+     * @param RunLength : number of years in the run
+     * @param TableData : the time series ((RunLength+1) x NumSpecies)
+     * @return Returns false if the table is missing data
+     */
+    bool getTimeSeriesData(const std::string                      MohnsRhoLabel,
+                           const std::string                      ForecastName,
+                           const std::string&                     TableName,
+                           const int&                             NumSpecies,
+                           const int&                             RunLength,
+                           boost::numeric::ublas::matrix<double>& TableData);
+    /**
+     * @brief Reads a species time series table and sums it by guild
+     * @param ForecastName : name of the forecast (empty if not reading a Forecast table)
+     * @param TableName : name of the time series table (without the Forecast prefix)
+     * @param NumGuilds : number of guilds
+     * @param RunLength : number of years in the run
+     * @param TableData : the time series ((RunLength+1) x NumGuilds)
+     * @return Returns false if the table has no data
+     */
+    bool getTimeSeriesDataByGuild(std::string                            ForecastName,
+                                  const std::string&                     TableName,
+                                  const int&                             NumGuilds,
+                                  const int&                             RunLength,
+                                  boost::numeric::ublas::matrix<double>& TableData);
+    /**
+     * @brief Loads the data structure that the estimation algorithms run on
+     * @param dataStruct : the data structure to load
+     * @param verbose : if true, each table read is logged
+     * @return Returns false if any of the required data are missing
+     */
+    bool loadParameters(Data_Struct& dataStruct,
+                        const bool&  verbose);
+    /**
+     * @brief Loads the settings of a saved Forecast
+     * @param ForecastName : name of the forecast
+     * @param Settings : the forecast's settings
+     * @return Returns false if the forecast wasn't found
+     */
+    bool loadForecastSettings(const std::string&   ForecastName,
+                              nmfForecastSettings& Settings);
+    /**
+     * @brief Loads the parameters saved by the last estimation with the passed settings
+     * @param Algorithm : name of estimation algorithm
+     * @param Minimizer : name of estimation minimizer
+     * @param ObjectiveCriterion : name of estimation objective criterion
+     * @param Scaling : name of estimation scaling algorithm
+     * @param isAggProdStr : "1" if running AGG-PROD, else "0"
+     * @param HarvestForm : name of harvest form
+     * @param CompetitionForm : name of competition form
+     * @param PredationForm : name of predation form
+     * @param GrowthRateTable : name of the estimated growth rate table
+     * @param CarryingCapacityTable : name of the estimated carrying capacity table
+     * @param CatchabilityTable : name of the estimated catchability table
+     * @param SpeciesList : names of the species (or guilds if running AGG-PROD)
+     * @param Parameters : the estimated parameters
+     * @return Returns false if any of the estimated parameters are missing
+     */
+    bool loadEstimatedParameters(const std::string&       Algorithm,
+                                 const std::string&       Minimizer,
+                                 const std::string&       ObjectiveCriterion,
+                                 const std::string&       Scaling,
+                                 const std::string&       isAggProdStr,
+                                 const std::string&       HarvestForm,
+                                 const std::string&       CompetitionForm,
+                                 const std::string&       PredationForm,
+                                 const std::string&       GrowthRateTable,
+                                 const std::string&       CarryingCapacityTable,
+                                 const std::string&       CatchabilityTable,
+                                 QStringList&             SpeciesList,
+                                 nmfProjectionParameters& Parameters);
+    /**
+     * @brief Loads the (unperturbed) inputs to project the estimated parameters
+     * @param ForecastName : name of the forecast (empty to project over the estimation years)
+     * @param RunLength : number of years in the run
+     * @param Algorithm : name of estimation algorithm
+     * @param Minimizer : name of estimation minimizer
+     * @param ObjectiveCriterion : name of estimation objective criterion
+     * @param Scaling : name of estimation scaling algorithm
+     * @param isAggProdStr : "1" if running AGG-PROD, else "0"
+     * @param GrowthForm : name of growth form
+     * @param HarvestForm : name of harvest form
+     * @param CompetitionForm : name of competition form
+     * @param PredationForm : name of predation form
+     * @param GrowthRateTable : name of the estimated growth rate table
+     * @param CarryingCapacityTable : name of the estimated carrying capacity table
+     * @param CatchabilityTable : name of the estimated catchability table
+     * @param SpeciesList : names of the species (or guilds if running AGG-PROD)
+     * @param Inputs : the projection inputs
+     * @return Returns false if any of the estimated parameters or time series are missing
+     */
+    bool loadProjectionInputs(const std::string&   ForecastName,
+                              const int&           RunLength,
+                              const std::string&   Algorithm,
+                              const std::string&   Minimizer,
+                              const std::string&   ObjectiveCriterion,
+                              const std::string&   Scaling,
+                              const std::string&   isAggProdStr,
+                              const std::string&   GrowthForm,
+                              const std::string&   HarvestForm,
+                              const std::string&   CompetitionForm,
+                              const std::string&   PredationForm,
+                              const std::string&   GrowthRateTable,
+                              const std::string&   CarryingCapacityTable,
+                              const std::string&   CatchabilityTable,
+                              QStringList&         SpeciesList,
+                              nmfProjectionInputs& Inputs);
+    /**
+     * @brief Loads a Forecast's Monte Carlo uncertainty factors
+     * @param NumSpeciesOrGuilds : number of species (or guilds if running AGG-PROD)
+     * @param ForecastName : name of the forecast
+     * @param Algorithm : name of estimation algorithm
+     * @param Minimizer : name of estimation minimizer
+     * @param ObjectiveCriterion : name of estimation objective criterion
+     * @param Scaling : name of estimation scaling algorithm
+     * @param Uncertainty : the uncertainty factors for each species (or guild)
+     * @return Returns false if the uncertainty factors are missing
+     */
+    bool loadUncertaintyData(const int&              NumSpeciesOrGuilds,
+                             const std::string&      ForecastName,
+                             const std::string&      Algorithm,
+                             const std::string&      Minimizer,
+                             const std::string&      ObjectiveCriterion,
+                             const std::string&      Scaling,
+                             nmfForecastUncertainty& Uncertainty);
+};
@@ -28,7 +28,7 @@
  * Please cite the author(s) in any work or product based on this material.
  */
 
-#include "nmfDatabase.h"
+#include "nmfTracedDatabase.h"
 #include "nmfLogger.h"
 #include "nmfUtils.h"
 
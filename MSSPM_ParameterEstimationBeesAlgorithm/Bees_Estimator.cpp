@@ -5,6 +5,12 @@
 
 Bees_Estimator::Bees_Estimator() {
 
+    m_RunCompleted  = false;
+    m_BestFitness   = 0;
+    m_IsResume      = false;
+    m_CachedFitness       = 0;
+    m_CachedFitnessStdDev = 0;
+    m_FitnessStdDev       = 0;
 }
 
 
@@ -27,9 +33,104 @@ Bees_Estimator::printBee(std::string          msg,
     std::cout << std::endl;
 }
 
+bool
+Bees_Estimator::getBestFitness(double &BestFitness)
+{
+    BestFitness = m_BestFitness;
+
+    return m_RunCompleted;
+}
+
+bool
+Bees_Estimator::getEstimatedParameters(std::vector<double>& EstParameters,
+                                       double&              FitnessStdDev)
+{
+    EstParameters = m_EstParameters;
+    FitnessStdDev = m_FitnessStdDev;
+
+    return m_RunCompleted;
+}
+
+void
+Bees_Estimator::setCachedResult(const std::vector<double>& Parameters,
+                                const double&              Fitness,
+                                const double&              FitnessStdDev)
+{
+    m_CachedParameters    = Parameters;
+    m_CachedFitness       = Fitness;
+    m_CachedFitnessStdDev = FitnessStdDev;
+}
+
+void
+Bees_Estimator::setCancellationToken(const nmfCancellationToken& CancelToken)
+{
+    m_CancelToken = CancelToken;
+}
+
+void
+Bees_Estimator::setInitialParameters(const std::vector<double>& InitialParameters)
+{
+    m_InitialParameters = InitialParameters;
+}
+
+void
+Bees_Estimator::setCheckpoint(const std::string& CheckpointFile,
+                              const bool&        Resume)
+{
+    m_CheckpointFile = CheckpointFile;
+    m_IsResume       = Resume;
+}
+
+void
+Bees_Estimator::callback_StopTheOptimizer()
+{
+    m_CancelToken.cancel();
+}
+
+void
+Bees_Estimator::runSubRun(Data_Struct&       beeStruct,
+                          int                RunNum,
+                          int                subRunNum,
+                          int                NumSubRuns,
+                          bool&              stopRequested,
+                          SubRunResult&      result)
+{
+    NMF_TRACE_SCOPE("estimation","Bees_Estimator::runSubRun");
+    std::string msg;
+
+    // Sub runs that haven't started yet are skipped once the user stops the run
+    if (stopRequested || m_CancelToken.isCancelled()) {
+        return;
+    }
+
+    std::unique_ptr<BeesAlgorithm> beesAlg =
+            std::make_unique<BeesAlgorithm>(beeStruct,nmfConstantsMSSPM::VerboseOn);
+    beesAlg->initializeParameterRangesAndPatchSizes();
+    result.ok = beesAlg->estimateParameters(
+                result.bestFitness,result.EstParameters,
+                RunNum,subRunNum,result.errorMsg);
+    if (! result.errorMsg.empty()) {
+        result.ok = false;
+        stopRequested = true;
+        return;
+    }
+    if (result.ok) {
+        msg = "Run " + std::to_string(subRunNum);
+        printBee(msg,result.bestFitness,result.EstParameters);
+        emit SubRunCompleted(RunNum,subRunNum,NumSubRuns);
+    }
+
+    // Break out if user has stopped the run
+    if (m_CancelToken.isCancelled()) {
+        std::cout << "Bees_Estimator StoppedByUser" << std::endl;
+        stopRequested = true;
+    }
+}
+
 void
 Bees_Estimator::estimateParameters(Data_Struct &beeStruct, int RunNum)
 {
+    NMF_TRACE_SCOPE("estimation","Bees_Estimator::estimateParameters");
     bool ok=false;
     bool isAggProd = (beeStruct.CompetitionForm == "AGG-PROD");
     int startPos = 0;
@@ -39,17 +140,20 @@ Bees_Estimator::estimateParameters(Data_Struct &beeStruct, int RunNum)
     int NumSubRuns = beeStruct.BeesNumRepetitions;
     int numTotalParameters;
     int numEstParameters; // The parameters that don't have their min range equal to their max range.
-    int usecDelay = 300000;
     double totStdDev;
-    double bestFitness;
+    double bestFitness = 0;
     double fitnessStdDev   = 0;
     double MeanFitness     = 0;
     double lastBestFitness = 99999;
-    std::string msg;
-    std::string errorMsg;
     std::string bestFitnessStr;
     std::vector<double> lastBestParameters;
+    bool stopRequested = false;
+    bool isCached = (int(m_CachedParameters.size()) == beeStruct.TotalNumberParameters);
 
+    m_RunCompleted  = false;
+    m_BestFitness   = 0;
+    m_FitnessStdDev = 0;
+    m_EstParameters.clear();
     m_InitialCarryingCapacities.clear();
     m_EstSystemCarryingCapacity = 0;
     m_EstGrowthRates.clear();
@@ -67,68 +171,114 @@ Bees_Estimator::estimateParameters(Data_Struct &beeStruct, int RunNum)
     nmfUtils::initialize(m_EstBetaSpecies,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
     nmfUtils::initialize(m_EstBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
     std::chrono::_V2::system_clock::time_point startTime = nmfUtils::startTimer();
-    std::chrono::_V2::system_clock::time_point startTimeSpecies;
     std::vector<double> EstParameters;
     std::vector<double> MeanEstParameters;
     std::vector<double> stdDevParameters;
-
-    startTimeSpecies = nmfUtils::startTimer();
-
-    std::unique_ptr<BeesAlgorithm> beesAlg;
-    std::unique_ptr<BeesStats>     beesStats;
+    std::vector<SubRunResult> subRunResults(NumSubRuns);
+    std::unique_ptr<nmfEstimationCheckpoint> checkpoint;
 
     for (int i=0; i<NumSpeciesOrGuilds; ++i) {
         m_InitialCarryingCapacities.push_back(beeStruct.CarryingCapacityInitial[i]);
     }
 
-    for (int subRunNum=1; subRunNum<=NumSubRuns; ++subRunNum)
-    {
-//std::cout << "subRunNum: " << subRunNum << std::endl;
-        // Initialize main class ptr
-        beesAlg   = std::make_unique<BeesAlgorithm>(beeStruct,nmfConstantsMSSPM::VerboseOn);
-        beesStats = std::make_unique<BeesStats>(
-                    beeStruct.TotalNumberParameters,NumSubRuns);
-        beesAlg->initializeParameterRangesAndPatchSizes();
-        errorMsg.clear();
-        ok = beesAlg->estimateParameters(
-                    bestFitness,EstParameters,
-                    RunNum,subRunNum,errorMsg);
-        if (! errorMsg.empty()) {
-            ok = false;
-            emit ErrorFound(errorMsg);
-            break;
-        }
-        if (ok) {
-            msg = "Run " + std::to_string(subRunNum);
-            printBee(msg,bestFitness,EstParameters);
-            beesStats->addData(bestFitness,EstParameters);
-            if (bestFitness < lastBestFitness) {
-                lastBestFitness = bestFitness;
-                lastBestParameters = EstParameters;
+    // The result of an identical estimation is reported as is, without re-estimating
+    if (isCached) {
+        std::cout << "Using the cached result of an identical estimation" << std::endl;
+        ok            = true;
+        bestFitness   = m_CachedFitness;
+        EstParameters = m_CachedParameters;
+        fitnessStdDev = m_CachedFitnessStdDev;
+    } else {
+        if (! m_CheckpointFile.empty()) {
+            checkpoint = std::make_unique<nmfEstimationCheckpoint>(
+                        m_CheckpointFile,
+                        nmfEstimationCheckpoint::key("Bees Algorithm",beeStruct,m_InitialParameters));
+            if (m_IsResume && checkpoint->load()) {
+                std::cout << "Resuming from checkpoint: " << checkpoint->getNumResults()
+                          << " of " << NumSubRuns << " sub run(s) already completed" << std::endl;
+            } else if (m_IsResume) {
+                std::cout << "No checkpoint found for this run, starting from the beginning" << std::endl;
             }
-            emit SubRunCompleted(RunNum,subRunNum,NumSubRuns);
+            checkpoint->start();
         }
-        // Added a delay to give Qt enough time to finish drawing this run's curve.
-//      usleep(300000);
-        std::this_thread::sleep_for(std::chrono::microseconds(usecDelay));
-
-        // Break out if user has stopped the run
-        if (wasStoppedByUser()) {
-            std::cout << "Bees_Estimator StoppedByUser" << std::endl;
-            ok = false;
-            break;
+
+        // The sub runs are run serially on the calling thread, as they always have been.
+        // BeesAlgorithm isn't known to be reentrant: every instance writes the same
+        // progress file and draws from its own random number generator, which can't be
+        // seeded per sub run from here.
+        for (int subRunNum=1; subRunNum<=NumSubRuns; ++subRunNum) {
+            // Sub runs already completed by a resumed run aren't rerun
+            nmfCheckpointResult completed;
+            if (checkpoint && checkpoint->getResult(subRunNum,completed)) {
+                SubRunResult& result = subRunResults[subRunNum-1];
+                result.ok            = true;
+                result.bestFitness   = completed.Fitness;
+                result.EstParameters = completed.Parameters;
+                continue;
+            }
+            SubRunResult& result = subRunResults[subRunNum-1];
+            runSubRun(beeStruct,RunNum,subRunNum,NumSubRuns,stopRequested,result);
+            if (checkpoint && result.ok && ! m_CancelToken.isCancelled()) {
+                nmfCheckpointResult checkpointResult;
+                checkpointResult.RunNum     = subRunNum;
+                checkpointResult.Fitness    = result.bestFitness;
+                checkpointResult.Parameters = result.EstParameters;
+                checkpoint->addResult(checkpointResult);
+            }
         }
 
+        // Merge the sub run results in sub run order, including those restored
+        // from the checkpoint
+        std::unique_ptr<BeesStats> beesStats = std::make_unique<BeesStats>(
+                    beeStruct.TotalNumberParameters,NumSubRuns);
+        ok = (NumSubRuns > 0);
+        for (SubRunResult& result : subRunResults) {
+            if (! result.errorMsg.empty()) {
+                ok = false;
+                emit ErrorFound(result.errorMsg);
+                break;
+            }
+            if (! result.ok) {
+                ok = false;
+                continue;
+            }
+            beesStats->addData(result.bestFitness,result.EstParameters);
+            if (result.bestFitness < lastBestFitness) {
+                lastBestFitness = result.bestFitness;
+                lastBestParameters = result.EstParameters;
+            }
+        }
+        if (ok) {
+            // Use the last best data and get some statistics
+            bestFitness   = lastBestFitness;
+            EstParameters = lastBestParameters;
+            beesStats->getMean(MeanFitness,MeanEstParameters);
+            beesStats->getStdDev(fitnessStdDev,totStdDev,stdDevParameters);
+        }
+    }
+    if (stopRequested || m_CancelToken.isCancelled()) {
+        ok = false;
     }
 
     if (ok) {
-        // Use the last best data and get some statistics
-        bestFitness   = lastBestFitness;
-        EstParameters = lastBestParameters;
-        beesStats->getMean(MeanFitness,MeanEstParameters);
-        beesStats->getStdDev(fitnessStdDev,totStdDev,stdDevParameters);
-
         // Extract the parameters and place them into their respective data structures.
+        std::unique_ptr<BeesAlgorithm> beesAlg =
+                std::make_unique<BeesAlgorithm>(beeStruct,nmfConstantsMSSPM::VerboseOff);
+        beesAlg->initializeParameterRangesAndPatchSizes();
+
+        // A warm start's previous estimate competes with the sub runs' best bee. It's
+        // not a sub run, so it's left out of the statistics. A cached result already
+        // went through this comparison.
+        if (! isCached && (int(m_InitialParameters.size()) == int(EstParameters.size()))) {
+            double initialFitness = beesAlg->evaluateObjectiveFunction(m_InitialParameters);
+            if (initialFitness < bestFitness) {
+                std::cout << "Warm start: keeping the previous estimate (fitness " <<
+                             initialFitness << " < " << bestFitness << ")" << std::endl;
+                bestFitness   = initialFitness;
+                EstParameters = m_InitialParameters;
+            }
+        }
+
         beesAlg->extractGrowthParameters(EstParameters,startPos,
                                          m_EstGrowthRates,
                                          m_EstCarryingCapacities,
@@ -146,9 +296,20 @@ Bees_Estimator::estimateParameters(Data_Struct &beeStruct, int RunNum)
         numTotalParameters = EstParameters.size();
         createOutputStr(numTotalParameters,numEstParameters,NumSubRuns,
                         bestFitness,fitnessStdDev,beeStruct,bestFitnessStr);
+        m_RunCompleted  = true;
+        m_BestFitness   = bestFitness;
+        m_FitnessStdDev = fitnessStdDev;
+        m_EstParameters = EstParameters;
         emit RunCompleted(bestFitnessStr,beeStruct.showDiagnosticChart);
 
     }
+
+    // A stopped run keeps its checkpoint so that it can be resumed
+    if (checkpoint && m_RunCompleted) {
+        checkpoint->remove();
+    } else if (checkpoint) {
+        checkpoint->stop();
+    }
     std::string elapsedTimeStr = "Elapsed runtime: " + nmfUtils::elapsedTime(startTime);
     std::cout << elapsedTimeStr << std::endl;
 
@@ -156,19 +317,6 @@ Bees_Estimator::estimateParameters(Data_Struct &beeStruct, int RunNum)
 }
 
 
-bool
-Bees_Estimator::wasStoppedByUser()
-{
-    std::string cmd;
-    std::ifstream inputFile(nmfConstantsMSSPM::MSSPMStopRunFile);
-    if (inputFile) {
-        std::getline(inputFile,cmd);
-    }
-    inputFile.close();
-
-    return (cmd == "StoppedByUser");
-}
-
 void
 Bees_Estimator::createOutputStr(const int&         numTotalParameters,
                                 const int&         numEstParameters,
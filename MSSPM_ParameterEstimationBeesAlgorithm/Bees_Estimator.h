@@ -44,6 +44,9 @@
 
 #include "BeesAlgorithm.h"
 #include "BeesStats.h"
+#include "nmfCancellationToken.h"
+#include "nmfEstimationCheckpoint.h"
+#include "nmfTrace.h"
 
 #include <QFile>
 #include <QMutex>
@@ -65,6 +68,27 @@ class Bees_Estimator : public QObject
     Q_OBJECT
 
 private:
+    /**
+     * @brief Result of a single Bees sub run
+     */
+    struct SubRunResult {
+        bool                ok = false;
+        double              bestFitness = 0;
+        std::vector<double> EstParameters;
+        std::string         errorMsg;
+    };
+
+    bool                                  m_RunCompleted;
+    double                                m_BestFitness;
+    nmfCancellationToken                  m_CancelToken;
+    std::vector<double>                   m_InitialParameters;
+    std::string                           m_CheckpointFile;
+    bool                                  m_IsResume;
+    std::vector<double>                   m_CachedParameters;
+    double                                m_CachedFitness;
+    double                                m_CachedFitnessStdDev;
+    std::vector<double>                   m_EstParameters;
+    double                                m_FitnessStdDev;
     std::vector<double>                   m_InitialCarryingCapacities;
     double                                m_EstSystemCarryingCapacity;
     std::vector<double>                   m_EstGrowthRates;
@@ -96,7 +120,12 @@ private:
                   std::vector<double> &parameters);
     void stopRun(const std::string &elapsedTimeStr,
                  const std::string &fitnessStr);
-    bool wasStoppedByUser();
+    void runSubRun(Data_Struct&       beeStruct,
+                   int                RunNum,
+                   int                subRunNum,
+                   int                NumSubRuns,
+                   bool&              stopRequested,
+                   SubRunResult&      result);
 
 signals:
     /**
@@ -133,11 +162,61 @@ public:
      * @param RunNum : the run number
      */
     void estimateParameters(Data_Struct &BeeStruct,int RunNum);
+    /**
+     * @brief Sets the token that cancels the estimation. The caller keeps a copy of the
+     * token and cancels it to stop the run.
+     * @param CancelToken : the cancellation token shared with the caller
+     */
+    void setCancellationToken(const nmfCancellationToken& CancelToken);
+    /**
+     * @brief Warm starts the estimation from previously estimated parameters. The
+     * Bees population is built inside the Bees algorithm, so the previous parameters
+     * can't be placed in it. Instead they're evaluated and compete with the best bee
+     * of each sub run, so a warm started run never returns a worse fit than the
+     * previous estimate. Parameters of the wrong size are ignored.
+     * @param InitialParameters : the parameters in the estimator's parameter order (empty for a cold start)
+     */
+    void setInitialParameters(const std::vector<double>& InitialParameters);
+    /**
+     * @brief Checkpoints the completed sub runs so that an interrupted run can be resumed.
+     * The checkpoint is deleted once the run completes. The random state of the Bees
+     * algorithm is internal to it, so the sub runs that hadn't completed start afresh.
+     * @param CheckpointFile : the checkpoint file (empty to not checkpoint the run)
+     * @param Resume : true to skip the sub runs already completed in a matching checkpoint
+     */
+    void setCheckpoint(const std::string& CheckpointFile,
+                       const bool&        Resume);
+    /**
+     * @brief Reports the cached result of an identical estimation instead of running
+     * the sub runs. Parameters that don't match the model's total number of parameters
+     * are ignored.
+     * @param Parameters : the cached parameters in the estimator's parameter order (empty to estimate)
+     * @param Fitness : the cached best fitness
+     * @param FitnessStdDev : the cached standard deviation of the best fitness of each sub run
+     */
+    void setCachedResult(const std::vector<double>& Parameters,
+                         const double&              Fitness,
+                         const double&              FitnessStdDev);
+    /**
+     * @brief Gets the parameters found by the last estimation in the estimator's
+     * parameter order (i.e., as passed to setCachedResult)
+     * @param EstParameters : the estimated parameters
+     * @param FitnessStdDev : the standard deviation of the best fitness of each sub run
+     * @return Returns false if the last estimation didn't complete
+     */
+    bool getEstimatedParameters(std::vector<double>& EstParameters,
+                                double&              FitnessStdDev);
     /**
      * @brief Gets the estimated carrying capacity values per species
      * @param EstCarryingCapacity : vector of carrying capacities per species
      */
     void getEstimatedCarryingCapacities(std::vector<double> &EstCarryingCapacity);
+    /**
+     * @brief Gets the best fitness value found by the last estimation
+     * @param BestFitness : the best fitness value of all of the sub runs
+     * @return Returns false if the last estimation didn't complete
+     */
+    bool getBestFitness(double &BestFitness);
     /**
      * @brief Gets the estimated catchability values per species
      * @param EstCatchability : vector of catchability values per species
@@ -179,6 +258,12 @@ public:
      */
     void getEstimatedPredation(boost::numeric::ublas::matrix<double> &EstPredation);
 
+public slots:
+    /**
+     * @brief Callback invoked when the user stops the Estimation run
+     */
+    void callback_StopTheOptimizer();
+
 };
 
 
@@ -5,6 +5,7 @@
 #-------------------------------------------------
 
 QT       -= gui
+QT       += concurrent
 
 TARGET = MSSPM_ParameterEstimationNLoptAlgorithm
 TEMPLATE = lib
@@ -23,11 +24,26 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Build the Chrome trace timers of nmfTrace.h with: qmake CONFIG+=trace
+CONFIG(trace): DEFINES += MSSPM_TRACE
+
+# Build the projection kernel's matrix-vector products with Eigen with: qmake CONFIG+=eigen
+CONFIG(eigen) {
+    DEFINES += MSSPM_EIGEN
+    INCLUDEPATH += /usr/include/eigen3
+}
+
 SOURCES += \
     NLopt_Estimator.cpp
 
 HEADERS += \
     NLopt_Estimator.h \
+    nmfProjectionKernel.h \
+    nmfAutoDiff.h \
+    nmfProgressChannel.h \
+    nmfCancellationToken.h \
+    nmfEstimationCheckpoint.h \
+    nmfEstimationHash.h \
     mainpage.h
 
 unix {
@@ -60,3 +76,6 @@ else:unix: LIBS += -L$$PWD/../../build-nmfModels-Qt_5_12_3_gcc64-Release/ -lnmfM
 
 INCLUDEPATH += $$PWD/../../nmfSharedUtilities/nmfModels
 DEPENDPATH += $$PWD/../../nmfSharedUtilities/nmfModels
+
+INCLUDEPATH += $$PWD/../MSSPM_Shared
+DEPENDPATH += $$PWD/../MSSPM_Shared
@@ -1,29 +1,26 @@
 #include "NLopt_Estimator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <numeric>
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <stdio.h>
 #include <math.h>
 
-bool m_Quit;
-//int NLopt_Estimator::m_NLoptIters    = 0;
-int NLopt_Estimator::m_NLoptFcnEvals = 0;
-int NLopt_Estimator::m_NumObjFcnCalls = 0;
-//int NLopt_Estimator::m_Counter       = 0;
-int NLopt_Estimator::m_RunNum        = 0;
-nlopt::opt       NLopt_Estimator::m_Optimizer;
-
-std::unique_ptr<nmfGrowthForm>      NLoptGrowthForm;
-std::unique_ptr<nmfHarvestForm>     NLoptHarvestForm;
-std::unique_ptr<nmfCompetitionForm> NLoptCompetitionForm;
-std::unique_ptr<nmfPredationForm>   NLoptPredationForm;
-
 
 NLopt_Estimator::NLopt_Estimator()
 {
-    m_Quit = false;
-//  m_Counter = 0;
+    m_RunNum        = 0;
+    m_MaxNumThreads = 0;
+    m_RunCompleted  = false;
+    m_BestFitness   = 0;
+    m_PruneSlackFactor = 0;
+    m_IsResume      = false;
+    m_CachedFitness       = 0;
+    m_CachedFitnessStdDev = 0;
+    m_FitnessStdDev       = 0;
     m_MinimizerToEnum.clear();
 
     // Load Minimizer Name Map with global algorithms
@@ -63,18 +60,84 @@ NLopt_Estimator::getVersion()
             QString::number(bugfix));
 }
 
-void
-NLopt_Estimator::extractParameters(const Data_Struct& NLoptDataStruct,
-                                   const double *EstParameters,
-                                   std::vector<double>& growthRate,
-                                   std::vector<double>& carryingCapacity,
-                                   std::vector<double>& catchabilityRate,
-                                   boost::numeric::ublas::matrix<double>& competitionAlpha,
-                                   boost::numeric::ublas::matrix<double>& competitionBetaSpecies,
-                                   boost::numeric::ublas::matrix<double>& competitionBetaGuilds,
-                                   boost::numeric::ublas::matrix<double>& predation,
-                                   boost::numeric::ublas::matrix<double>& handling,
-                                   std::vector<double>& exponent)
+// Resizes only when the shape changes so that repeated calls reuse the same storage
+template <class T>
+static void
+resizeMatrix(boost::numeric::ublas::matrix<T>& matrix,
+             const int& numRows,
+             const int& numCols)
+{
+    if ((int(matrix.size1()) != numRows) || (int(matrix.size2()) != numCols)) {
+        matrix.resize(numRows,numCols,false);
+    }
+}
+
+template <class T>
+static void
+loadMatrix(const T*                          EstParameters,
+           int&                              offset,
+           const int&                        numRows,
+           const int&                        numCols,
+           boost::numeric::ublas::matrix<T>& matrix)
+{
+    resizeMatrix(matrix,numRows,numCols);
+    for (int i=0; i<numRows; ++i) {
+        for (int j=0; j<numCols; ++j) {
+            matrix(i,j) = EstParameters[offset++];
+        }
+    }
+}
+
+template <class T>
+static void
+loadVector(const T*        EstParameters,
+           int&            offset,
+           const int&      numValues,
+           std::vector<T>& values)
+{
+    values.resize(numValues); // keeps capacity, so no reallocation after the first call
+    for (int i=0; i<numValues; ++i) {
+        values[i] = EstParameters[offset++];
+    }
+}
+
+// Sizes and zeroes the parameter matrices and reserves the parameter vectors
+template <class T>
+static void
+initializeParameters(const int&                   NumSpeciesOrGuilds,
+                     const int&                   NumGuilds,
+                     nmfProjectionParametersT<T>& parameters)
+{
+    resizeMatrix(parameters.CompetitionAlpha,       NumSpeciesOrGuilds, NumSpeciesOrGuilds);
+    resizeMatrix(parameters.CompetitionBetaSpecies, NumSpeciesOrGuilds, NumSpeciesOrGuilds);
+    resizeMatrix(parameters.CompetitionBetaGuilds,  NumSpeciesOrGuilds, NumGuilds);
+    resizeMatrix(parameters.Predation,              NumSpeciesOrGuilds, NumSpeciesOrGuilds);
+    resizeMatrix(parameters.Handling,               NumSpeciesOrGuilds, NumSpeciesOrGuilds);
+    parameters.CompetitionAlpha.clear();
+    parameters.CompetitionBetaSpecies.clear();
+    parameters.CompetitionBetaGuilds.clear();
+    parameters.Predation.clear();
+    parameters.Handling.clear();
+    parameters.GrowthRate.reserve(NumSpeciesOrGuilds);
+    parameters.CarryingCapacity.reserve(NumSpeciesOrGuilds);
+    parameters.Catchability.reserve(NumSpeciesOrGuilds);
+    parameters.Exponent.reserve(NumSpeciesOrGuilds);
+}
+
+// Shared by extractParameters (double) and the gradient evaluation (nmfAutoDiff::Real)
+template <class T>
+static void
+extractParameterValues(const Data_Struct&                NLoptDataStruct,
+                       const T*                          EstParameters,
+                       std::vector<T>&                   growthRate,
+                       std::vector<T>&                   carryingCapacity,
+                       std::vector<T>&                   catchabilityRate,
+                       boost::numeric::ublas::matrix<T>& competitionAlpha,
+                       boost::numeric::ublas::matrix<T>& competitionBetaSpecies,
+                       boost::numeric::ublas::matrix<T>& competitionBetaGuilds,
+                       boost::numeric::ublas::matrix<T>& predation,
+                       boost::numeric::ublas::matrix<T>& handling,
+                       std::vector<T>&                   exponent)
 {
     bool isLogistic     = (NLoptDataStruct.GrowthForm      == "Logistic");
     bool isCatchability = (NLoptDataStruct.HarvestForm     == "Effort (qE)");
@@ -87,114 +150,490 @@ NLopt_Estimator::extractParameters(const Data_Struct& NLoptDataStruct,
     bool isHandling     = (NLoptDataStruct.PredationForm   == "Type II") ||
                           (NLoptDataStruct.PredationForm   == "Type III");
     bool isExponent     = (NLoptDataStruct.PredationForm   == "Type III");
-    int m;
     int offset = 0;
     int NumSpecies = NLoptDataStruct.NumSpecies;
     int NumGuilds  = NLoptDataStruct.NumGuilds;
     int NumSpeciesOrGuilds = (isAGGPROD) ? NumGuilds : NumSpecies;
-    int MatrixSize = NumSpeciesOrGuilds*NumSpeciesOrGuilds;
 
-    growthRate.clear();
-    carryingCapacity.clear();
-    catchabilityRate.clear();
+    // Unused matrices are zeroed (but keep their size) and unused vectors are
+    // emptied, as before. None of this releases memory so that the objective
+    // function can call this repeatedly without allocating.
     competitionAlpha.clear();
     competitionBetaSpecies.clear();
     competitionBetaGuilds.clear();
     predation.clear();
     handling.clear();
-    exponent.clear();
 
-    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-        growthRate.emplace_back(EstParameters[i]);
+    loadVector(EstParameters,offset,NumSpeciesOrGuilds,growthRate);
+    loadVector(EstParameters,offset,(isLogistic     ? NumSpeciesOrGuilds : 0),carryingCapacity);
+    loadVector(EstParameters,offset,(isCatchability ? NumSpeciesOrGuilds : 0),catchabilityRate);
+
+    if (isAlpha) {
+        loadMatrix(EstParameters,offset,NumSpeciesOrGuilds,NumSpeciesOrGuilds,competitionAlpha);
+    }
+    if (isMSPROD) {
+        loadMatrix(EstParameters,offset,NumSpeciesOrGuilds,NumSpeciesOrGuilds,competitionBetaSpecies);
+    }
+    if (isMSPROD || isAGGPROD) {
+        loadMatrix(EstParameters,offset,NumSpeciesOrGuilds,NumGuilds,competitionBetaGuilds);
     }
-    offset += NumSpeciesOrGuilds;
+    if (isRho) {
+        loadMatrix(EstParameters,offset,NumSpeciesOrGuilds,NumSpeciesOrGuilds,predation);
+    }
+    if (isHandling) {
+        loadMatrix(EstParameters,offset,NumSpeciesOrGuilds,NumSpeciesOrGuilds,handling);
+    }
+    loadVector(EstParameters,offset,(isExponent ? NumSpeciesOrGuilds : 0),exponent);
+}
 
-    if (isLogistic) {
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            carryingCapacity.emplace_back(EstParameters[offset+i]);
+// Rescales each column of the matrix with (x - min)/(max-min)
+template <class T>
+static void
+rescaleColumnsMinMax(const boost::numeric::ublas::matrix<T>& matrix,
+                     boost::numeric::ublas::matrix<T>&       rescaledMatrix)
+{
+    int numYears   = matrix.size1();
+    int numSpecies = matrix.size2();
+    T den;
+    T minVal;
+    T maxVal;
+
+    // The min and max are found with a single pass so no temporaries are needed.
+    for (int species=0; species<numSpecies; ++species) {
+        minVal = matrix(0,species);
+        maxVal = minVal;
+        for (int time=1; time<numYears; ++time) {
+            minVal = std::min(minVal,matrix(time,species));
+            maxVal = std::max(maxVal,matrix(time,species));
+        }
+        den = maxVal - minVal;
+        for (int time=0; time<numYears; ++time) {
+            rescaledMatrix(time,species) = (matrix(time,species) - minVal) / den;  // min max normalization
         }
-        offset += NumSpeciesOrGuilds;
     }
+}
+
+// Rescales each column of the matrix with (x - ave)/(max-min)
+template <class T>
+static void
+rescaleColumnsMean(const boost::numeric::ublas::matrix<T>& matrix,
+                   boost::numeric::ublas::matrix<T>&       rescaledMatrix)
+{
+    int numYears   = matrix.size1();
+    int numSpecies = matrix.size2();
+    T den;
+    T minVal;
+    T maxVal;
+    T avgVal;
 
-    if (isCatchability) {
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            catchabilityRate.emplace_back(EstParameters[offset+i]);
+    for (int species=0; species<numSpecies; ++species) {
+        minVal = matrix(0,species);
+        maxVal = minVal;
+        avgVal = 0;
+        for (int time=0; time<numYears; ++time) {
+            minVal  = std::min(minVal,matrix(time,species));
+            maxVal  = std::max(maxVal,matrix(time,species));
+            avgVal += matrix(time,species);
+        }
+        avgVal /= numYears;
+        den     = maxVal - minVal;
+        for (int time=0; time<numYears; ++time) {
+            rescaledMatrix(time,species) = (matrix(time,species) - avgVal) / den; // mean normalization
         }
-        offset += NumSpeciesOrGuilds;
     }
+}
 
-    if (isAlpha) {
-        m = 0;
-        nmfUtils::initialize(competitionAlpha,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumSpeciesOrGuilds; ++j) {
-                competitionAlpha(i,j) = EstParameters[offset + (m++)];
-            }
+// Calculates the fitness from the workspace's current estimated biomass using
+// the appropriate objective criterion
+static double
+calculateFitness(const Data_Struct&    NLoptDataStruct,
+                 const NLoptWorkspace& ws)
+{
+    double fitness = 0;
+
+    if (NLoptDataStruct.ObjectiveCriterion == "Least Squares") {
+
+        fitness =  nmfUtilsStatistics::calculateSumOfSquares(
+                    ws.EstBiomassRescaled,
+                    ws.ObsBiomassBySpeciesOrGuildsRescaled);
+    } else if (NLoptDataStruct.ObjectiveCriterion == "Model Efficiency") {
+
+        // Negate the MEF here since the ranges is from -inf to 1, where 1 is best.  So we negate it,
+        // then minimize that, and then negate and plot the resulting value.
+        fitness = -nmfUtilsStatistics::calculateModelEfficiency(
+                    ws.EstBiomassRescaled,
+                    ws.ObsBiomassBySpeciesOrGuildsRescaled);
+    } else if (NLoptDataStruct.ObjectiveCriterion == "Maximum Likelihood") {
+        // The maximum likelihood calculations must use the unscaled data or else the
+        // results will be incorrect.
+        fitness =  nmfUtilsStatistics::calculateMaximumLikelihoodNoRescale(
+                    ws.EstBiomassSpecies,
+                    *ws.ObsBiomassBySpeciesOrGuilds);
+    }
+
+    return fitness;
+}
+
+// The objective criteria below restate the nmfUtilsStatistics ones so they can be
+// recorded on the tape. They're only used for the gradient minimizers and
+// msspm-bench --check compares their values with the library's.
+
+// Sum over all years and species of the squared difference between the estimated
+// and observed biomass
+template <class T>
+static T
+sumOfSquares(const boost::numeric::ublas::matrix<T>&      EstBiomass,
+             const boost::numeric::ublas::matrix<double>& ObsBiomass)
+{
+    int numYears   = EstBiomass.size1();
+    int numSpecies = EstBiomass.size2();
+    T diff;
+    T sum = 0;
+
+    for (int species=0; species<numSpecies; ++species) {
+        for (int time=0; time<numYears; ++time) {
+            diff = EstBiomass(time,species) - ObsBiomass(time,species);
+            sum += diff*diff;
         }
-        offset += MatrixSize;
     }
 
-    if (isMSPROD) {
-        m = 0;
-        nmfUtils::initialize(competitionBetaSpecies,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumSpeciesOrGuilds; ++j) {
-                competitionBetaSpecies(i,j) = EstParameters[offset + (m++)];
-            }
+    return sum;
+}
+
+// Nash-Sutcliffe model efficiency averaged over the species. For each species
+// MEF = 1 - sum((E-O)^2) / sum((O-mean(O))^2), which ranges from -inf to 1 with 1
+// being a perfect fit.
+template <class T>
+static T
+modelEfficiency(const boost::numeric::ublas::matrix<T>&      EstBiomass,
+                const boost::numeric::ublas::matrix<double>& ObsBiomass)
+{
+    int numYears   = EstBiomass.size1();
+    int numSpecies = EstBiomass.size2();
+    double meanObs;
+    double sumObsSq;
+    T diff;
+    T sumDiffSq;
+    T mef = 0;
+
+    for (int species=0; species<numSpecies; ++species) {
+        meanObs = 0;
+        for (int time=0; time<numYears; ++time) {
+            meanObs += ObsBiomass(time,species);
         }
-        offset += MatrixSize;
-        m = 0;
-        nmfUtils::initialize(competitionBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumGuilds; ++j) {
-                competitionBetaGuilds(i,j) = EstParameters[offset + (m++)];
-            }
+        meanObs /= numYears;
+        sumObsSq  = 0;
+        sumDiffSq = 0;
+        for (int time=0; time<numYears; ++time) {
+            diff       = EstBiomass(time,species) - ObsBiomass(time,species);
+            sumDiffSq += diff*diff;
+            sumObsSq  += (ObsBiomass(time,species)-meanObs)*(ObsBiomass(time,species)-meanObs);
         }
-        offset += NumSpeciesOrGuilds*NumGuilds;
+        mef += 1.0 - sumDiffSq/sumObsSq;
     }
 
-    if (isAGGPROD) {
-        m = 0;
-        nmfUtils::initialize(competitionBetaGuilds, NumSpeciesOrGuilds,NumGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumGuilds; ++j) {
-                competitionBetaGuilds(i,j) = EstParameters[offset + (m++)];
+    return mef/double(numSpecies);
+}
+
+// Negative log likelihood of the observed biomass assuming lognormal errors with a
+// separate variance per species. With the variance replaced by its maximum likelihood
+// estimate, each species contributes (n/2)*log(sum((log O - log E)^2)/n) up to a
+// constant, where n is the number of years with a positive observation. Must be
+// called with the unscaled biomass.
+template <class T>
+static T
+negativeLogLikelihood(const boost::numeric::ublas::matrix<T>&      EstBiomass,
+                      const boost::numeric::ublas::matrix<double>& ObsBiomass)
+{
+    using std::log;
+    int numYears   = EstBiomass.size1();
+    int numSpecies = EstBiomass.size2();
+    int numObs;
+    T diff;
+    T sumLogDiffSq;
+    T nll = 0;
+
+    for (int species=0; species<numSpecies; ++species) {
+        numObs       = 0;
+        sumLogDiffSq = 0;
+        for (int time=0; time<numYears; ++time) {
+            if (ObsBiomass(time,species) > 0) {
+                diff          = log(EstBiomass(time,species)) - std::log(ObsBiomass(time,species));
+                sumLogDiffSq += diff*diff;
+                ++numObs;
             }
         }
-        offset += NumSpeciesOrGuilds*NumGuilds;
+        if (numObs > 0) {
+            nll += 0.5*double(numObs)*log(sumLogDiffSq/double(numObs));
+        }
     }
 
-    if (isRho) {
-        m = 0;
-        nmfUtils::initialize(predation,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumSpeciesOrGuilds; ++j) {
-                predation(i,j) = EstParameters[offset + (m++)];
-            }
-        }
-        offset += MatrixSize;
+    return nll;
+}
+
+// Same as calculateFitness but from the workspace's estimated biomass on the tape
+static nmfAutoDiff::Real
+calculateFitnessAD(const Data_Struct&    NLoptDataStruct,
+                   const NLoptWorkspace& ws)
+{
+    nmfAutoDiff::Real fitness = 0;
+
+    if (NLoptDataStruct.ObjectiveCriterion == "Least Squares") {
+        fitness =  sumOfSquares(ws.EstBiomassRescaledAD,ws.ObsBiomassBySpeciesOrGuildsRescaled);
+    } else if (NLoptDataStruct.ObjectiveCriterion == "Model Efficiency") {
+        fitness = -modelEfficiency(ws.EstBiomassRescaledAD,ws.ObsBiomassBySpeciesOrGuildsRescaled);
+    } else if (NLoptDataStruct.ObjectiveCriterion == "Maximum Likelihood") {
+        fitness =  negativeLogLikelihood(ws.EstBiomassSpeciesAD,*ws.ObsBiomassBySpeciesOrGuilds);
     }
 
-    if (isHandling) {
-        m = 0;
-        nmfUtils::initialize(handling,NumSpeciesOrGuilds,NumSpeciesOrGuilds);
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            for (int j=0; j<NumSpeciesOrGuilds; ++j) {
-                handling(i,j) = EstParameters[offset + (m++)];
-            }
-        }
-        offset += MatrixSize;
+    return fitness;
+}
+
+void
+NLopt_Estimator::extractParameters(const Data_Struct& NLoptDataStruct,
+                                   const double *EstParameters,
+                                   std::vector<double>& growthRate,
+                                   std::vector<double>& carryingCapacity,
+                                   std::vector<double>& catchabilityRate,
+                                   boost::numeric::ublas::matrix<double>& competitionAlpha,
+                                   boost::numeric::ublas::matrix<double>& competitionBetaSpecies,
+                                   boost::numeric::ublas::matrix<double>& competitionBetaGuilds,
+                                   boost::numeric::ublas::matrix<double>& predation,
+                                   boost::numeric::ublas::matrix<double>& handling,
+                                   std::vector<double>& exponent)
+{
+    extractParameterValues(NLoptDataStruct,EstParameters,
+                           growthRate,carryingCapacity,catchabilityRate,
+                           competitionAlpha,competitionBetaSpecies,competitionBetaGuilds,
+                           predation,handling,exponent);
+}
+
+
+void
+NLopt_Estimator::initializeWorkspace(const Data_Struct& NLoptDataStruct,
+                                     NLoptWorkspace&    workspace,
+                                     const int&         RunNum,
+                                     const int&         StartNum)
+{
+    bool isAggProd         = (NLoptDataStruct.CompetitionForm == "AGG-PROD");
+    int NumSpecies         = NLoptDataStruct.NumSpecies;
+    int NumGuilds          = NLoptDataStruct.NumGuilds;
+    int NumYears           = NLoptDataStruct.RunLength+1;
+    int NumSpeciesOrGuilds = (isAggProd) ? NumGuilds : NumSpecies;
+
+    workspace.DataStruct = &NLoptDataStruct;
+    workspace.MSSPMName  = "Run " + std::to_string(RunNum) + "-" + std::to_string(StartNum);
+    workspace.RunNum     = RunNum;
+    workspace.StartNum   = StartNum;
+    workspace.NumObjFcnCalls = 0;
+    workspace.HasBestFitness = false;
+    workspace.FitnessBound.NumPruned = 0;
+    workspace.CanPrune = supportsPruning(NLoptDataStruct.Minimizer) &&
+                         (NLoptDataStruct.ObjectiveCriterion == "Least Squares");
+    workspace.IsMaximize = (NLoptDataStruct.ObjectiveCriterion == "Model Efficiency");
+    workspace.InProgress = nmfCheckpointResult();
+    workspace.InProgress.RunNum = StartNum;
+    workspace.IsInProgressSaved = true;
+    workspace.ObsBiomassBySpeciesOrGuilds = (isAggProd) ?
+                &NLoptDataStruct.ObservedBiomassByGuilds :
+                &NLoptDataStruct.ObservedBiomassBySpecies;
+
+    // Choose the projection kernel once for the entire run
+    workspace.Project = nmfProjectionKernel::select(
+                NLoptDataStruct.GrowthForm,
+                NLoptDataStruct.HarvestForm,
+                NLoptDataStruct.CompetitionForm,
+                NLoptDataStruct.PredationForm,
+                false);
+    nmfProjectionKernel::initializeSystem(
+                NumYears,NumSpeciesOrGuilds,NumGuilds,isAggProd,
+                NLoptDataStruct.GuildSpecies,
+                NLoptDataStruct.Catch,
+                NLoptDataStruct.Effort,
+                NLoptDataStruct.Exploitation,
+                workspace.System);
+    // Pairs of species whose interaction parameters are fixed at zero are never visited
+    nmfProjectionKernel::initializeInteractions(
+                NLoptDataStruct.CompetitionMin,
+                NLoptDataStruct.CompetitionMax,
+                NLoptDataStruct.CompetitionBetaSpeciesMin,
+                NLoptDataStruct.CompetitionBetaSpeciesMax,
+                NLoptDataStruct.PredationMin,
+                NLoptDataStruct.PredationMax,
+                workspace.System);
+    workspace.FreeParameters.clear();
+
+    nmfUtils::initialize(workspace.EstBiomassSpecies,  NumYears, NumSpeciesOrGuilds);
+    nmfUtils::initialize(workspace.EstBiomassGuilds,   NumYears, NumGuilds);
+    nmfUtils::initialize(workspace.EstBiomassRescaled, NumYears, NumSpeciesOrGuilds);
+    initializeParameters(NumSpeciesOrGuilds,NumGuilds,workspace.Parameters);
+
+    // The gradient based minimizers also need the AD version of the kernel
+    workspace.ProjectAD = nullptr;
+    if ((NLoptDataStruct.Minimizer.rfind("LD_",0) == 0) ||
+        (NLoptDataStruct.Minimizer.rfind("GD_",0) == 0)) {
+        workspace.ProjectAD = nmfProjectionKernel::select<nmfAutoDiff::Real>(
+                    NLoptDataStruct.GrowthForm,
+                    NLoptDataStruct.HarvestForm,
+                    NLoptDataStruct.CompetitionForm,
+                    NLoptDataStruct.PredationForm,
+                    false);
+        resizeMatrix(workspace.EstBiomassSpeciesAD,  NumYears, NumSpeciesOrGuilds);
+        resizeMatrix(workspace.EstBiomassGuildsAD,   NumYears, NumGuilds);
+        resizeMatrix(workspace.EstBiomassRescaledAD, NumYears, NumSpeciesOrGuilds);
+        initializeParameters(NumSpeciesOrGuilds,NumGuilds,workspace.ParametersAD);
+    }
+
+    // The observed biomass never changes during a run, so only rescale it once
+    nmfUtils::initialize(workspace.ObsBiomassBySpeciesOrGuildsRescaled, NumYears, NumSpeciesOrGuilds);
+    if (NLoptDataStruct.Scaling == "Mean") {
+        rescaleMean(*workspace.ObsBiomassBySpeciesOrGuilds, workspace.ObsBiomassBySpeciesOrGuildsRescaled);
+    } else {
+        rescaleMinMax(*workspace.ObsBiomassBySpeciesOrGuilds, workspace.ObsBiomassBySpeciesOrGuildsRescaled);
+    }
+    workspace.FitnessBound.ObsRescaled = &workspace.ObsBiomassBySpeciesOrGuildsRescaled;
+    workspace.System.StopAfterYearData = &workspace.FitnessBound;
+}
+
+
+// End of year check used by the projection kernel when pruning. Adds the newly
+// projected year to the running sums of the fitness bound (see NLoptFitnessBound)
+// and stops the projection once the bound exceeds the cutoff. The estimated biomass
+// is shifted by its initial value so the sums don't lose precision.
+static bool
+exceedsFitnessBound(const boost::numeric::ublas::matrix<double>& BiomassSpecies,
+                    int   time,
+                    void* data)
+{
+    NLoptFitnessBound& fb = *((NLoptFitnessBound *)data);
+    const boost::numeric::ublas::matrix<double>& Obs = *fb.ObsRescaled;
+    int NumSpeciesOrGuilds = BiomassSpecies.size2();
+    int firstYear = time;
+    double NumYears = time+1;
+    double est;
+    double obs;
+    double Sxx;
+    double Syy;
+    double Sxy;
+    double residual;
+
+    // The initial year is added along with the first projected year
+    if (time == 1) {
+        firstYear = 0;
+        fb.SumEst.assign(   NumSpeciesOrGuilds,0);
+        fb.SumEstSq.assign( NumSpeciesOrGuilds,0);
+        fb.SumObs.assign(   NumSpeciesOrGuilds,0);
+        fb.SumObsSq.assign( NumSpeciesOrGuilds,0);
+        fb.SumEstObs.assign(NumSpeciesOrGuilds,0);
     }
 
-    if (isExponent) {
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            exponent.emplace_back(EstParameters[offset+i]);
+    fb.Bound = 0;
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        for (int t=firstYear; t<=time; ++t) {
+            est = BiomassSpecies(t,i) - BiomassSpecies(0,i);
+            obs = Obs(t,i);
+            fb.SumEst[i]    += est;
+            fb.SumEstSq[i]  += est*est;
+            fb.SumObs[i]    += obs;
+            fb.SumObsSq[i]  += obs*obs;
+            fb.SumEstObs[i] += est*obs;
+        }
+        Sxx = fb.SumEstSq[i]  - fb.SumEst[i]*fb.SumEst[i]/NumYears;
+        Syy = fb.SumObsSq[i]  - fb.SumObs[i]*fb.SumObs[i]/NumYears;
+        Sxy = fb.SumEstObs[i] - fb.SumEst[i]*fb.SumObs[i]/NumYears;
+        residual = Syy;
+        if ((Sxy > 0) && (Sxx > 0)) {
+            residual -= Sxy*Sxy/Sxx;
         }
-        offset += NumSpeciesOrGuilds;
+        fb.Bound += std::max(0.0,residual);
     }
+
+    return (fb.Bound > fb.Cutoff);
 }
 
 
+// Calculates the fitness and its gradient. The projection, rescaling and objective
+// criterion are all recorded on the workspace tape, so a single reverse sweep seeded
+// with an adjoint of 1 on the fitness gives the whole gradient.
+static bool
+calculateFitnessAndGradient(unsigned           n,
+                            const double*      EstParameters,
+                            double*            gradient,
+                            NLoptWorkspace&    ws,
+                            double&            fitness)
+{
+    using nmfAutoDiff::Real;
+    const Data_Struct& NLoptDataStruct = *ws.DataStruct;
+    nmfProjectionParametersT<Real>& P = ws.ParametersAD;
+    int NumSpeciesOrGuilds = ws.System.NumSpeciesOrGuilds;
+    Real fitnessAD;
+
+    ws.Tape.clear();
+    ws.VariablesAD.resize(n);
+    for (unsigned k=0; k<n; ++k) {
+        ws.VariablesAD[k] = Real::variable(ws.Tape,EstParameters[k]);
+    }
+    extractParameterValues(NLoptDataStruct, ws.VariablesAD.data(),
+                           P.GrowthRate,P.CarryingCapacity,P.Catchability,
+                           P.CompetitionAlpha,P.CompetitionBetaSpecies,P.CompetitionBetaGuilds,
+                           P.Predation,P.Handling,P.Exponent);
+
+    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+        ws.EstBiomassSpeciesAD(0,i) = (*ws.ObsBiomassBySpeciesOrGuilds)(0,i);
+    }
+    if (! ws.ProjectAD(ws.System,P,ws.ScratchAD,ws.EstBiomassSpeciesAD,ws.EstBiomassGuildsAD)) {
+        return false;
+    }
+    if (NLoptDataStruct.Scaling == "Mean") {
+        rescaleColumnsMean(ws.EstBiomassSpeciesAD, ws.EstBiomassRescaledAD);
+    } else {
+        rescaleColumnsMinMax(ws.EstBiomassSpeciesAD, ws.EstBiomassRescaledAD);
+    }
+
+    fitnessAD = calculateFitnessAD(NLoptDataStruct,ws);
+    fitness   = fitnessAD.Value;
+
+    std::fill(gradient,gradient+n,0.0);
+    if (fitnessAD.Index < 0) {
+        return true; // doesn't depend on the parameters
+    }
+    ws.Tape.resetAdjoints();
+    ws.Tape.seed(fitnessAD.Index,1.0);
+    ws.Tape.sweep();
+    for (unsigned k=0; k<n; ++k) {
+        gradient[k] = ws.Tape.adjoint(ws.VariablesAD[k].Index);
+    }
+
+    return true;
+}
+
+// Keeps the best parameters of the start so far and periodically copies them into
+// the checkpoint, so a resumed run can continue the start from them
+static void
+updateInProgress(unsigned        n,
+                 const double*   EstParameters,
+                 const double&   fitness,
+                 NLoptWorkspace& ws)
+{
+    const int SaveInterval = 1000; // evaluations between copies into the checkpoint
+    nmfCheckpointResult& best = ws.InProgress;
+
+    if (ws.Checkpoint == nullptr) {
+        return;
+    }
+    if (best.Parameters.empty() ||
+        ( ws.IsMaximize && (fitness > best.Fitness)) ||
+        (!ws.IsMaximize && (fitness < best.Fitness))) {
+        best.Fitness = fitness;
+        best.Parameters.assign(EstParameters,EstParameters+n);
+        ws.IsInProgressSaved = false;
+    }
+    ++best.NumEvaluations;
+    if (! ws.IsInProgressSaved && (best.NumEvaluations%SaveInterval == 0)) {
+        ws.Checkpoint->setInProgress(best);
+        ws.IsInProgressSaved = true;
+    }
+}
 
 double
 NLopt_Estimator::objectiveFunction(unsigned n,
@@ -202,253 +641,149 @@ NLopt_Estimator::objectiveFunction(unsigned n,
                                    double* gradient,
                                    void* dataPtr)
 {
+    NMF_TRACE_SCOPE("estimation","NLopt objective");
     const int DefaultFitness = 99999;
-    Data_Struct NLoptDataStruct = *((Data_Struct *)dataPtr);
-    bool isAggProd = (NLoptDataStruct.CompetitionForm == "AGG-PROD");
-    double EstBiomassVal;
-    double GrowthTerm;
-    double HarvestTerm;
-    double CompetitionTerm;
-    double PredationTerm;
-    double systemCarryingCapacity;
-    double guildK;
+    NLoptWorkspace& ws = *((NLoptWorkspace *)dataPtr);
     double fitness=0;
-    int timeMinus1;
-    int NumYears   = NLoptDataStruct.RunLength+1;
-    int NumSpecies = NLoptDataStruct.NumSpecies;
-    int NumGuilds  = NLoptDataStruct.NumGuilds;
-    int guildNum = 0;
-    int NumSpeciesOrGuilds;
-    std::vector<double> growthRate;
-    std::vector<double> carryingCapacity;
-    std::vector<double> guildCarryingCapacity;
-    std::vector<double> exponent;
-    std::vector<double> catchabilityRate;
-    boost::numeric::ublas::matrix<double> EstBiomassSpecies;
-    boost::numeric::ublas::matrix<double> EstBiomassGuilds;
-    boost::numeric::ublas::matrix<double> EstBiomassRescaled;
-    boost::numeric::ublas::matrix<double> ObsBiomassBySpeciesOrGuildsRescaled;
-    boost::numeric::ublas::matrix<double> competitionAlpha;
-    boost::numeric::ublas::matrix<double> competitionBetaSpecies;
-    boost::numeric::ublas::matrix<double> competitionBetaGuilds;
-    boost::numeric::ublas::matrix<double> predation;
-    boost::numeric::ublas::matrix<double> handling;
-    boost::numeric::ublas::matrix<double> ObsBiomassBySpeciesOrGuilds;
-    boost::numeric::ublas::matrix<double> Catch        = NLoptDataStruct.Catch;
-    boost::numeric::ublas::matrix<double> Effort       = NLoptDataStruct.Effort;
-    boost::numeric::ublas::matrix<double> Exploitation = NLoptDataStruct.Exploitation;
-    std::map<int,std::vector<int> > GuildSpecies = NLoptDataStruct.GuildSpecies;
-    std::string MSSPMName = "Run " + std::to_string(m_RunNum) + "-1";
-
-    if (m_Quit) {
-       throw nlopt::forced_stop();
-    }
+    bool ok;
 
-    if (isAggProd) {
-        NumSpeciesOrGuilds = NumGuilds;
-        ObsBiomassBySpeciesOrGuilds = NLoptDataStruct.ObservedBiomassByGuilds;
-    } else {
-        NumSpeciesOrGuilds = NumSpecies;
-        ObsBiomassBySpeciesOrGuilds = NLoptDataStruct.ObservedBiomassBySpecies;
-    }
-    nmfUtils::initialize(EstBiomassSpecies,                   NumYears,           NumSpeciesOrGuilds);
-    nmfUtils::initialize(EstBiomassGuilds,                    NumYears,           NumGuilds);
-    nmfUtils::initialize(EstBiomassRescaled,                  NumYears,           NumSpeciesOrGuilds);
-    nmfUtils::initialize(ObsBiomassBySpeciesOrGuildsRescaled, NumYears,           NumSpeciesOrGuilds);
-    nmfUtils::initialize(competitionAlpha,                    NumSpeciesOrGuilds, NumSpeciesOrGuilds);
-    nmfUtils::initialize(competitionBetaSpecies,              NumSpecies,         NumSpecies);
-    nmfUtils::initialize(competitionBetaGuilds,               NumSpeciesOrGuilds, NumGuilds);
-    nmfUtils::initialize(predation,                           NumSpeciesOrGuilds, NumSpeciesOrGuilds);
-    nmfUtils::initialize(handling,                            NumSpeciesOrGuilds, NumSpeciesOrGuilds);
-
-    extractParameters(NLoptDataStruct, EstParameters,
-                      growthRate,carryingCapacity,catchabilityRate,
-                      competitionAlpha,competitionBetaSpecies,competitionBetaGuilds,
-                      predation,handling,exponent);
-
-    // Calculate carrying capacity for all guilds
-    systemCarryingCapacity = 0;
-    for (int i=0; i<NumGuilds; ++i) {
-        guildK = 0;
-        for (unsigned j=0; j<GuildSpecies[i].size(); ++j) {
-            guildK += carryingCapacity[GuildSpecies[i][j]];
-            systemCarryingCapacity += guildK;
-        }
-        guildCarryingCapacity.push_back(guildK);
-    }
-
-    for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-        EstBiomassSpecies(0,i) = NLoptDataStruct.ObservedBiomassBySpecies(0,i);
-    }
-    for (int i=0; i<NumGuilds; ++i) {
-        EstBiomassGuilds(0,i)  = NLoptDataStruct.ObservedBiomassByGuilds(0,i); // Remember there's only initial guild biomass data.
+    if (ws.Cancel.isCancelled()) {
+       throw nlopt::forced_stop();
     }
 
-    if (NLoptGrowthForm == nullptr) {
-        incrementObjectiveFunctionCounter(MSSPMName,-1.0,NLoptDataStruct);
+    if ((ws.DataStruct == nullptr) || (ws.Project == nullptr)) {
         return -1;
     }
-    for (int time=1; time<NumYears; ++time) {
-        timeMinus1 = time - 1;
-        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
-            EstBiomassVal   = EstBiomassSpecies(timeMinus1,i);
-            GrowthTerm      = NLoptGrowthForm->evaluate(i,EstBiomassVal,
-                                                     growthRate,carryingCapacity);
-            HarvestTerm     = NLoptHarvestForm->evaluate(timeMinus1,i,
-                                                      Catch,Effort,Exploitation,
-                                                      EstBiomassVal,catchabilityRate);
-            CompetitionTerm = NLoptCompetitionForm->evaluate(
-                                   timeMinus1,i,EstBiomassVal,
-                                   systemCarryingCapacity,
-                                   growthRate,
-                                   guildCarryingCapacity[guildNum],
-                                   competitionAlpha,
-                                   competitionBetaSpecies,
-                                   competitionBetaGuilds,
-                                   EstBiomassSpecies,
-                                   EstBiomassGuilds);
-            PredationTerm   = NLoptPredationForm->evaluate(
-                                   timeMinus1,i,
-                                   predation,handling,exponent,
-                                   EstBiomassSpecies,EstBiomassVal);
-
-            EstBiomassVal  += GrowthTerm - HarvestTerm - CompetitionTerm - PredationTerm;
-
-//std::cout << "EstBiomassVal: " << EstBiomassVal <<
-//             ", g: " << GrowthTerm <<
-//             ", h: " << HarvestTerm <<
-//             ", c: " << CompetitionTerm <<
-//             ", p: " << PredationTerm << std::endl;
-
-            if ((EstBiomassVal < 0) || (std::isnan(std::fabs(EstBiomassVal)))) {
-                incrementObjectiveFunctionCounter(MSSPMName,(double)DefaultFitness,NLoptDataStruct);
-                return DefaultFitness;
-            }
 
-            EstBiomassSpecies(time,i) = EstBiomassVal;
+    const Data_Struct& NLoptDataStruct = *ws.DataStruct;
+    nmfProjectionParameters& P = ws.Parameters;
+    bool prune;
 
-            // update EstBiomassGuilds for next time step
-            for (int i=0; i<NumGuilds; ++i) {
-                for (unsigned j=0; j<GuildSpecies[i].size(); ++j) {
-                    EstBiomassGuilds(time,i) += EstBiomassSpecies(time,GuildSpecies[i][j]);
-                }
-            }
-        } // end i
-    } // end time
-
-    // Scale the data
-    std::string m_Scaling = NLoptDataStruct.Scaling;
-    if (m_Scaling == "Min Max") {
-        rescaleMinMax(EstBiomassSpecies, EstBiomassRescaled);
-        rescaleMinMax(ObsBiomassBySpeciesOrGuilds, ObsBiomassBySpeciesOrGuildsRescaled);
-    } else if (m_Scaling == "Mean") {
-        rescaleMean(EstBiomassSpecies, EstBiomassRescaled);
-        rescaleMean(ObsBiomassBySpeciesOrGuilds, ObsBiomassBySpeciesOrGuildsRescaled);
+    if ((gradient != nullptr) && (ws.ProjectAD != nullptr)) {
+        ok = calculateFitnessAndGradient(n,EstParameters,gradient,ws,fitness);
     } else {
-//      std::cout << "Error: No Scaling Algorithm detected. Defaulting to Min Max." << std::endl;
-        rescaleMinMax(EstBiomassSpecies, EstBiomassRescaled);
-        rescaleMinMax(ObsBiomassBySpeciesOrGuilds, ObsBiomassBySpeciesOrGuildsRescaled);
-    }
+        if (gradient != nullptr) {
+            std::fill(gradient,gradient+n,0.0);
+        }
+        extractParameters(NLoptDataStruct, EstParameters,
+                          P.GrowthRate,P.CarryingCapacity,P.Catchability,
+                          P.CompetitionAlpha,P.CompetitionBetaSpecies,P.CompetitionBetaGuilds,
+                          P.Predation,P.Handling,P.Exponent);
 
-    // Calculate fitness using the appropriate objective criterion
-    if (NLoptDataStruct.ObjectiveCriterion == "Least Squares") {
+        for (int i=0; i<ws.System.NumSpeciesOrGuilds; ++i) {
+            ws.EstBiomassSpecies(0,i) = (*ws.ObsBiomassBySpeciesOrGuilds)(0,i);
+        }
 
-        fitness =  nmfUtilsStatistics::calculateSumOfSquares(
-                    EstBiomassRescaled,
-                    ObsBiomassBySpeciesOrGuildsRescaled);
-    } else if (NLoptDataStruct.ObjectiveCriterion == "Model Efficiency") {
+        // Least Squares projections that can no longer beat the best fitness are stopped early
+        prune = (ws.PruneSlackFactor > 0) && ws.HasBestFitness && ws.CanPrune;
+        ws.System.StopAfterYear  = (prune) ? exceedsFitnessBound : nullptr;
+        ws.FitnessBound.Cutoff   = ws.BestFitness*ws.PruneSlackFactor;
+        ws.FitnessBound.Bound    = 0;
+        ws.FitnessBound.IsPruned = false;
+
+        ok = ws.Project(ws.System,P,ws.Scratch,ws.EstBiomassSpecies,ws.EstBiomassGuilds);
+        if (! ok && prune && (ws.FitnessBound.Bound > ws.FitnessBound.Cutoff)) {
+            // Not the fitness, only a value the minimizer ranks behind the cutoff
+            ++ws.FitnessBound.NumPruned;
+            ws.FitnessBound.IsPruned = true;
+            fitness = std::max(ws.FitnessBound.Bound,ws.FitnessBound.Cutoff);
+            if (ws.ReportProgress) {
+                incrementObjectiveFunctionCounter(ws,fitness);
+            }
+            return fitness;
+        }
+        if (ok) {
+            // Scale the data (the observed biomass was already rescaled in initializeWorkspace)
+            if (NLoptDataStruct.Scaling == "Mean") {
+                rescaleMean(ws.EstBiomassSpecies, ws.EstBiomassRescaled);
+            } else {
+                rescaleMinMax(ws.EstBiomassSpecies, ws.EstBiomassRescaled);
+            }
+            fitness = calculateFitness(NLoptDataStruct,ws);
+            if (! ws.HasBestFitness || (fitness < ws.BestFitness)) {
+                ws.BestFitness    = fitness;
+                ws.HasBestFitness = true;
+            }
+        }
+    }
 
-        // Negate the MEF here since the ranges is from -inf to 1, where 1 is best.  So we negate it,
-        // then minimize that, and then negate and plot the resulting value.
-        fitness = -nmfUtilsStatistics::calculateModelEfficiency(
-                    EstBiomassRescaled,
-                    ObsBiomassBySpeciesOrGuildsRescaled);
-    } else if (NLoptDataStruct.ObjectiveCriterion == "Maximum Likelihood") {
-        // The maximum likelihood calculations must use the unscaled data or else the
-        // results will be incorrect.
-        fitness =  nmfUtilsStatistics::calculateMaximumLikelihoodNoRescale(
-                    EstBiomassSpecies,
-                    ObsBiomassBySpeciesOrGuilds);
-     }
+    if (! ok) {
+        // Found a negative or NaN biomass value
+        if (gradient != nullptr) {
+            std::fill(gradient,gradient+n,0.0);
+        }
+        if (ws.ReportProgress) {
+            incrementObjectiveFunctionCounter(ws,(double)DefaultFitness);
+        }
+        return DefaultFitness;
+    }
 
-    incrementObjectiveFunctionCounter(MSSPMName,fitness,NLoptDataStruct);
+    updateInProgress(n,EstParameters,fitness,ws);
+    if (ws.ReportProgress) {
+        incrementObjectiveFunctionCounter(ws,fitness);
+    }
 
     return fitness;
 }
 
 
-void
-NLopt_Estimator::incrementObjectiveFunctionCounter(std::string MSSPMName,
-                                                   double fitness,
-                                                   Data_Struct NLoptDataStruct)
+double
+NLopt_Estimator::freeParametersObjectiveFunction(unsigned n,
+                                                 const double* FreeParameters,
+                                                 double* gradient,
+                                                 void* dataPtr)
 {
-    int unused = -1;
+    NLoptWorkspace& ws = *((NLoptWorkspace *)dataPtr);
+    double* allGradient = (gradient != nullptr) ? ws.AllGradient.data() : nullptr;
+    double fitness;
 
-    // Update progress output file
-    // RSK - comment out for now, some algorithms yield 0 evals while they're calculating
-//    m_NLoptFcnEvals = m_Optimizer.get_numevals();
-
-    ++m_NumObjFcnCalls;
-//std::cout << "x,y: " << m_NumObjFcnCalls << "," << fitness << std::endl;
-    if (m_NumObjFcnCalls%1000 == 0) {
-
-    writeCurrentLoopFile(MSSPMName,
-                         m_NumObjFcnCalls,
-                         fitness,
-                         NLoptDataStruct.ObjectiveCriterion,
-                         unused);
-}
-//    if (m_NLoptFcnEvals == 0) {
-//        if (m_NumObjFcnCalls%10 == 0) {
-//            if (NLoptDataStruct.NLoptUseStopAfterIter) {
-//                if (m_NumObjFcnCalls <= m_Optimizer.get_maxeval())
-//                {
-//                    writeCurrentLoopFile(MSSPMName,
-//                                         m_NumObjFcnCalls,
-//                                         fitness,
-//                                         NLoptDataStruct.ObjectiveCriterion,
-//                                         unused);
-//                }
-//            } else {
-//                writeCurrentLoopFile(MSSPMName,
-//                                     m_NumObjFcnCalls,
-//                                     fitness,
-//                                     NLoptDataStruct.ObjectiveCriterion,
-//                                     unused);
-//            }
-//        }
-//    }
-//    else {
-//        if (m_NLoptFcnEvals%10 == 0) {
-//            if (NLoptDataStruct.NLoptUseStopAfterIter) {
-//                if (m_NLoptFcnEvals <= m_Optimizer.get_maxeval())
-//                {
-//                    writeCurrentLoopFile(MSSPMName,
-//                                         m_NLoptFcnEvals,
-//                                         fitness,
-//                                         NLoptDataStruct.ObjectiveCriterion,
-//                                         unused);
-//                }
-//            } else {
-//                writeCurrentLoopFile(MSSPMName,
-//                                     m_NLoptFcnEvals,
-//                                     fitness,
-//                                     NLoptDataStruct.ObjectiveCriterion,
-//                                     unused);
-//            }
-//        }
-//    }
+    for (unsigned k=0; k<n; ++k) {
+        ws.AllParameters[ws.FreeParameters[k]] = FreeParameters[k];
+    }
+    fitness = objectiveFunction(ws.AllParameters.size(),ws.AllParameters.data(),allGradient,dataPtr);
+    if (gradient != nullptr) {
+        for (unsigned k=0; k<n; ++k) {
+            gradient[k] = ws.AllGradient[ws.FreeParameters[k]];
+        }
+    }
 
+    return fitness;
+}
 
+void
+NLopt_Estimator::incrementObjectiveFunctionCounter(NLoptWorkspace& ws,
+                                                   const double&   fitness)
+{
+    int unused = -1;
 
+    // Update progress (each start counts its own evaluations). If there's a progress
+    // ring the GUI thread drains it, otherwise the sample goes to the progress file.
+    ++ws.NumObjFcnCalls;
+    if (ws.NumObjFcnCalls%1000 != 0) {
+        return;
+    }
+    if (ws.Progress != nullptr) {
+        nmfProgressSample sample;
+        sample.RunNum     = ws.RunNum;
+        sample.StartNum   = ws.StartNum;
+        sample.Evaluation = ws.NumObjFcnCalls;
+        sample.Fitness    = (ws.DataStruct->ObjectiveCriterion == "Model Efficiency") ? -fitness : fitness;
+        ws.Progress->push(sample);
+    } else {
+        writeCurrentLoopFile(ws.MSSPMName,
+                             ws.NumObjFcnCalls,
+                             fitness,
+                             ws.DataStruct->ObjectiveCriterion,
+                             unused);
+    }
 }
 
 void
-NLopt_Estimator::writeCurrentLoopFile(std::string &MSSPMName,
-                                      int         &NumGens,
-                                      double      &BestFitness,
-                                      std::string &ObjectiveCriterion,
-                                      int         &NumGensSinceBestFit)
+NLopt_Estimator::writeCurrentLoopFile(const std::string &MSSPMName,
+                                      const int         &NumGens,
+                                      const double      &BestFitness,
+                                      const std::string &ObjectiveCriterion,
+                                      const int         &NumGensSinceBestFit)
 {
     double adjustedBestFitness; // May need negating if ObjCrit is Model Efficiency
     std::ofstream outputFile(nmfConstantsMSSPM::MSSPMProgressChartFile,
@@ -466,10 +801,13 @@ NLopt_Estimator::writeCurrentLoopFile(std::string &MSSPMName,
         adjustedBestFitness = -adjustedBestFitness;
     }
 
-    outputFile << MSSPMName   << ", "
-               << NumGens     << ", "
-               << adjustedBestFitness << ", "
-               << NumGensSinceBestFit << std::endl;
+    // Concurrent starts append to the same file, so write each line in a single call
+    std::ostringstream line;
+    line << MSSPMName   << ", "
+         << NumGens     << ", "
+         << adjustedBestFitness << ", "
+         << NumGensSinceBestFit << "\n";
+    outputFile << line.str() << std::flush;
 
     outputFile.close();
 }
@@ -509,151 +847,468 @@ NLopt_Estimator::writeCurrentLoopFile(std::string &MSSPMName,
 
 
 
+// Sets each point to a Latin hypercube sample of the bounds: every parameter's range is
+// split into NumPoints equal strata and each stratum is used by exactly one point.
+static void
+latinHypercubeStartingPoints(const std::vector<double>&         lowerBounds,
+                             const std::vector<double>&         upperBounds,
+                             const int&                         NumPoints,
+                             std::mt19937&                      generator,
+                             std::vector<std::vector<double> >& Points)
+{
+    int NumParameters = lowerBounds.size();
+    std::vector<int> strata(NumPoints);
+    std::uniform_real_distribution<double> uniform(0.0,1.0);
+
+    Points.assign(NumPoints,std::vector<double>(NumParameters,0.0));
+    for (int i=0; i<NumParameters; ++i) {
+        std::iota(strata.begin(),strata.end(),0);
+        std::shuffle(strata.begin(),strata.end(),generator);
+        for (int point=0; point<NumPoints; ++point) {
+            Points[point][i] = lowerBounds[i] + (upperBounds[i]-lowerBounds[i]) *
+                               (strata[point]+uniform(generator))/NumPoints;
+        }
+    }
+}
+
+bool
+NLopt_Estimator::getBestFitness(double& BestFitness)
+{
+    BestFitness = m_BestFitness;
+
+    return m_RunCompleted;
+}
+
+bool
+NLopt_Estimator::getEstParameters(std::vector<double>& EstParameters,
+                                  double&              FitnessStdDev)
+{
+    EstParameters = m_Parameters;
+    FitnessStdDev = m_FitnessStdDev;
+
+    return m_RunCompleted;
+}
+
+nmfProgressChannel*
+NLopt_Estimator::getProgressChannel()
+{
+    return &m_ProgressChannel;
+}
+
+void
+NLopt_Estimator::setMaxNumThreads(int MaxNumThreads)
+{
+    m_MaxNumThreads = MaxNumThreads;
+}
+
+void
+NLopt_Estimator::setPruneSlackFactor(double SlackFactor)
+{
+    m_PruneSlackFactor = (SlackFactor > 0) ? std::max(1.0,SlackFactor) : 0;
+}
+
+bool
+NLopt_Estimator::supportsPruning(const std::string& Minimizer)
+{
+    return ((Minimizer == "LN_NELDERMEAD") ||
+            (Minimizer == "LN_SBPLX")      ||
+            (Minimizer == "GN_CRS2_LM"));
+}
+
+void
+NLopt_Estimator::setInitialParameters(const std::vector<double>& InitialParameters)
+{
+    m_InitialParameters = InitialParameters;
+}
+
+void
+NLopt_Estimator::setCheckpoint(const std::string& CheckpointFile,
+                               const bool&        Resume)
+{
+    m_CheckpointFile = CheckpointFile;
+    m_IsResume       = Resume;
+}
+
+void
+NLopt_Estimator::setCachedResult(const std::vector<double>& Parameters,
+                                 const double&              Fitness,
+                                 const double&              FitnessStdDev)
+{
+    m_CachedParameters    = Parameters;
+    m_CachedFitness       = Fitness;
+    m_CachedFitnessStdDev = FitnessStdDev;
+}
+
+void
+NLopt_Estimator::setCancellationToken(const nmfCancellationToken& CancelToken)
+{
+    m_CancelToken = CancelToken;
+}
+
+void
+NLopt_Estimator::runStart(const Data_Struct&         NLoptStruct,
+                          int                        RunNum,
+                          int                        StartNum,
+                          const std::vector<double>& lowerBounds,
+                          const std::vector<double>& upperBounds,
+                          nmfEstimationCheckpoint*   checkpoint,
+                          StartResult&               result)
+{
+    NMF_TRACE_SCOPE("estimation","NLopt_Estimator::runStart");
+    int NumEstParameters = lowerBounds.size();
+    int NumFreeParameters;
+    double fitness = 0;
+    std::vector<double> freeLowerBounds;
+    std::vector<double> freeUpperBounds;
+    std::vector<double> freeParameters;
+
+    // Starts that haven't begun yet are skipped once the user stops the run
+    if (m_CancelToken.isCancelled()) {
+        return;
+    }
+
+    // Each start has its own optimizer and workspace so the starts can run concurrently
+    NLoptWorkspace workspace;
+    initializeWorkspace(NLoptStruct,workspace,RunNum,StartNum);
+    workspace.Cancel   = m_CancelToken;
+    workspace.Progress = m_ProgressChannel.ring(StartNum-1);
+    workspace.PruneSlackFactor = m_PruneSlackFactor;
+    workspace.Checkpoint = checkpoint;
+
+    // Parameters fixed by their range (e.g., the many pairs of a large food web that
+    // don't interact) are left out of the optimizer, which only searches the free ones
+    for (int i=0; i<NumEstParameters; ++i) {
+        if (upperBounds[i] > lowerBounds[i]) {
+            workspace.FreeParameters.push_back(i);
+            freeLowerBounds.push_back(lowerBounds[i]);
+            freeUpperBounds.push_back(upperBounds[i]);
+            freeParameters.push_back(result.EstParameters[i]);
+        }
+    }
+    NumFreeParameters = workspace.FreeParameters.size();
+    workspace.AllParameters = result.EstParameters;
+    workspace.AllGradient.assign(NumEstParameters,0.0);
+    if (NumFreeParameters == 0) {
+        workspace.ReportProgress = false;
+        result.ok = true;
+        result.bestFitness = objectiveFunction(NumEstParameters,result.EstParameters.data(),nullptr,&workspace);
+        result.NumEvaluations = 1;
+        return;
+    }
+
+    nlopt::opt optimizer(m_MinimizerToEnum[NLoptStruct.Minimizer],NumFreeParameters);
+    optimizer.set_lower_bounds(freeLowerBounds);
+    optimizer.set_upper_bounds(freeUpperBounds);
+
+    // Call the appropriate Objective Function
+    if (NLoptStruct.ObjectiveCriterion == "Model Efficiency") {
+        optimizer.set_max_objective(freeParametersObjectiveFunction, &workspace);
+    } else {
+        optimizer.set_min_objective(freeParametersObjectiveFunction, &workspace);
+    }
+
+    // Set Stopping Criteria
+    if (NLoptStruct.NLoptUseStopVal) {
+        optimizer.set_stopval(NLoptStruct.NLoptStopVal);
+    }
+    if (NLoptStruct.NLoptUseStopAfterTime) {
+        optimizer.set_maxtime(NLoptStruct.NLoptStopAfterTime);
+    }
+    if (NLoptStruct.NLoptUseStopAfterIter) {
+        optimizer.set_maxeval(NLoptStruct.NLoptStopAfterIter);
+    }
+
+    //
+    // Run the Optimizer using the previously defined objective function
+    //
+    try {
+        //------------------------------------------------
+        nlopt::result code = optimizer.optimize(freeParameters, fitness);
+        //------------------------------------------------
+        std::cout << "\nOptimizer (start " << StartNum << ") return code: " << returnCode(code) << std::endl;
+        if (workspace.FitnessBound.NumPruned > 0) {
+            std::cout << "Stopped " << workspace.FitnessBound.NumPruned << " of "
+                      << workspace.NumObjFcnCalls << " projections early" << std::endl;
+        }
+    } catch (nlopt::forced_stop &e) {
+        std::cout << "User terminated application: " << e.what() << std::endl;
+        // Keep the best parameters so far so that a resumed run continues from them
+        if ((checkpoint != nullptr) && ! workspace.IsInProgressSaved) {
+            checkpoint->setInProgress(workspace.InProgress);
+        }
+        return;
+    } catch (const std::exception& e) {
+        // Some exceptions (e.g. roundoff limited) still leave usable parameters, so
+        // re-evaluate them to rank this start against the others
+        std::cout << "Exception thrown (start " << StartNum << "): " << e.what() << std::endl;
+        workspace.ReportProgress   = false;
+        workspace.PruneSlackFactor = 0;
+        fitness = freeParametersObjectiveFunction(NumFreeParameters,freeParameters.data(),nullptr,&workspace);
+    } catch (...) {
+        std::cout << "Error: Unknown error from NLopt_Estimator::runStart optimize()" << std::endl;
+        return;
+    }
+
+    for (int k=0; k<NumFreeParameters; ++k) {
+        result.EstParameters[workspace.FreeParameters[k]] = freeParameters[k];
+    }
+
+    result.ok = true;
+    result.bestFitness = fitness;
+    result.NumEvaluations = workspace.NumObjFcnCalls;
+}
+
 void
 NLopt_Estimator::estimateParameters(Data_Struct &NLoptStruct, int RunNum)
 {
+    NMF_TRACE_SCOPE("estimation","NLopt_Estimator::estimateParameters");
     int NumEstParameters;
-    int NumSubRuns = NLoptStruct.BeesNumRepetitions;
+    int NumFixedParameters;
+    int NumStarts = std::max(1,NLoptStruct.BeesNumRepetitions);
+    int NumOK = 0;
+    int best = -1;
+    bool isWarmStart;
+    bool isMaximize = (NLoptStruct.ObjectiveCriterion == "Model Efficiency");
+    double meanFitness     = 0;
     double fitnessStdDev   = 0;
     std::chrono::_V2::system_clock::time_point startTime = nmfUtils::startTimer();
-    std::chrono::_V2::system_clock::time_point startTimeSpecies;
     std::string bestFitnessStr = "TBD";
+    std::string MaxOrMin = (isMaximize) ? "maximum" : "minimum";
     std::vector<std::pair<double,double> > ParameterRanges;
-    std::string MaxOrMin;
-
-    startTimeSpecies = nmfUtils::startTimer();
-
-//  m_NLoptIters    = 0;
-    m_NLoptFcnEvals = 0;
-    m_NumObjFcnCalls = 0;
-//  m_Counter       = 0;
-    m_Quit          = false;
-    m_RunNum       += 1;
-
-    // Define forms
-    NLoptGrowthForm      = std::make_unique<nmfGrowthForm>(     NLoptStruct.GrowthForm);
-    NLoptHarvestForm     = std::make_unique<nmfHarvestForm>(    NLoptStruct.HarvestForm);
-    NLoptCompetitionForm = std::make_unique<nmfCompetitionForm>(NLoptStruct.CompetitionForm);
-    NLoptPredationForm   = std::make_unique<nmfPredationForm>(  NLoptStruct.PredationForm);
+    std::vector<std::vector<double> > StartingPoints;
+    std::vector<StartResult> startResults;
+    QList<QFuture<void> > futures;
+    unsigned Seed = std::random_device()();
+    std::unique_ptr<nmfEstimationCheckpoint> checkpoint;
+
+    m_RunNum = RunNum;
+    m_RunCompleted  = false;
+    m_BestFitness   = 0;
+    m_FitnessStdDev = 0;
+
+    // Define forms (only used here for their parameter ranges, the objective
+    // function uses the projection kernel selected in initializeWorkspace)
+    std::unique_ptr<nmfGrowthForm>      growthForm      = std::make_unique<nmfGrowthForm>(     NLoptStruct.GrowthForm);
+    std::unique_ptr<nmfHarvestForm>     harvestForm     = std::make_unique<nmfHarvestForm>(    NLoptStruct.HarvestForm);
+    std::unique_ptr<nmfCompetitionForm> competitionForm = std::make_unique<nmfCompetitionForm>(NLoptStruct.CompetitionForm);
+    std::unique_ptr<nmfPredationForm>   predationForm   = std::make_unique<nmfPredationForm>(  NLoptStruct.PredationForm);
 
     // Load parameter ranges
-    NLoptGrowthForm->loadParameterRanges(     ParameterRanges, NLoptStruct);
-    NLoptHarvestForm->loadParameterRanges(    ParameterRanges, NLoptStruct);
-    NLoptCompetitionForm->loadParameterRanges(ParameterRanges, NLoptStruct);
-    NLoptPredationForm->loadParameterRanges(  ParameterRanges, NLoptStruct);
+    growthForm->loadParameterRanges(     ParameterRanges, NLoptStruct);
+    harvestForm->loadParameterRanges(    ParameterRanges, NLoptStruct);
+    competitionForm->loadParameterRanges(ParameterRanges, NLoptStruct);
+    predationForm->loadParameterRanges(  ParameterRanges, NLoptStruct);
 
     NumEstParameters = ParameterRanges.size();
     std::vector<double> lowerBounds(NumEstParameters);
     std::vector<double> upperBounds(NumEstParameters);
-
-    // Initialize the optimizer with the appropriate algorithm
-//std::cout << "minimizer: " << NLoptStruct.Minimizer << std::endl;
-//std::cout << "m_MinimizerToEnum: " << m_MinimizerToEnum[NLoptStruct.Minimizer] << std::endl;
-//std::cout << "NumEstParam: " << NumEstParameters << std::endl;
-    m_Optimizer = nlopt::opt(m_MinimizerToEnum[NLoptStruct.Minimizer],NumEstParameters);
-//  nlopt::opt opt(m_MinimizerToEnum[NLoptStruct.Minimizer],NumEstParameters);
-
-    // Set parameter bounds for all parameters
     for (int i=0; i<NumEstParameters; ++i) {
         lowerBounds[i] = ParameterRanges[i].first;
         upperBounds[i] = ParameterRanges[i].second;
-//std::cout << "Bounds: " << lowerBounds[i] << "," << upperBounds[i] << std::endl;
     }
-    m_Optimizer.set_lower_bounds(lowerBounds);
-    m_Optimizer.set_upper_bounds(upperBounds);
+    NumFixedParameters = 0;
+    for (int i=0; i<NumEstParameters; ++i) {
+        if (upperBounds[i] <= lowerBounds[i]) {
+            ++NumFixedParameters;
+        }
+    }
+    if (NumFixedParameters > 0) {
+        std::cout << "Estimating " << NumEstParameters-NumFixedParameters << " of " << NumEstParameters
+                  << " parameters (the others are fixed by their ranges)" << std::endl;
+    }
+
+    // A warm start makes a single start from the previous estimate, since that estimate
+    // is already the best of the previous run's starts
+    isWarmStart = (int(m_InitialParameters.size()) == NumEstParameters);
+    if (isWarmStart) {
+        NumStarts = 1;
+        std::cout << "Warm starting from the previous estimate" << std::endl;
+    }
+    startResults.resize(NumStarts);
+
+    // The result of an identical estimation is reported as is, without re-estimating
+    if (int(m_CachedParameters.size()) == NumEstParameters) {
+        std::cout << "Using the cached result of an identical estimation" << std::endl;
+        m_Parameters = m_CachedParameters;
+        completeRun(NLoptStruct,NumStarts,m_CachedFitness,m_CachedFitnessStdDev,bestFitnessStr);
+        stopRun("Elapsed runtime: " + nmfUtils::elapsedTime(startTime),bestFitnessStr);
+        return;
+    }
+
+    // The seed of the starting points is kept with the checkpoint so a resumed run
+    // redraws the same starting points for the starts that hadn't completed
+    if (! m_CheckpointFile.empty()) {
+        checkpoint = std::make_unique<nmfEstimationCheckpoint>(
+                    m_CheckpointFile,
+                    nmfEstimationCheckpoint::key("NLopt Algorithm",NLoptStruct,m_InitialParameters));
+        if (m_IsResume && checkpoint->load()) {
+            Seed = checkpoint->getSeed();
+            std::cout << "Resuming from checkpoint: " << checkpoint->getNumResults()
+                      << " of " << NumStarts << " start(s) already completed" << std::endl;
+        } else if (m_IsResume) {
+            std::cout << "No checkpoint found for this run, starting from the beginning" << std::endl;
+        }
+        checkpoint->setSeed(Seed);
+        checkpoint->start();
+    }
 
-    // Set starting points for all parameters
+    // The first start is at the middle of the parameter ranges (as with a single
+    // start). Any additional starts are spread over the ranges with a Latin hypercube.
+    m_Parameters.assign(NumEstParameters,0.0);
     for (int i=0; i<NumEstParameters; ++i) {
-        if (lowerBounds[i] == upperBounds[i]) {
-            m_Parameters.push_back(lowerBounds[i]);
+        if (isWarmStart) {
+            m_Parameters[i] = std::min(upperBounds[i],std::max(lowerBounds[i],m_InitialParameters[i]));
         } else {
-            m_Parameters.push_back(lowerBounds[i] + (upperBounds[i]-lowerBounds[i])/2.0);
+            m_Parameters[i] = lowerBounds[i] + (upperBounds[i]-lowerBounds[i])/2.0;
         }
     }
     NLoptStruct.Parameters = m_Parameters;
-
-    // Call the appropriate Objective Function
-    if (NLoptStruct.ObjectiveCriterion == "Least Squares") {
-        MaxOrMin = "minimum";
-        m_Optimizer.set_min_objective(objectiveFunction, &NLoptStruct);
-    } else if (NLoptStruct.ObjectiveCriterion == "Maximum Likelihood") {
-        MaxOrMin = "minimum";
-        m_Optimizer.set_min_objective(objectiveFunction, &NLoptStruct);
-    } else if (NLoptStruct.ObjectiveCriterion == "Model Efficiency") {
-        MaxOrMin = "maximum";
-        m_Optimizer.set_max_objective(objectiveFunction, &NLoptStruct);
+    startResults[0].EstParameters = m_Parameters;
+    if (NumStarts > 1) {
+        std::mt19937 generator(Seed);
+        latinHypercubeStartingPoints(lowerBounds,upperBounds,NumStarts-1,generator,StartingPoints);
+        for (int startNum=1; startNum<NumStarts; ++startNum) {
+            startResults[startNum].EstParameters = StartingPoints[startNum-1];
+        }
     }
-
-    // Set Stopping Criteria
     if (NLoptStruct.NLoptUseStopVal) {
         std::cout << "Setting stop fitness value: " << NLoptStruct.NLoptStopVal << std::endl;
-        m_Optimizer.set_stopval(NLoptStruct.NLoptStopVal);
     }
     if (NLoptStruct.NLoptUseStopAfterTime) {
         std::cout << "Setting max run time: " << NLoptStruct.NLoptStopAfterTime << std::endl;
-        m_Optimizer.set_maxtime(NLoptStruct.NLoptStopAfterTime);
     }
     if (NLoptStruct.NLoptUseStopAfterIter) {
         std::cout << "Setting max num function evaluations: " << NLoptStruct.NLoptStopAfterIter << std::endl;
-        m_Optimizer.set_maxeval(NLoptStruct.NLoptStopAfterIter);
+    }
+    if ((m_PruneSlackFactor > 0) && ! supportsPruning(NLoptStruct.Minimizer)) {
+        std::cout << "Not stopping projections early: " << NLoptStruct.Minimizer
+                  << " uses the fitness values, not just their order" << std::endl;
     }
 
-    //
-    // Run the Optimizer using the previously defined objective function
-    //
-    nlopt::result result;
-    try {
-        double minf=0;
-        try {
-            //------------------------------------------------
-            result = m_Optimizer.optimize(m_Parameters, minf);
-            //------------------------------------------------
-            std::cout << "\nOptimizer return code: " << returnCode(result) << std::endl;
-        } catch (const std::exception& e) {
-            std::cout << "Exception thrown: " << e.what() << std::endl;
-        } catch (...) {
-            std::cout << "Error: Unknown error from NLopt_Estimator::estimateParameters m_Optimizer.optimize()" << std::endl;
-        }
-
-        std::cout << "Found " + MaxOrMin + " fitness of: " << minf << std::endl;
-        for (unsigned i=0; i<m_Parameters.size(); ++i) {
-            std::cout << "  Est Param[" << i << "]: " << m_Parameters[i] << std::endl;
+    // One progress ring per start since each start runs on its own thread
+    m_ProgressChannel.reset(NumStarts);
+
+    // Each start is independent, so run them concurrently on a local pool. The
+    // pool is local so that an NLopt run doesn't starve the global pool used by the GUI.
+    QThreadPool pool;
+    pool.setMaxThreadCount((m_MaxNumThreads > 0) ? m_MaxNumThreads : QThread::idealThreadCount());
+    for (int startNum=1; startNum<=NumStarts; ++startNum) {
+        // Starts already completed by a resumed run aren't rerun, and starts that were
+        // interrupted continue from the best parameters they had found
+        nmfCheckpointResult completed;
+        if (checkpoint && checkpoint->getResult(startNum,completed)) {
+            StartResult& result   = startResults[startNum-1];
+            result.ok             = true;
+            result.bestFitness    = completed.Fitness;
+            result.NumEvaluations = completed.NumEvaluations;
+            result.EstParameters  = completed.Parameters;
+            continue;
         }
+        if (checkpoint && checkpoint->getInProgress(startNum,completed) &&
+            (int(completed.Parameters.size()) == NumEstParameters)) {
+            std::cout << "Continuing start " << startNum << " from its best fitness so far: "
+                      << completed.Fitness << std::endl;
+            for (int i=0; i<NumEstParameters; ++i) {
+                startResults[startNum-1].EstParameters[i] =
+                        std::min(upperBounds[i],std::max(lowerBounds[i],completed.Parameters[i]));
+            }
+        }
+        futures.append(QtConcurrent::run(&pool, [&,startNum]() {
+            StartResult& result = startResults[startNum-1];
+            runStart(NLoptStruct,RunNum,startNum,lowerBounds,upperBounds,checkpoint.get(),result);
+            if (checkpoint && result.ok && ! m_CancelToken.isCancelled()) {
+                nmfCheckpointResult checkpointResult;
+                checkpointResult.RunNum         = startNum;
+                checkpointResult.Fitness        = result.bestFitness;
+                checkpointResult.NumEvaluations = result.NumEvaluations;
+                checkpointResult.Parameters     = result.EstParameters;
+                checkpoint->addResult(checkpointResult);
+            }
+        }));
+    }
+    for (QFuture<void>& future : futures) {
+        future.waitForFinished();
+    }
 
-        extractParameters(NLoptStruct, &m_Parameters[0],
-                          m_EstGrowthRates, m_EstCarryingCapacities,
-                          m_EstCatchability, m_EstAlpha,
-                          m_EstBetaSpecies, m_EstBetaGuilds,
-                          m_EstPredation, m_EstHandling, m_EstExponent);
+    // Choose the best start in start order so the result doesn't depend on
+    // the order the threads finished in
+    for (int startNum=0; startNum<NumStarts; ++startNum) {
+        const StartResult& result = startResults[startNum];
+        if (! result.ok) {
+            continue;
+        }
+        ++NumOK;
+        meanFitness += result.bestFitness;
+        if ((best < 0) ||
+            ( isMaximize && (result.bestFitness > startResults[best].bestFitness)) ||
+            (!isMaximize && (result.bestFitness < startResults[best].bestFitness))) {
+            best = startNum;
+        }
+    }
 
-        createOutputStr(NLoptStruct.TotalNumberParameters,
-                        m_Parameters.size(),NumSubRuns,
-                        minf,fitnessStdDev,NLoptStruct,bestFitnessStr);
+    if (m_CancelToken.isCancelled() || (best < 0)) {
+        std::cout << "NLopt run stopped before completion" << std::endl;
+    } else {
+        meanFitness /= NumOK;
+        for (const StartResult& result : startResults) {
+            if (result.ok) {
+                fitnessStdDev += (result.bestFitness-meanFitness)*(result.bestFitness-meanFitness);
+            }
+        }
+        fitnessStdDev = (NumOK > 1) ? std::sqrt(fitnessStdDev/(NumOK-1)) : 0;
 
-        emit RunCompleted(bestFitnessStr,NLoptStruct.showDiagnosticChart);
+        m_Parameters = startResults[best].EstParameters;
+        std::cout << "Found " + MaxOrMin + " fitness of: " << startResults[best].bestFitness
+                  << " (start " << best+1 << " of " << NumStarts << ")" << std::endl;
+        for (unsigned i=0; i<m_Parameters.size(); ++i) {
+            std::cout << "  Est Param[" << i << "]: " << m_Parameters[i] << std::endl;
+        }
 
+        completeRun(NLoptStruct,NumStarts,startResults[best].bestFitness,fitnessStdDev,bestFitnessStr);
     }
-    catch (nlopt::forced_stop &e) {
-        std::cout << "User terminated application: " << e.what() << std::endl;
-    }
-    catch (std::exception &e) {
-        std::cout << "nlopt failed: " << e.what() << std::endl;
+
+    // A stopped run keeps its checkpoint so that it can be resumed
+    if (checkpoint && m_RunCompleted) {
+        checkpoint->remove();
+    } else if (checkpoint) {
+        checkpoint->stop();
     }
 
     std::string elapsedTimeStr = "Elapsed runtime: " + nmfUtils::elapsedTime(startTime);
     std::cout << elapsedTimeStr << std::endl;
 
     stopRun(elapsedTimeStr,bestFitnessStr);
+}
 
-//std::cout << "throwing nlopt::forced_stop()" << std::endl;
-//    throw nlopt::forced_stop();
-
+void
+NLopt_Estimator::completeRun(const Data_Struct& NLoptStruct,
+                             const int&         NumStarts,
+                             const double&      BestFitness,
+                             const double&      FitnessStdDev,
+                             std::string&       bestFitnessStr)
+{
+    extractParameters(NLoptStruct, &m_Parameters[0],
+                      m_EstGrowthRates, m_EstCarryingCapacities,
+                      m_EstCatchability, m_EstAlpha,
+                      m_EstBetaSpecies, m_EstBetaGuilds,
+                      m_EstPredation, m_EstHandling, m_EstExponent);
+
+    createOutputStr(NLoptStruct.TotalNumberParameters,
+                    m_Parameters.size(),NumStarts,
+                    BestFitness,FitnessStdDev,
+                    NLoptStruct,bestFitnessStr);
+
+    m_RunCompleted  = true;
+    m_BestFitness   = BestFitness;
+    m_FitnessStdDev = FitnessStdDev;
+
+    emit RunCompleted(bestFitnessStr,NLoptStruct.showDiagnosticChart);
 }
 
 void
 NLopt_Estimator::callback_StopTheOptimizer()
 {
-   m_Quit = true;
+   m_CancelToken.cancel();
 }
 
 void
@@ -888,34 +1543,7 @@ void
 NLopt_Estimator::rescaleMinMax(const boost::numeric::ublas::matrix<double> &matrix,
                                      boost::numeric::ublas::matrix<double> &rescaledMatrix)
 {
-    int numYears   = matrix.size1();
-    int numSpecies = matrix.size2();
-    double den;
-    double minVal;
-    double maxVal;
-    std::vector<double> minValues(numSpecies,0);
-    std::vector<double> maxValues(numSpecies,0);
-    std::vector<double> tmp(numYears,0);
-
-    // Find min,max values for each column of matrix
-    for (int species=0; species<numSpecies; ++species) {
-        for (int time=0; time<numYears; ++time) {
-            tmp[time] = matrix(time,species);
-        }
-        std::sort(tmp.begin(),tmp.end());
-        minValues[species] = tmp.front();
-        maxValues[species] = tmp.back();
-    }
-
-    // Rescale each column of the matrix with (x - min)/(max-min) formula.
-    for (int species=0; species<numSpecies; ++species) {
-        minVal = minValues[species];
-        maxVal = maxValues[species];
-        den    = maxVal - minVal;
-        for (int time=0; time<numYears; ++time) {
-            rescaledMatrix(time,species) = (matrix(time,species) - minVal) / den;  // min max normalization
-        }
-    }
+    rescaleColumnsMinMax(matrix,rescaledMatrix);
 }
 
 
@@ -923,39 +1551,5 @@ void
 NLopt_Estimator::rescaleMean(const boost::numeric::ublas::matrix<double> &matrix,
                                    boost::numeric::ublas::matrix<double> &rescaledMatrix)
 {
-    int numYears   = matrix.size1();
-    int numSpecies = matrix.size2();
-    double den;
-    double minVal;
-    double maxVal;
-    double avgVal;
-    std::vector<double> minValues(numSpecies,0);
-    std::vector<double> maxValues(numSpecies,0);
-    std::vector<double> avgValues(numSpecies,0);
-    std::vector<double> tmp(numYears,0);
-
-    // Find min,max values for each column of matrix
-    for (int species=0; species<numSpecies; ++species) {
-        avgVal = 0;
-        for (int time=0; time<numYears; ++time) {
-            tmp[time] = matrix(time,species);
-            avgVal += tmp[time];
-        }
-        avgVal /= numYears;
-        std::sort(tmp.begin(),tmp.end());
-        minValues[species] = tmp.front();
-        maxValues[species] = tmp.back();
-        avgValues[species] = avgVal;
-    }
-
-    // Rescale each column of the matrix with (x - ave)/(max-min) formula.
-    for (int species=0; species<numSpecies; ++species) {
-        minVal = minValues[species];
-        maxVal = maxValues[species];
-        den    = maxVal - minVal;
-        avgVal = avgValues[species];
-        for (int time=0; time<numYears; ++time) {
-            rescaledMatrix(time,species) = (matrix(time,species) - avgVal) / den; // mean normalization
-        }
-    }
+    rescaleColumnsMean(matrix,rescaledMatrix);
 }
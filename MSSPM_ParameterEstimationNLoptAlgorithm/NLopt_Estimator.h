@@ -38,15 +38,100 @@
 #include "nmfHarvestForm.h"
 #include "nmfCompetitionForm.h"
 #include "nmfPredationForm.h"
+#include "nmfProjectionKernel.h"
+#include "nmfAutoDiff.h"
+#include "nmfProgressChannel.h"
+#include "nmfCancellationToken.h"
+#include "nmfEstimationCheckpoint.h"
+#include "nmfTrace.h"
 
 #include <QObject>
 #include <QString>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
+#include <atomic>
 #include <exception>
+#include <memory>
 #include <nlopt.hpp>
 #include <random>
 
 
+/**
+ * @brief Running lower bound of the Least Squares fitness of a projection in progress.
+ *
+ * Both scalings map each estimated biomass column onto u*B+v with u > 0, so the sum
+ * of squares over the years projected so far can't be less than the residual of the
+ * best (u >= 0) linear fit of the rescaled observed biomass on the estimated biomass.
+ * The fit is updated from running sums as each year is projected. Once the bound
+ * exceeds the cutoff, the candidate can't beat the incumbent and the projection stops.
+ */
+struct NLoptFitnessBound {
+    double              Cutoff = 0;       // the projection stops once Bound exceeds this
+    double              Bound  = 0;       // lower bound of the Least Squares fitness
+    int                 NumPruned = 0;    // number of evaluations stopped early
+    bool                IsPruned  = false; // true if the last evaluation was stopped early
+    const boost::numeric::ublas::matrix<double>* ObsRescaled = nullptr;
+    std::vector<double> SumEst;           // per species (or guild) running sums
+    std::vector<double> SumEstSq;
+    std::vector<double> SumObs;
+    std::vector<double> SumObsSq;
+    std::vector<double> SumEstObs;
+};
+
+/**
+ * @brief Per-run evaluation workspace passed to the NLopt objective function.
+ *
+ * The workspace is sized once by NLopt_Estimator::initializeWorkspace() and is then
+ * reused by reference on every objective function evaluation. This keeps the steady-state
+ * evaluations free of Data_Struct copies and heap allocations. The automatic differentiation
+ * members are only set up for the gradient based (LD_ and GD_) minimizers. All of the
+ * evaluation state is held here, so separate workspaces can be evaluated concurrently.
+ * Parameters fixed by their range aren't searched by the optimizer; it only sees the
+ * free parameters, which are expanded into all of the parameters before evaluating.
+ */
+struct NLoptWorkspace {
+    const Data_Struct*                      DataStruct = nullptr;
+    std::string                             MSSPMName;
+    bool                                    ReportProgress = true; // false if evaluations shouldn't update the progress chart
+    int                                     NumObjFcnCalls = 0;
+    int                                     RunNum   = 1;
+    int                                     StartNum = 1;
+    nmfProgressRing*                        Progress = nullptr;    // if set, progress goes here instead of to the progress file
+    nmfCancellationToken                    Cancel;                // evaluations stop once it's cancelled
+    double                                  PruneSlackFactor = 0;  // if > 0, stop Least Squares projections that exceed best*factor
+    bool                                    CanPrune = false;      // true if the minimizer and objective criterion support pruning
+    double                                  BestFitness = 0;       // best (unpruned) fitness found so far
+    bool                                    HasBestFitness = false;
+    NLoptFitnessBound                       FitnessBound;
+    nmfEstimationCheckpoint*                Checkpoint = nullptr;  // if set, the start's best parameters are saved to it periodically
+    bool                                    IsMaximize = false;    // true if the optimizer maximizes the fitness
+    nmfCheckpointResult                     InProgress;            // best parameters (all of them) and fitness of the start so far
+    bool                                    IsInProgressSaved = true;
+    std::vector<int>                        FreeParameters;        // indices of the parameters the optimizer searches
+    std::vector<double>                     AllParameters;         // all of the parameters (fixed ones at their value)
+    std::vector<double>                     AllGradient;
+    nmfProjectionKernel::ProjectionFunction Project = nullptr;
+    nmfProjectionSystem                     System;
+    nmfProjectionParameters                 Parameters;
+    nmfProjectionScratch                    Scratch;
+    const boost::numeric::ublas::matrix<double>* ObsBiomassBySpeciesOrGuilds = nullptr;
+    boost::numeric::ublas::matrix<double>   ObsBiomassBySpeciesOrGuildsRescaled;
+    boost::numeric::ublas::matrix<double>   EstBiomassSpecies;
+    boost::numeric::ublas::matrix<double>   EstBiomassGuilds;
+    boost::numeric::ublas::matrix<double>   EstBiomassRescaled;
+    nmfProjectionKernel::Types<nmfAutoDiff::Real>::ProjectionFunction ProjectAD = nullptr;
+    nmfAutoDiff::Tape                                Tape;
+    std::vector<nmfAutoDiff::Real>                   VariablesAD;
+    nmfProjectionParametersT<nmfAutoDiff::Real>      ParametersAD;
+    nmfProjectionScratchT<nmfAutoDiff::Real>         ScratchAD;
+    boost::numeric::ublas::matrix<nmfAutoDiff::Real> EstBiomassSpeciesAD;
+    boost::numeric::ublas::matrix<nmfAutoDiff::Real> EstBiomassGuildsAD;
+    boost::numeric::ublas::matrix<nmfAutoDiff::Real> EstBiomassRescaledAD;
+};
+
+
 /**
  * @brief This class acts as an interface class to the NLopt library.
  *
@@ -59,7 +144,29 @@ class  NLopt_Estimator : public QObject
     Q_OBJECT
 
 private:
-    static nlopt::opt                             m_Optimizer;
+    /**
+     * @brief Result of a single NLopt start
+     */
+    struct StartResult {
+        bool                ok = false;
+        double              bestFitness = 0;
+        int                 NumEvaluations = 0;
+        std::vector<double> EstParameters; // the starting point on input
+    };
+
+    nmfCancellationToken                   m_CancelToken;
+    int                                    m_RunNum;
+    int                                    m_MaxNumThreads;
+    bool                                   m_RunCompleted;
+    double                                 m_BestFitness;
+    double                                 m_PruneSlackFactor;
+    std::vector<double>                    m_InitialParameters;
+    std::string                            m_CheckpointFile;
+    bool                                   m_IsResume;
+    std::vector<double>                    m_CachedParameters;
+    double                                 m_CachedFitness;
+    double                                 m_CachedFitnessStdDev;
+    double                                 m_FitnessStdDev;
     std::vector<double>                    m_InitialCarryingCapacities;
     std::vector<double>                    m_EstCatchability;
     std::vector<double>                    m_EstExponent;
@@ -73,8 +180,14 @@ private:
     boost::numeric::ublas::matrix<double>  m_EstHandling;
     std::map<std::string,nlopt::algorithm> m_MinimizerToEnum;
     std::vector<double>                    m_Parameters;
+    nmfProgressChannel                     m_ProgressChannel;
 
 
+    void completeRun(const Data_Struct& NLoptStruct,
+                     const int&         NumStarts,
+                     const double&      BestFitness,
+                     const double&      FitnessStdDev,
+                     std::string&       bestFitnessStr);
     std::string returnCode(int result);
     void stopRun(const std::string &elapsedTimeStr,
                  const std::string &fitnessStr);
@@ -90,9 +203,19 @@ private:
                                     const bool& includeTotal);
     std::string convertValues2DToOutputStr(const std::string& label,
                                     const boost::numeric::ublas::matrix<double> &matrix);
-    static void incrementObjectiveFunctionCounter(std::string MSSPMName,
-                                           double fitness,
-                                           Data_Struct NLoptDataStruct);
+    static void incrementObjectiveFunctionCounter(NLoptWorkspace& ws,
+                                                  const double&   fitness);
+    static double freeParametersObjectiveFunction(unsigned      n,
+                                                  const double* FreeParameters,
+                                                  double*       Gradient,
+                                                  void*         FunctionData);
+    void runStart(const Data_Struct&         NLoptStruct,
+                  int                        RunNum,
+                  int                        StartNum,
+                  const std::vector<double>& lowerBounds,
+                  const std::vector<double>& upperBounds,
+                  nmfEstimationCheckpoint*   checkpoint,
+                  StartResult&               result);
 //    double  dnorm4(double x, double mu, double sigma, int give_log);
 
 signals:
@@ -113,26 +236,11 @@ public:
     NLopt_Estimator();
    ~NLopt_Estimator();
 
-//    /**
-//     * @brief Counts the number of run iterations
-//     */
-//    static int m_NLoptIters;
-    /**
-     * @brief Counts the number of function evaluations
-     */
-    static int m_NLoptFcnEvals;
-
-    static int m_NumObjFcnCalls;
-//    /**
-//     * @brief Counts the number of run iterations by the thousands
-//     */
-//    static int m_Counter;
-    /**
-     * @brief Keeps track of the run number
-     */
-    static int m_RunNum;
     /**
-     * @brief The main routine that runs the NLopt Optimizer
+     * @brief The main routine that runs the NLopt Optimizer. The optimizer is started
+     * BeesNumRepetitions times (at least once) on separate threads: the first start is at
+     * the middle of the parameter ranges and the others are at Latin hypercube samples of
+     * the ranges. The best of the starts is kept.
      * @param NLoptDataStruct : structure containing all of the parameters needed by NLopt
      * @param RunNum : the number of the run
      */
@@ -195,6 +303,21 @@ public:
      */
     void getEstCompetitionBetaSpecies(
             boost::numeric::ublas::matrix<double>& EstCompSpecies);
+    /**
+     * @brief Gets the best fitness value found by the last estimation
+     * @param BestFitness : the best fitness value of all of the starts
+     * @return Returns false if the last estimation didn't complete
+     */
+    bool getBestFitness(double& BestFitness);
+    /**
+     * @brief Gets the parameters found by the last estimation in the estimator's
+     * parameter order (i.e., as passed to setCachedResult)
+     * @param EstParameters : the estimated parameters
+     * @param FitnessStdDev : the standard deviation of the best fitness of each start
+     * @return Returns false if the last estimation didn't complete
+     */
+    bool getEstParameters(std::vector<double>& EstParameters,
+                          double&              FitnessStdDev);
     /**
      * @brief Get the estimated exponent values
      * @param EstExponent : the estimated exponent values to return
@@ -224,13 +347,96 @@ public:
      * @return Returns a QString which comprises the major, minor, and bugfix version of NLopt
      */
     QString getVersion();
+    /**
+     * @brief Gets the channel that the estimation threads push their progress samples to.
+     * The GUI drains it on its progress timer instead of having the estimator write the
+     * progress file.
+     * @return Returns the progress channel (owned by this estimator)
+     */
+    nmfProgressChannel* getProgressChannel();
+    /**
+     * @brief Sets the maximum number of threads used to run the starts concurrently
+     * @param MaxNumThreads : the maximum number of threads (0 for the ideal thread count)
+     */
+    void setMaxNumThreads(int MaxNumThreads);
+    /**
+     * @brief Sets the token that cancels the estimation. The caller keeps a copy of the
+     * token and cancels it to stop the run.
+     * @param CancelToken : the cancellation token shared with the caller
+     */
+    void setCancellationToken(const nmfCancellationToken& CancelToken);
+    /**
+     * @brief Turns on early termination of dominated Least Squares projections. A
+     * projection stops as soon as a lower bound of its fitness exceeds the best fitness
+     * found so far (by its start) times the slack factor. Its true fitness isn't known,
+     * so the larger of the bound and the cutoff is returned, which ranks it behind every
+     * candidate within the cutoff. Only the minimizers that just compare fitness values
+     * support this (see supportsPruning); the others always run the complete projection.
+     * The minimizers also compare candidates with their worse points (e.g., the worst
+     * vertex of the simplex), so the search is only unchanged while the cutoff stays
+     * above those. A slack factor of about 10 keeps it so for most Systems.
+     * @param SlackFactor : the cutoff as a multiple of the best fitness (0 turns pruning off, else >= 1)
+     */
+    void setPruneSlackFactor(double SlackFactor);
+    /**
+     * @brief Checks if a minimizer supports early termination of dominated projections.
+     * Only LN_NELDERMEAD, LN_SBPLX and GN_CRS2_LM do, since they only compare fitness
+     * values. The interpolation models of LN_BOBYQA, LN_COBYLA and LN_PRAXIS, the
+     * Lipschitz estimates of the DIRECT algorithms and the gradient based minimizers all
+     * use the fitness values themselves, which a pruned evaluation doesn't have.
+     * @param Minimizer : the name of the minimizer
+     * @return Returns true if the minimizer supports pruning
+     */
+    static bool supportsPruning(const std::string& Minimizer);
+    /**
+     * @brief Warm starts the estimation from previously estimated parameters. The run
+     * then makes a single start from the passed parameters (clamped to the parameter
+     * ranges) in place of the middle of the ranges and any Latin hypercube starts.
+     * Parameters that don't match the model's number of estimated parameters are ignored.
+     * @param InitialParameters : the parameters in the estimator's parameter order (empty for a cold start)
+     */
+    void setInitialParameters(const std::vector<double>& InitialParameters);
+    /**
+     * @brief Checkpoints the completed starts, and the best parameters so far of the starts
+     * still running, so that an interrupted run can be resumed. The checkpoint is deleted
+     * once the run completes.
+     * @param CheckpointFile : the checkpoint file (empty to not checkpoint the run)
+     * @param Resume : true to skip the starts already completed in a matching checkpoint and
+     * continue the interrupted ones from their best parameters
+     */
+    void setCheckpoint(const std::string& CheckpointFile,
+                       const bool&        Resume);
+    /**
+     * @brief Reports the cached result of an identical estimation instead of estimating.
+     * Parameters that don't match the model's number of estimated parameters are ignored.
+     * @param Parameters : the cached parameters in the estimator's parameter order (empty to estimate)
+     * @param Fitness : the cached best fitness
+     * @param FitnessStdDev : the cached standard deviation of the best fitness of each start
+     */
+    void setCachedResult(const std::vector<double>& Parameters,
+                         const double&              Fitness,
+                         const double&              FitnessStdDev);
+    /**
+     * @brief Sizes the evaluation workspace for the passed data struct. Must be called
+     * once prior to calling objectiveFunction with the workspace.
+     * @param NLoptDataStruct : structure containing all of the parameters needed by NLopt (must outlive the workspace)
+     * @param Workspace : the workspace to initialize
+     * @param RunNum : the run number used to name the progress chart line
+     * @param StartNum : the start number used to name the progress chart line
+     */
+    static void initializeWorkspace(
+            const Data_Struct& NLoptDataStruct,
+            NLoptWorkspace&    Workspace,
+            const int&         RunNum   = 1,
+            const int&         StartNum = 1);
     /**
      * @brief Calculates the objective function fitness value
-     * @param n : unused (needed by NLopt library)
+     * @param n : number of estimated parameters
      * @param EstParameters : estimated parameter values
-     * @param Gradient : unused (needed by NLopt library)
-     * @param FunctionData : input parameter estimation data
-     * @return
+     * @param Gradient : if not null, set to the gradient of the fitness with respect to the
+     * estimated parameters (only requested by the gradient based minimizers)
+     * @param FunctionData : pointer to an NLoptWorkspace previously set up with initializeWorkspace
+     * @return Returns the fitness value (or -1 if the workspace hasn't been initialized or has an unknown model form)
      */
     static double objectiveFunction(
             unsigned      n,
@@ -263,11 +469,11 @@ public:
      * @param NumGensSinceBestFit : unused
      */
     static void writeCurrentLoopFile(
-            std::string& MSSPMName,
-            int&         NumGens,
-            double&      BestFitness,
-            std::string& ObjectiveCriterion,
-            int&         NumGensSinceBestFit);
+            const std::string& MSSPMName,
+            const int&         NumGens,
+            const double&      BestFitness,
+            const std::string& ObjectiveCriterion,
+            const int&         NumGensSinceBestFit);
 
 public slots:
     /**
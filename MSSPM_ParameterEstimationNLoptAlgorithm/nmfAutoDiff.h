@@ -0,0 +1,219 @@
+/**
+ * @file nmfAutoDiff.h
+ * @brief Definition of the reverse mode automatic differentiation types
+ *
+ * This file contains a small tape based reverse mode automatic differentiation
+ * scalar. Every arithmetic operation on a variable records its local partial
+ * derivatives on a tape, and a single reverse sweep of the tape then gives the
+ * derivative of an output with respect to all of the independent variables.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+namespace nmfAutoDiff {
+
+/**
+ * @brief Records the operations of one function evaluation
+ *
+ * A tape isn't thread safe and must only be used by one evaluation at a time.
+ * Clearing the tape keeps its capacity, so after the first evaluation recording
+ * doesn't allocate.
+ */
+class Tape
+{
+private:
+    struct Node {
+        int    Parent[2];
+        double Partial[2];
+    };
+    std::vector<Node>   m_Nodes;
+    std::vector<double> m_Adjoints;
+
+public:
+    /**
+     * @brief Removes all of the recorded operations
+     */
+    void clear() {
+        m_Nodes.clear();
+    }
+    /**
+     * @brief Records an operation
+     * @param parent0 : index of the first operand (-1 if a constant)
+     * @param partial0 : partial derivative with respect to the first operand
+     * @param parent1 : index of the second operand (-1 if a constant or unary operation)
+     * @param partial1 : partial derivative with respect to the second operand
+     * @return Returns the index of the recorded result
+     */
+    int push(const int&    parent0,
+             const double& partial0,
+             const int&    parent1,
+             const double& partial1) {
+        Node node;
+        node.Parent[0]  = parent0;
+        node.Parent[1]  = parent1;
+        node.Partial[0] = partial0;
+        node.Partial[1] = partial1;
+        m_Nodes.push_back(node);
+        return int(m_Nodes.size())-1;
+    }
+    /**
+     * @brief Sets all of the adjoints to zero. Must be called before seeding the outputs.
+     */
+    void resetAdjoints() {
+        m_Adjoints.assign(m_Nodes.size(),0.0);
+    }
+    /**
+     * @brief Adds to the adjoint (i.e., d(output)/d(node)) of a recorded node
+     * @param index : index of the node
+     * @param weight : value to add
+     */
+    void seed(const int& index, const double& weight) {
+        m_Adjoints[index] += weight;
+    }
+    /**
+     * @brief Propagates the seeded adjoints back to the independent variables
+     */
+    void sweep() {
+        for (int k=int(m_Nodes.size())-1; k>=0; --k) {
+            const double adjoint = m_Adjoints[k];
+            if (adjoint == 0) {
+                continue;
+            }
+            const Node& node = m_Nodes[k];
+            if (node.Parent[0] >= 0) {
+                m_Adjoints[node.Parent[0]] += adjoint*node.Partial[0];
+            }
+            if (node.Parent[1] >= 0) {
+                m_Adjoints[node.Parent[1]] += adjoint*node.Partial[1];
+            }
+        }
+    }
+    /**
+     * @brief Gets the adjoint of a recorded node (after sweep, the derivative of the seeded output)
+     * @param index : index of the node
+     * @return Returns the adjoint value
+     */
+    double adjoint(const int& index) const {
+        return m_Adjoints[index];
+    }
+};
+
+/**
+ * @brief Scalar that records its operations on a tape
+ *
+ * A Real constructed from a double is a constant and records nothing, so it can be
+ * mixed freely with doubles. Only values derived from a variable are recorded.
+ */
+class Real
+{
+public:
+    double Value;
+    int    Index;
+    Tape*  TapePtr;
+
+    Real() : Value(0), Index(-1), TapePtr(nullptr) {}
+    Real(const double& value) : Value(value), Index(-1), TapePtr(nullptr) {}
+
+    /**
+     * @brief Creates an independent variable
+     * @param tape : tape on which to record the variable
+     * @param value : value of the variable
+     * @return Returns the variable
+     */
+    static Real variable(Tape& tape, const double& value) {
+        Real retv(value);
+        retv.TapePtr = &tape;
+        retv.Index   = tape.push(-1,0,-1,0);
+        return retv;
+    }
+
+    Real& operator+=(const Real& rhs);
+    Real& operator-=(const Real& rhs);
+    Real& operator*=(const Real& rhs);
+    Real& operator/=(const Real& rhs);
+};
+
+inline Real
+record(const double& value,
+       const Real&   a, const double& da,
+       const Real&   b, const double& db)
+{
+    Real retv(value);
+    Tape* tape = (a.TapePtr != nullptr) ? a.TapePtr : b.TapePtr;
+    if (tape != nullptr) {
+        retv.TapePtr = tape;
+        retv.Index   = tape->push(a.Index,da,b.Index,db);
+    }
+    return retv;
+}
+
+inline Real operator+(const Real& a, const Real& b) { return record(a.Value+b.Value,a, 1.0,b, 1.0); }
+inline Real operator-(const Real& a, const Real& b) { return record(a.Value-b.Value,a, 1.0,b,-1.0); }
+inline Real operator*(const Real& a, const Real& b) { return record(a.Value*b.Value,a,b.Value,b,a.Value); }
+inline Real operator/(const Real& a, const Real& b) {
+    const double value = a.Value/b.Value;
+    return record(value,a,1.0/b.Value,b,-value/b.Value);
+}
+inline Real operator-(const Real& a) { return record(-a.Value,a,-1.0,Real(),0.0); }
+
+inline Real& Real::operator+=(const Real& rhs) { return *this = *this + rhs; }
+inline Real& Real::operator-=(const Real& rhs) { return *this = *this - rhs; }
+inline Real& Real::operator*=(const Real& rhs) { return *this = *this * rhs; }
+inline Real& Real::operator/=(const Real& rhs) { return *this = *this / rhs; }
+
+inline bool operator< (const Real& a, const Real& b) { return a.Value <  b.Value; }
+inline bool operator> (const Real& a, const Real& b) { return a.Value >  b.Value; }
+inline bool operator<=(const Real& a, const Real& b) { return a.Value <= b.Value; }
+inline bool operator>=(const Real& a, const Real& b) { return a.Value >= b.Value; }
+inline bool operator==(const Real& a, const Real& b) { return a.Value == b.Value; }
+inline bool operator!=(const Real& a, const Real& b) { return a.Value != b.Value; }
+
+inline Real
+pow(const Real& a, const Real& b)
+{
+    const double value = std::pow(a.Value,b.Value);
+    const double da    = (b.Value == 0) ? 0 : b.Value*std::pow(a.Value,b.Value-1.0);
+    const double db    = (a.Value > 0)  ? value*std::log(a.Value) : 0;
+    return record(value,a,da,b,db);
+}
+
+inline Real
+log(const Real& a)
+{
+    return record(std::log(a.Value),a,1.0/a.Value,Real(),0.0);
+}
+
+/**
+ * @brief Gets the value of a scalar without its derivative information
+ */
+inline double
+scalarValue(const Real& a)
+{
+    return a.Value;
+}
+
+} // end namespace nmfAutoDiff
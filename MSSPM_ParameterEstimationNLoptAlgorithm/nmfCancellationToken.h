@@ -0,0 +1,66 @@
+/**
+ * @file nmfCancellationToken.h
+ * @brief Definition of the cooperative cancellation token
+ *
+ * A single token type is passed down into every long running operation (the Bees
+ * sub runs, the NLopt objective function, the diagnostic parameter profiles, the
+ * Monte Carlo forecast runs and the retrospective peels). Copies of a token share
+ * the same state, so the GUI keeps one copy to cancel with and the workers poll
+ * their copies. Polling is a single atomic load, so workers check it at every
+ * step of their inner loops and no filesystem polling is needed.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Cooperative cancellation token shared between an operation and its workers
+ */
+class nmfCancellationToken
+{
+private:
+    std::shared_ptr<std::atomic<bool> > m_Cancelled;
+
+public:
+    /**
+     * @brief Creates a new (not cancelled) token with its own state
+     */
+    nmfCancellationToken() : m_Cancelled(std::make_shared<std::atomic<bool> >(false)) {}
+
+    /**
+     * @brief Requests cancellation of the operation (and of every copy of this token)
+     */
+    void cancel() const {
+        m_Cancelled->store(true,std::memory_order_relaxed);
+    }
+    /**
+     * @brief Checks whether cancellation has been requested
+     * @return Returns true if the operation should stop as soon as possible
+     */
+    bool isCancelled() const {
+        return m_Cancelled->load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,333 @@
+/**
+ * @file nmfEstimationCheckpoint.h
+ * @brief Definition of the estimation checkpoint used to resume interrupted runs
+ *
+ * An estimation is made of independent starts (NLopt) or sub runs (Bees). As each one
+ * completes its result is copied into the checkpoint and a background thread saves the
+ * checkpoint to disk, so a run that's stopped or crashes can be resumed later without
+ * repeating the starts that had already finished.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfEstimationHash.h"
+#include "nmfUtils.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The result of one completed start (NLopt) or sub run (Bees)
+ */
+struct nmfCheckpointResult {
+    int                 RunNum         = 0; // 1 based start or sub run number
+    double              Fitness        = 0;
+    int                 NumEvaluations = 0; // 0 if the algorithm doesn't report them
+    std::vector<double> Parameters;
+};
+
+/**
+ * @brief Periodically saves the completed starts (or sub runs) of an estimation
+ *
+ * The estimation threads only copy their result in under a mutex. The file is written
+ * by a background thread, at most once per interval and only if something changed, so
+ * an estimation never waits on the disk. The file is replaced atomically, so a crash
+ * while it's being written leaves the previous checkpoint intact.
+ *
+ * Besides the completed results the checkpoint keeps the seed of the run's random
+ * starting points, so a resumed run redraws the same starting points for the starts
+ * that hadn't finished, and the best parameters found so far by each start that's
+ * still running, so a resumed start can continue from them.
+ */
+class nmfEstimationCheckpoint
+{
+private:
+    std::string    m_FileName;
+    std::string    m_Key;
+    unsigned long  m_IntervalMilliseconds;
+    unsigned       m_Seed;
+    bool           m_IsDirty;
+    bool           m_IsStopping;
+    QMutex         m_Mutex;
+    QWaitCondition m_Wake;
+    std::thread    m_Writer;
+    std::map<int,nmfCheckpointResult> m_Results;
+    std::map<int,nmfCheckpointResult> m_InProgress;
+
+    static void writeResult(std::ostringstream&        stream,
+                            const std::string&         label,
+                            const nmfCheckpointResult& Result) {
+        stream << label << " " << Result.RunNum << " " << Result.Fitness << " "
+               << Result.NumEvaluations << " " << Result.Parameters.size();
+        for (const double& parameter : Result.Parameters) {
+            stream << " " << parameter;
+        }
+        stream << "\n";
+    }
+
+    static bool readResult(std::istringstream&  stream,
+                           nmfCheckpointResult& Result) {
+        unsigned NumParameters = 0;
+        stream >> Result.RunNum >> Result.Fitness >> Result.NumEvaluations >> NumParameters;
+        Result.Parameters.assign(NumParameters,0.0);
+        for (double& parameter : Result.Parameters) {
+            stream >> parameter;
+        }
+        return ! stream.fail();
+    }
+
+    // Writes a snapshot taken under the mutex so the estimation threads aren't held up
+    bool write() {
+        std::ostringstream stream;
+        std::map<int,nmfCheckpointResult> Results;
+        std::map<int,nmfCheckpointResult> InProgress;
+        {
+            QMutexLocker locker(&m_Mutex);
+            Results    = m_Results;
+            InProgress = m_InProgress;
+            m_IsDirty  = false;
+        }
+
+        stream << std::setprecision(17);
+        stream << "MSSPM Estimation Checkpoint\n";
+        stream << "Key " << m_Key << "\n";
+        stream << "Seed " << m_Seed << "\n";
+        for (const auto& item : Results) {
+            writeResult(stream,"Result",item.second);
+        }
+        for (const auto& item : InProgress) {
+            writeResult(stream,"InProgress",item.second);
+        }
+
+        QSaveFile file(QString::fromStdString(m_FileName));
+        if (! file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            return false;
+        }
+        file.write(stream.str().c_str());
+        return file.commit();
+    }
+
+public:
+    /**
+     * @brief nmfEstimationCheckpoint : class constructor
+     * @param FileName : the checkpoint file
+     * @param Key : describes the run, a checkpoint is only resumed by a run with the same key
+     * @param IntervalSeconds : minimum time between writes of the checkpoint file
+     */
+    nmfEstimationCheckpoint(const std::string& FileName,
+                            const std::string& Key,
+                            const int&         IntervalSeconds = 30)
+        : m_FileName(FileName),
+          m_Key(Key),
+          m_IntervalMilliseconds(1000*std::max(1,IntervalSeconds)),
+          m_Seed(0),
+          m_IsDirty(false),
+          m_IsStopping(false) {}
+   ~nmfEstimationCheckpoint() {
+        stop();
+    }
+
+    /**
+     * @brief Builds the key of an estimation run. It's the hash of every input of the
+     * estimation (see nmfEstimationHash), so a changed System, parameter range or
+     * estimation setting doesn't resume a stale run.
+     * @param Algorithm : name of the estimation algorithm
+     * @param dataStruct : the data structure describing the model to estimate
+     * @param InitialParameters : the warm start parameters (empty for a cold start)
+     * @return Returns the key
+     */
+    static std::string key(const std::string&         Algorithm,
+                           const Data_Struct&         dataStruct,
+                           const std::vector<double>& InitialParameters) {
+        return nmfEstimationHash::hash(Algorithm,dataStruct,InitialParameters);
+    }
+
+    /**
+     * @brief Loads the checkpoint file, if it was written by a run with the same key
+     * @return Returns false if there's no checkpoint file or it belongs to a different run
+     */
+    bool load() {
+        bool isMatch = false;
+        std::string line;
+        std::string label;
+        std::ifstream file(m_FileName);
+        nmfCheckpointResult result;
+        QMutexLocker locker(&m_Mutex);
+
+        m_Results.clear();
+        m_InProgress.clear();
+        while (std::getline(file,line)) {
+            std::istringstream stream(line);
+            stream >> label;
+            if (label == "Key") {
+                isMatch = (line.size() > 4) && (line.substr(4) == m_Key);
+                if (! isMatch) {
+                    break;
+                }
+            } else if (isMatch && (label == "Seed")) {
+                stream >> m_Seed;
+            } else if (isMatch && (label == "Result") && readResult(stream,result)) {
+                m_Results[result.RunNum] = result;
+            } else if (isMatch && (label == "InProgress") && readResult(stream,result)) {
+                m_InProgress[result.RunNum] = result;
+            }
+        }
+        if (! isMatch) {
+            m_Results.clear();
+            m_InProgress.clear();
+        }
+        return isMatch;
+    }
+    /**
+     * @brief Gets the seed of the run's random starting points
+     */
+    unsigned getSeed() {
+        QMutexLocker locker(&m_Mutex);
+        return m_Seed;
+    }
+    /**
+     * @brief Sets the seed of the run's random starting points (call before start)
+     * @param Seed : the seed
+     */
+    void setSeed(const unsigned& Seed) {
+        QMutexLocker locker(&m_Mutex);
+        m_Seed = Seed;
+    }
+    /**
+     * @brief Gets the number of completed results
+     */
+    int getNumResults() {
+        QMutexLocker locker(&m_Mutex);
+        return m_Results.size();
+    }
+    /**
+     * @brief Gets a completed result
+     * @param RunNum : the 1 based start or sub run number
+     * @param Result : the result, if it was completed
+     * @return Returns false if the start or sub run hadn't completed
+     */
+    bool getResult(const int&           RunNum,
+                   nmfCheckpointResult& Result) {
+        QMutexLocker locker(&m_Mutex);
+        auto item = m_Results.find(RunNum);
+        if (item == m_Results.end()) {
+            return false;
+        }
+        Result = item->second;
+        return true;
+    }
+    /**
+     * @brief Adds a completed result, it's saved by the next write (any thread)
+     * @param Result : the completed result
+     */
+    void addResult(const nmfCheckpointResult& Result) {
+        QMutexLocker locker(&m_Mutex);
+        m_Results[Result.RunNum] = Result;
+        m_InProgress.erase(Result.RunNum);
+        m_IsDirty = true;
+    }
+    /**
+     * @brief Gets the best parameters found so far by a start or sub run that hadn't completed
+     * @param RunNum : the 1 based start or sub run number
+     * @param Result : the best parameters and their fitness, if any were saved
+     * @return Returns false if nothing was saved for the start or sub run
+     */
+    bool getInProgress(const int&           RunNum,
+                       nmfCheckpointResult& Result) {
+        QMutexLocker locker(&m_Mutex);
+        auto item = m_InProgress.find(RunNum);
+        if (item == m_InProgress.end()) {
+            return false;
+        }
+        Result = item->second;
+        return true;
+    }
+    /**
+     * @brief Sets the best parameters found so far by a running start or sub run, they're
+     * saved by the next write (any thread). Completing the start or sub run replaces them.
+     * @param Result : the best parameters and their fitness so far
+     */
+    void setInProgress(const nmfCheckpointResult& Result) {
+        QMutexLocker locker(&m_Mutex);
+        if (m_Results.find(Result.RunNum) == m_Results.end()) {
+            m_InProgress[Result.RunNum] = Result;
+            m_IsDirty = true;
+        }
+    }
+    /**
+     * @brief Writes the checkpoint and starts the background writer
+     */
+    void start() {
+        write();
+        m_IsStopping = false;
+        m_Writer = std::thread([this]() {
+            QMutexLocker locker(&m_Mutex);
+            while (! m_IsStopping) {
+                m_Wake.wait(&m_Mutex,m_IntervalMilliseconds);
+                if (m_IsDirty && ! m_IsStopping) {
+                    locker.unlock();
+                    write();
+                    locker.relock();
+                }
+            }
+        });
+    }
+    /**
+     * @brief Stops the background writer and writes any results it hadn't saved yet
+     */
+    void stop() {
+        if (! m_Writer.joinable()) {
+            return;
+        }
+        {
+            QMutexLocker locker(&m_Mutex);
+            m_IsStopping = true;
+            m_Wake.wakeAll();
+        }
+        m_Writer.join();
+        if (m_IsDirty) {
+            write();
+        }
+    }
+    /**
+     * @brief Stops the background writer and deletes the checkpoint file (i.e., once
+     * the run has completed there's nothing left to resume)
+     */
+    void remove() {
+        stop();
+        QFile::remove(QString::fromStdString(m_FileName));
+    }
+};
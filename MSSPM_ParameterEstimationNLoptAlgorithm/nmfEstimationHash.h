@@ -0,0 +1,163 @@
+/**
+ * @file nmfEstimationHash.h
+ * @brief Definition of the hash of an estimation's inputs
+ *
+ * The hash identifies an estimation by everything that determines its result: the
+ * model forms, the estimation settings, the parameter ranges, the observed data and
+ * any warm start parameters. It keys both the cache of estimation results and the
+ * checkpoints of interrupted runs.
+ *
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include "nmfUtils.h"
+
+#include <QCryptographicHash>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hashes the inputs of an estimation with SHA-1
+ */
+class nmfEstimationHash
+{
+private:
+    // Each value is hashed with its size so that differently sized inputs never collide
+    static void addValue(QCryptographicHash& hasher, const int& value) {
+        hasher.addData(reinterpret_cast<const char*>(&value),sizeof(value));
+    }
+    static void addValue(QCryptographicHash& hasher, const std::string& value) {
+        addValue(hasher,int(value.size()));
+        hasher.addData(value.data(),int(value.size()));
+    }
+    static void addValue(QCryptographicHash& hasher, const double& value) {
+        hasher.addData(reinterpret_cast<const char*>(&value),sizeof(value));
+    }
+    static void addValue(QCryptographicHash& hasher, const std::vector<double>& values) {
+        addValue(hasher,int(values.size()));
+        for (const double& value : values) {
+            addValue(hasher,value);
+        }
+    }
+    static void addValue(QCryptographicHash& hasher, const std::vector<std::vector<double> >& values) {
+        addValue(hasher,int(values.size()));
+        for (const std::vector<double>& row : values) {
+            addValue(hasher,row);
+        }
+    }
+    static void addValue(QCryptographicHash& hasher, const boost::numeric::ublas::vector<double>& values) {
+        addValue(hasher,int(values.size()));
+        for (unsigned i=0; i<values.size(); ++i) {
+            addValue(hasher,values(i));
+        }
+    }
+    static void addValue(QCryptographicHash& hasher, const boost::numeric::ublas::matrix<double>& values) {
+        addValue(hasher,int(values.size1()));
+        addValue(hasher,int(values.size2()));
+        for (unsigned i=0; i<values.size1(); ++i) {
+            for (unsigned j=0; j<values.size2(); ++j) {
+                addValue(hasher,values(i,j));
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Hashes the inputs of an estimation. The estimations have no random seed
+     * setting, so two runs with the same hash are interchangeable realizations.
+     * @param Algorithm : name of the estimation algorithm
+     * @param dataStruct : the data structure describing the model to estimate
+     * @param InitialParameters : the warm start parameters (empty for a cold start)
+     * @return Returns the hash as a hex string
+     */
+    static std::string hash(const std::string&         Algorithm,
+                            const Data_Struct&         dataStruct,
+                            const std::vector<double>& InitialParameters) {
+        // Incremented whenever the fitness of the same inputs changes, so stored
+        // results computed the old way aren't reused
+        const int FitnessVersion = 2;
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+
+        addValue(hasher,FitnessVersion);
+
+        // Model and estimation settings
+        for (const std::string* value : {&Algorithm,
+                                         &dataStruct.GrowthForm, &dataStruct.HarvestForm,
+                                         &dataStruct.CompetitionForm, &dataStruct.PredationForm,
+                                         &dataStruct.Minimizer, &dataStruct.ObjectiveCriterion,
+                                         &dataStruct.Scaling}) {
+            addValue(hasher,*value);
+        }
+        for (const int* value : {&dataStruct.RunLength, &dataStruct.NumSpecies, &dataStruct.NumGuilds,
+                                 &dataStruct.TotalNumberParameters,
+                                 &dataStruct.BeesNumTotal, &dataStruct.BeesNumElite,
+                                 &dataStruct.BeesNumOther, &dataStruct.BeesNumEliteSites,
+                                 &dataStruct.BeesNumBestSites, &dataStruct.BeesNumRepetitions,
+                                 &dataStruct.BeesMaxGenerations,
+                                 &dataStruct.NLoptUseStopVal, &dataStruct.NLoptUseStopAfterTime,
+                                 &dataStruct.NLoptUseStopAfterIter, &dataStruct.NLoptStopAfterTime,
+                                 &dataStruct.NLoptStopAfterIter}) {
+            addValue(hasher,*value);
+        }
+        addValue(hasher,double(dataStruct.BeesNeighborhoodSize));
+        addValue(hasher,dataStruct.NLoptStopVal);
+        addValue(hasher,int(dataStruct.GuildNum.size()));
+        for (const int& guild : dataStruct.GuildNum) {
+            addValue(hasher,guild);
+        }
+
+        // Parameter ranges
+        for (const boost::numeric::ublas::vector<double>* values :
+             {&dataStruct.GrowthRateMin, &dataStruct.GrowthRateMax,
+              &dataStruct.CarryingCapacityInitial,
+              &dataStruct.CarryingCapacityMin, &dataStruct.CarryingCapacityMax,
+              &dataStruct.ExploitationRateMin, &dataStruct.ExploitationRateMax,
+              &dataStruct.CatchabilityMin, &dataStruct.CatchabilityMax}) {
+            addValue(hasher,*values);
+        }
+        for (const std::vector<std::vector<double> >* values :
+             {&dataStruct.CompetitionMin, &dataStruct.CompetitionMax,
+              &dataStruct.CompetitionBetaSpeciesMin, &dataStruct.CompetitionBetaSpeciesMax,
+              &dataStruct.CompetitionBetaGuildsMin, &dataStruct.CompetitionBetaGuildsMax,
+              &dataStruct.PredationMin, &dataStruct.PredationMax,
+              &dataStruct.HandlingMin, &dataStruct.HandlingMax}) {
+            addValue(hasher,*values);
+        }
+        addValue(hasher,dataStruct.ExponentMin);
+        addValue(hasher,dataStruct.ExponentMax);
+
+        // Observed data
+        for (const boost::numeric::ublas::matrix<double>* values :
+             {&dataStruct.ObservedBiomassBySpecies, &dataStruct.ObservedBiomassByGuilds,
+              &dataStruct.Catch, &dataStruct.Effort, &dataStruct.Exploitation}) {
+            addValue(hasher,*values);
+        }
+
+        addValue(hasher,InitialParameters);
+
+        return hasher.result().toHex().toStdString();
+    }
+};
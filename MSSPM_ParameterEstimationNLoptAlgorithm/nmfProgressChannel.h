@@ -0,0 +1,158 @@
+/**
+ * @file nmfProgressChannel.h
+ * @brief Definition of the in-process estimation progress channel
+ *
+ * The estimation threads push (run, evaluation, fitness) samples into the channel and
+ * the GUI thread drains them on its progress timer. Each producer (i.e., each NLopt
+ * start) has its own single-producer/single-consumer ring, so pushing a sample is a
+ * couple of atomic operations and never blocks or touches the disk.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief One progress chart sample
+ */
+struct nmfProgressSample {
+    int    RunNum     = 0;
+    int    StartNum   = 0;
+    int    Evaluation = 0;
+    double Fitness    = 0; // as plotted (i.e., Model Efficiency is already negated back)
+};
+
+/**
+ * @brief Fixed size, lock free single-producer/single-consumer ring of progress samples
+ *
+ * If the consumer falls behind and the ring fills up, new samples are dropped
+ * (and counted) rather than blocking the producer.
+ */
+class nmfProgressRing
+{
+private:
+    static const unsigned Capacity = 1024; // must be a power of 2
+    std::array<nmfProgressSample,Capacity> m_Samples;
+    std::atomic<unsigned> m_Head; // next sample to pop, only written by the consumer
+    std::atomic<unsigned> m_Tail; // next sample to push, only written by the producer
+    std::atomic<unsigned> m_NumDropped;
+
+public:
+    nmfProgressRing() : m_Head(0), m_Tail(0), m_NumDropped(0) {}
+
+    /**
+     * @brief Adds a sample (producer thread only)
+     * @param sample : the sample to add
+     * @return Returns false if the ring was full and the sample was dropped
+     */
+    bool push(const nmfProgressSample& sample) {
+        unsigned tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_Head.load(std::memory_order_acquire) >= Capacity) {
+            m_NumDropped.fetch_add(1,std::memory_order_relaxed);
+            return false;
+        }
+        m_Samples[tail & (Capacity-1)] = sample;
+        m_Tail.store(tail+1,std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief Removes the oldest sample (consumer thread only)
+     * @param sample : the removed sample
+     * @return Returns false if the ring was empty
+     */
+    bool pop(nmfProgressSample& sample) {
+        unsigned head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        sample = m_Samples[head & (Capacity-1)];
+        m_Head.store(head+1,std::memory_order_release);
+        return true;
+    }
+    /**
+     * @brief Gets the number of samples dropped because the ring was full
+     */
+    unsigned numDropped() const {
+        return m_NumDropped.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief The set of progress rings for one estimation run, one per producer
+ *
+ * The mutex only guards resizing the set of rings against a concurrent drain.
+ * Producers never take it: reset() must be called before the producers start.
+ */
+class nmfProgressChannel
+{
+private:
+    QMutex                                        m_Mutex;
+    std::vector<std::unique_ptr<nmfProgressRing> > m_Rings;
+
+public:
+    /**
+     * @brief Replaces the rings with empty ones (call before the producers start)
+     * @param NumProducers : number of producer threads
+     */
+    void reset(const int& NumProducers) {
+        QMutexLocker locker(&m_Mutex);
+        m_Rings.clear();
+        for (int i=0; i<NumProducers; ++i) {
+            m_Rings.push_back(std::make_unique<nmfProgressRing>());
+        }
+    }
+    /**
+     * @brief Gets the ring of a producer
+     * @param Producer : index of the producer (0 based)
+     * @return Returns the producer's ring (or nullptr if there's no such producer)
+     */
+    nmfProgressRing* ring(const int& Producer) {
+        QMutexLocker locker(&m_Mutex);
+        return ((Producer >= 0) && (Producer < int(m_Rings.size()))) ?
+                    m_Rings[Producer].get() : nullptr;
+    }
+    /**
+     * @brief Removes all of the available samples (consumer thread only)
+     * @param Samples : the samples are appended here, in producer order
+     * @return Returns the number of samples removed
+     */
+    int drain(std::vector<nmfProgressSample>& Samples) {
+        int NumSamples = 0;
+        nmfProgressSample sample;
+        QMutexLocker locker(&m_Mutex);
+        for (std::unique_ptr<nmfProgressRing>& ring : m_Rings) {
+            while (ring->pop(sample)) {
+                Samples.push_back(sample);
+                ++NumSamples;
+            }
+        }
+        return NumSamples;
+    }
+};
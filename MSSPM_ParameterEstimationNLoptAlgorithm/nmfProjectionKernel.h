@@ -0,0 +1,984 @@
+/**
+ * @file nmfProjectionKernel.h
+ * @brief Definition of the biomass projection kernel
+ *
+ * This file contains the biomass projection kernel used by the estimation objective
+ * functions and by the forecasts. The kernel is a template specialized on the model
+ * form combination (growth, harvest, competition, predation). The specialization is
+ * chosen once per run from the model form names, so the innermost time/species loop
+ * contains no string comparisons or virtual calls. The kernel is also templated on
+ * the scalar type, so it can be run with an automatic differentiation scalar to get
+ * the gradient of the projected biomass with respect to the model parameters.
+ *
+ * The species interactions (competition and predation) are visited through sparse
+ * interaction patterns, so that a large food web in which most pairs of species
+ * don't interact only costs as much per time step as its interacting pairs.
+ *
+ * Each time step is computed for all of the species at once: the interaction terms
+ * are matrix-vector products over the contiguous biomass row of the previous year,
+ * after which the growth, harvest and update are an elementwise pass over the species.
+ * When built with MSSPM_EIGEN (qmake CONFIG+=eigen) the dense products of the double
+ * kernels are done by Eigen, which vectorizes them with SIMD instructions.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <boost/numeric/ublas/matrix.hpp>
+#ifdef MSSPM_EIGEN
+#include <Eigen/Core>
+#endif
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The model parameters that the projection kernel runs with
+ */
+template <class T>
+struct nmfProjectionParametersT {
+    std::vector<T>                   GrowthRate;
+    std::vector<T>                   CarryingCapacity;
+    std::vector<T>                   Catchability;
+    std::vector<T>                   Exponent;
+    boost::numeric::ublas::matrix<T> CompetitionAlpha;
+    boost::numeric::ublas::matrix<T> CompetitionBetaSpecies;
+    boost::numeric::ublas::matrix<T> CompetitionBetaGuilds;
+    boost::numeric::ublas::matrix<T> Predation;
+    boost::numeric::ublas::matrix<T> Handling;
+};
+typedef nmfProjectionParametersT<double> nmfProjectionParameters;
+
+/**
+ * @brief The structure of a sparse interaction matrix in compressed sparse row (CSR)
+ * form. The columns of row i are Column[RowStart[i]] through Column[RowStart[i+1]-1],
+ * in increasing order. Only the structure is kept here, the values stay in the parameter
+ * matrices.
+ */
+struct nmfInteractionPattern {
+    std::vector<int> RowStart;
+    std::vector<int> Column;
+};
+
+/**
+ * @brief The inputs to the projection kernel that stay constant for an entire run
+ */
+struct nmfProjectionSystem {
+    int  NumYears           = 0;
+    int  NumSpeciesOrGuilds = 0;
+    int  NumGuilds          = 0;
+    bool isAggProd          = false;
+    const boost::numeric::ublas::matrix<double>* Catch        = nullptr;
+    const boost::numeric::ublas::matrix<double>* Effort       = nullptr;
+    const boost::numeric::ublas::matrix<double>* Exploitation = nullptr;
+    std::vector<std::vector<int> > GuildSpecies; // species indices in each guild
+    std::vector<int>               GuildNum;     // guild index of each species (or guild)
+    // The pairs of species visited by the interaction terms (every pair unless narrowed
+    // by initializeInteractions). The predator pattern is the transpose of the predation
+    // pattern and is used for the Type II/III denominators.
+    nmfInteractionPattern          CompetitionPattern;  // alpha(i,j) of NO_K
+    nmfInteractionPattern          BetaSpeciesPattern;  // beta(i,j) of MS-PROD, j in the guild of i
+    nmfInteractionPattern          PredationPattern;    // rho(i,j) by prey i
+    nmfInteractionPattern          PredatorPattern;     // rho(k,j) by predator j
+    // Optional check called with the species biomass after each projected year (only by
+    // the double kernels). If it returns true the projection stops and returns false.
+    bool (*StopAfterYear)(const boost::numeric::ublas::matrix<double>& BiomassSpecies,
+                          int time, void* data) = nullptr;
+    void* StopAfterYearData = nullptr;
+};
+
+/**
+ * @brief Scratch space reused by the projection kernel between calls
+ */
+template <class T>
+struct nmfProjectionScratchT {
+    T              SystemCarryingCapacity = 0;
+    std::vector<T> GuildCarryingCapacity;
+    std::vector<T> PredationDenominator;
+    std::vector<T> ExponentBiomass;
+    // Interaction values in the order of the system's interaction patterns (set once per projection)
+    std::vector<T> CompetitionValues;       // alpha (NO_K) or the species beta (MS-PROD)
+    std::vector<T> GuildCompetitionValues;  // guild beta, (NumSpeciesOrGuilds x NumGuilds)
+    std::vector<T> PredationValues;         // rho by prey
+    std::vector<T> HandlingPredationValues; // handling*rho by predator
+    // Interaction sums of every species for the current time step
+    std::vector<T> CompetitionSum;
+    std::vector<T> GuildCompetitionSum;
+    std::vector<T> PredationSum;
+    std::vector<T> PreyBiomass;             // biomass over the Type II/III denominator
+};
+typedef nmfProjectionScratchT<double> nmfProjectionScratch;
+
+
+namespace nmfProjectionKernel {
+
+typedef boost::numeric::ublas::matrix<double> Matrix;
+
+/**
+ * @brief The kernel types for a scalar type
+ */
+template <class T>
+struct Types {
+    typedef boost::numeric::ublas::matrix<T> Matrix;
+    /**
+     * @brief Signature shared by all of the kernel specializations
+     * @param System : the run constant inputs
+     * @param Parameters : the model parameters
+     * @param Scratch : scratch space (sized on first use)
+     * @param BiomassSpecies : estimated biomass (NumYears x NumSpeciesOrGuilds) with row 0 set to the initial biomass
+     * @param BiomassGuilds : estimated guild biomass (NumYears x NumGuilds), filled in by the kernel
+     * @return Returns false if a negative or NaN biomass was found (only when not clamping to zero)
+     * or if the system's StopAfterYear check stopped the projection
+     */
+    typedef bool (*ProjectionFunction)(const nmfProjectionSystem&         System,
+                                       const nmfProjectionParametersT<T>& Parameters,
+                                       nmfProjectionScratchT<T>&          Scratch,
+                                       Matrix&                            BiomassSpecies,
+                                       Matrix&                            BiomassGuilds);
+};
+typedef Types<double>::ProjectionFunction ProjectionFunction;
+
+/**
+ * @brief Gets the value of a scalar (other scalar types provide their own overload)
+ */
+inline double
+scalarValue(const double& value)
+{
+    return value;
+}
+
+/**
+ * @brief Builds an interaction pattern from the pairs for which Include(i,j) is true
+ * @param NumRows : number of rows (and columns) of the interaction matrix
+ * @param Include : predicate that is true for the pairs that interact
+ * @param Pattern : the interaction pattern
+ */
+template <class F>
+void
+buildPattern(const int&             NumRows,
+             F                      Include,
+             nmfInteractionPattern& Pattern)
+{
+    Pattern.RowStart.assign(1,0);
+    Pattern.Column.clear();
+    for (int i=0; i<NumRows; ++i) {
+        for (int j=0; j<NumRows; ++j) {
+            if (Include(i,j)) {
+                Pattern.Column.push_back(j);
+            }
+        }
+        Pattern.RowStart.push_back(Pattern.Column.size());
+    }
+}
+
+/**
+ * @brief Builds the transpose of an interaction pattern (columns stay in increasing order)
+ * @param NumRows : number of rows (and columns) of the interaction matrix
+ * @param Pattern : the interaction pattern
+ * @param Transpose : the transposed interaction pattern
+ */
+inline void
+transposePattern(const int&                   NumRows,
+                 const nmfInteractionPattern& Pattern,
+                 nmfInteractionPattern&       Transpose)
+{
+    std::vector<int> next;
+
+    Transpose.RowStart.assign(NumRows+1,0);
+    Transpose.Column.assign(Pattern.Column.size(),0);
+    for (int j : Pattern.Column) {
+        ++Transpose.RowStart[j+1];
+    }
+    for (int j=0; j<NumRows; ++j) {
+        Transpose.RowStart[j+1] += Transpose.RowStart[j];
+    }
+    next.assign(Transpose.RowStart.begin(),Transpose.RowStart.end()-1);
+    for (int i=0; i<NumRows; ++i) {
+        for (int k=Pattern.RowStart[i]; k<Pattern.RowStart[i+1]; ++k) {
+            Transpose.Column[next[Pattern.Column[k]]++] = i;
+        }
+    }
+}
+
+/**
+ * @brief Gets the number of interacting pairs in a pattern
+ */
+inline int
+numInteractions(const nmfInteractionPattern& Pattern)
+{
+    return Pattern.Column.size();
+}
+
+/**
+ * @brief Sets up the system structure for a run
+ * @param NumYears : number of years to project (including the initial year)
+ * @param NumSpeciesOrGuilds : number of species (or guilds if running AGG-PROD)
+ * @param NumGuilds : number of guilds
+ * @param isAggProd : true if the competition form is AGG-PROD
+ * @param GuildSpecies : map of guild index to the species indices in the guild
+ * @param Catch : catch time series (only referenced, must outlive the system)
+ * @param Effort : effort time series (only referenced, must outlive the system)
+ * @param Exploitation : exploitation time series (only referenced, must outlive the system)
+ * @param System : the system structure to initialize
+ */
+inline void
+initializeSystem(const int&                              NumYears,
+                 const int&                              NumSpeciesOrGuilds,
+                 const int&                              NumGuilds,
+                 const bool&                             isAggProd,
+                 const std::map<int,std::vector<int> >&  GuildSpecies,
+                 const Matrix&                           Catch,
+                 const Matrix&                           Effort,
+                 const Matrix&                           Exploitation,
+                 nmfProjectionSystem&                    System)
+{
+    std::map<int,std::vector<int> >::const_iterator guildIt;
+
+    System.NumYears           = NumYears;
+    System.NumSpeciesOrGuilds = NumSpeciesOrGuilds;
+    System.NumGuilds          = NumGuilds;
+    System.isAggProd          = isAggProd;
+    System.Catch              = &Catch;
+    System.Effort             = &Effort;
+    System.Exploitation       = &Exploitation;
+
+    System.GuildSpecies.assign(NumGuilds,std::vector<int>());
+    System.GuildNum.assign(NumSpeciesOrGuilds,0);
+    if (isAggProd) {
+        for (int i=0; i<NumSpeciesOrGuilds; ++i) {
+            System.GuildNum[i] = i;
+            if (i < NumGuilds) {
+                System.GuildSpecies[i].push_back(i);
+            }
+        }
+    } else {
+        for (int i=0; i<NumGuilds; ++i) {
+            guildIt = GuildSpecies.find(i);
+            if (guildIt != GuildSpecies.end()) {
+                System.GuildSpecies[i] = guildIt->second;
+                for (int species : guildIt->second) {
+                    if ((species >= 0) && (species < NumSpeciesOrGuilds)) {
+                        System.GuildNum[species] = i;
+                    }
+                }
+            }
+        }
+    }
+
+    // Every pair interacts until the interactions are narrowed
+    buildPattern(NumSpeciesOrGuilds,[](int i, int j) { return true; },System.CompetitionPattern);
+    buildPattern(NumSpeciesOrGuilds,[](int i, int j) { return true; },System.PredationPattern);
+    buildPattern(NumSpeciesOrGuilds,[](int i, int j) { return true; },System.PredatorPattern);
+    buildPattern(NumSpeciesOrGuilds,[&](int i, int j) {
+        return ! isAggProd && (System.GuildNum[i] == System.GuildNum[j]);
+    },System.BetaSpeciesPattern);
+}
+
+/**
+ * @brief Narrows the system's interaction patterns to the pairs whose parameter range
+ * isn't fixed at zero (i.e., both its min and max are 0). A range that doesn't cover
+ * every pair leaves its pattern as is.
+ * @param CompetitionMin : min of the NO_K competition parameters (alpha)
+ * @param CompetitionMax : max of the NO_K competition parameters (alpha)
+ * @param BetaSpeciesMin : min of the MS-PROD species competition parameters (beta)
+ * @param BetaSpeciesMax : max of the MS-PROD species competition parameters (beta)
+ * @param PredationMin : min of the predation parameters (rho)
+ * @param PredationMax : max of the predation parameters (rho)
+ * @param System : the system structure, set up by initializeSystem
+ */
+inline void
+initializeInteractions(const std::vector<std::vector<double> >& CompetitionMin,
+                       const std::vector<std::vector<double> >& CompetitionMax,
+                       const std::vector<std::vector<double> >& BetaSpeciesMin,
+                       const std::vector<std::vector<double> >& BetaSpeciesMax,
+                       const std::vector<std::vector<double> >& PredationMin,
+                       const std::vector<std::vector<double> >& PredationMax,
+                       nmfProjectionSystem&                     System)
+{
+    int N = System.NumSpeciesOrGuilds;
+    auto coversAllPairs = [N](const std::vector<std::vector<double> >& Range) {
+        if (int(Range.size()) < N) {
+            return false;
+        }
+        for (int i=0; i<N; ++i) {
+            if (int(Range[i].size()) < N) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto inRange = [](const std::vector<std::vector<double> >& Min,
+                      const std::vector<std::vector<double> >& Max,
+                      int i, int j) {
+        return (Min[i][j] != 0) || (Max[i][j] != 0);
+    };
+
+    if (coversAllPairs(CompetitionMin) && coversAllPairs(CompetitionMax)) {
+        buildPattern(N,[&](int i, int j) {
+            return inRange(CompetitionMin,CompetitionMax,i,j);
+        },System.CompetitionPattern);
+    }
+    if (coversAllPairs(BetaSpeciesMin) && coversAllPairs(BetaSpeciesMax) && ! System.isAggProd) {
+        buildPattern(N,[&](int i, int j) {
+            return (System.GuildNum[i] == System.GuildNum[j]) &&
+                    inRange(BetaSpeciesMin,BetaSpeciesMax,i,j);
+        },System.BetaSpeciesPattern);
+    }
+    if (coversAllPairs(PredationMin) && coversAllPairs(PredationMax)) {
+        buildPattern(N,[&](int i, int j) {
+            return inRange(PredationMin,PredationMax,i,j);
+        },System.PredationPattern);
+        transposePattern(N,System.PredationPattern,System.PredatorPattern);
+    }
+}
+
+/**
+ * @brief Narrows the system's interaction patterns to the pairs with non-zero parameters.
+ * This is for projecting a fixed set of parameters (e.g., an estimate or a forecast).
+ * A matrix that doesn't cover every pair leaves its pattern as is.
+ * @param Parameters : the model parameters
+ * @param System : the system structure, set up by initializeSystem
+ */
+template <class T>
+void
+initializeInteractions(const nmfProjectionParametersT<T>& Parameters,
+                       nmfProjectionSystem&               System)
+{
+    int N = System.NumSpeciesOrGuilds;
+    auto coversAllPairs = [N](const typename Types<T>::Matrix& Values) {
+        return (int(Values.size1()) >= N) && (int(Values.size2()) >= N);
+    };
+
+    if (coversAllPairs(Parameters.CompetitionAlpha)) {
+        buildPattern(N,[&](int i, int j) {
+            return (scalarValue(Parameters.CompetitionAlpha(i,j)) != 0);
+        },System.CompetitionPattern);
+    }
+    if (coversAllPairs(Parameters.CompetitionBetaSpecies) && ! System.isAggProd) {
+        buildPattern(N,[&](int i, int j) {
+            return (System.GuildNum[i] == System.GuildNum[j]) &&
+                   (scalarValue(Parameters.CompetitionBetaSpecies(i,j)) != 0);
+        },System.BetaSpeciesPattern);
+    }
+    if (coversAllPairs(Parameters.Predation)) {
+        buildPattern(N,[&](int i, int j) {
+            return (scalarValue(Parameters.Predation(i,j)) != 0);
+        },System.PredationPattern);
+        transposePattern(N,System.PredationPattern,System.PredatorPattern);
+    }
+}
+
+
+// Growth forms
+
+struct GrowthNull {
+    template <class T>
+    static T term(const nmfProjectionParametersT<T>& P, int i, const T& Bi) {
+        return 0;
+    }
+};
+struct GrowthLinear {
+    template <class T>
+    static T term(const nmfProjectionParametersT<T>& P, int i, const T& Bi) {
+        return P.GrowthRate[i]*Bi;
+    }
+};
+struct GrowthLogistic {
+    template <class T>
+    static T term(const nmfProjectionParametersT<T>& P, int i, const T& Bi) {
+        return P.GrowthRate[i]*Bi*(1.0-Bi/P.CarryingCapacity[i]);
+    }
+};
+
+
+// Harvest forms
+
+struct HarvestNull {
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  int t, int i, const T& Bi) {
+        return 0;
+    }
+};
+struct HarvestCatch {
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  int t, int i, const T& Bi) {
+        return T((*S.Catch)(t,i));
+    }
+};
+struct HarvestEffort {
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  int t, int i, const T& Bi) {
+        return P.Catchability[i]*(*S.Effort)(t,i)*Bi;
+    }
+};
+struct HarvestExploitation {
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  int t, int i, const T& Bi) {
+        return (*S.Exploitation)(t,i)*Bi;
+    }
+};
+
+
+// Matrix-vector products of the interaction terms
+
+/**
+ * @brief Gets a pointer to the start of a row of a (row major) matrix
+ */
+template <class T>
+T*
+rowPointer(boost::numeric::ublas::matrix<T>& M,
+           int                               row)
+{
+    return M.data().begin() + std::size_t(row)*M.size2();
+}
+template <class T>
+const T*
+rowPointer(const boost::numeric::ublas::matrix<T>& M,
+           int                                     row)
+{
+    return M.data().begin() + std::size_t(row)*M.size2();
+}
+
+/**
+ * @brief Gathers the values of an interaction matrix in the order of its pattern
+ */
+template <class T>
+void
+gatherValues(const nmfInteractionPattern&     Pattern,
+             const typename Types<T>::Matrix& M,
+             std::vector<T>&                  Values)
+{
+    int NumRows = int(Pattern.RowStart.size())-1;
+
+    Values.resize(Pattern.Column.size());
+    for (int i=0; i<NumRows; ++i) {
+        for (int k=Pattern.RowStart[i]; k<Pattern.RowStart[i+1]; ++k) {
+            Values[k] = M(i,Pattern.Column[k]);
+        }
+    }
+}
+
+/**
+ * @brief Gathers the leading (NumRows x NumColumns) block of a matrix into contiguous values
+ */
+template <class T>
+void
+gatherValues(const int&                       NumRows,
+             const int&                       NumColumns,
+             const typename Types<T>::Matrix& M,
+             std::vector<T>&                  Values)
+{
+    Values.resize(std::size_t(NumRows)*NumColumns);
+    for (int i=0; i<NumRows; ++i) {
+        for (int j=0; j<NumColumns; ++j) {
+            Values[std::size_t(i)*NumColumns+j] = M(i,j);
+        }
+    }
+}
+
+/**
+ * @brief Dense matrix-vector product y = A*x with A a contiguous (row major) matrix
+ */
+template <class T>
+void
+multiplyDense(const T*   A,
+              const int& NumRows,
+              const int& NumColumns,
+              const T*   x,
+              T*         y)
+{
+    for (int i=0; i<NumRows; ++i) {
+        const T* a = A + std::size_t(i)*NumColumns;
+        T sum = 0;
+        for (int j=0; j<NumColumns; ++j) {
+            sum += a[j]*x[j];
+        }
+        y[i] = sum;
+    }
+}
+
+#ifdef MSSPM_EIGEN
+/**
+ * @brief Dense matrix-vector product y = A*x of the double kernels, vectorized by Eigen
+ */
+inline void
+multiplyDense(const double* A,
+              const int&    NumRows,
+              const int&    NumColumns,
+              const double* x,
+              double*       y)
+{
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMajorMatrix;
+
+    Eigen::Map<Eigen::VectorXd>(y,NumRows).noalias() =
+            Eigen::Map<const RowMajorMatrix>(A,NumRows,NumColumns)*
+            Eigen::Map<const Eigen::VectorXd>(x,NumColumns);
+}
+#endif
+
+/**
+ * @brief Sparse matrix-vector product y = A*x with A's values in the order of its pattern.
+ * A pattern with every pair is multiplied as a dense matrix.
+ */
+template <class T>
+void
+multiply(const nmfInteractionPattern& Pattern,
+         const std::vector<T>&        Values,
+         const int&                   NumColumns,
+         const T*                     x,
+         T*                           y)
+{
+    int NumRows = int(Pattern.RowStart.size())-1;
+
+    if (Values.size() == std::size_t(NumRows)*NumColumns) {
+        multiplyDense(Values.data(),NumRows,NumColumns,x,y);
+        return;
+    }
+    for (int i=0; i<NumRows; ++i) {
+        T sum = 0;
+        for (int k=Pattern.RowStart[i]; k<Pattern.RowStart[i+1]; ++k) {
+            sum += Values[k]*x[Pattern.Column[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+
+// Competition forms. The initialize() step is called once per projection to gather
+// the interaction values and the prepare() step once per time step to calculate the
+// interaction sums of all of the species from the previous year's biomass (b) and
+// guild biomass (bg).
+
+struct CompetitionNull {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {}
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, nmfProjectionScratchT<T>& W,
+                        const T* b, const T* bg) {}
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return 0;
+    }
+};
+struct CompetitionNoK {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        gatherValues(S.CompetitionPattern,P.CompetitionAlpha,W.CompetitionValues);
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, nmfProjectionScratchT<T>& W,
+                        const T* b, const T* bg) {
+        multiply(S.CompetitionPattern,W.CompetitionValues,S.NumSpeciesOrGuilds,b,W.CompetitionSum.data());
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return Bi*W.CompetitionSum[i];
+    }
+};
+struct CompetitionMsProd {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        gatherValues(S.BetaSpeciesPattern,P.CompetitionBetaSpecies,W.CompetitionValues);
+        gatherValues(S.NumSpeciesOrGuilds,S.NumGuilds,P.CompetitionBetaGuilds,W.GuildCompetitionValues);
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, nmfProjectionScratchT<T>& W,
+                        const T* b, const T* bg) {
+        multiply(S.BetaSpeciesPattern,W.CompetitionValues,S.NumSpeciesOrGuilds,b,W.CompetitionSum.data());
+        multiplyDense(W.GuildCompetitionValues.data(),S.NumSpeciesOrGuilds,S.NumGuilds,bg,W.GuildCompetitionSum.data());
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        int guild      = S.GuildNum[i];
+        T guildK       = W.GuildCarryingCapacity[guild];
+        T otherGuildsK = W.SystemCarryingCapacity - guildK;
+        T retv         = 0;
+        // A zero denominator only happens with a single guild (or no K), in which case that part has no effect
+        if (guildK != 0) {
+            retv += W.CompetitionSum[i]/guildK;
+        }
+        if (otherGuildsK != 0) {
+            retv -= W.GuildCompetitionSum[i]/otherGuildsK;
+        }
+        return P.GrowthRate[i]*Bi*retv;
+    }
+};
+struct CompetitionAggProd {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        gatherValues(S.NumSpeciesOrGuilds,S.NumGuilds,P.CompetitionBetaGuilds,W.GuildCompetitionValues);
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, nmfProjectionScratchT<T>& W,
+                        const T* b, const T* bg) {
+        multiplyDense(W.GuildCompetitionValues.data(),S.NumSpeciesOrGuilds,S.NumGuilds,bg,W.GuildCompetitionSum.data());
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        T otherGuildsK = W.SystemCarryingCapacity - W.GuildCarryingCapacity[i];
+        if (otherGuildsK == 0) {
+            return 0;
+        }
+        return P.GrowthRate[i]*Bi*(W.GuildCompetitionSum[i]/otherGuildsK);
+    }
+};
+
+
+// Predation forms, with the same initialize() and prepare() steps as the competition
+// forms. The Type II/III denominators only depend on the predator, so they're also
+// calculated once per time step.
+
+struct PredationNull {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {}
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                        nmfProjectionScratchT<T>& W, const T* b) {}
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return 0;
+    }
+};
+struct PredationTypeI {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        gatherValues(S.PredationPattern,P.Predation,W.PredationValues);
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                        nmfProjectionScratchT<T>& W, const T* b) {
+        multiply(S.PredationPattern,W.PredationValues,S.NumSpeciesOrGuilds,b,W.PredationSum.data());
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return Bi*W.PredationSum[i];
+    }
+};
+struct PredationTypeII {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        const nmfInteractionPattern& pattern = S.PredatorPattern;
+        gatherValues(S.PredationPattern,P.Predation,W.PredationValues);
+        W.HandlingPredationValues.resize(pattern.Column.size());
+        for (int j=0; j<S.NumSpeciesOrGuilds; ++j) {
+            for (int m=pattern.RowStart[j]; m<pattern.RowStart[j+1]; ++m) {
+                const int k = pattern.Column[m];
+                W.HandlingPredationValues[m] = P.Handling(k,j)*P.Predation(k,j);
+            }
+        }
+    }
+    // Calculates the sums of rho(i,j)*x(j)/(1 + sum over k of handling(k,j)*rho(k,j)*y(k))
+    template <class T>
+    static void prepareSums(const nmfProjectionSystem& S, nmfProjectionScratchT<T>& W,
+                            const T* x, const T* y) {
+        int N = S.NumSpeciesOrGuilds;
+        multiply(S.PredatorPattern,W.HandlingPredationValues,N,y,W.PredationDenominator.data());
+        for (int j=0; j<N; ++j) {
+            W.PredationDenominator[j] += 1.0;
+            W.PreyBiomass[j] = x[j]/W.PredationDenominator[j];
+        }
+        multiply(S.PredationPattern,W.PredationValues,N,W.PreyBiomass.data(),W.PredationSum.data());
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                        nmfProjectionScratchT<T>& W, const T* b) {
+        prepareSums(S,W,b,b);
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return Bi*W.PredationSum[i];
+    }
+};
+struct PredationTypeIII {
+    template <class T>
+    static void initialize(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                           nmfProjectionScratchT<T>& W) {
+        PredationTypeII::initialize(S,P,W);
+    }
+    template <class T>
+    static void prepare(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                        nmfProjectionScratchT<T>& W, const T* b) {
+        using std::pow;
+        for (int k=0; k<S.NumSpeciesOrGuilds; ++k) {
+            W.ExponentBiomass[k] = pow(b[k],P.Exponent[k]+1.0);
+        }
+        PredationTypeII::prepareSums(S,W,b,W.ExponentBiomass.data());
+    }
+    template <class T>
+    static T term(const nmfProjectionSystem& S, const nmfProjectionParametersT<T>& P,
+                  const nmfProjectionScratchT<T>& W, int i, const T& Bi) {
+        return W.ExponentBiomass[i]*W.PredationSum[i];
+    }
+};
+
+
+/**
+ * @brief Sizes the scratch space for the system (only allocates on first use)
+ */
+template <class T>
+void
+prepareScratch(const nmfProjectionSystem& S,
+               nmfProjectionScratchT<T>&  W)
+{
+    W.PredationDenominator.resize(S.NumSpeciesOrGuilds);
+    W.ExponentBiomass.resize(S.NumSpeciesOrGuilds);
+    W.CompetitionSum.resize(S.NumSpeciesOrGuilds);
+    W.GuildCompetitionSum.resize(S.NumSpeciesOrGuilds);
+    W.PredationSum.resize(S.NumSpeciesOrGuilds);
+    W.PreyBiomass.resize(S.NumSpeciesOrGuilds);
+}
+
+/**
+ * @brief Calculates the guild and system carrying capacities from the species carrying capacities
+ */
+template <class T>
+void
+prepareCarryingCapacities(const nmfProjectionSystem&         S,
+                          const nmfProjectionParametersT<T>& P,
+                          nmfProjectionScratchT<T>&          W)
+{
+    bool hasK = (int(P.CarryingCapacity.size()) >= S.NumSpeciesOrGuilds);
+
+    W.GuildCarryingCapacity.assign(S.NumGuilds,T(0));
+    W.SystemCarryingCapacity = 0;
+    if (! hasK) {
+        return;
+    }
+    for (int i=0; i<S.NumSpeciesOrGuilds; ++i) {
+        W.GuildCarryingCapacity[S.GuildNum[i]] += P.CarryingCapacity[i];
+        W.SystemCarryingCapacity += P.CarryingCapacity[i];
+    }
+}
+
+/**
+ * @brief Sums the species biomass into the guild biomass for the given year
+ */
+template <class T>
+void
+updateGuildBiomass(const nmfProjectionSystem&        S,
+                   const typename Types<T>::Matrix& B,
+                   typename Types<T>::Matrix&       BG,
+                   int                               time)
+{
+    for (int g=0; g<S.NumGuilds; ++g) {
+        T sum = 0;
+        for (int j : S.GuildSpecies[g]) {
+            sum += B(time,j);
+        }
+        BG(time,g) = sum;
+    }
+}
+
+/**
+ * @brief Runs the system's optional end of year check on the projected biomass
+ */
+inline bool
+stopAfterYear(const nmfProjectionSystem& S,
+              const Matrix&              B,
+              int                        time)
+{
+    return (S.StopAfterYear != nullptr) && S.StopAfterYear(B,time,S.StopAfterYearData);
+}
+
+/**
+ * @brief Other scalar types don't support the end of year check
+ */
+template <class M>
+bool
+stopAfterYear(const nmfProjectionSystem& S,
+              const M&                   B,
+              int                        time)
+{
+    return false;
+}
+
+/**
+ * @brief The projection kernel for one model form combination
+ */
+template <class T, class Growth, class Harvest, class Competition, class Predation, bool ClampToZero>
+bool
+project(const nmfProjectionSystem&         S,
+        const nmfProjectionParametersT<T>& P,
+        nmfProjectionScratchT<T>&          W,
+        typename Types<T>::Matrix&         B,
+        typename Types<T>::Matrix&         BG)
+{
+    const int N = S.NumSpeciesOrGuilds;
+    double value;
+
+    prepareScratch(S,W);
+    prepareCarryingCapacities(S,P,W);
+    Competition::initialize(S,P,W);
+    Predation::initialize(S,P,W);
+    updateGuildBiomass<T>(S,B,BG,0);
+
+    for (int time=1; time<S.NumYears; ++time) {
+        const int timeMinus1 = time-1;
+        const T* b  = rowPointer(B, timeMinus1);
+        const T* bg = rowPointer(BG,timeMinus1);
+        T* next     = rowPointer(B, time);
+
+        // The interaction sums of all of the species, then an elementwise update
+        Competition::prepare(S,W,b,bg);
+        Predation::prepare(S,P,W,b);
+        for (int i=0; i<N; ++i) {
+            next[i] = b[i] + Growth::term(P,i,b[i])
+                           - Harvest::term(S,P,timeMinus1,i,b[i])
+                           - Competition::term(S,P,W,i,b[i])
+                           - Predation::term(S,P,W,i,b[i]);
+        }
+        for (int i=0; i<N; ++i) {
+            value = scalarValue(next[i]);
+            if ((value < 0) || std::isnan(value)) {
+                if (! ClampToZero) {
+                    return false;
+                }
+                next[i] = 0;
+            }
+        }
+        updateGuildBiomass<T>(S,B,BG,time);
+        if (stopAfterYear(S,B,time)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+template <class T, class G, class H, class C, bool Clamp>
+typename Types<T>::ProjectionFunction
+selectPredation(const std::string& PredationForm)
+{
+    if (PredationForm == "Null")     return &project<T,G,H,C,PredationNull,   Clamp>;
+    if (PredationForm == "Type I")   return &project<T,G,H,C,PredationTypeI,  Clamp>;
+    if (PredationForm == "Type II")  return &project<T,G,H,C,PredationTypeII, Clamp>;
+    if (PredationForm == "Type III") return &project<T,G,H,C,PredationTypeIII,Clamp>;
+    return nullptr;
+}
+
+template <class T, class G, class H, bool Clamp>
+typename Types<T>::ProjectionFunction
+selectCompetition(const std::string& CompetitionForm,
+                  const std::string& PredationForm)
+{
+    if (CompetitionForm == "Null")     return selectPredation<T,G,H,CompetitionNull,   Clamp>(PredationForm);
+    if (CompetitionForm == "NO_K")     return selectPredation<T,G,H,CompetitionNoK,    Clamp>(PredationForm);
+    if (CompetitionForm == "MS-PROD")  return selectPredation<T,G,H,CompetitionMsProd, Clamp>(PredationForm);
+    if (CompetitionForm == "AGG-PROD") return selectPredation<T,G,H,CompetitionAggProd,Clamp>(PredationForm);
+    return nullptr;
+}
+
+template <class T, class G, bool Clamp>
+typename Types<T>::ProjectionFunction
+selectHarvest(const std::string& HarvestForm,
+              const std::string& CompetitionForm,
+              const std::string& PredationForm)
+{
+    if (HarvestForm == "Null")             return selectCompetition<T,G,HarvestNull,        Clamp>(CompetitionForm,PredationForm);
+    if (HarvestForm == "Catch")            return selectCompetition<T,G,HarvestCatch,       Clamp>(CompetitionForm,PredationForm);
+    if (HarvestForm == "Effort (qE)")      return selectCompetition<T,G,HarvestEffort,      Clamp>(CompetitionForm,PredationForm);
+    if (HarvestForm == "Exploitation (F)") return selectCompetition<T,G,HarvestExploitation,Clamp>(CompetitionForm,PredationForm);
+    return nullptr;
+}
+
+template <class T, bool Clamp>
+typename Types<T>::ProjectionFunction
+selectGrowth(const std::string& GrowthForm,
+             const std::string& HarvestForm,
+             const std::string& CompetitionForm,
+             const std::string& PredationForm)
+{
+    if (GrowthForm == "Null")     return selectHarvest<T,GrowthNull,    Clamp>(HarvestForm,CompetitionForm,PredationForm);
+    if (GrowthForm == "Linear")   return selectHarvest<T,GrowthLinear,  Clamp>(HarvestForm,CompetitionForm,PredationForm);
+    if (GrowthForm == "Logistic") return selectHarvest<T,GrowthLogistic,Clamp>(HarvestForm,CompetitionForm,PredationForm);
+    return nullptr;
+}
+
+/**
+ * @brief Chooses the kernel specialization for a model form combination. This is meant
+ * to be called once per run and not from within the time loop.
+ * @param GrowthForm : name of growth form (Null, Linear, Logistic)
+ * @param HarvestForm : name of harvest form (Null, Catch, Effort (qE), Exploitation (F))
+ * @param CompetitionForm : name of competition form (Null, NO_K, MS-PROD, AGG-PROD)
+ * @param PredationForm : name of predation form (Null, Type I, Type II, Type III)
+ * @param ClampToZero : if true, negative or NaN biomass values are set to 0 (forecasts),
+ * else the projection stops and returns false (estimation)
+ * @return Returns the kernel function or nullptr if any of the form names are unknown.
+ * The scalar type T defaults to double.
+ */
+template <class T = double>
+typename Types<T>::ProjectionFunction
+select(const std::string& GrowthForm,
+       const std::string& HarvestForm,
+       const std::string& CompetitionForm,
+       const std::string& PredationForm,
+       const bool&        ClampToZero)
+{
+    if (ClampToZero) {
+        return selectGrowth<T,true>( GrowthForm,HarvestForm,CompetitionForm,PredationForm);
+    } else {
+        return selectGrowth<T,false>(GrowthForm,HarvestForm,CompetitionForm,PredationForm);
+    }
+}
+
+} // end namespace nmfProjectionKernel
+
+
+/**
+ * @brief A self-contained set of inputs for projecting a model. The harvest time
+ * series referenced by System are owned here, so the struct can't be copied.
+ */
+struct nmfProjectionInputs {
+    nmfProjectionKernel::ProjectionFunction Project = nullptr;
+    nmfProjectionSystem                     System;
+    nmfProjectionParameters                 Parameters;
+    std::vector<double>                     InitialBiomass;
+    nmfProjectionKernel::Matrix             Catch;
+    nmfProjectionKernel::Matrix             Effort;
+    nmfProjectionKernel::Matrix             Exploitation;
+
+    nmfProjectionInputs() {}
+    nmfProjectionInputs(const nmfProjectionInputs&) = delete;
+    nmfProjectionInputs& operator=(const nmfProjectionInputs&) = delete;
+};
@@ -0,0 +1,299 @@
+/**
+ * @file nmfTrace.h
+ * @brief Definition of the scoped timers that write Chrome trace-event files
+ *
+ * A trace session (e.g., one estimation run) collects the begin time and duration of
+ * every NMF_TRACE_SCOPE block. Each thread records into its own buffer, so a timer
+ * costs two clock reads and an uncontended lock. At the end of the session the events
+ * can be written as Chrome trace-event JSON (viewable in chrome://tracing or Perfetto)
+ * and summed into per-stage totals.
+ *
+ * The timers are only compiled in if MSSPM_TRACE is defined (qmake CONFIG+=trace);
+ * otherwise NMF_TRACE_SCOPE expands to nothing. Database calls are timed by
+ * nmfTracedDatabase rather than at each call site.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief One timed block (times are in microseconds from the start of the session)
+ */
+struct nmfTraceEvent {
+    const char* Category;
+    const char* Name;
+    const char* Site;     // source file and line of the timer
+    int64_t     Start;
+    int64_t     Duration;
+};
+
+/**
+ * @brief Total time of all of the blocks with the same category and name
+ */
+struct nmfTraceTotal {
+    int64_t Count   = 0;
+    double  Seconds = 0;
+};
+
+/**
+ * @brief Events and totals recorded by one thread during one session
+ *
+ * Only the recording thread adds to the buffer; the mutex is taken by the
+ * recording thread and, once the session has ended, by the writer.
+ */
+struct nmfTraceBuffer {
+    QMutex                     Mutex;
+    int                        ThreadId   = 0;
+    int64_t                    NumDropped = 0;
+    std::vector<nmfTraceEvent> Events;
+    std::map<std::pair<const char*,const char*>,nmfTraceTotal> Totals;
+};
+
+/**
+ * @brief The process wide trace session
+ */
+class nmfTrace
+{
+private:
+    QMutex                                       m_Mutex;
+    std::atomic<bool>                            m_Active;
+    std::atomic<unsigned>                        m_Session;
+    std::atomic<int64_t>                         m_Epoch; // steady clock microseconds
+    std::vector<std::shared_ptr<nmfTraceBuffer> > m_Buffers;
+
+    nmfTrace() : m_Active(false), m_Session(0), m_Epoch(0) {}
+
+    static int64_t microseconds(const std::chrono::steady_clock::time_point& time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+    static std::string escape(const char* str) {
+        std::string escaped;
+        for (const char* c=str; *c != '\0'; ++c) {
+            if ((*c == '"') || (*c == '\\')) {
+                escaped += '\\';
+            }
+            escaped += *c;
+        }
+        return escaped;
+    }
+    // Gets the calling thread's buffer, registering a new one for each session
+    nmfTraceBuffer* buffer() {
+        static thread_local std::shared_ptr<nmfTraceBuffer> Buffer;
+        static thread_local unsigned BufferSession = 0;
+        if ((Buffer == nullptr) || (BufferSession != m_Session.load(std::memory_order_acquire))) {
+            QMutexLocker locker(&m_Mutex);
+            Buffer = std::make_shared<nmfTraceBuffer>();
+            Buffer->ThreadId = int(m_Buffers.size())+1;
+            m_Buffers.push_back(Buffer);
+            BufferSession = m_Session.load(std::memory_order_relaxed);
+        }
+        return Buffer.get();
+    }
+    std::vector<std::shared_ptr<nmfTraceBuffer> > buffers() {
+        QMutexLocker locker(&m_Mutex);
+        return m_Buffers;
+    }
+
+public:
+    /**
+     * @brief Maximum number of events kept per thread, later events are only added to the totals
+     */
+    static const std::size_t MaxEventsPerThread = 250000;
+
+    /**
+     * @brief Gets the process wide trace
+     */
+    static nmfTrace& instance() {
+        static nmfTrace trace;
+        return trace;
+    }
+    /**
+     * @brief Checks whether the timers were compiled in (i.e., MSSPM_TRACE was defined)
+     */
+    static bool isCompiledIn() {
+#ifdef MSSPM_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+    /**
+     * @brief Starts a new session, discarding the events of the previous one
+     */
+    void begin() {
+        QMutexLocker locker(&m_Mutex);
+        m_Active.store(false,std::memory_order_relaxed);
+        m_Buffers.clear();
+        m_Epoch.store(microseconds(std::chrono::steady_clock::now()),std::memory_order_relaxed);
+        m_Session.fetch_add(1,std::memory_order_release);
+        m_Active.store(true,std::memory_order_release);
+    }
+    /**
+     * @brief Stops recording; the session's events remain available until the next begin()
+     */
+    void end() {
+        m_Active.store(false,std::memory_order_release);
+    }
+    /**
+     * @brief Checks whether a session is recording
+     */
+    bool isActive() const {
+        return m_Active.load(std::memory_order_acquire);
+    }
+    /**
+     * @brief Records a timed block (called by nmfTraceScope)
+     * @param Category : the block's category (e.g., "db")
+     * @param Name : the block's name
+     * @param Site : source file and line of the timer
+     * @param Start : time the block began
+     * @param End : time the block ended
+     */
+    void record(const char* Category,
+                const char* Name,
+                const char* Site,
+                const std::chrono::steady_clock::time_point& Start,
+                const std::chrono::steady_clock::time_point& End) {
+        if (! isActive()) {
+            return;
+        }
+        nmfTraceBuffer* Buffer = buffer();
+        int64_t start    = microseconds(Start) - m_Epoch.load(std::memory_order_relaxed);
+        int64_t duration = microseconds(End) - microseconds(Start);
+        QMutexLocker locker(&Buffer->Mutex);
+        nmfTraceTotal& Total = Buffer->Totals[std::make_pair(Category,Name)];
+        ++Total.Count;
+        Total.Seconds += std::chrono::duration<double>(End-Start).count();
+        if (Buffer->Events.size() < MaxEventsPerThread) {
+            Buffer->Events.push_back({Category,Name,Site,start,duration});
+        } else {
+            ++Buffer->NumDropped;
+        }
+    }
+    /**
+     * @brief Sums the session's blocks by category and name
+     * @return Returns the totals keyed by "category: name" (nested blocks are included in their parents' totals)
+     */
+    std::map<std::string,nmfTraceTotal> totals() {
+        std::map<std::string,nmfTraceTotal> Totals;
+        for (std::shared_ptr<nmfTraceBuffer>& Buffer : buffers()) {
+            QMutexLocker locker(&Buffer->Mutex);
+            for (const auto& item : Buffer->Totals) {
+                nmfTraceTotal& Total = Totals[std::string(item.first.first) + ": " + item.first.second];
+                Total.Count   += item.second.Count;
+                Total.Seconds += item.second.Seconds;
+            }
+        }
+        return Totals;
+    }
+    /**
+     * @brief Writes the session's events as Chrome trace-event JSON
+     * @param FileName : name of the trace file
+     * @return Returns false if the file couldn't be written
+     */
+    bool write(const std::string& FileName) {
+        bool first = true;
+        int64_t NumDropped = 0;
+        std::string Site;
+        std::ofstream outputFile(FileName);
+
+        if (! outputFile) {
+            return false;
+        }
+        outputFile << "{\"traceEvents\":[";
+        for (std::shared_ptr<nmfTraceBuffer>& Buffer : buffers()) {
+            QMutexLocker locker(&Buffer->Mutex);
+            for (const nmfTraceEvent& Event : Buffer->Events) {
+                Site = escape(Event.Site);
+                Site = Site.substr(Site.find_last_of("/\\")+1);
+                outputFile << (first ? "\n" : ",\n")
+                           << "{\"name\":\"" << escape(Event.Name)
+                           << "\",\"cat\":\"" << escape(Event.Category)
+                           << "\",\"ph\":\"X\",\"ts\":" << Event.Start
+                           << ",\"dur\":" << Event.Duration
+                           << ",\"pid\":1,\"tid\":" << Buffer->ThreadId
+                           << ",\"args\":{\"site\":\"" << Site << "\"}}";
+                first = false;
+            }
+            NumDropped += Buffer->NumDropped;
+        }
+        outputFile << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << NumDropped << "}}\n";
+        outputFile.close();
+
+        return ! outputFile.fail();
+    }
+};
+
+/**
+ * @brief Times the enclosing block if a trace session is recording (use NMF_TRACE_SCOPE)
+ */
+class nmfTraceScope
+{
+private:
+    const char* m_Category;
+    const char* m_Name;
+    const char* m_Site;
+    bool        m_Active;
+    std::chrono::steady_clock::time_point m_Start;
+
+public:
+    nmfTraceScope(const char* Category, const char* Name, const char* Site) :
+        m_Category(Category), m_Name(Name), m_Site(Site),
+        m_Active(nmfTrace::instance().isActive()) {
+        if (m_Active) {
+            m_Start = std::chrono::steady_clock::now();
+        }
+    }
+   ~nmfTraceScope() {
+        if (m_Active) {
+            nmfTrace::instance().record(m_Category,m_Name,m_Site,m_Start,std::chrono::steady_clock::now());
+        }
+    }
+    nmfTraceScope(const nmfTraceScope&) = delete;
+    nmfTraceScope& operator=(const nmfTraceScope&) = delete;
+};
+
+#define NMF_TRACE_STRINGIZE2(x) #x
+#define NMF_TRACE_STRINGIZE(x) NMF_TRACE_STRINGIZE2(x)
+#define NMF_TRACE_CONCAT2(a,b) a##b
+#define NMF_TRACE_CONCAT(a,b) NMF_TRACE_CONCAT2(a,b)
+#define NMF_TRACE_SITE __FILE__ ":" NMF_TRACE_STRINGIZE(__LINE__)
+
+#ifdef MSSPM_TRACE
+#define NMF_TRACE_SCOPE(Category,Name) \
+    nmfTraceScope NMF_TRACE_CONCAT(nmfTraceScope_,__LINE__)(Category,Name,NMF_TRACE_SITE)
+#else
+#define NMF_TRACE_SCOPE(Category,Name) ((void)0)
+#endif
@@ -0,0 +1,76 @@
+/**
+ * @file nmfTracedDatabase.h
+ * @brief Definition of the database whose queries and updates are timed
+ *
+ * The MSSPM libraries hold their database as an nmfTracedDatabase so that every
+ * nmfQueryDatabase and nmfUpdateDatabase call is timed in one place rather than at
+ * each call site. Without MSSPM_TRACE it's nmfDatabase itself.
+ *
+ * @copyright
+ * Public Domain Notice\n
+ *
+ * National Oceanic And Atmospheric Administration\n\n
+ *
+ * This software is a "United States Government Work" under the terms of the
+ * United States Copyright Act.  It was written as part of the author's official
+ * duties as a United States Government employee/contractor and thus cannot be copyrighted.
+ * This software is freely available to the public for use. The National Oceanic
+ * And Atmospheric Administration and the U.S. Government have not placed any
+ * restriction on its use or reproduction.  Although all reasonable efforts have
+ * been taken to ensure the accuracy and reliability of the software and data,
+ * the National Oceanic And Atmospheric Administration and the U.S. Government
+ * do not and cannot warrant the performance or results that may be obtained
+ * by using this software or data. The National Oceanic And Atmospheric
+ * Administration and the U.S. Government disclaim all warranties, express
+ * or implied, including warranties of performance, merchantability or fitness
+ * for any particular purpose.\n\n
+ *
+ * Please cite the author(s) in any work or product based on this material.
+ */
+
+
+#pragma once
+
+#include "nmfDatabase.h"
+#include "nmfTrace.h"
+
+#include <utility>
+
+#ifdef MSSPM_TRACE
+/**
+ * @brief nmfDatabase with its queries and updates timed in the "db" category
+ *
+ * nmfDatabase is external and its methods aren't virtual, so the timed methods
+ * hide the base class ones. Calls made through an nmfDatabase pointer aren't timed.
+ */
+class nmfTracedDatabase : public nmfDatabase
+{
+public:
+    using nmfDatabase::nmfDatabase;
+
+    /**
+     * @brief Times nmfDatabase::nmfQueryDatabase
+     * @param args : the arguments of nmfDatabase::nmfQueryDatabase
+     * @return Returns the result of nmfDatabase::nmfQueryDatabase
+     */
+    template <class... Args>
+    auto nmfQueryDatabase(Args&&... args)
+        -> decltype(nmfDatabase::nmfQueryDatabase(std::forward<Args>(args)...)) {
+        NMF_TRACE_SCOPE("db","nmfQueryDatabase");
+        return nmfDatabase::nmfQueryDatabase(std::forward<Args>(args)...);
+    }
+    /**
+     * @brief Times nmfDatabase::nmfUpdateDatabase
+     * @param args : the arguments of nmfDatabase::nmfUpdateDatabase
+     * @return Returns the result of nmfDatabase::nmfUpdateDatabase
+     */
+    template <class... Args>
+    auto nmfUpdateDatabase(Args&&... args)
+        -> decltype(nmfDatabase::nmfUpdateDatabase(std::forward<Args>(args)...)) {
+        NMF_TRACE_SCOPE("db","nmfUpdateDatabase");
+        return nmfDatabase::nmfUpdateDatabase(std::forward<Args>(args)...);
+    }
+};
+#else
+using nmfTracedDatabase = nmfDatabase;
+#endif